@@ -0,0 +1,242 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <getopt.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/cyber.h"
+#include "cyber/message/raw_message.h"
+
+using apollo::cyber::Node;
+using apollo::cyber::Reader;
+using apollo::cyber::ReaderConfig;
+using apollo::cyber::Time;
+using apollo::cyber::message::RawMessage;
+
+std::string BINARY_NAME = "cyber_benchmark_batch_reader";  // NOLINT
+
+int message_rate = 1000;
+int message_size = 64;
+int batch_size = 10;
+int batch_timeout_us = 10000;
+int duration_s = 5;
+
+struct Result {
+  uint64_t messages = 0;
+  uint64_t wakeups = 0;
+  double cpu_percent = 0.0;
+  uint64_t p50_us = 0;
+  uint64_t p99_us = 0;
+  uint64_t max_us = 0;
+};
+
+void DisplayUsage() {
+  AINFO << "Usage: \n    " << BINARY_NAME << " [OPTION]...\n"
+        << "Description: \n"
+        << "    -h, --help: help information \n"
+        << "    -r, --rate=hz: messages written per second, default value is "
+           "1000\n"
+        << "    -s, --size=bytes: message size, default value is 64\n"
+        << "    -b, --batch_size=n: messages of a batch, default value is 10\n"
+        << "    -t, --batch_timeout=us: max delay of a batch, default value "
+           "is 10000\n"
+        << "    -d, --duration=s: duration of each run, default value is 5\n"
+        << "Example:\n"
+        << "    " << BINARY_NAME << " -h\n"
+        << "    " << BINARY_NAME << " -r 200 -b 10 -t 20000\n";
+}
+
+void GetOptions(const int argc, char* const argv[]) {
+  opterr = 0;  // extern int opterr
+  int long_index = 0;
+  const std::string short_opts = "hr:s:b:t:d:";
+  static const struct option long_opts[] = {
+      {"help", no_argument, nullptr, 'h'},
+      {"rate", required_argument, nullptr, 'r'},
+      {"size", required_argument, nullptr, 's'},
+      {"batch_size", required_argument, nullptr, 'b'},
+      {"batch_timeout", required_argument, nullptr, 't'},
+      {"duration", required_argument, nullptr, 'd'},
+      {NULL, no_argument, nullptr, 0}};
+
+  do {
+    int opt =
+        getopt_long(argc, argv, short_opts.c_str(), long_opts, &long_index);
+    if (opt == -1) {
+      break;
+    }
+    switch (opt) {
+      case 'r':
+        message_rate = std::stoi(std::string(optarg));
+        break;
+      case 's':
+        message_size = std::stoi(std::string(optarg));
+        break;
+      case 'b':
+        batch_size = std::stoi(std::string(optarg));
+        break;
+      case 't':
+        batch_timeout_us = std::stoi(std::string(optarg));
+        break;
+      case 'd':
+        duration_s = std::stoi(std::string(optarg));
+        break;
+      case 'h':
+        DisplayUsage();
+        exit(0);
+      default:
+        break;
+    }
+  } while (true);
+
+  if (message_rate <= 0 || message_size < static_cast<int>(sizeof(uint64_t)) ||
+      batch_size <= 0 || batch_timeout_us < 0 || duration_s <= 0) {
+    AERROR << "Invalid options";
+    DisplayUsage();
+    exit(-1);
+  }
+}
+
+uint64_t CpuTimeUs() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000ULL +
+         usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+// Collects the delivery latency of the messages, the write time is carried
+// by the first bytes of the message
+class Collector {
+ public:
+  void OnBatch(const std::vector<std::shared_ptr<RawMessage>>& msgs) {
+    const uint64_t now = Time::MonoTime().ToNanosecond();
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++wakeups_;
+    for (const auto& msg : msgs) {
+      uint64_t stamp = 0;
+      std::memcpy(&stamp, msg->message.data(), sizeof(stamp));
+      latencies_.push_back((now - stamp) / 1000);
+    }
+  }
+
+  Result Finish(const uint64_t cpu_us, const uint64_t wall_us) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Result result;
+    result.messages = latencies_.size();
+    result.wakeups = wakeups_;
+    result.cpu_percent = 100.0 * static_cast<double>(cpu_us) /
+                         static_cast<double>(wall_us);
+    if (!latencies_.empty()) {
+      std::sort(latencies_.begin(), latencies_.end());
+      result.p50_us = latencies_[latencies_.size() / 2];
+      result.p99_us = latencies_[latencies_.size() * 99 / 100];
+      result.max_us = latencies_.back();
+    }
+    return result;
+  }
+
+ private:
+  std::mutex mutex_;
+  uint64_t wakeups_ = 0;
+  std::vector<uint64_t> latencies_;
+};
+
+Result Run(Node* node, const bool batched) {
+  const std::string channel =
+      std::string("/benchmark/batch_reader/") + (batched ? "batch" : "single");
+  auto collector = std::make_shared<Collector>();
+  ReaderConfig config;
+  config.channel_name = channel;
+  std::shared_ptr<Reader<RawMessage>> reader = nullptr;
+  if (batched) {
+    config.batch_size = batch_size;
+    config.batch_timeout_us = batch_timeout_us;
+    reader = node->CreateBatchReader<RawMessage>(
+        config, [collector](const std::vector<std::shared_ptr<RawMessage>>&
+                                msgs) { collector->OnBatch(msgs); });
+  } else {
+    // deep enough to not lose messages behind a slow wakeup either
+    config.pending_queue_size = 2 * batch_size;
+    reader = node->CreateReader<RawMessage>(
+        config, [collector](const std::shared_ptr<RawMessage>& msg) {
+          collector->OnBatch({msg});
+        });
+  }
+  auto writer = node->CreateWriter<RawMessage>(channel);
+  if (reader == nullptr || writer == nullptr) {
+    AERROR << "Failed to create the reader or the writer of " << channel;
+    exit(-1);
+  }
+
+  const uint64_t nums_of_message =
+      static_cast<uint64_t>(message_rate) * duration_s;
+  const auto period = std::chrono::nanoseconds(1000000000LL / message_rate);
+  const uint64_t cpu_start = CpuTimeUs();
+  const auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < nums_of_message; ++i) {
+    std::this_thread::sleep_until(start + period * i);
+    auto msg = std::make_shared<RawMessage>(std::string(message_size, '\0'));
+    const uint64_t stamp = Time::MonoTime().ToNanosecond();
+    std::memcpy(&msg->message[0], &stamp, sizeof(stamp));
+    writer->Write(msg);
+  }
+  // let the last batch time out
+  std::this_thread::sleep_for(
+      std::chrono::microseconds(batch_timeout_us + 100000));
+  const uint64_t cpu_us = CpuTimeUs() - cpu_start;
+  const uint64_t wall_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+  reader->Shutdown();
+  writer->Shutdown();
+  return collector->Finish(cpu_us, wall_us);
+}
+
+int main(int argc, char** argv) {
+  GetOptions(argc, argv);
+  apollo::cyber::Init(argv[0], BINARY_NAME);
+  auto node = apollo::cyber::CreateNode(BINARY_NAME);
+
+  std::printf("rate %dHz, size %dB, batch %d messages or %dus\n",
+              message_rate, message_size, batch_size, batch_timeout_us);
+  std::printf("%-8s %10s %12s %8s %10s %10s %10s\n", "reader", "messages",
+              "wakeups/s", "cpu(%)", "p50(us)", "p99(us)", "max(us)");
+  for (const bool batched : {false, true}) {
+    const Result result = Run(node.get(), batched);
+    std::printf("%-8s %10" PRIu64 " %12.1f %8.2f %10" PRIu64 " %10" PRIu64
+                " %10" PRIu64 "\n",
+                batched ? "batch" : "single", result.messages,
+                static_cast<double>(result.wakeups) / duration_s,
+                result.cpu_percent, result.p50_us, result.p99_us,
+                result.max_us);
+  }
+
+  apollo::cyber::Clear();
+  return 0;
+}
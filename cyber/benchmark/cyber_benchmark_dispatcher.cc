@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/cyber.h"
+#include "cyber/data/data_dispatcher.h"
+#include "cyber/message/raw_message.h"
+
+using apollo::cyber::data::CacheBuffer;
+using apollo::cyber::data::ChannelBuffer;
+using apollo::cyber::data::DataDispatcher;
+using apollo::cyber::data::RingBuffer;
+using apollo::cyber::message::RawMessage;
+
+std::string BINARY_NAME = "cyber_benchmark_dispatcher";  // NOLINT
+
+int max_subscribers = 32;
+int nums_of_message = 100000;
+int queue_size = 10;
+int message_interval_us = 0;
+
+struct Latency {
+  double avg_ns = 0.0;
+  uint64_t p50_ns = 0;
+  uint64_t p99_ns = 0;
+  uint64_t max_ns = 0;
+};
+
+void DisplayUsage() {
+  AINFO << "Usage: \n    " << BINARY_NAME << " [OPTION]...\n"
+        << "Description: \n"
+        << "    -h, --help: help information \n"
+        << "    -s, --max_subscribers=max_subscribers: subscribers grow "
+           "from 1 to max_subscribers by doubling, default value is 32\n"
+        << "    -n, --nums_of_message=nums_of_message: messages dispatched "
+           "for each subscriber count, default value is 100000\n"
+        << "    -q, --queue_size=queue_size: pending queue size of each "
+           "subscriber, default value is 10\n"
+        << "    -i, --interval=us: interval between two messages, default "
+           "value is 0\n"
+        << "Example:\n"
+        << "    " << BINARY_NAME << " -h\n"
+        << "    " << BINARY_NAME << " -s 32 -n 100000\n";
+}
+
+void GetOptions(const int argc, char* const argv[]) {
+  opterr = 0;  // extern int opterr
+  int long_index = 0;
+  const std::string short_opts = "hs:n:q:i:";
+  static const struct option long_opts[] = {
+      {"help", no_argument, nullptr, 'h'},
+      {"max_subscribers", required_argument, nullptr, 's'},
+      {"nums_of_message", required_argument, nullptr, 'n'},
+      {"queue_size", required_argument, nullptr, 'q'},
+      {"interval", required_argument, nullptr, 'i'},
+      {NULL, no_argument, nullptr, 0}};
+
+  do {
+    int opt =
+        getopt_long(argc, argv, short_opts.c_str(), long_opts, &long_index);
+    if (opt == -1) {
+      break;
+    }
+    switch (opt) {
+      case 's':
+        max_subscribers = std::stoi(std::string(optarg));
+        break;
+      case 'n':
+        nums_of_message = std::stoi(std::string(optarg));
+        break;
+      case 'q':
+        queue_size = std::stoi(std::string(optarg));
+        break;
+      case 'i':
+        message_interval_us = std::stoi(std::string(optarg));
+        break;
+      case 'h':
+        DisplayUsage();
+        exit(0);
+      default:
+        break;
+    }
+  } while (true);
+
+  if (max_subscribers <= 0 || nums_of_message <= 0 || queue_size <= 0 ||
+      message_interval_us < 0) {
+    AERROR << "Invalid options";
+    DisplayUsage();
+    exit(-1);
+  }
+}
+
+// Dispatch messages to the subscribers, each of them fetches them in its own
+// thread as a reader would, and return the latency of the dispatching.
+Latency RunDispatch(const uint64_t channel_id, const int subscribers,
+                    const bool lock_free) {
+  std::vector<ChannelBuffer<RawMessage>> buffers;
+  for (int i = 0; i < subscribers; ++i) {
+    if (lock_free) {
+      buffers.emplace_back(channel_id, new RingBuffer<RawMessage>(queue_size));
+    } else {
+      buffers.emplace_back(
+          channel_id, new CacheBuffer<std::shared_ptr<RawMessage>>(queue_size));
+    }
+    DataDispatcher<RawMessage>::Instance()->AddBuffer(buffers.back());
+  }
+
+  std::atomic<bool> stop = {false};
+  std::vector<std::thread> readers;
+  for (auto& buffer : buffers) {
+    readers.emplace_back([&buffer, &stop]() {
+      uint64_t index = 0;
+      std::shared_ptr<RawMessage> msg;
+      while (!stop.load(std::memory_order_relaxed)) {
+        if (buffer.Fetch(&index, msg)) {
+          ++index;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  auto msg = std::make_shared<RawMessage>(std::string(64, 'a'));
+  std::vector<uint64_t> latencies;
+  latencies.reserve(nums_of_message);
+  for (int i = 0; i < nums_of_message; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    DataDispatcher<RawMessage>::Instance()->Dispatch(channel_id, msg);
+    const auto end = std::chrono::steady_clock::now();
+    latencies.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count());
+    if (message_interval_us > 0) {
+      std::this_thread::sleep_for(
+          std::chrono::microseconds(message_interval_us));
+    }
+  }
+
+  stop.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  Latency latency;
+  uint64_t sum = 0;
+  for (const uint64_t ns : latencies) {
+    sum += ns;
+  }
+  latency.avg_ns = static_cast<double>(sum) / latencies.size();
+  std::sort(latencies.begin(), latencies.end());
+  latency.p50_ns = latencies[latencies.size() / 2];
+  latency.p99_ns = latencies[latencies.size() * 99 / 100];
+  latency.max_ns = latencies.back();
+  return latency;
+}
+
+int main(int argc, char** argv) {
+  GetOptions(argc, argv);
+  apollo::cyber::Init(argv[0], BINARY_NAME);
+
+  std::printf("%-12s %-10s %12s %10s %10s %10s\n", "subscribers", "buffer",
+              "avg(ns)", "p50(ns)", "p99(ns)", "max(ns)");
+  uint64_t channel_id = std::hash<std::string>()(BINARY_NAME);
+  for (int subscribers = 1; subscribers <= max_subscribers;
+       subscribers *= 2) {
+    for (const bool lock_free : {false, true}) {
+      const Latency latency = RunDispatch(++channel_id, subscribers, lock_free);
+      std::printf(
+          "%-12d %-10s %12.1f %10" PRIu64 " %10" PRIu64 " %10" PRIu64 "\n",
+          subscribers, lock_free ? "ring" : "mutex", latency.avg_ns,
+          latency.p50_ns, latency.p99_ns, latency.max_ns);
+    }
+  }
+
+  apollo::cyber::Clear();
+  return 0;
+}
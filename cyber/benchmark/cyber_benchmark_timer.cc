@@ -0,0 +1,210 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/component/timer_component.h"
+#include "cyber/cyber.h"
+#include "cyber/timer/timing_wheel.h"
+
+using apollo::cyber::Time;
+using apollo::cyber::TimerComponent;
+using apollo::cyber::TimerComponentConfig;
+using apollo::cyber::TimingWheel;
+
+std::string BINARY_NAME = "cyber_benchmark_timer";  // NOLINT
+
+int nums_of_component = 4;
+int interval_ms = 10;
+int duration_s = 10;
+int work_us = 1000;
+
+void DisplayUsage() {
+  AINFO << "Usage: \n    " << BINARY_NAME << " [OPTION]...\n"
+        << "Description: \n"
+        << "    -h, --help: help information \n"
+        << "    -n, --nums_of_component=nums_of_component: timer components "
+           "running together, default value is 4\n"
+        << "    -i, --interval=ms: interval of the components, default value "
+           "is 10\n"
+        << "    -d, --duration=s: duration of the run, default value is 10\n"
+        << "    -w, --work=us: busy time of each Proc, default value is 1000\n"
+        << "The resolution of the timing wheel is the resolution_us of the "
+           "timer_conf in cyber.pb.conf\n"
+        << "Example:\n"
+        << "    " << BINARY_NAME << " -h\n"
+        << "    " << BINARY_NAME << " -n 4 -i 10 -d 10\n";
+}
+
+void GetOptions(const int argc, char* const argv[]) {
+  opterr = 0;  // extern int opterr
+  int long_index = 0;
+  const std::string short_opts = "hn:i:d:w:";
+  static const struct option long_opts[] = {
+      {"help", no_argument, nullptr, 'h'},
+      {"nums_of_component", required_argument, nullptr, 'n'},
+      {"interval", required_argument, nullptr, 'i'},
+      {"duration", required_argument, nullptr, 'd'},
+      {"work", required_argument, nullptr, 'w'},
+      {NULL, no_argument, nullptr, 0}};
+
+  do {
+    int opt =
+        getopt_long(argc, argv, short_opts.c_str(), long_opts, &long_index);
+    if (opt == -1) {
+      break;
+    }
+    switch (opt) {
+      case 'n':
+        nums_of_component = std::stoi(std::string(optarg));
+        break;
+      case 'i':
+        interval_ms = std::stoi(std::string(optarg));
+        break;
+      case 'd':
+        duration_s = std::stoi(std::string(optarg));
+        break;
+      case 'w':
+        work_us = std::stoi(std::string(optarg));
+        break;
+      case 'h':
+        DisplayUsage();
+        exit(0);
+      default:
+        break;
+    }
+  } while (true);
+
+  if (nums_of_component <= 0 || interval_ms <= 0 || duration_s <= 0 ||
+      work_us < 0) {
+    AERROR << "Invalid options";
+    DisplayUsage();
+    exit(-1);
+  }
+}
+
+// Timer component keeping the monotonic time of each of its Proc
+class JitterComponent : public TimerComponent {
+ public:
+  bool Init() override {
+    stamps_.reserve(duration_s * 1000 / interval_ms + 16);
+    return true;
+  }
+
+  bool Proc() override {
+    const uint64_t now = Time::MonoTime().ToNanosecond();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stamps_.push_back(now);
+    }
+    // busy loop as the Proc of a real component would
+    while (Time::MonoTime().ToNanosecond() - now <
+           static_cast<uint64_t>(work_us) * 1000) {
+    }
+    return true;
+  }
+
+  std::vector<uint64_t> Stamps() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stamps_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<uint64_t> stamps_;
+};
+
+struct Jitter {
+  size_t fires = 0;
+  int64_t p50_us = 0;
+  int64_t p99_us = 0;
+  int64_t max_us = 0;
+  // lateness of the last Proc from its place on the grid of the first one
+  int64_t drift_us = 0;
+};
+
+// Jitter of the periods between two Procs
+Jitter ComputeJitter(const std::vector<uint64_t>& stamps) {
+  Jitter jitter;
+  jitter.fires = stamps.size();
+  if (stamps.size() < 2) {
+    return jitter;
+  }
+  const int64_t interval_ns = static_cast<int64_t>(interval_ms) * 1000000;
+  std::vector<int64_t> deviations;
+  for (size_t i = 1; i < stamps.size(); ++i) {
+    deviations.push_back(
+        std::abs(static_cast<int64_t>(stamps[i] - stamps[i - 1]) -
+                 interval_ns));
+  }
+  std::sort(deviations.begin(), deviations.end());
+  jitter.p50_us = deviations[deviations.size() / 2] / 1000;
+  jitter.p99_us = deviations[deviations.size() * 99 / 100] / 1000;
+  jitter.max_us = deviations.back() / 1000;
+  jitter.drift_us = (static_cast<int64_t>(stamps.back() - stamps.front()) -
+                     static_cast<int64_t>(stamps.size() - 1) * interval_ns) /
+                    1000;
+  return jitter;
+}
+
+int main(int argc, char** argv) {
+  GetOptions(argc, argv);
+  apollo::cyber::Init(argv[0], BINARY_NAME);
+
+  std::vector<std::shared_ptr<JitterComponent>> components;
+  for (int i = 0; i < nums_of_component; ++i) {
+    TimerComponentConfig config;
+    config.set_name(BINARY_NAME + "_" + std::to_string(i));
+    config.set_interval(interval_ms);
+    auto component = std::make_shared<JitterComponent>();
+    if (!component->Initialize(config)) {
+      AERROR << "Failed to initialize component " << i;
+      return -1;
+    }
+    components.push_back(component);
+  }
+  std::this_thread::sleep_for(std::chrono::seconds(duration_s));
+  for (auto& component : components) {
+    component->Shutdown();
+  }
+
+  std::printf("resolution %" PRIu64 "us, interval %dms, work %dus\n",
+              TimingWheel::Instance()->ResolutionNs() / 1000, interval_ms,
+              work_us);
+  std::printf("%-10s %8s %10s %10s %10s %10s\n", "component", "fires",
+              "p50(us)", "p99(us)", "max(us)", "drift(us)");
+  for (size_t i = 0; i < components.size(); ++i) {
+    const Jitter jitter = ComputeJitter(components[i]->Stamps());
+    std::printf("%-10zu %8zu %10" PRId64 " %10" PRId64 " %10" PRId64
+                " %10" PRId64 "\n",
+                i, jitter.fires, jitter.p50_us, jitter.p99_us, jitter.max_us,
+                jitter.drift_us);
+  }
+
+  apollo::cyber::Clear();
+  return 0;
+}
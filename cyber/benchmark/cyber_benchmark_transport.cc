@@ -0,0 +1,446 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <getopt.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/common/environment.h"
+#include "cyber/common/file.h"
+#include "cyber/common/global_data.h"
+#include "cyber/cyber.h"
+#include "cyber/message/raw_message.h"
+#include "cyber/proto/cyber_conf.pb.h"
+
+using apollo::cyber::Node;
+using apollo::cyber::Reader;
+using apollo::cyber::Time;
+using apollo::cyber::common::GetAbsolutePath;
+using apollo::cyber::common::GetProtoFromFile;
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::common::WorkRoot;
+using apollo::cyber::message::RawMessage;
+using apollo::cyber::proto::CyberConfig;
+using apollo::cyber::proto::OptionalMode;
+
+std::string BINARY_NAME = "cyber_benchmark_transport";  // NOLINT
+
+std::vector<std::string> modes = {"intra", "shm", "rtps"};
+std::vector<std::string> notifiers = {"condition", "multicast"};
+std::vector<std::string> policies = {"classic", "choreography"};
+std::vector<uint64_t> message_sizes = {64,          1024,      16 * 1024,
+                                       128 * 1024, 1024 * 1024,
+                                       8 * 1024 * 1024};
+std::vector<uint64_t> message_rates = {100, 1000};
+std::vector<uint64_t> subscriber_nums = {1, 4};
+int duration_s = 2;
+int warmup_ms = 500;
+uint64_t max_bandwidth_mb = 1024;
+
+struct Result {
+  uint64_t sent = 0;
+  uint64_t received = 0;
+  uint64_t p50_us = 0;
+  uint64_t p99_us = 0;
+  uint64_t p999_us = 0;
+  uint64_t max_us = 0;
+  double cpu_us_per_msg = 0.0;
+};
+
+void DisplayUsage() {
+  AINFO << "Usage: \n    " << BINARY_NAME << " [OPTION]...\n"
+        << "Description: \n"
+        << "    Runs every combination of the values given, one process per "
+           "mode, notifier and scheduler policy, and prints one json object "
+           "per run on stdout.\n"
+        << "    -h, --help: help information \n"
+        << "    -m, --modes=list: transport modes among intra, shm and rtps, "
+           "default value is intra,shm,rtps\n"
+        << "    -n, --notifiers=list: shm notifiers among condition and "
+           "multicast, default value is condition,multicast\n"
+        << "    -p, --policies=list: scheduler policies among classic and "
+           "choreography, default value is classic,choreography\n"
+        << "    -s, --sizes=list: message sizes in bytes, default value is "
+           "64,1024,16384,131072,1048576,8388608\n"
+        << "    -r, --rates=list: messages written per second, default value "
+           "is 100,1000\n"
+        << "    -c, --subscribers=list: readers of the channel, default value "
+           "is 1,4\n"
+        << "    -d, --duration=s: duration of each run, default value is 2\n"
+        << "    -w, --warmup=ms: wait for the readers to be matched, default "
+           "value is 500\n"
+        << "    -b, --max_bandwidth=MB/s: skip the runs writing more, "
+           "default value is 1024\n"
+        << "Example:\n"
+        << "    " << BINARY_NAME << " -h\n"
+        << "    " << BINARY_NAME << " -m shm -s 64,1048576 > baseline.json\n";
+}
+
+std::vector<std::string> SplitList(const std::string& str) {
+  std::vector<std::string> items;
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+std::vector<uint64_t> SplitNumbers(const std::string& str) {
+  std::vector<uint64_t> numbers;
+  for (const auto& item : SplitList(str)) {
+    numbers.push_back(std::stoull(item));
+  }
+  return numbers;
+}
+
+bool Contains(const std::vector<std::string>& allowed,
+              const std::vector<std::string>& values) {
+  for (const auto& value : values) {
+    if (std::find(allowed.begin(), allowed.end(), value) == allowed.end()) {
+      return false;
+    }
+  }
+  return !values.empty();
+}
+
+void GetOptions(const int argc, char* const argv[]) {
+  opterr = 0;  // extern int opterr
+  int long_index = 0;
+  const std::string short_opts = "hm:n:p:s:r:c:d:w:b:";
+  static const struct option long_opts[] = {
+      {"help", no_argument, nullptr, 'h'},
+      {"modes", required_argument, nullptr, 'm'},
+      {"notifiers", required_argument, nullptr, 'n'},
+      {"policies", required_argument, nullptr, 'p'},
+      {"sizes", required_argument, nullptr, 's'},
+      {"rates", required_argument, nullptr, 'r'},
+      {"subscribers", required_argument, nullptr, 'c'},
+      {"duration", required_argument, nullptr, 'd'},
+      {"warmup", required_argument, nullptr, 'w'},
+      {"max_bandwidth", required_argument, nullptr, 'b'},
+      {NULL, no_argument, nullptr, 0}};
+
+  do {
+    int opt =
+        getopt_long(argc, argv, short_opts.c_str(), long_opts, &long_index);
+    if (opt == -1) {
+      break;
+    }
+    switch (opt) {
+      case 'm':
+        modes = SplitList(optarg);
+        break;
+      case 'n':
+        notifiers = SplitList(optarg);
+        break;
+      case 'p':
+        policies = SplitList(optarg);
+        break;
+      case 's':
+        message_sizes = SplitNumbers(optarg);
+        break;
+      case 'r':
+        message_rates = SplitNumbers(optarg);
+        break;
+      case 'c':
+        subscriber_nums = SplitNumbers(optarg);
+        break;
+      case 'd':
+        duration_s = std::stoi(std::string(optarg));
+        break;
+      case 'w':
+        warmup_ms = std::stoi(std::string(optarg));
+        break;
+      case 'b':
+        max_bandwidth_mb = std::stoull(std::string(optarg));
+        break;
+      case 'h':
+        DisplayUsage();
+        exit(0);
+      default:
+        break;
+    }
+  } while (true);
+
+  const bool valid_sizes =
+      !message_sizes.empty() &&
+      *std::min_element(message_sizes.begin(), message_sizes.end()) >=
+          sizeof(uint64_t);
+  const bool valid_numbers =
+      !message_rates.empty() && !subscriber_nums.empty() &&
+      *std::min_element(message_rates.begin(), message_rates.end()) > 0 &&
+      *std::min_element(subscriber_nums.begin(), subscriber_nums.end()) > 0;
+  if (!Contains({"intra", "shm", "rtps"}, modes) ||
+      !Contains({"condition", "multicast"}, notifiers) ||
+      !Contains({"classic", "choreography"}, policies) || !valid_sizes ||
+      !valid_numbers || duration_s <= 0 || warmup_ms < 0) {
+    AERROR << "Invalid options";
+    DisplayUsage();
+    exit(-1);
+  }
+}
+
+uint64_t CpuTimeUs() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000ULL +
+         usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+// The mode and the notifier are read from the cyber conf, and the scheduler
+// policy from the conf of the process group, when cyber is initialized. A
+// copy of the conf directory is made for the process with the ones asked.
+bool PrepareWorkRoot(const std::string& mode, const std::string& notifier,
+                     const std::string& policy) {
+  const std::string conf_dir = GetAbsolutePath(WorkRoot(), "conf");
+  CyberConfig config;
+  if (!GetProtoFromFile(GetAbsolutePath(conf_dir, "cyber.pb.conf"),
+                        &config)) {
+    AERROR << "Failed to read the cyber conf of " << WorkRoot();
+    return false;
+  }
+  OptionalMode optional_mode = OptionalMode::INTRA;
+  if (mode == "shm") {
+    optional_mode = OptionalMode::SHM;
+  } else if (mode == "rtps") {
+    optional_mode = OptionalMode::RTPS;
+  }
+  auto transport_conf = config.mutable_transport_conf();
+  // the writer and the readers share the process
+  transport_conf->mutable_communication_mode()->set_same_proc(optional_mode);
+  transport_conf->mutable_shm_conf()->set_notifier_type(notifier);
+
+  const std::string work_root =
+      "/tmp/" + BINARY_NAME + "_" + std::to_string(getpid());
+  const std::string sched_conf = "example_sched_" + policy + ".conf";
+  if (!apollo::cyber::common::EnsureDirectory(work_root + "/conf") ||
+      !apollo::cyber::common::SetProtoToASCIIFile(
+          config, work_root + "/conf/cyber.pb.conf") ||
+      !apollo::cyber::common::CopyFile(
+          GetAbsolutePath(conf_dir, sched_conf),
+          work_root + "/conf/" + sched_conf)) {
+    AERROR << "Failed to prepare the conf of " << work_root;
+    return false;
+  }
+  setenv("CYBER_PATH", work_root.c_str(), 1);
+  return true;
+}
+
+// Delivery latency of the messages to a reader, the write time is carried
+// by the first bytes of the message
+class Collector {
+ public:
+  explicit Collector(const size_t expected) { latencies_.reserve(expected); }
+
+  void OnMessage(const std::shared_ptr<RawMessage>& msg) {
+    const uint64_t now = Time::MonoTime().ToNanosecond();
+    uint64_t stamp = 0;
+    std::memcpy(&stamp, msg->message.data(), sizeof(stamp));
+    std::lock_guard<std::mutex> lock(mutex_);
+    latencies_.push_back(now - stamp);
+  }
+
+  size_t received() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latencies_.size();
+  }
+
+  void AppendTo(std::vector<uint64_t>* latencies) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latencies->insert(latencies->end(), latencies_.begin(), latencies_.end());
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<uint64_t> latencies_;
+};
+
+Result Run(const int run, const uint64_t message_size,
+           const uint64_t message_rate, const uint64_t subscriber_num) {
+  // a new channel, and segment, for each run
+  const std::string name = "benchmark_transport_" + std::to_string(run);
+  const std::string channel = "/benchmark/transport/" +
+                              std::to_string(getpid()) + "_" +
+                              std::to_string(run);
+  const uint64_t nums_of_message = message_rate * duration_s;
+  std::vector<std::unique_ptr<Node>> nodes;
+  std::vector<std::shared_ptr<Collector>> collectors;
+  std::vector<std::shared_ptr<Reader<RawMessage>>> readers;
+  for (uint64_t i = 0; i < subscriber_num; ++i) {
+    // a node has a single reader per channel
+    nodes.push_back(
+        apollo::cyber::CreateNode(name + "_reader_" + std::to_string(i)));
+    auto collector = std::make_shared<Collector>(nums_of_message);
+    auto reader = nodes.back()->CreateReader<RawMessage>(
+        channel, [collector](const std::shared_ptr<RawMessage>& msg) {
+          collector->OnMessage(msg);
+        });
+    collectors.push_back(collector);
+    readers.push_back(reader);
+  }
+  nodes.push_back(apollo::cyber::CreateNode(name + "_writer"));
+  auto writer = nodes.back()->CreateWriter<RawMessage>(channel);
+  if (writer == nullptr ||
+      std::find(readers.begin(), readers.end(), nullptr) != readers.end()) {
+    AERROR << "Failed to create the readers or the writer of " << channel;
+    exit(-1);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(warmup_ms));
+
+  const std::string payload(message_size, '\0');
+  const auto period = std::chrono::nanoseconds(1000000000ULL / message_rate);
+  const uint64_t cpu_start = CpuTimeUs();
+  const auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < nums_of_message; ++i) {
+    std::this_thread::sleep_until(start + period * i);
+    auto msg = std::make_shared<RawMessage>(payload);
+    const uint64_t stamp = Time::MonoTime().ToNanosecond();
+    std::memcpy(&msg->message[0], &stamp, sizeof(stamp));
+    writer->Write(msg);
+  }
+  // wait for the messages still on their way, at most a second
+  const auto drain_end =
+      std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (std::chrono::steady_clock::now() < drain_end) {
+    size_t received = 0;
+    for (const auto& collector : collectors) {
+      received += collector->received();
+    }
+    if (received >= nums_of_message * subscriber_num) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const uint64_t cpu_us = CpuTimeUs() - cpu_start;
+
+  for (auto& reader : readers) {
+    reader->Shutdown();
+  }
+  writer->Shutdown();
+
+  std::vector<uint64_t> latencies;
+  for (const auto& collector : collectors) {
+    collector->AppendTo(&latencies);
+  }
+  Result result;
+  result.sent = nums_of_message;
+  result.received = latencies.size();
+  result.cpu_us_per_msg =
+      static_cast<double>(cpu_us) / static_cast<double>(nums_of_message);
+  if (!latencies.empty()) {
+    std::sort(latencies.begin(), latencies.end());
+    const size_t n = latencies.size();
+    result.p50_us = latencies[n / 2] / 1000;
+    result.p99_us = latencies[n * 99 / 100] / 1000;
+    result.p999_us = latencies[n * 999 / 1000] / 1000;
+    result.max_us = latencies.back() / 1000;
+  }
+  return result;
+}
+
+// Runs the sweep of sizes, rates and subscribers in a child process set up
+// for the mode, notifier and policy
+int RunProcess(const std::string& mode, const std::string& notifier,
+               const std::string& policy) {
+  if (!PrepareWorkRoot(mode, notifier, policy)) {
+    return -1;
+  }
+  GlobalData::Instance()->SetProcessGroup("example_sched_" + policy);
+  apollo::cyber::Init(BINARY_NAME.c_str());
+
+  int run = 0;
+  for (const auto subscriber_num : subscriber_nums) {
+    for (const auto message_rate : message_rates) {
+      for (const auto message_size : message_sizes) {
+        if (message_size * message_rate > max_bandwidth_mb * 1024 * 1024) {
+          continue;
+        }
+        const Result result =
+            Run(run++, message_size, message_rate, subscriber_num);
+        std::printf(
+            "{\"mode\":\"%s\",\"notifier\":\"%s\",\"policy\":\"%s\","
+            "\"size\":%" PRIu64 ",\"rate\":%" PRIu64
+            ",\"subscribers\":%" PRIu64 ",\"sent\":%" PRIu64
+            ",\"received\":%" PRIu64 ",\"p50_us\":%" PRIu64
+            ",\"p99_us\":%" PRIu64 ",\"p999_us\":%" PRIu64
+            ",\"max_us\":%" PRIu64 ",\"cpu_us_per_msg\":%.2f}\n",
+            mode.c_str(), notifier.c_str(), policy.c_str(), message_size,
+            message_rate, subscriber_num, result.sent, result.received,
+            result.p50_us, result.p99_us, result.p999_us, result.max_us,
+            result.cpu_us_per_msg);
+        std::fflush(stdout);
+      }
+    }
+  }
+
+  apollo::cyber::Clear();
+  const std::string work_root = WorkRoot();
+  apollo::cyber::common::RemoveAllFiles(work_root + "/conf");
+  rmdir((work_root + "/conf").c_str());
+  rmdir(work_root.c_str());
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  GetOptions(argc, argv);
+
+  // the transport conf and the scheduler are per process, each combination
+  // runs in its own child
+  for (const auto& mode : modes) {
+    for (size_t i = 0; i < notifiers.size(); ++i) {
+      // only the shm mode is notified
+      if (mode != "shm" && i > 0) {
+        break;
+      }
+      for (const auto& policy : policies) {
+        std::fflush(stdout);
+        pid_t pid = fork();
+        if (pid < 0) {
+          AERROR << "fork failed: " << strerror(errno);
+          return -1;
+        }
+        if (pid == 0) {
+          _exit(RunProcess(mode, notifiers[i], policy));
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+          AERROR << "run of " << mode << " " << notifiers[i] << " " << policy
+                 << " failed";
+        }
+      }
+    }
+  }
+  return 0;
+}
@@ -17,9 +17,9 @@
 #ifndef CYBER_BLOCKER_BLOCKER_H_
 #define CYBER_BLOCKER_BLOCKER_H_
 
+#include <algorithm>
 #include <cstddef>
 #include <functional>
-#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -67,10 +67,10 @@ class Blocker : public BlockerBase {
  public:
   using MessageType = T;
   using MessagePtr = std::shared_ptr<T>;
-  using MessageQueue = std::list<MessagePtr>;
+  using MessageQueue = std::vector<MessagePtr>;
   using Callback = std::function<void(const MessagePtr&)>;
   using CallbackMap = std::unordered_map<std::string, Callback>;
-  using Iterator = typename std::list<std::shared_ptr<T>>::const_iterator;
+  using Iterator = typename std::vector<std::shared_ptr<T>>::const_iterator;
 
   explicit Blocker(const BlockerAttr& attr);
   virtual ~Blocker();
@@ -103,10 +103,17 @@ class Blocker : public BlockerBase {
   void Reset() override;
   void Enqueue(const MessagePtr& msg);
   void Notify(const MessagePtr& msg);
+  // Reorder the published ring from the oldest to the latest message,
+  // keeping at most capacity of the latest ones
+  void Linearize(size_t capacity);
 
   BlockerAttr attr_;
+  // The observed messages from the latest to the oldest one
   MessageQueue observed_msg_queue_;
+  // Fixed ring of the published messages, which grows up to the capacity
+  // and is then overwritten from the oldest message
   MessageQueue published_msg_queue_;
+  size_t published_head_ = 0;  // slot of the latest published message
   mutable std::mutex msg_mutex_;
 
   CallbackMap published_callbacks_;
@@ -142,6 +149,7 @@ void Blocker<T>::Reset() {
     std::lock_guard<std::mutex> lock(msg_mutex_);
     observed_msg_queue_.clear();
     published_msg_queue_.clear();
+    published_head_ = 0;
   }
   {
     std::lock_guard<std::mutex> lock(cb_mutex_);
@@ -159,12 +167,19 @@ template <typename T>
 void Blocker<T>::ClearPublished() {
   std::lock_guard<std::mutex> lock(msg_mutex_);
   published_msg_queue_.clear();
+  published_head_ = 0;
 }
 
 template <typename T>
 void Blocker<T>::Observe() {
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  observed_msg_queue_ = published_msg_queue_;
+  // the observed queue keeps its storage, no allocation once it is warm
+  observed_msg_queue_.clear();
+  const size_t size = published_msg_queue_.size();
+  for (size_t i = 0; i < size; ++i) {
+    observed_msg_queue_.push_back(
+        published_msg_queue_[(published_head_ + size - i) % size]);
+  }
 }
 
 template <typename T>
@@ -229,7 +244,7 @@ auto Blocker<T>::GetLatestPublishedPtr() const -> const MessagePtr {
   if (published_msg_queue_.empty()) {
     return nullptr;
   }
-  return published_msg_queue_.front();
+  return published_msg_queue_[published_head_];
 }
 
 template <typename T>
@@ -251,9 +266,7 @@ template <typename T>
 void Blocker<T>::set_capacity(size_t capacity) {
   std::lock_guard<std::mutex> lock(msg_mutex_);
   attr_.capacity = capacity;
-  while (published_msg_queue_.size() > capacity) {
-    published_msg_queue_.pop_back();
-  }
+  Linearize(capacity);
 }
 
 template <typename T>
@@ -267,10 +280,28 @@ void Blocker<T>::Enqueue(const MessagePtr& msg) {
     return;
   }
   std::lock_guard<std::mutex> lock(msg_mutex_);
-  published_msg_queue_.push_front(msg);
-  while (published_msg_queue_.size() > attr_.capacity) {
-    published_msg_queue_.pop_back();
+  if (published_msg_queue_.size() < attr_.capacity) {
+    published_msg_queue_.push_back(msg);
+    published_head_ = published_msg_queue_.size() - 1;
+  } else {
+    published_head_ = (published_head_ + 1) % published_msg_queue_.size();
+    published_msg_queue_[published_head_] = msg;
+  }
+}
+
+template <typename T>
+void Blocker<T>::Linearize(size_t capacity) {
+  const size_t size = published_msg_queue_.size();
+  const size_t kept = std::min(size, capacity);
+  MessageQueue queue;
+  queue.reserve(kept);
+  for (size_t i = kept; i > 0; --i) {
+    queue.push_back(
+        std::move(published_msg_queue_[(published_head_ + size - i + 1) %
+                                       size]));
   }
+  published_msg_queue_.swap(queue);
+  published_head_ = kept == 0 ? 0 : kept - 1;
 }
 
 template <typename T>
@@ -17,6 +17,8 @@
 #include "cyber/blocker/blocker.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -97,6 +99,45 @@ TEST(BlockerTest, publish) {
   EXPECT_TRUE(blocker.IsObservedEmpty());
 }
 
+TEST(BlockerTest, ring) {
+  BlockerAttr attr(3, "channel");
+  Blocker<UnitTest> blocker(attr);
+
+  for (int i = 0; i < 5; ++i) {
+    auto msg = std::make_shared<UnitTest>();
+    msg->set_case_name(std::to_string(i));
+    blocker.Publish(msg);
+  }
+  EXPECT_EQ(blocker.GetLatestPublishedPtr()->case_name(), "4");
+
+  blocker.Observe();
+  std::vector<std::string> observed;
+  for (auto it = blocker.ObservedBegin(); it != blocker.ObservedEnd(); ++it) {
+    observed.push_back((*it)->case_name());
+  }
+  EXPECT_EQ(observed, std::vector<std::string>({"4", "3", "2"}));
+  EXPECT_EQ(blocker.GetOldestObservedPtr()->case_name(), "2");
+
+  // the latest messages are kept in order across capacity changes
+  blocker.set_capacity(2);
+  blocker.Observe();
+  EXPECT_EQ(blocker.GetLatestObservedPtr()->case_name(), "4");
+  EXPECT_EQ(blocker.GetOldestObservedPtr()->case_name(), "3");
+
+  blocker.set_capacity(4);
+  for (int i = 5; i < 8; ++i) {
+    auto msg = std::make_shared<UnitTest>();
+    msg->set_case_name(std::to_string(i));
+    blocker.Publish(msg);
+  }
+  blocker.Observe();
+  observed.clear();
+  for (auto it = blocker.ObservedBegin(); it != blocker.ObservedEnd(); ++it) {
+    observed.push_back((*it)->case_name());
+  }
+  EXPECT_EQ(observed, std::vector<std::string>({"7", "6", "5", "4"}));
+}
+
 TEST(BlockerTest, subscribe) {
   BlockerAttr attr(10, "channel");
   Blocker<UnitTest> blocker(attr);
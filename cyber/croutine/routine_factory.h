@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
@@ -69,6 +70,39 @@ RoutineFactory CreateRoutineFactory(
   return factory;
 }
 
+// The routine hands f all the messages available, up to max_batch, as one
+// vector. It waits for the next notification afterwards unless it stopped at
+// max_batch, so the notifier decides how often the routine wakes up.
+template <typename M0, typename F>
+RoutineFactory CreateBatchRoutineFactory(
+    F&& f, const std::shared_ptr<data::DataVisitor<M0>>& dv,
+    size_t max_batch) {
+  RoutineFactory factory;
+  factory.SetDataVisitor(dv);
+  factory.create_routine = [=]() {
+    return [=]() {
+      std::shared_ptr<M0> msg;
+      std::vector<std::shared_ptr<M0>> msgs;
+      msgs.reserve(max_batch);
+      for (;;) {
+        CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
+        while (msgs.size() < max_batch && dv->TryFetch(msg)) {
+          msgs.emplace_back(std::move(msg));
+        }
+        if (msgs.empty()) {
+          CRoutine::Yield();
+          continue;
+        }
+        const bool full = msgs.size() >= max_batch;
+        f(msgs);
+        msgs.clear();
+        CRoutine::Yield(full ? RoutineState::READY : RoutineState::DATA_WAIT);
+      }
+    };
+  };
+  return factory;
+}
+
 template <typename M0, typename M1, typename F>
 RoutineFactory CreateRoutineFactory(
     F&& f, const std::shared_ptr<data::DataVisitor<M0, M1>>& dv) {
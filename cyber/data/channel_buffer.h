@@ -20,11 +20,13 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/data/data_notifier.h"
+#include "cyber/data/ring_buffer.h"
 
 namespace apollo {
 namespace cyber {
@@ -36,8 +38,11 @@ template <typename T>
 class ChannelBuffer {
  public:
   using BufferType = CacheBuffer<std::shared_ptr<T>>;
+  using RingType = RingBuffer<T>;
   ChannelBuffer(uint64_t channel_id, BufferType* buffer)
       : channel_id_(channel_id), buffer_(buffer) {}
+  ChannelBuffer(uint64_t channel_id, RingType* ring)
+      : channel_id_(channel_id), ring_(ring) {}
 
   bool Fetch(uint64_t* index, std::shared_ptr<T>& m);  // NOLINT
 
@@ -46,16 +51,27 @@ class ChannelBuffer {
   bool FetchMulti(uint64_t fetch_size, std::vector<std::shared_ptr<T>>* vec);
 
   uint64_t channel_id() const { return channel_id_; }
+  // Only one of them is set, depending on the constructor
   std::shared_ptr<BufferType> Buffer() const { return buffer_; }
+  std::shared_ptr<RingType> Ring() const { return ring_; }
 
  private:
+  bool FetchRing(uint64_t* index, std::shared_ptr<T>& m);  // NOLINT
+  bool LatestRing(std::shared_ptr<T>& m);                  // NOLINT
+  bool FetchMultiRing(uint64_t fetch_size,
+                      std::vector<std::shared_ptr<T>>* vec);
+
   uint64_t channel_id_;
   std::shared_ptr<BufferType> buffer_;
+  std::shared_ptr<RingType> ring_;
 };
 
 template <typename T>
 bool ChannelBuffer<T>::Fetch(uint64_t* index,
                              std::shared_ptr<T>& m) {  // NOLINT
+  if (ring_) {
+    return FetchRing(index, m);
+  }
   std::lock_guard<std::mutex> lock(buffer_->Mutex());
   if (buffer_->Empty()) {
     return false;
@@ -78,6 +94,9 @@ bool ChannelBuffer<T>::Fetch(uint64_t* index,
 
 template <typename T>
 bool ChannelBuffer<T>::Latest(std::shared_ptr<T>& m) {  // NOLINT
+  if (ring_) {
+    return LatestRing(m);
+  }
   std::lock_guard<std::mutex> lock(buffer_->Mutex());
   if (buffer_->Empty()) {
     return false;
@@ -90,6 +109,9 @@ bool ChannelBuffer<T>::Latest(std::shared_ptr<T>& m) {  // NOLINT
 template <typename T>
 bool ChannelBuffer<T>::FetchMulti(uint64_t fetch_size,
                                   std::vector<std::shared_ptr<T>>* vec) {
+  if (ring_) {
+    return FetchMultiRing(fetch_size, vec);
+  }
   std::lock_guard<std::mutex> lock(buffer_->Mutex());
   if (buffer_->Empty()) {
     return false;
@@ -104,6 +126,67 @@ bool ChannelBuffer<T>::FetchMulti(uint64_t fetch_size,
   return true;
 }
 
+template <typename T>
+bool ChannelBuffer<T>::FetchRing(uint64_t* index,
+                                 std::shared_ptr<T>& m) {  // NOLINT
+  // retry from the latest message if it was overwritten while reading
+  for (;;) {
+    const uint64_t tail = ring_->Tail();
+    if (tail == 0) {
+      return false;
+    }
+
+    if (*index == 0) {
+      *index = tail;
+    } else if (*index == tail + 1) {
+      return false;
+    } else if (*index < ring_->Head()) {
+      auto interval = tail - *index;
+      AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
+            << "read buffer overflow, drop_message[" << interval
+            << "] pre_index[" << *index << "] current_index[" << tail
+            << "] ";
+      *index = tail;
+    }
+    if (ring_->Read(*index, &m)) {
+      return true;
+    }
+  }
+}
+
+template <typename T>
+bool ChannelBuffer<T>::LatestRing(std::shared_ptr<T>& m) {  // NOLINT
+  for (;;) {
+    const uint64_t tail = ring_->Tail();
+    if (tail == 0) {
+      return false;
+    }
+    if (ring_->Read(tail, &m)) {
+      return true;
+    }
+  }
+}
+
+template <typename T>
+bool ChannelBuffer<T>::FetchMultiRing(uint64_t fetch_size,
+                                      std::vector<std::shared_ptr<T>>* vec) {
+  const uint64_t tail = ring_->Tail();
+  if (tail == 0) {
+    return false;
+  }
+
+  auto num = std::min(tail - ring_->Head() + 1, fetch_size);
+  vec->reserve(num);
+  std::shared_ptr<T> m;
+  for (auto index = tail - num + 1; index <= tail; ++index) {
+    // messages overwritten meanwhile are skipped
+    if (ring_->Read(index, &m)) {
+      vec->emplace_back(std::move(m));
+    }
+  }
+  return true;
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
@@ -47,8 +47,16 @@ class DataDispatcher {
 
  private:
   DataNotifier* notifier_ = DataNotifier::Instance();
+  // RingBuffer is filled by a single writer, the writers of a channel take
+  // turns on its write_mutex, which its readers never take.
+  struct ChannelRings {
+    std::mutex write_mutex;
+    std::vector<std::weak_ptr<RingBuffer<T>>> rings;
+  };
+
   std::mutex buffers_map_mutex_;
   AtomicHashMap<uint64_t, BufferVector> buffers_map_;
+  AtomicHashMap<uint64_t, std::shared_ptr<ChannelRings>> rings_map_;
 
   DECLARE_SINGLETON(DataDispatcher)
 };
@@ -59,6 +67,17 @@ inline DataDispatcher<T>::DataDispatcher() {}
 template <typename T>
 void DataDispatcher<T>::AddBuffer(const ChannelBuffer<T>& channel_buffer) {
   std::lock_guard<std::mutex> lock(buffers_map_mutex_);
+  if (auto ring = channel_buffer.Ring()) {
+    std::shared_ptr<ChannelRings>* channel_rings = nullptr;
+    if (!rings_map_.Get(channel_buffer.channel_id(), &channel_rings)) {
+      rings_map_.Set(channel_buffer.channel_id(),
+                     std::make_shared<ChannelRings>());
+      rings_map_.Get(channel_buffer.channel_id(), &channel_rings);
+    }
+    std::lock_guard<std::mutex> write_lock((*channel_rings)->write_mutex);
+    (*channel_rings)->rings.emplace_back(ring);
+    return;
+  }
   auto buffer = channel_buffer.Buffer();
   BufferVector* buffers = nullptr;
   if (buffers_map_.Get(channel_buffer.channel_id(), &buffers)) {
@@ -73,18 +92,30 @@ template <typename T>
 bool DataDispatcher<T>::Dispatch(const uint64_t channel_id,
                                  const std::shared_ptr<T>& msg) {
   BufferVector* buffers = nullptr;
+  std::shared_ptr<ChannelRings>* channel_rings = nullptr;
   if (apollo::cyber::IsShutdown()) {
     return false;
   }
-  if (buffers_map_.Get(channel_id, &buffers)) {
+  const bool has_buffers = buffers_map_.Get(channel_id, &buffers);
+  const bool has_rings = rings_map_.Get(channel_id, &channel_rings);
+  if (!has_buffers && !has_rings) {
+    return false;
+  }
+  if (has_buffers) {
     for (auto& buffer_wptr : *buffers) {
       if (auto buffer = buffer_wptr.lock()) {
         std::lock_guard<std::mutex> lock(buffer->Mutex());
         buffer->Fill(msg);
       }
     }
-  } else {
-    return false;
+  }
+  if (has_rings) {
+    std::lock_guard<std::mutex> write_lock((*channel_rings)->write_mutex);
+    for (auto& ring_wptr : (*channel_rings)->rings) {
+      if (auto ring = ring_wptr.lock()) {
+        ring->Fill(msg);
+      }
+    }
   }
   return notifier_->Notify(channel_id);
 }
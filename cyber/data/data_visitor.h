@@ -18,6 +18,7 @@
 #define CYBER_DATA_DATA_VISITOR_H_
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -28,6 +29,8 @@
 #include "cyber/data/data_visitor_base.h"
 #include "cyber/data/fusion/all_latest.h"
 #include "cyber/data/fusion/data_fusion.h"
+#include "cyber/data/fusion/time_sync.h"
+#include "cyber/proto/component_conf.pb.h"
 
 namespace apollo {
 namespace cyber {
@@ -43,11 +46,21 @@ struct VisitorConfig {
 template <typename T>
 using BufferType = CacheBuffer<std::shared_ptr<T>>;
 
+// Tolerance of the time synchronized fusion policies in nanoseconds
+inline int64_t FusionTolerance(const proto::FusionOption& option) {
+  if (option.policy() == proto::FusionOption::EXACT_TIME) {
+    return 0;
+  }
+  return std::llround(option.time_tolerance_ms() * 1e6);
+}
+
 template <typename M0, typename M1 = NullType, typename M2 = NullType,
           typename M3 = NullType>
 class DataVisitor : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(
+      const std::vector<VisitorConfig>& configs,
+      const proto::FusionOption& option = proto::FusionOption())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
@@ -61,8 +74,18 @@ class DataVisitor : public DataVisitorBase {
     DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
     DataDispatcher<M3>::Instance()->AddBuffer(buffer_m3_);
     data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ = new fusion::AllLatest<M0, M1, M2, M3>(
-        buffer_m0_, buffer_m1_, buffer_m2_, buffer_m3_);
+    if (option.policy() == proto::FusionOption::ALL_LATEST) {
+      data_fusion_ = new fusion::AllLatest<M0, M1, M2, M3>(
+          buffer_m0_, buffer_m1_, buffer_m2_, buffer_m3_);
+    } else {
+      // late messages of the other channels may complete a pending one
+      data_notifier_->AddNotifier(buffer_m1_.channel_id(), notifier_);
+      data_notifier_->AddNotifier(buffer_m2_.channel_id(), notifier_);
+      data_notifier_->AddNotifier(buffer_m3_.channel_id(), notifier_);
+      data_fusion_ = new fusion::TimeSync<M0, M1, M2, M3>(
+          buffer_m0_, buffer_m1_, buffer_m2_, buffer_m3_,
+          FusionTolerance(option));
+    }
   }
 
   ~DataVisitor() {
@@ -92,7 +115,9 @@ class DataVisitor : public DataVisitorBase {
 template <typename M0, typename M1, typename M2>
 class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(
+      const std::vector<VisitorConfig>& configs,
+      const proto::FusionOption& option = proto::FusionOption())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
@@ -103,8 +128,16 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
     DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
     data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ =
-        new fusion::AllLatest<M0, M1, M2>(buffer_m0_, buffer_m1_, buffer_m2_);
+    if (option.policy() == proto::FusionOption::ALL_LATEST) {
+      data_fusion_ = new fusion::AllLatest<M0, M1, M2>(buffer_m0_, buffer_m1_,
+                                                       buffer_m2_);
+    } else {
+      // late messages of the other channels may complete a pending one
+      data_notifier_->AddNotifier(buffer_m1_.channel_id(), notifier_);
+      data_notifier_->AddNotifier(buffer_m2_.channel_id(), notifier_);
+      data_fusion_ = new fusion::TimeSync<M0, M1, M2>(
+          buffer_m0_, buffer_m1_, buffer_m2_, FusionTolerance(option));
+    }
   }
 
   ~DataVisitor() {
@@ -133,7 +166,9 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
 template <typename M0, typename M1>
 class DataVisitor<M0, M1, NullType, NullType> : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(
+      const std::vector<VisitorConfig>& configs,
+      const proto::FusionOption& option = proto::FusionOption())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
@@ -141,7 +176,14 @@ class DataVisitor<M0, M1, NullType, NullType> : public DataVisitorBase {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
     data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ = new fusion::AllLatest<M0, M1>(buffer_m0_, buffer_m1_);
+    if (option.policy() == proto::FusionOption::ALL_LATEST) {
+      data_fusion_ = new fusion::AllLatest<M0, M1>(buffer_m0_, buffer_m1_);
+    } else {
+      // late messages of the other channel may complete a pending one
+      data_notifier_->AddNotifier(buffer_m1_.channel_id(), notifier_);
+      data_fusion_ = new fusion::TimeSync<M0, M1>(buffer_m0_, buffer_m1_,
+                                                  FusionTolerance(option));
+    }
   }
 
   ~DataVisitor() {
@@ -169,13 +211,13 @@ template <typename M0>
 class DataVisitor<M0, NullType, NullType, NullType> : public DataVisitorBase {
  public:
   explicit DataVisitor(const VisitorConfig& configs)
-      : buffer_(configs.channel_id, new BufferType<M0>(configs.queue_size)) {
+      : buffer_(CreateBuffer(configs.channel_id, configs.queue_size)) {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_);
     data_notifier_->AddNotifier(buffer_.channel_id(), notifier_);
   }
 
   DataVisitor(uint64_t channel_id, uint32_t queue_size)
-      : buffer_(channel_id, new BufferType<M0>(queue_size)) {
+      : buffer_(CreateBuffer(channel_id, queue_size)) {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_);
     data_notifier_->AddNotifier(buffer_.channel_id(), notifier_);
   }
@@ -189,6 +231,14 @@ class DataVisitor<M0, NullType, NullType, NullType> : public DataVisitorBase {
   }
 
  private:
+  static ChannelBuffer<M0> CreateBuffer(uint64_t channel_id,
+                                        uint32_t queue_size) {
+    if (GlobalData::Instance()->Config().data_conf().lock_free_buffer()) {
+      return ChannelBuffer<M0>(channel_id, new RingBuffer<M0>(queue_size));
+    }
+    return ChannelBuffer<M0>(channel_id, new BufferType<M0>(queue_size));
+  }
+
   ChannelBuffer<M0> buffer_;
 };
 
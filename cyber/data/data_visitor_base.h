@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "cyber/common/global_data.h"
@@ -34,10 +35,24 @@ class DataVisitorBase {
  public:
   DataVisitorBase() : notifier_(new Notifier()) {}
 
+  using NotifyWrapper =
+      std::function<std::function<void()>(std::function<void()>&&)>;
+
   void RegisterNotifyCallback(std::function<void()>&& callback) {
-    notifier_->callback = callback;
+    if (notify_wrapper_) {
+      notifier_->callback = notify_wrapper_(std::move(callback));
+    } else {
+      notifier_->callback = callback;
+    }
   }
 
+  /**
+   * @brief Set a wrapper of the notify callback registered afterwards, which
+   * decides when the new messages wake the task up, e.g. a batched reader
+   * notifying once per batch instead of once per message
+   */
+  void SetNotifyWrapper(NotifyWrapper&& wrapper) { notify_wrapper_ = wrapper; }
+
  protected:
   DataVisitorBase(const DataVisitorBase&) = delete;
   DataVisitorBase& operator=(const DataVisitorBase&) = delete;
@@ -45,6 +60,7 @@ class DataVisitorBase {
   uint64_t next_msg_index_ = 0;
   DataNotifier* data_notifier_ = DataNotifier::Instance();
   std::shared_ptr<Notifier> notifier_;
+  NotifyWrapper notify_wrapper_;
 };
 
 }  // namespace data
@@ -0,0 +1,293 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_DATA_FUSION_TIME_SYNC_H_
+#define CYBER_DATA_FUSION_TIME_SYNC_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include "cyber/common/types.h"
+#include "cyber/data/channel_buffer.h"
+#include "cyber/data/fusion/data_fusion.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+namespace fusion {
+
+// Whether the message has an Apollo header with timestamp_sec
+template <typename T, typename = void>
+struct HasHeaderTime : std::false_type {};
+
+template <typename T>
+struct HasHeaderTime<
+    T, decltype(void(std::declval<const T&>().header().has_timestamp_sec()),
+                void(std::declval<const T&>().header().timestamp_sec()))>
+    : std::true_type {};
+
+constexpr int64_t kNoMessageTime = -1;
+
+// Result of looking for the message matching a timestamp in a channel,
+// ordered from the best to the worst.
+enum class MatchResult {
+  MATCHED,  // a message is within the tolerance
+  WAIT,     // no message yet, but a later one may still match
+  MISS,     // no message will ever match
+};
+
+/**
+ * @brief Header timestamp of a message in nanoseconds, or kNoMessageTime
+ *        if the message has no header timestamp.
+ */
+template <typename T>
+typename std::enable_if<HasHeaderTime<T>::value, int64_t>::type GetMessageTime(
+    const T& message) {
+  if (!message.header().has_timestamp_sec()) {
+    return kNoMessageTime;
+  }
+  return std::llround(message.header().timestamp_sec() * 1e9);
+}
+
+template <typename T>
+typename std::enable_if<!HasHeaderTime<T>::value, int64_t>::type GetMessageTime(
+    const T&) {
+  return kNoMessageTime;
+}
+
+/**
+ * @brief Find the message of the channel nearest to time, messages of a
+ *        channel are expected in timestamp order. The latest message is
+ *        taken if time is unknown or the channel has no header timestamp.
+ */
+template <typename T>
+MatchResult MatchNearest(const ChannelBuffer<T>& buffer, const int64_t time,
+                         const int64_t tolerance,
+                         std::shared_ptr<T>* message) {
+  auto cache = buffer.Buffer();
+  std::lock_guard<std::mutex> lock(cache->Mutex());
+  if (cache->Empty()) {
+    return MatchResult::WAIT;
+  }
+
+  const int64_t latest_time = GetMessageTime(*cache->Back());
+  if (time == kNoMessageTime || latest_time == kNoMessageTime) {
+    *message = cache->Back();
+    return MatchResult::MATCHED;
+  }
+
+  int64_t min_diff = std::numeric_limits<int64_t>::max();
+  for (uint64_t index = cache->Tail(); index >= cache->Head(); --index) {
+    const int64_t message_time = GetMessageTime(*cache->at(index));
+    const int64_t diff = std::abs(message_time - time);
+    if (diff < min_diff) {
+      min_diff = diff;
+      *message = cache->at(index);
+    }
+    // older messages are only further away
+    if (message_time <= time) {
+      break;
+    }
+  }
+
+  if (min_diff <= tolerance) {
+    return MatchResult::MATCHED;
+  }
+  return latest_time < time ? MatchResult::WAIT : MatchResult::MISS;
+}
+
+/**
+ * @brief Messages of M0 waiting for the other channels, the fusion callback
+ *        of M0 stores them here instead of fusing them right away.
+ */
+template <typename M0>
+class PendingBuffer {
+ public:
+  explicit PendingBuffer(const ChannelBuffer<M0>& buffer_0)
+      : buffer_(buffer_0.channel_id(),
+                new CacheBuffer<std::shared_ptr<M0>>(
+                    buffer_0.Buffer()->Capacity() - uint64_t(1))) {
+    buffer_0.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M0>& m0) {
+          std::lock_guard<std::mutex> lg(buffer_.Buffer()->Mutex());
+          buffer_.Buffer()->Fill(m0);
+        });
+  }
+
+  bool Fetch(uint64_t* index, std::shared_ptr<M0>& m0) {  // NOLINT
+    return buffer_.Fetch(index, m0);
+  }
+
+  // Whether the message at index is dropped by the next one of M0, there is
+  // no point to wait any longer for it then.
+  bool WillOverwrite(const uint64_t index) const {
+    auto cache = buffer_.Buffer();
+    std::lock_guard<std::mutex> lg(cache->Mutex());
+    return cache->Full() && index <= cache->Head();
+  }
+
+ private:
+  ChannelBuffer<M0> buffer_;
+};
+
+/**
+ * @class TimeSync
+ * @brief Fuse each message of M0 with the messages of the other channels
+ *        nearest to its header timestamp, within the tolerance in
+ *        nanoseconds. A tolerance of 0 requires exactly the same timestamp.
+ *        Messages of M0 without a match are dropped, the ones still
+ *        waiting for a match are retried on the next notification.
+ */
+template <typename M0, typename M1 = NullType, typename M2 = NullType,
+          typename M3 = NullType>
+class TimeSync : public DataFusion<M0, M1, M2, M3> {
+ public:
+  TimeSync(const ChannelBuffer<M0>& buffer_0, const ChannelBuffer<M1>& buffer_1,
+           const ChannelBuffer<M2>& buffer_2, const ChannelBuffer<M3>& buffer_3,
+           const int64_t tolerance)
+      : buffer_m1_(buffer_1),
+        buffer_m2_(buffer_2),
+        buffer_m3_(buffer_3),
+        buffer_pending_(buffer_0),
+        tolerance_(tolerance) {}
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,
+              std::shared_ptr<M2>& m2, std::shared_ptr<M3>& m3) override {
+    std::shared_ptr<M0> msg0;
+    std::shared_ptr<M1> msg1;
+    std::shared_ptr<M2> msg2;
+    std::shared_ptr<M3> msg3;
+    while (buffer_pending_.Fetch(index, msg0)) {
+      const int64_t time = GetMessageTime(*msg0);
+      const MatchResult result =
+          std::max({MatchNearest(buffer_m1_, time, tolerance_, &msg1),
+                    MatchNearest(buffer_m2_, time, tolerance_, &msg2),
+                    MatchNearest(buffer_m3_, time, tolerance_, &msg3)});
+      if (result == MatchResult::MATCHED) {
+        m0 = msg0;
+        m1 = msg1;
+        m2 = msg2;
+        m3 = msg3;
+        return true;
+      }
+      if (result == MatchResult::WAIT &&
+          !buffer_pending_.WillOverwrite(*index)) {
+        return false;
+      }
+      ++(*index);
+    }
+    return false;
+  }
+
+ private:
+  ChannelBuffer<M1> buffer_m1_;
+  ChannelBuffer<M2> buffer_m2_;
+  ChannelBuffer<M3> buffer_m3_;
+  PendingBuffer<M0> buffer_pending_;
+  int64_t tolerance_;
+};
+
+template <typename M0, typename M1, typename M2>
+class TimeSync<M0, M1, M2, NullType> : public DataFusion<M0, M1, M2> {
+ public:
+  TimeSync(const ChannelBuffer<M0>& buffer_0, const ChannelBuffer<M1>& buffer_1,
+           const ChannelBuffer<M2>& buffer_2, const int64_t tolerance)
+      : buffer_m1_(buffer_1),
+        buffer_m2_(buffer_2),
+        buffer_pending_(buffer_0),
+        tolerance_(tolerance) {}
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,
+              std::shared_ptr<M2>& m2) override {
+    std::shared_ptr<M0> msg0;
+    std::shared_ptr<M1> msg1;
+    std::shared_ptr<M2> msg2;
+    while (buffer_pending_.Fetch(index, msg0)) {
+      const int64_t time = GetMessageTime(*msg0);
+      const MatchResult result =
+          std::max(MatchNearest(buffer_m1_, time, tolerance_, &msg1),
+                   MatchNearest(buffer_m2_, time, tolerance_, &msg2));
+      if (result == MatchResult::MATCHED) {
+        m0 = msg0;
+        m1 = msg1;
+        m2 = msg2;
+        return true;
+      }
+      if (result == MatchResult::WAIT &&
+          !buffer_pending_.WillOverwrite(*index)) {
+        return false;
+      }
+      ++(*index);
+    }
+    return false;
+  }
+
+ private:
+  ChannelBuffer<M1> buffer_m1_;
+  ChannelBuffer<M2> buffer_m2_;
+  PendingBuffer<M0> buffer_pending_;
+  int64_t tolerance_;
+};
+
+template <typename M0, typename M1>
+class TimeSync<M0, M1, NullType, NullType> : public DataFusion<M0, M1> {
+ public:
+  TimeSync(const ChannelBuffer<M0>& buffer_0, const ChannelBuffer<M1>& buffer_1,
+           const int64_t tolerance)
+      : buffer_m1_(buffer_1),
+        buffer_pending_(buffer_0),
+        tolerance_(tolerance) {}
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0,
+              std::shared_ptr<M1>& m1) override {
+    std::shared_ptr<M0> msg0;
+    std::shared_ptr<M1> msg1;
+    while (buffer_pending_.Fetch(index, msg0)) {
+      const int64_t time = GetMessageTime(*msg0);
+      const MatchResult result =
+          MatchNearest(buffer_m1_, time, tolerance_, &msg1);
+      if (result == MatchResult::MATCHED) {
+        m0 = msg0;
+        m1 = msg1;
+        return true;
+      }
+      if (result == MatchResult::WAIT &&
+          !buffer_pending_.WillOverwrite(*index)) {
+        return false;
+      }
+      ++(*index);
+    }
+    return false;
+  }
+
+ private:
+  ChannelBuffer<M1> buffer_m1_;
+  PendingBuffer<M0> buffer_pending_;
+  int64_t tolerance_;
+};
+
+}  // namespace fusion
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_DATA_FUSION_TIME_SYNC_H_
@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/data/fusion/time_sync.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "cyber/message/raw_message.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+
+using apollo::cyber::message::RawMessage;
+
+namespace {
+
+class TimedMessage {
+ public:
+  class Header {
+   public:
+    bool has_timestamp_sec() const { return true; }
+    double timestamp_sec() const { return timestamp_sec_; }
+
+   private:
+    friend class TimedMessage;
+    double timestamp_sec_ = 0.0;
+  };
+
+  TimedMessage(const double timestamp_sec, const std::string& name)
+      : name_(name) {
+    header_.timestamp_sec_ = timestamp_sec;
+  }
+
+  const Header& header() const { return header_; }
+  const std::string& name() const { return name_; }
+
+ private:
+  Header header_;
+  std::string name_;
+};
+
+std::shared_ptr<TimedMessage> Message(const double timestamp_sec,
+                                      const std::string& name) {
+  return std::make_shared<TimedMessage>(timestamp_sec, name);
+}
+
+}  // namespace
+
+TEST(TimeSyncTest, approximate_time) {
+  auto cache0 = new CacheBuffer<std::shared_ptr<TimedMessage>>(10);
+  auto cache1 = new CacheBuffer<std::shared_ptr<TimedMessage>>(10);
+  ChannelBuffer<TimedMessage> buffer0(0, cache0);
+  ChannelBuffer<TimedMessage> buffer1(1, cache1);
+  std::shared_ptr<TimedMessage> m0;
+  std::shared_ptr<TimedMessage> m1;
+  uint64_t index = 0;
+  // 10ms
+  fusion::TimeSync<TimedMessage, TimedMessage> fusion(buffer0, buffer1,
+                                                      10000000);
+
+  // nothing to fuse yet
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+  cache1->Fill(Message(0.895, "1-0"));
+  cache0->Fill(Message(1.0, "0-0"));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+
+  // a late message of channel 1 completes the pending one
+  cache1->Fill(Message(0.995, "1-1"));
+  cache1->Fill(Message(1.095, "1-2"));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  index++;
+  EXPECT_EQ("0-0", m0->name());
+  EXPECT_EQ("1-1", m1->name());
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+
+  // the nearest one is taken, not the latest one
+  cache1->Fill(Message(1.195, "1-3"));
+  cache0->Fill(Message(1.1, "0-1"));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  index++;
+  EXPECT_EQ("0-1", m0->name());
+  EXPECT_EQ("1-2", m1->name());
+
+  // no message of channel 1 will match, 0-2 is dropped
+  cache0->Fill(Message(1.15, "0-2"));
+  cache0->Fill(Message(1.2, "0-3"));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  index++;
+  EXPECT_EQ("0-3", m0->name());
+  EXPECT_EQ("1-3", m1->name());
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+}
+
+TEST(TimeSyncTest, exact_time) {
+  auto cache0 = new CacheBuffer<std::shared_ptr<TimedMessage>>(10);
+  auto cache1 = new CacheBuffer<std::shared_ptr<TimedMessage>>(10);
+  auto cache2 = new CacheBuffer<std::shared_ptr<TimedMessage>>(10);
+  ChannelBuffer<TimedMessage> buffer0(0, cache0);
+  ChannelBuffer<TimedMessage> buffer1(1, cache1);
+  ChannelBuffer<TimedMessage> buffer2(2, cache2);
+  std::shared_ptr<TimedMessage> m0;
+  std::shared_ptr<TimedMessage> m1;
+  std::shared_ptr<TimedMessage> m2;
+  uint64_t index = 0;
+  fusion::TimeSync<TimedMessage, TimedMessage, TimedMessage> fusion(
+      buffer0, buffer1, buffer2, 0);
+
+  cache0->Fill(Message(1.0, "0-0"));
+  cache1->Fill(Message(1.0, "1-0"));
+  cache2->Fill(Message(0.999, "2-0"));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1, m2));
+  cache2->Fill(Message(1.0, "2-1"));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1, m2));
+  index++;
+  EXPECT_EQ("0-0", m0->name());
+  EXPECT_EQ("1-0", m1->name());
+  EXPECT_EQ("2-1", m2->name());
+
+  cache0->Fill(Message(1.1, "0-1"));
+  cache1->Fill(Message(1.1, "1-1"));
+  cache2->Fill(Message(1.101, "2-2"));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1, m2));
+}
+
+TEST(TimeSyncTest, pending_overflow) {
+  auto cache0 = new CacheBuffer<std::shared_ptr<TimedMessage>>(2);
+  auto cache1 = new CacheBuffer<std::shared_ptr<TimedMessage>>(10);
+  ChannelBuffer<TimedMessage> buffer0(0, cache0);
+  ChannelBuffer<TimedMessage> buffer1(1, cache1);
+  std::shared_ptr<TimedMessage> m0;
+  std::shared_ptr<TimedMessage> m1;
+  uint64_t index = 0;
+  fusion::TimeSync<TimedMessage, TimedMessage> fusion(buffer0, buffer1,
+                                                      10000000);
+
+  // channel 1 is silent, the oldest pending message is given up when it
+  // is about to be overwritten
+  cache1->Fill(Message(0.5, "1-0"));
+  cache0->Fill(Message(1.0, "0-0"));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+  cache0->Fill(Message(1.1, "0-1"));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+  cache1->Fill(Message(1.1, "1-1"));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  EXPECT_EQ("0-1", m0->name());
+  EXPECT_EQ("1-1", m1->name());
+}
+
+TEST(TimeSyncTest, without_header) {
+  auto cache0 = new CacheBuffer<std::shared_ptr<RawMessage>>(10);
+  auto cache1 = new CacheBuffer<std::shared_ptr<TimedMessage>>(10);
+  ChannelBuffer<RawMessage> buffer0(0, cache0);
+  ChannelBuffer<TimedMessage> buffer1(1, cache1);
+  std::shared_ptr<RawMessage> m0;
+  std::shared_ptr<TimedMessage> m1;
+  uint64_t index = 0;
+  fusion::TimeSync<RawMessage, TimedMessage> fusion(buffer0, buffer1, 0);
+
+  // the latest message is taken without timestamp of channel 0
+  cache0->Fill(std::make_shared<RawMessage>("0-0"));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+  cache1->Fill(Message(1.0, "1-0"));
+  cache1->Fill(Message(2.0, "1-1"));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  EXPECT_EQ("0-0", m0->message);
+  EXPECT_EQ("1-1", m1->name());
+}
+
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
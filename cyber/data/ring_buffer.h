@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_DATA_RING_BUFFER_H_
+#define CYBER_DATA_RING_BUFFER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace apollo {
+namespace cyber {
+namespace data {
+
+/**
+ * @class RingBuffer
+ * @brief Message buffer of a reader with the same indexes as CacheBuffer,
+ *        filled by a single writer and read without any lock. The tail and
+ *        the index of the message in each slot are published atomically, so
+ *        a reader detects that a message was overwritten, or is being
+ *        overwritten, and retries from the tail instead of waiting.
+ */
+template <typename T>
+class RingBuffer {
+ public:
+  using value_type = std::shared_ptr<T>;
+
+  explicit RingBuffer(uint64_t size)
+      : capacity_(std::max(size, uint64_t(1))), slots_(new Slot[capacity_]) {}
+
+  uint64_t Head() const {
+    const uint64_t tail = Tail();
+    return tail > capacity_ ? tail - capacity_ + 1 : 1;
+  }
+  uint64_t Tail() const { return tail_.load(std::memory_order_acquire); }
+  bool Empty() const { return Tail() == 0; }
+  uint64_t Capacity() const { return capacity_; }
+
+  /**
+   * @brief Append a message. Single writer, the writers of a channel are
+   *        serialized by DataDispatcher.
+   */
+  void Fill(const value_type& value) {
+    const uint64_t index = tail_.load(std::memory_order_relaxed) + 1;
+    Slot& slot = slots_[index % capacity_];
+    // Unpublish the slot first, then wait for the readers which found it
+    // published. Only a reader a full ring behind is on this slot, copying
+    // the handle out.
+    slot.index.store(kWriting, std::memory_order_seq_cst);
+    while (slot.readers.load(std::memory_order_seq_cst) != 0) {
+      std::this_thread::yield();
+    }
+    value_type overwritten = value;
+    slot.value.swap(overwritten);
+    slot.index.store(index, std::memory_order_release);
+    tail_.store(index, std::memory_order_release);
+    // the overwritten message is released after publishing
+  }
+
+  /**
+   * @brief Read the message at index, never waits for the writer
+   * @return False if the message is not written yet, or is overwritten
+   */
+  bool Read(uint64_t index, value_type* value) const {
+    Slot& slot = slots_[index % capacity_];
+    slot.readers.fetch_add(1, std::memory_order_seq_cst);
+    const bool published =
+        slot.index.load(std::memory_order_seq_cst) == index;
+    if (published) {
+      *value = slot.value;
+    }
+    slot.readers.fetch_sub(1, std::memory_order_release);
+    return published;
+  }
+
+ private:
+  RingBuffer(const RingBuffer& other) = delete;
+  RingBuffer& operator=(const RingBuffer& other) = delete;
+
+  // Message indexes start from 1
+  static constexpr uint64_t kWriting = 0;
+
+  struct Slot {
+    std::atomic<uint64_t> index{kWriting};
+    std::atomic<uint32_t> readers{0};
+    value_type value;
+  };
+
+  const uint64_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> tail_{0};
+};
+
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_DATA_RING_BUFFER_H_
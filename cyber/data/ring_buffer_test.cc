@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/data/ring_buffer.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/data/channel_buffer.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+
+TEST(RingBufferTest, ring_buffer_test) {
+  RingBuffer<int> ring(4);
+  EXPECT_TRUE(ring.Empty());
+  EXPECT_EQ(4, ring.Capacity());
+  std::shared_ptr<int> value;
+  EXPECT_FALSE(ring.Read(1, &value));
+
+  for (int i = 1; i <= 4; ++i) {
+    ring.Fill(std::make_shared<int>(i));
+  }
+  EXPECT_EQ(1, ring.Head());
+  EXPECT_EQ(4, ring.Tail());
+  for (uint64_t i = 1; i <= 4; ++i) {
+    EXPECT_TRUE(ring.Read(i, &value));
+    EXPECT_EQ(i, *value);
+  }
+
+  ring.Fill(std::make_shared<int>(5));
+  EXPECT_EQ(2, ring.Head());
+  EXPECT_EQ(5, ring.Tail());
+  EXPECT_FALSE(ring.Read(1, &value));
+  EXPECT_TRUE(ring.Read(5, &value));
+  EXPECT_EQ(5, *value);
+  EXPECT_FALSE(ring.Read(6, &value));
+}
+
+TEST(RingBufferTest, channel_buffer) {
+  auto ring = new RingBuffer<int>(3);
+  ChannelBuffer<int> buffer(0, ring);
+  EXPECT_EQ(nullptr, buffer.Buffer());
+  std::shared_ptr<int> value;
+  uint64_t index = 0;
+  EXPECT_FALSE(buffer.Fetch(&index, value));
+  EXPECT_FALSE(buffer.Latest(value));
+
+  ring->Fill(std::make_shared<int>(1));
+  EXPECT_TRUE(buffer.Fetch(&index, value));
+  EXPECT_EQ(1, index);
+  EXPECT_EQ(1, *value);
+  index++;
+  EXPECT_FALSE(buffer.Fetch(&index, value));
+
+  // overflow
+  for (int i = 2; i <= 6; ++i) {
+    ring->Fill(std::make_shared<int>(i));
+  }
+  EXPECT_TRUE(buffer.Fetch(&index, value));
+  EXPECT_EQ(6, index);
+  EXPECT_EQ(6, *value);
+  EXPECT_TRUE(buffer.Latest(value));
+  EXPECT_EQ(6, *value);
+
+  std::vector<std::shared_ptr<int>> values;
+  EXPECT_TRUE(buffer.FetchMulti(5, &values));
+  ASSERT_EQ(3, values.size());
+  EXPECT_EQ(4, *values[0]);
+  EXPECT_EQ(6, *values[2]);
+}
+
+TEST(RingBufferTest, concurrent_readers) {
+  const int kNumMessages = 10000;
+  auto ring = new RingBuffer<int>(1024);
+  ChannelBuffer<int> buffer(0, ring);
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&buffer]() {
+      uint64_t index = 0;
+      int last_value = 0;
+      std::shared_ptr<int> value;
+      while (last_value < kNumMessages) {
+        if (!buffer.Fetch(&index, value)) {
+          std::this_thread::yield();
+          continue;
+        }
+        // every message read is the one of its index
+        EXPECT_EQ(index, static_cast<uint64_t>(*value));
+        EXPECT_GT(*value, last_value);
+        last_value = *value;
+        index++;
+      }
+    });
+  }
+  for (int i = 1; i <= kNumMessages; ++i) {
+    ring->Fill(std::make_shared<int>(i));
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
+TEST(RingBufferTest, lapped_readers) {
+  // readers are lapped by the writer all the time, and retry from the tail
+  const int kNumMessages = 10000;
+  auto ring = new RingBuffer<int>(1);
+  ChannelBuffer<int> buffer(0, ring);
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&buffer]() {
+      int last_value = 0;
+      std::shared_ptr<int> value;
+      while (last_value < kNumMessages) {
+        uint64_t index = 0;
+        if (!buffer.Latest(value)) {
+          std::this_thread::yield();
+          continue;
+        }
+        EXPECT_GE(*value, last_value);
+        last_value = *value;
+        if (buffer.Fetch(&index, value)) {
+          EXPECT_EQ(index, static_cast<uint64_t>(*value));
+        }
+      }
+    });
+  }
+  for (int i = 1; i <= kNumMessages; ++i) {
+    ring->Fill(std::make_shared<int>(i));
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
@@ -29,7 +29,13 @@ namespace apollo {
 namespace cyber {
 namespace event {
 
-enum class EventType { SCHED_EVENT = 0, TRANS_EVENT = 1, TRY_FETCH_EVENT = 3 };
+enum class EventType {
+  SCHED_EVENT = 0,
+  TRANS_EVENT = 1,
+  TRY_FETCH_EVENT = 3,
+  BLOCK_EVENT = 4,
+  NAME_EVENT = 5,
+};
 
 enum class TransPerf {
   TRANSMIT_BEGIN = 0,
@@ -16,10 +16,15 @@
 
 #include "cyber/event/perf_event_cache.h"
 
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <string>
 
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
+#include "cyber/common/util.h"
 #include "cyber/state.h"
 #include "cyber/time/time.h"
 
@@ -31,6 +36,21 @@ using common::GlobalData;
 using proto::PerfConf;
 using proto::PerfType;
 
+namespace {
+
+// Retires the ring of a thread when the thread exits, the flush thread
+// releases it once drained
+struct ThreadRingHolder {
+  TraceRing* ring = nullptr;
+  ~ThreadRingHolder() {
+    if (ring != nullptr) {
+      ring->Retire();
+    }
+  }
+};
+
+}  // namespace
+
 PerfEventCache::PerfEventCache() {
   auto& global_conf = GlobalData::Instance()->Config();
   if (global_conf.has_perf_conf()) {
@@ -39,10 +59,6 @@ PerfEventCache::PerfEventCache() {
   }
 
   if (enable_) {
-    if (!event_queue_.Init(kEventQueueSize)) {
-      AERROR << "Event queue init failed.";
-      throw std::runtime_error("Event queue init failed.");
-    }
     Start();
   }
 }
@@ -50,19 +66,48 @@ PerfEventCache::PerfEventCache() {
 PerfEventCache::~PerfEventCache() { Shutdown(); }
 
 void PerfEventCache::Shutdown() {
-  if (!enable_) {
+  if (!enable_ || shutdown_.exchange(true)) {
     return;
   }
 
-  shutdown_ = true;
-  event_queue_.BreakAllWait();
+  flush_cv_.notify_all();
   if (io_thread_.joinable()) {
     io_thread_.join();
   }
 
-  of_ << cyber::Time::Now().ToNanosecond() << std::endl;
-  of_.flush();
-  of_.close();
+  Flush();
+  writer_.Close();
+  {
+    std::lock_guard<std::mutex> lg(rings_mutex_);
+    for (const auto& ring : rings_) {
+      dropped_ += ring->dropped();
+    }
+  }
+  if (dropped_ > 0) {
+    AWARN << dropped_ << " perf events dropped, the trace rings were full";
+  }
+}
+
+TraceRing* PerfEventCache::ThreadRing() {
+  static thread_local ThreadRingHolder holder;
+  if (cyber_unlikely(holder.ring == nullptr)) {
+    std::unique_ptr<TraceRing> ring(
+        new TraceRing(static_cast<uint32_t>(syscall(SYS_gettid)), kRingSize));
+    holder.ring = ring.get();
+    std::lock_guard<std::mutex> lg(rings_mutex_);
+    rings_.emplace_back(std::move(ring));
+  }
+  return holder.ring;
+}
+
+uint64_t PerfEventCache::InternLabel(const std::string& label) {
+  const uint64_t id = common::Hash(label);
+  static thread_local std::unordered_set<uint64_t> interned;
+  if (cyber_unlikely(interned.insert(id).second)) {
+    std::lock_guard<std::mutex> lg(labels_mutex_);
+    labels_.emplace(id, label);
+  }
+  return id;
 }
 
 void PerfEventCache::AddSchedEvent(const SchedPerf event_id,
@@ -77,14 +122,16 @@ void PerfEventCache::AddSchedEvent(const SchedPerf event_id,
     return;
   }
 
-  EventBasePtr e = std::make_shared<SchedEvent>();
-  e->set_eid(static_cast<int>(event_id));
-  e->set_stamp(Time::Now().ToNanosecond());
-  e->set_cr_state(cr_state);
-  e->set_cr_id(cr_id);
-  e->set_proc_id(proc_id);
-
-  event_queue_.Enqueue(e);
+  TraceRecord record;
+  record.etype = static_cast<int16_t>(EventType::SCHED_EVENT);
+  record.eid = static_cast<int16_t>(event_id);
+  record.stamp = Time::Now().ToNanosecond();
+  record.id = cr_id;
+  record.value = proc_id;
+  record.state = cr_state;
+  TraceRing* ring = ThreadRing();
+  record.tid = ring->tid();
+  ring->Push(record);
 }
 
 void PerfEventCache::AddTransportEvent(const TransPerf event_id,
@@ -101,32 +148,112 @@ void PerfEventCache::AddTransportEvent(const TransPerf event_id,
     return;
   }
 
-  EventBasePtr e = std::make_shared<TransportEvent>();
-  e->set_eid(static_cast<int>(event_id));
-  e->set_channel_id(channel_id);
-  e->set_msg_seq(msg_seq);
-  e->set_adder(adder);
-  auto t = stamp;
-  if (stamp == 0) {
-    t = Time::Now().ToNanosecond();
+  TraceRecord record;
+  record.etype = static_cast<int16_t>(EventType::TRANS_EVENT);
+  record.eid = static_cast<int16_t>(event_id);
+  record.stamp = stamp == 0 ? Time::Now().ToNanosecond() : stamp;
+  record.id = channel_id;
+  record.arg = msg_seq;
+  if (!adder.empty() && adder != "-") {
+    record.name = InternLabel(adder);
+  }
+  TraceRing* ring = ThreadRing();
+  record.tid = ring->tid();
+  ring->Push(record);
+}
+
+void PerfEventCache::AddBlockEvent(const std::string& name,
+                                   const uint64_t duration_ns,
+                                   const int depth) {
+  if (!enable_) {
+    return;
   }
-  e->set_stamp(t);
 
-  event_queue_.Enqueue(e);
+  if (perf_conf_.type() != PerfType::PROFILER &&
+      perf_conf_.type() != PerfType::ALL) {
+    return;
+  }
+
+  TraceRecord record;
+  record.etype = static_cast<int16_t>(EventType::BLOCK_EVENT);
+  record.stamp = Time::Now().ToNanosecond() - duration_ns;
+  record.name = InternLabel(name);
+  record.arg = duration_ns;
+  record.value = depth;
+  TraceRing* ring = ThreadRing();
+  record.tid = ring->tid();
+  ring->Push(record);
 }
 
-void PerfEventCache::Run() {
-  EventBasePtr event;
-  int buf_size = 0;
-  while (!shutdown_ && !apollo::cyber::IsShutdown()) {
-    if (event_queue_.WaitDequeue(&event)) {
-      of_ << event->SerializeToString() << std::endl;
-      buf_size++;
-      if (buf_size >= kFlushSize) {
-        of_.flush();
-        buf_size = 0;
+void PerfEventCache::WriteName(TraceName kind, uint64_t id) {
+  if (!written_names_.emplace(kind, id).second) {
+    return;
+  }
+  std::string name;
+  switch (kind) {
+    case TraceName::TASK:
+      name = GlobalData::GetTaskNameById(id);
+      break;
+    case TraceName::CHANNEL:
+      name = GlobalData::GetChannelById(id);
+      break;
+    case TraceName::LABEL: {
+      std::lock_guard<std::mutex> lg(labels_mutex_);
+      auto it = labels_.find(id);
+      if (it != labels_.end()) {
+        name = it->second;
       }
+      break;
     }
+    default:
+      break;
+  }
+  if (!name.empty()) {
+    writer_.WriteName(kind, id, name);
+  }
+}
+
+void PerfEventCache::WriteRecord(const TraceRecord& record) {
+  switch (static_cast<EventType>(record.etype)) {
+    case EventType::SCHED_EVENT:
+      WriteName(TraceName::TASK, record.id);
+      break;
+    case EventType::TRANS_EVENT:
+      WriteName(TraceName::CHANNEL, record.id);
+      if (record.name != 0) {
+        WriteName(TraceName::LABEL, record.name);
+      }
+      break;
+    case EventType::BLOCK_EVENT:
+      WriteName(TraceName::LABEL, record.name);
+      break;
+    default:
+      break;
+  }
+  writer_.Write(record);
+}
+
+void PerfEventCache::Flush() {
+  std::lock_guard<std::mutex> lg(rings_mutex_);
+  for (auto it = rings_.begin(); it != rings_.end();) {
+    // a retired ring gets no more records, it is released once drained
+    const bool retired = (*it)->retired();
+    (*it)->Drain([this](const TraceRecord& record) { WriteRecord(record); });
+    if (retired) {
+      dropped_ += (*it)->dropped();
+      it = rings_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  writer_.Flush();
+}
+
+void PerfEventCache::Run() {
+  std::unique_lock<std::mutex> lk(flush_mutex_);
+  while (!shutdown_ && !apollo::cyber::IsShutdown()) {
+    flush_cv_.wait_for(lk, kFlushInterval);
+    Flush();
   }
 }
 
@@ -135,9 +262,14 @@ void PerfEventCache::Start() {
   std::string perf_file = "cyber_perf_" + now.ToString() + ".data";
   std::replace(perf_file.begin(), perf_file.end(), ' ', '_');
   std::replace(perf_file.begin(), perf_file.end(), ':', '-');
-  of_.open(perf_file, std::ios::trunc);
+  const int pid = GlobalData::Instance()->ProcessId();
+  if (!writer_.Open(perf_file, pid, now.ToNanosecond())) {
+    enable_ = false;
+    return;
+  }
   perf_file_ = perf_file;
-  of_ << Time::Now().ToNanosecond() << std::endl;
+  writer_.WriteName(TraceName::PROCESS, static_cast<uint64_t>(pid),
+                    GlobalData::Instance()->ProcessGroup());
   io_thread_ = std::thread(&PerfEventCache::Run, this);
 }
 
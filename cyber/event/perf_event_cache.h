@@ -17,32 +17,48 @@
 #ifndef CYBER_EVENT_PERF_EVENT_CACHE_H_
 #define CYBER_EVENT_PERF_EVENT_CACHE_H_
 
+#include <atomic>
 #include <chrono>
-#include <fstream>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "cyber/proto/perf_conf.pb.h"
 
-#include "cyber/base/bounded_queue.h"
 #include "cyber/common/macros.h"
 #include "cyber/event/perf_event.h"
+#include "cyber/event/trace_file.h"
+#include "cyber/event/trace_record.h"
 
 namespace apollo {
 namespace cyber {
 namespace event {
 
+/**
+ * @class PerfEventCache
+ * @brief Records perf events into per thread rings of fixed size records,
+ *        without locks on the traced threads. A flush thread drains the
+ *        rings periodically into a binary trace file, to be converted into a
+ *        Chrome/Perfetto timeline with the cyber_trace tool.
+ */
 class PerfEventCache {
  public:
-  using EventBasePtr = std::shared_ptr<EventBase>;
-
   ~PerfEventCache();
   void AddSchedEvent(const SchedPerf event_id, const uint64_t cr_id,
                      const int proc_id, const int cr_state = -1);
   void AddTransportEvent(const TransPerf event_id, const uint64_t channel_id,
                          const uint64_t msg_seq, const uint64_t stamp = 0,
                          const std::string& adder = "-");
+  // A PERF_BLOCK region ending now
+  void AddBlockEvent(const std::string& name, const uint64_t duration_ns,
+                     const int depth);
 
   std::string PerfFile() { return perf_file_; }
 
@@ -51,19 +67,34 @@ class PerfEventCache {
  private:
   void Start();
   void Run();
+  void Flush();
+  TraceRing* ThreadRing();
+  uint64_t InternLabel(const std::string& label);
+  void WriteRecord(const TraceRecord& record);
+  void WriteName(TraceName kind, uint64_t id);
 
   std::thread io_thread_;
-  std::ofstream of_;
+  TraceFileWriter writer_;
 
   bool enable_ = false;
-  bool shutdown_ = false;
+  std::atomic<bool> shutdown_ = {false};
+  std::mutex flush_mutex_;
+  std::condition_variable flush_cv_;
 
   proto::PerfConf perf_conf_;
   std::string perf_file_ = "";
-  base::BoundedQueue<EventBasePtr> event_queue_;
 
-  const int kFlushSize = 512;
-  const uint64_t kEventQueueSize = 8192;
+  std::mutex rings_mutex_;
+  std::vector<std::unique_ptr<TraceRing>> rings_;
+  uint64_t dropped_ = 0;
+
+  std::mutex labels_mutex_;
+  std::unordered_map<uint64_t, std::string> labels_;
+  // names already in the trace file, only used by the flush thread
+  std::set<std::pair<TraceName, uint64_t>> written_names_;
+
+  const size_t kRingSize = 4096;
+  const std::chrono::milliseconds kFlushInterval{10};
 
   DECLARE_SINGLETON(PerfEventCache)
 };
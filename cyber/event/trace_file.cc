@@ -0,0 +1,273 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/event/trace_file.h"
+
+#include <cstring>
+#include <iomanip>
+
+#include "cyber/common/log.h"
+#include "cyber/event/perf_event.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+namespace {
+
+constexpr char kTraceMagic[8] = {'C', 'Y', 'B', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t kTraceVersion = 1;
+// Longest name accepted while reading, anything longer is a corrupted file
+constexpr uint64_t kMaxNameLength = 4096;
+
+std::string ShowSchedPerf(const int16_t eid) {
+  switch (static_cast<SchedPerf>(eid)) {
+    case SchedPerf::SWAP_IN:
+      return "SWAP_IN";
+    case SchedPerf::SWAP_OUT:
+      return "SWAP_OUT";
+    case SchedPerf::NOTIFY_IN:
+      return "NOTIFY_IN";
+    case SchedPerf::NEXT_RT:
+      return "NEXT_RT";
+    case SchedPerf::RT_CREATE:
+      return "RT_CREATE";
+  }
+  return "";
+}
+
+void WriteJsonString(const std::string& str, std::ostream* out) {
+  *out << '"';
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        *out << "\\\"";
+        break;
+      case '\\':
+        *out << "\\\\";
+        break;
+      case '\n':
+        *out << "\\n";
+        break;
+      case '\t':
+        *out << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          *out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+               << static_cast<int>(c) << std::dec << std::setfill(' ');
+        } else {
+          *out << c;
+        }
+    }
+  }
+  *out << '"';
+}
+
+// Chrome trace timestamps are in microseconds
+void WriteMicroseconds(const uint64_t ns, std::ostream* out) {
+  *out << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000
+       << std::setfill(' ');
+}
+
+// Write the fields shared by all the events, the caller closes the object.
+void WriteEventHead(const std::string& name, const char* category,
+                    const char* phase, const uint64_t stamp, const int pid,
+                    const uint32_t tid, std::ostream* out) {
+  *out << "{\"name\":";
+  WriteJsonString(name, out);
+  *out << ",\"cat\":\"" << category << "\",\"ph\":\"" << phase
+       << "\",\"ts\":";
+  WriteMicroseconds(stamp, out);
+  *out << ",\"pid\":" << pid << ",\"tid\":" << tid;
+}
+
+}  // namespace
+
+bool TraceFileWriter::Open(const std::string& path, int pid,
+                           uint64_t start_stamp) {
+  of_.open(path, std::ios::binary | std::ios::trunc);
+  if (!of_.is_open()) {
+    AERROR << "Failed to open trace file " << path;
+    return false;
+  }
+  TraceFileHeader header;
+  std::memcpy(header.magic, kTraceMagic, sizeof(header.magic));
+  header.version = kTraceVersion;
+  header.record_size = sizeof(TraceRecord);
+  header.pid = pid;
+  header.start_stamp = start_stamp;
+  of_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  return true;
+}
+
+void TraceFileWriter::Write(const TraceRecord& record) {
+  of_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+void TraceFileWriter::WriteName(TraceName kind, uint64_t id,
+                                const std::string& name) {
+  TraceRecord record;
+  record.etype = static_cast<int16_t>(EventType::NAME_EVENT);
+  record.eid = static_cast<int16_t>(kind);
+  record.id = id;
+  record.arg = name.size();
+  Write(record);
+  of_.write(name.data(), name.size());
+}
+
+void TraceFileWriter::Flush() { of_.flush(); }
+
+void TraceFileWriter::Close() {
+  if (of_.is_open()) {
+    of_.flush();
+    of_.close();
+  }
+}
+
+bool TraceFileReader::Open(const std::string& path) {
+  in_.open(path, std::ios::binary);
+  if (!in_.is_open()) {
+    AERROR << "Failed to open trace file " << path;
+    return false;
+  }
+  if (!in_.read(reinterpret_cast<char*>(&header_), sizeof(header_)) ||
+      std::memcmp(header_.magic, kTraceMagic, sizeof(kTraceMagic)) != 0) {
+    AERROR << path << " is not a cyber trace file";
+    return false;
+  }
+  if (header_.version != kTraceVersion ||
+      header_.record_size != sizeof(TraceRecord)) {
+    AERROR << "Unsupported trace file version " << header_.version
+           << " with record size " << header_.record_size;
+    return false;
+  }
+  return true;
+}
+
+bool TraceFileReader::Next(TraceRecord* record) {
+  while (in_.read(reinterpret_cast<char*>(record), sizeof(*record))) {
+    if (record->etype != static_cast<int16_t>(EventType::NAME_EVENT)) {
+      return true;
+    }
+    if (record->arg > kMaxNameLength) {
+      AERROR << "Corrupted name of length " << record->arg;
+      return false;
+    }
+    std::string name(record->arg, '\0');
+    if (!in_.read(&name[0], name.size())) {
+      return false;
+    }
+    names_[std::make_pair(record->eid, record->id)] = std::move(name);
+  }
+  return false;
+}
+
+std::string TraceFileReader::Name(TraceName kind, uint64_t id) const {
+  auto it = names_.find(std::make_pair(static_cast<int16_t>(kind), id));
+  if (it == names_.end()) {
+    return std::to_string(id);
+  }
+  return it->second;
+}
+
+bool ConvertToChromeTrace(const std::vector<std::string>& trace_files,
+                          std::ostream* out) {
+  *out << "{\"traceEvents\":[";
+  bool first = true;
+  auto next_event = [&first, out]() {
+    if (!first) {
+      *out << ",\n";
+    } else {
+      *out << "\n";
+      first = false;
+    }
+  };
+
+  for (const auto& trace_file : trace_files) {
+    TraceFileReader reader;
+    if (!reader.Open(trace_file)) {
+      return false;
+    }
+    const int pid = reader.header().pid;
+    TraceRecord record;
+    while (reader.Next(&record)) {
+      switch (static_cast<EventType>(record.etype)) {
+        case EventType::SCHED_EVENT: {
+          const auto eid = static_cast<SchedPerf>(record.eid);
+          const std::string task = reader.Name(TraceName::TASK, record.id);
+          next_event();
+          if (eid == SchedPerf::SWAP_IN) {
+            WriteEventHead(task, "sched", "B", record.stamp, pid, record.tid,
+                           out);
+            *out << ",\"args\":{\"processor\":" << record.value << "}}";
+          } else if (eid == SchedPerf::SWAP_OUT) {
+            WriteEventHead(task, "sched", "E", record.stamp, pid, record.tid,
+                           out);
+            *out << ",\"args\":{\"state\":" << record.state << "}}";
+          } else {
+            WriteEventHead(ShowSchedPerf(record.eid), "sched", "i",
+                           record.stamp, pid, record.tid, out);
+            *out << ",\"s\":\"t\",\"args\":{\"task\":";
+            WriteJsonString(task, out);
+            *out << "}}";
+          }
+          break;
+        }
+        case EventType::TRANS_EVENT: {
+          next_event();
+          WriteEventHead(TransportEvent::ShowTransPerf(
+                             static_cast<TransPerf>(record.eid)),
+                         "transport", "i", record.stamp, pid, record.tid,
+                         out);
+          *out << ",\"s\":\"t\",\"args\":{\"channel\":";
+          WriteJsonString(reader.Name(TraceName::CHANNEL, record.id), out);
+          *out << ",\"seq\":" << record.arg;
+          if (record.name != 0) {
+            *out << ",\"adder\":";
+            WriteJsonString(reader.Name(TraceName::LABEL, record.name), out);
+          }
+          *out << "}}";
+          break;
+        }
+        case EventType::BLOCK_EVENT: {
+          next_event();
+          WriteEventHead(reader.Name(TraceName::LABEL, record.name), "block",
+                         "X", record.stamp, pid, record.tid, out);
+          *out << ",\"dur\":";
+          WriteMicroseconds(record.arg, out);
+          *out << ",\"args\":{\"depth\":" << record.value << "}}";
+          break;
+        }
+        default:
+          break;
+      }
+    }
+
+    next_event();
+    *out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+         << ",\"args\":{\"name\":";
+    WriteJsonString(
+        reader.Name(TraceName::PROCESS, static_cast<uint64_t>(pid)), out);
+    *out << "}}";
+  }
+  *out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+  return out->good();
+}
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
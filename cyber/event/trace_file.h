@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_EVENT_TRACE_FILE_H_
+#define CYBER_EVENT_TRACE_FILE_H_
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cyber/event/trace_record.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+// Kinds of the ids named in a trace file, labels are the names interned
+// by the traced process, like block names
+enum class TraceName : int16_t {
+  PROCESS = 0,
+  TASK = 1,
+  CHANNEL = 2,
+  LABEL = 3,
+};
+
+// A trace file is this header followed by trace records. A name entry is a
+// record of NAME_EVENT type, with the kind of name as eid, the named id as
+// id and the length of the name as arg, followed by the name itself. Names
+// are written before the first record referring to them.
+struct TraceFileHeader {
+  char magic[8];
+  uint32_t version = 0;
+  uint32_t record_size = 0;
+  int32_t pid = 0;
+  uint32_t reserved = 0;
+  uint64_t start_stamp = 0;
+};
+
+class TraceFileWriter {
+ public:
+  bool Open(const std::string& path, int pid, uint64_t start_stamp);
+  bool is_open() const { return of_.is_open(); }
+
+  void Write(const TraceRecord& record);
+  void WriteName(TraceName kind, uint64_t id, const std::string& name);
+
+  void Flush();
+  void Close();
+
+ private:
+  std::ofstream of_;
+};
+
+class TraceFileReader {
+ public:
+  bool Open(const std::string& path);
+  const TraceFileHeader& header() const { return header_; }
+
+  /**
+   * @brief Read the next record of an event, name entries met on the way
+   *        are kept for Name()
+   * @return False at the end of the file
+   */
+  bool Next(TraceRecord* record);
+
+  // The name of an id, or the id itself if it was not named
+  std::string Name(TraceName kind, uint64_t id) const;
+
+ private:
+  std::ifstream in_;
+  TraceFileHeader header_;
+  std::map<std::pair<int16_t, uint64_t>, std::string> names_;
+};
+
+/**
+ * @brief Convert trace files, of one or more processes, into a single
+ *        timeline in the Chrome trace event JSON format, which is also
+ *        loaded by Perfetto
+ */
+bool ConvertToChromeTrace(const std::vector<std::string>& trace_files,
+                          std::ostream* out);
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_EVENT_TRACE_FILE_H_
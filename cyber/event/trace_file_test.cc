@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/event/trace_file.h"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/event/perf_event.h"
+#include "cyber/event/trace_record.h"
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+TraceRecord SchedRecord(SchedPerf eid, uint64_t stamp) {
+  TraceRecord record;
+  record.etype = static_cast<int16_t>(EventType::SCHED_EVENT);
+  record.eid = static_cast<int16_t>(eid);
+  record.stamp = stamp;
+  record.id = 7;
+  record.tid = 100;
+  record.value = 1;
+  return record;
+}
+
+TEST(TraceRingTest, push_drain) {
+  TraceRing ring(100, 3);
+  EXPECT_EQ(100, ring.tid());
+  for (uint64_t i = 0; i < 6; ++i) {
+    ring.Push(SchedRecord(SchedPerf::SWAP_IN, i));
+  }
+  // rounded up to 4 records, the last 2 are dropped
+  EXPECT_EQ(2, ring.dropped());
+
+  std::vector<uint64_t> stamps;
+  EXPECT_EQ(4, ring.Drain([&stamps](const TraceRecord& record) {
+    stamps.push_back(record.stamp);
+  }));
+  EXPECT_EQ(std::vector<uint64_t>({0, 1, 2, 3}), stamps);
+  EXPECT_EQ(0, ring.Drain([](const TraceRecord&) {}));
+
+  EXPECT_TRUE(ring.Push(SchedRecord(SchedPerf::SWAP_OUT, 10)));
+  EXPECT_FALSE(ring.retired());
+  ring.Retire();
+  EXPECT_TRUE(ring.retired());
+  EXPECT_EQ(1, ring.Drain([](const TraceRecord&) {}));
+}
+
+TEST(TraceFileTest, write_read) {
+  const std::string path = "trace_file_test_write_read.data";
+  TraceFileWriter writer;
+  ASSERT_TRUE(writer.Open(path, 42, 1000));
+  writer.WriteName(TraceName::TASK, 7, "task_a");
+  writer.Write(SchedRecord(SchedPerf::SWAP_IN, 2000));
+  writer.WriteName(TraceName::LABEL, 9, "block_b");
+  writer.Write(SchedRecord(SchedPerf::SWAP_OUT, 3000));
+  writer.Close();
+
+  TraceFileReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_EQ(42, reader.header().pid);
+  EXPECT_EQ(1000, reader.header().start_stamp);
+  TraceRecord record;
+  ASSERT_TRUE(reader.Next(&record));
+  EXPECT_EQ(2000, record.stamp);
+  EXPECT_EQ("task_a", reader.Name(TraceName::TASK, 7));
+  EXPECT_EQ("9", reader.Name(TraceName::LABEL, 9));
+  ASSERT_TRUE(reader.Next(&record));
+  EXPECT_EQ(3000, record.stamp);
+  EXPECT_EQ("block_b", reader.Name(TraceName::LABEL, 9));
+  EXPECT_FALSE(reader.Next(&record));
+
+  TraceFileReader not_trace;
+  EXPECT_FALSE(not_trace.Open("trace_file_test_not_exist.data"));
+  std::remove(path.c_str());
+}
+
+TEST(TraceFileTest, chrome_trace) {
+  const std::string path = "trace_file_test_chrome_trace.data";
+  TraceFileWriter writer;
+  ASSERT_TRUE(writer.Open(path, 42, 1000));
+  writer.WriteName(TraceName::PROCESS, 42, "process \"a\"");
+  writer.WriteName(TraceName::TASK, 7, "task_a");
+  writer.Write(SchedRecord(SchedPerf::SWAP_IN, 2000));
+  writer.Write(SchedRecord(SchedPerf::SWAP_OUT, 3500));
+
+  TraceRecord block;
+  block.etype = static_cast<int16_t>(EventType::BLOCK_EVENT);
+  block.stamp = 2100;
+  block.arg = 1200;
+  block.name = 9;
+  block.value = 1;
+  block.tid = 100;
+  writer.WriteName(TraceName::LABEL, 9, "block_b");
+  writer.Write(block);
+
+  TraceRecord trans;
+  trans.etype = static_cast<int16_t>(EventType::TRANS_EVENT);
+  trans.eid = static_cast<int16_t>(TransPerf::TRANSMIT_BEGIN);
+  trans.stamp = 2200;
+  trans.id = 11;
+  trans.arg = 5;
+  trans.tid = 100;
+  writer.Write(trans);
+  writer.Close();
+
+  std::ostringstream out;
+  EXPECT_TRUE(ConvertToChromeTrace({path}, &out));
+  const std::string json = out.str();
+  EXPECT_NE(std::string::npos,
+            json.find("{\"name\":\"task_a\",\"cat\":\"sched\",\"ph\":\"B\","
+                      "\"ts\":2.000,\"pid\":42,\"tid\":100"));
+  EXPECT_NE(std::string::npos, json.find("\"ph\":\"E\",\"ts\":3.500"));
+  EXPECT_NE(std::string::npos,
+            json.find("{\"name\":\"block_b\",\"cat\":\"block\",\"ph\":\"X\","
+                      "\"ts\":2.100,\"pid\":42,\"tid\":100,\"dur\":1.200"));
+  EXPECT_NE(std::string::npos,
+            json.find("\"args\":{\"channel\":\"11\",\"seq\":5}"));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"process \\\"a\\\"\""));
+
+  std::ostringstream missing;
+  EXPECT_FALSE(
+      ConvertToChromeTrace({"trace_file_test_not_exist.data"}, &missing));
+  std::remove(path.c_str());
+}
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
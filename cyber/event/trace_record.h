@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_EVENT_TRACE_RECORD_H_
+#define CYBER_EVENT_TRACE_RECORD_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace event {
+
+// Fixed size record of a perf event, the meaning of the fields depends on
+// the event type:
+//   SCHED_EVENT: id is the croutine id, value the processor id and state the
+//                croutine state.
+//   TRANS_EVENT: id is the channel id, arg the message seq and name the id
+//                of the adder, 0 if there is none.
+//   BLOCK_EVENT: name is the id of the block name, arg the duration in ns,
+//                stamp the beginning and value the depth of the block.
+struct TraceRecord {
+  uint64_t stamp = 0;
+  uint64_t id = 0;
+  uint64_t arg = 0;
+  uint64_t name = 0;
+  uint32_t tid = 0;
+  int32_t value = 0;
+  int16_t etype = 0;
+  int16_t eid = 0;
+  int32_t state = 0;
+};
+
+static_assert(sizeof(TraceRecord) == 48, "TraceRecord must be packed");
+
+/**
+ * @class TraceRing
+ * @brief Ring of the trace records of one thread, written by that thread
+ *        only and drained by the flush thread. Records are dropped when the
+ *        ring is full instead of blocking the traced thread.
+ */
+class TraceRing {
+ public:
+  // capacity is rounded up to a power of 2
+  TraceRing(uint32_t tid, size_t capacity) : tid_(tid) {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    records_.resize(size);
+    mask_ = size - 1;
+  }
+
+  uint32_t tid() const { return tid_; }
+  uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  // The thread of the ring exited, nothing is pushed anymore
+  void Retire() { retired_.store(true, std::memory_order_release); }
+  bool retired() const { return retired_.load(std::memory_order_acquire); }
+
+  bool Push(const TraceRecord& record) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= records_.size()) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    records_[head & mask_] = record;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Called by the consumer only, return the number of records drained.
+  template <typename Consumer>
+  size_t Drain(Consumer&& consumer) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    for (uint64_t i = tail; i < head; ++i) {
+      consumer(records_[i & mask_]);
+    }
+    tail_.store(head, std::memory_order_release);
+    return static_cast<size_t>(head - tail);
+  }
+
+ private:
+  const uint32_t tid_;
+  std::vector<TraceRecord> records_;
+  uint64_t mask_ = 0;
+  std::atomic<uint64_t> head_ = {0};
+  std::atomic<uint64_t> tail_ = {0};
+  std::atomic<uint64_t> dropped_ = {0};
+  std::atomic<bool> retired_ = {false};
+};
+
+}  // namespace event
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_EVENT_TRACE_RECORD_H_
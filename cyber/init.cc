@@ -27,6 +27,7 @@
 #include <string>
 
 #include "cyber/proto/clock.pb.h"
+#include "cyber/proto/profiler_stats.pb.h"
 
 #include "cyber/binary.h"
 #include "cyber/common/file.h"
@@ -34,11 +35,13 @@
 #include "cyber/data/data_dispatcher.h"
 #include "cyber/logger/async_logger.h"
 #include "cyber/node/node.h"
+#include "cyber/profiler/block_registry.h"
 #include "cyber/scheduler/scheduler.h"
 #include "cyber/service_discovery/topology_manager.h"
 #include "cyber/sysmo/sysmo.h"
 #include "cyber/task/task.h"
 #include "cyber/time/clock.h"
+#include "cyber/timer/timer.h"
 #include "cyber/timer/timing_wheel.h"
 #include "cyber/transport/transport.h"
 #include "cyber/statistics/statistics.h"
@@ -55,10 +58,13 @@ namespace {
 
 const std::string& kClockChannel = "/clock";
 const std::string& kClockNode = "clock";
+const std::string& kProfilerNode = "profiler";
 
 bool g_atexit_registered = false;
 std::mutex g_mutex;
 std::unique_ptr<Node> clock_node;
+std::unique_ptr<Node> profiler_node;
+std::unique_ptr<Timer> profiler_timer;
 
 logger::AsyncLogger* async_logger = nullptr;
 
@@ -85,6 +91,39 @@ void InitLogger(const char* binary_name) {
 
 void StopLogger() { delete async_logger; }
 
+// Publish the latency histograms of the PERF_BLOCKs of the process
+void StartProfilerPublisher() {
+  const auto& conf = GlobalData::Instance()->Config().profiler_conf();
+  if (!conf.publish_stats()) {
+    return;
+  }
+  auto node_name = kProfilerNode + std::to_string(getpid());
+  profiler_node = std::unique_ptr<Node>(new Node(node_name));
+  auto writer = profiler_node->CreateWriter<proto::ProfilerStats>(
+      conf.stats_channel());
+  if (writer == nullptr) {
+    AERROR << "Failed to create the profiler stats writer";
+    return;
+  }
+  profiler_timer.reset(new Timer(
+      conf.publish_interval_ms(),
+      [writer]() {
+        auto stats = std::make_shared<proto::ProfilerStats>();
+        profiler::BlockRegistry::Instance()->Collect(stats.get());
+        writer->Write(stats);
+      },
+      false));
+  profiler_timer->Start();
+}
+
+void StopProfilerPublisher() {
+  if (profiler_timer != nullptr) {
+    profiler_timer->Stop();
+    profiler_timer.reset();
+  }
+  profiler_node.reset();
+}
+
 }  // namespace
 
 void OnShutdown(int sig) {
@@ -130,6 +169,7 @@ bool Init(const char* binary_name, const std::string& dag_info) {
         };
     clock_node->CreateReader<apollo::cyber::proto::Clock>(kClockChannel, cb);
   }
+  StartProfilerPublisher();
 
   if (dag_info != "") {
     std::string dump_path;
@@ -156,6 +196,7 @@ void Clear() {
   if (GetState() == STATE_SHUTDOWN || GetState() == STATE_UNINITIALIZED) {
     return;
   }
+  StopProfilerPublisher();
   SysMo::CleanUp();
   TaskManager::CleanUp();
   TimingWheel::CleanUp();
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_NODE_BATCH_TRIGGER_H_
+#define CYBER_NODE_BATCH_TRIGGER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "cyber/time/time.h"
+#include "cyber/timer/timer_task.h"
+#include "cyber/timer/timing_wheel.h"
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @class BatchTrigger
+ * @brief Coalesces the notifications of the messages of a batched reader.
+ * The reader is notified once `max_messages` messages are pending, or once
+ * the first pending message waited `max_delay_us`. The delay is rounded up
+ * to the resolution of the timing wheel, 0 disables it.
+ */
+class BatchTrigger : public std::enable_shared_from_this<BatchTrigger> {
+ public:
+  BatchTrigger(uint32_t max_messages, uint64_t max_delay_us,
+               std::function<void()>&& notify)
+      : max_messages_(max_messages == 0 ? 1 : max_messages),
+        max_delay_ns_(max_delay_us * 1000),
+        notify_(std::move(notify)) {}
+
+  /**
+   * @brief Called for every message dispatched to the reader
+   */
+  void OnMessage() {
+    const uint32_t pending = pending_.fetch_add(1) + 1;
+    if (pending >= max_messages_) {
+      Flush();
+    } else if (pending == 1 && max_delay_ns_ > 0) {
+      ArmFlush(generation_.load());
+    }
+  }
+
+  /**
+   * @brief Notify the reader of the pending messages, if any
+   */
+  void Flush() {
+    if (pending_.load() == 0) {
+      return;
+    }
+    // the generation changes before the pending count, so the flush task
+    // armed by the first message of the next batch can not be mistaken for
+    // a stale one
+    generation_.fetch_add(1);
+    if (pending_.exchange(0) == 0) {
+      return;
+    }
+    notify_();
+  }
+
+  uint32_t max_messages() const { return max_messages_; }
+  uint64_t max_delay_us() const { return max_delay_ns_ / 1000; }
+
+ private:
+  void ArmFlush(const uint64_t generation) {
+    std::weak_ptr<BatchTrigger> weak_trigger = shared_from_this();
+    auto task = std::make_shared<TimerTask>(0);
+    task->deadline_ns = Time::MonoTime().ToNanosecond() + max_delay_ns_;
+    task->callback = [weak_trigger, generation]() {
+      auto trigger = weak_trigger.lock();
+      // the batch was already flushed once full
+      if (trigger && trigger->generation_.load() == generation) {
+        trigger->Flush();
+      }
+    };
+    {
+      // the wheel only keeps weak references, the task of the previous batch
+      // is no longer needed
+      std::lock_guard<std::mutex> lock(flush_task_mutex_);
+      flush_task_ = task;
+    }
+    TimingWheel::Instance()->AddTask(task);
+  }
+
+  const uint32_t max_messages_;
+  const uint64_t max_delay_ns_;
+  std::function<void()> notify_;
+  std::atomic<uint32_t> pending_ = {0};
+  std::atomic<uint64_t> generation_ = {0};
+  std::mutex flush_task_mutex_;
+  std::shared_ptr<TimerTask> flush_task_ = nullptr;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_NODE_BATCH_TRIGGER_H_
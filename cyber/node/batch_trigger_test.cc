@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/node/batch_trigger.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+
+TEST(BatchTriggerTest, batch_size) {
+  std::atomic<int> notified = {0};
+  auto trigger =
+      std::make_shared<BatchTrigger>(4, 0, [&notified]() { notified++; });
+  for (int i = 0; i < 3; ++i) {
+    trigger->OnMessage();
+  }
+  EXPECT_EQ(0, notified.load());
+  trigger->OnMessage();
+  EXPECT_EQ(1, notified.load());
+
+  for (int i = 0; i < 10; ++i) {
+    trigger->OnMessage();
+  }
+  EXPECT_EQ(3, notified.load());
+
+  // the 2 messages left are flushed on demand, only once
+  trigger->Flush();
+  trigger->Flush();
+  EXPECT_EQ(4, notified.load());
+}
+
+TEST(BatchTriggerTest, batch_timeout) {
+  std::atomic<int> notified = {0};
+  auto trigger =
+      std::make_shared<BatchTrigger>(100, 20000, [&notified]() { notified++; });
+  trigger->OnMessage();
+  trigger->OnMessage();
+  EXPECT_EQ(0, notified.load());
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(1, notified.load());
+
+  // a batch flushed once full does not time out afterwards
+  auto full =
+      std::make_shared<BatchTrigger>(2, 20000, [&notified]() { notified++; });
+  full->OnMessage();
+  full->OnMessage();
+  EXPECT_EQ(2, notified.load());
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(2, notified.load());
+}
+
+}  // namespace cyber
+}  // namespace apollo
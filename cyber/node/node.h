@@ -109,6 +109,22 @@ class Node {
                     const CallbackFunc<MessageT>& reader_func = nullptr)
       -> std::shared_ptr<cyber::Reader<MessageT>>;
 
+  /**
+   * @brief Create a batched Reader, the callback is invoked with the
+   * messages received since the previous call once `config.batch_size` of
+   * them are pending or the first of them waited `config.batch_timeout_us`
+   *
+   * @tparam MessageT Message Type
+   * @param config instance of `ReaderConfig`,
+   * include channel name, qos, pending queue size and batch configuration
+   * @param batch_func invoked with the messages from the oldest to the latest
+   * @return std::shared_ptr<cyber::Reader<MessageT>> result Reader Object
+   */
+  template <typename MessageT>
+  auto CreateBatchReader(const ReaderConfig& config,
+                         const BatchCallbackFunc<MessageT>& batch_func)
+      -> std::shared_ptr<cyber::Reader<MessageT>>;
+
   /**
    * @brief Create a Reader object with `RoleAttributes`
    *
@@ -236,6 +252,24 @@ auto Node::CreateReader(const ReaderConfig& config,
   return reader;
 }
 
+template <typename MessageT>
+auto Node::CreateBatchReader(const ReaderConfig& config,
+                             const BatchCallbackFunc<MessageT>& batch_func)
+    -> std::shared_ptr<cyber::Reader<MessageT>> {
+  std::lock_guard<std::mutex> lg(readers_mutex_);
+  if (readers_.find(config.channel_name) != readers_.end()) {
+    AWARN << "Failed to create reader: reader with the same channel already "
+             "exists.";
+    return nullptr;
+  }
+  auto reader = node_channel_impl_->template CreateBatchReader<MessageT>(
+      config, batch_func);
+  if (reader != nullptr) {
+    readers_.emplace(std::make_pair(config.channel_name, reader));
+  }
+  return reader;
+}
+
 template <typename MessageT>
 auto Node::CreateReader(const std::string& channel_name,
                         const CallbackFunc<MessageT>& reader_func)
@@ -48,7 +48,9 @@ struct ReaderConfig {  ///< configurations for a Reader
   ReaderConfig(const ReaderConfig& other)
       : channel_name(other.channel_name),
         qos_profile(other.qos_profile),
-        pending_queue_size(other.pending_queue_size) {}
+        pending_queue_size(other.pending_queue_size),
+        batch_size(other.batch_size),
+        batch_timeout_us(other.batch_timeout_us) {}
 
   std::string channel_name;       //< channel reads
   proto::QosProfile qos_profile;  //< the qos configuration
@@ -57,6 +59,12 @@ struct ReaderConfig {  ///< configurations for a Reader
    * Older messages will dropped if you have no time to handle
    */
   uint32_t pending_queue_size;
+  /**
+   * @brief configuration of a batched reader, which wakes up once batch_size
+   * messages are pending or the first of them waited batch_timeout_us
+   */
+  uint32_t batch_size = 1;
+  uint64_t batch_timeout_us = 0;
 };
 
 /**
@@ -139,6 +147,11 @@ class NodeChannelImpl {
   auto CreateReader(const proto::RoleAttributes& role_attr)
       -> std::shared_ptr<Reader<MessageT>>;
 
+  template <typename MessageT>
+  auto CreateBatchReader(const ReaderConfig& config,
+                         const BatchCallbackFunc<MessageT>& batch_func)
+      -> std::shared_ptr<Reader<MessageT>>;
+
   template <typename MessageT>
   void FillInAttr(proto::RoleAttributes* attr);
 
@@ -231,6 +244,38 @@ auto NodeChannelImpl::CreateReader(const proto::RoleAttributes& role_attr)
   return this->template CreateReader<MessageT>(role_attr, nullptr);
 }
 
+template <typename MessageT>
+auto NodeChannelImpl::CreateBatchReader(
+    const ReaderConfig& config, const BatchCallbackFunc<MessageT>& batch_func)
+    -> std::shared_ptr<Reader<MessageT>> {
+  if (config.channel_name.empty()) {
+    AERROR << "Can't create a reader with empty channel name!";
+    return nullptr;
+  }
+
+  proto::RoleAttributes new_attr;
+  new_attr.set_channel_name(config.channel_name);
+  new_attr.mutable_qos_profile()->CopyFrom(config.qos_profile);
+  FillInAttr<MessageT>(&new_attr);
+
+  std::shared_ptr<Reader<MessageT>> reader_ptr = nullptr;
+  if (!is_reality_mode_) {
+    // messages are published one by one in simulation mode
+    reader_ptr = std::make_shared<blocker::IntraReader<MessageT>>(
+        new_attr, [batch_func](const std::shared_ptr<MessageT>& msg) {
+          batch_func({msg});
+        });
+  } else {
+    reader_ptr = std::make_shared<Reader<MessageT>>(
+        new_attr, batch_func, config.batch_size, config.batch_timeout_us,
+        config.pending_queue_size);
+  }
+
+  RETURN_VAL_IF_NULL(reader_ptr, nullptr);
+  RETURN_VAL_IF(!reader_ptr->Init(), nullptr);
+  return reader_ptr;
+}
+
 template <typename MessageT>
 void NodeChannelImpl::FillInAttr(proto::RoleAttributes* attr) {
   attr->set_host_name(node_attr_.host_name());
@@ -164,6 +164,52 @@ TEST(WriterReaderTest, messaging) {
   reader_b.Shutdown();
 }
 
+TEST(WriterReaderTest, batch_messaging) {
+  proto::RoleAttributes attr;
+  attr.set_node_name("writer");
+  attr.set_channel_name("batch_messaging");
+  auto channel_id = common::GlobalData::RegisterChannel(attr.channel_name());
+  attr.set_channel_id(channel_id);
+
+  Writer<proto::UnitTest> writer(attr);
+  EXPECT_TRUE(writer.Init());
+
+  std::mutex mtx;
+  std::vector<size_t> batches;
+  attr.set_node_name("batch_reader");
+  Reader<proto::UnitTest> reader(
+      attr,
+      [&](const std::vector<std::shared_ptr<proto::UnitTest>>& msgs) {
+        std::lock_guard<std::mutex> lck(mtx);
+        batches.push_back(msgs.size());
+      },
+      4, 50000);
+  EXPECT_EQ(reader.PendingQueueSize(), 8);
+  EXPECT_TRUE(reader.Init());
+
+  auto msg = std::make_shared<proto::UnitTest>();
+  msg->set_class_name("WriterReaderTest");
+  msg->set_case_name("batch_messaging");
+  // a full batch, then a partial one delivered once it times out
+  for (int i = 0; i < 6; ++i) {
+    writer.Write(msg);
+  }
+  std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(500));
+
+  {
+    std::lock_guard<std::mutex> lck(mtx);
+    size_t received = 0;
+    for (const auto size : batches) {
+      received += size;
+    }
+    EXPECT_EQ(received, 6);
+    EXPECT_LE(batches.size(), 2);
+  }
+
+  writer.Shutdown();
+  reader.Shutdown();
+}
+
 TEST(WriterReaderTest, observe) {
   proto::RoleAttributes attr;
   attr.set_node_name("node");
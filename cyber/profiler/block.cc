@@ -17,15 +17,23 @@
 #include "cyber/profiler/block.h"
 
 #include "cyber/profiler/block_manager.h"
+#include "cyber/profiler/block_registry.h"
 
 namespace apollo {
 namespace cyber {
 namespace profiler {
 
-Block::Block() : depth_(0), begin_time_(), end_time_() {}
+Block::Block()
+    : id_(BlockRegistry::kInvalidId), depth_(0), begin_time_(), end_time_() {}
 
 Block::Block(const std::string& name)
-    : name_(name), depth_(0), begin_time_(), end_time_() {}
+    : id_(BlockRegistry::Instance()->Intern(name)),
+      depth_(0),
+      begin_time_(),
+      end_time_() {}
+
+Block::Block(std::uint32_t id)
+    : id_(id), depth_(0), begin_time_(), end_time_() {}
 
 Block::~Block() {
   if (!finished())
@@ -33,11 +41,19 @@ Block::~Block() {
 }
 
 void Block::Start() {
+  sampled_ = true;
   begin_time_ = std::chrono::steady_clock::now();
 }
 
 void Block::End() {
-  end_time_ = std::chrono::steady_clock::now();
+  if (sampled_) {
+    end_time_ = std::chrono::steady_clock::now();
+  }
+  finished_ = true;
+}
+
+const std::string& Block::name() const {
+  return BlockRegistry::Instance()->Name(id_);
 }
 
 std::uint64_t Block::begin_time_since_epoch() const {
@@ -18,6 +18,7 @@
 #define CYBER_PROFILER_BLOCK_H_
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 namespace apollo {
@@ -30,13 +31,17 @@ class Block {
 
  public:
   Block();
+  // Interns the name, PERF_BLOCK interns it once for all the runs instead
   explicit Block(const std::string& name);
+  explicit Block(std::uint32_t id);
   virtual ~Block();
 
+  // Only the sampled blocks are started, the others are just ended
   void Start();
   void End();
 
-  const std::string& name() const { return name_; }
+  std::uint32_t id() const { return id_; }
+  const std::string& name() const;
   std::uint32_t depth() const { return depth_; }
   void set_depth(std::uint32_t depth) { depth_ = depth; }
 
@@ -47,11 +52,14 @@ class Block {
   std::uint64_t end_time_since_epoch() const;
   std::uint64_t duration() const;
 
-  bool finished() const { return end_time_ > begin_time_; }
+  bool sampled() const { return sampled_; }
+  bool finished() const { return finished_; }
 
  private:
-  std::string name_;
+  std::uint32_t id_;
   std::uint32_t depth_;
+  bool sampled_ = false;
+  bool finished_ = false;
   time_point begin_time_;
   time_point end_time_;
 };
@@ -16,24 +16,43 @@
 
 #include "cyber/profiler/block_manager.h"
 
+#include <algorithm>
+
+#include "cyber/common/global_data.h"
 #include "cyber/croutine/croutine.h"
+#include "cyber/event/perf_event_cache.h"
+#include "cyber/profiler/block_registry.h"
 
 namespace apollo {
 namespace cyber {
 namespace profiler {
 
-thread_local std::unordered_map<std::string, Frame>
-    BlockManager::routine_frame_map_{};
+thread_local BlockManager::RoutineFrameMap BlockManager::routine_frame_map_{};
+thread_local BlockManager::RoutineId BlockManager::cached_routine_id_ = 0;
+thread_local Frame* BlockManager::cached_frame_ = nullptr;
 
-BlockManager::BlockManager() {}
+BlockManager::BlockManager() {
+  const auto& conf = common::GlobalData::Instance()->Config();
+  if (conf.has_profiler_conf()) {
+    sample_interval_ =
+        std::max(conf.profiler_conf().sample_interval(), std::uint32_t(1));
+    log_frames_ = conf.profiler_conf().log_frames();
+  }
+}
 
 void BlockManager::StartBlock(Block* block) {
   Frame* frame_ptr = GetRoutineFrame();
   if (frame_ptr == nullptr || block == nullptr)
     return;
+  const bool sampled = frame_ptr->finished()
+                           ? frame_ptr->Sample(sample_interval_)
+                           : frame_ptr->sampled();
   frame_ptr->Push(block);
+  if (frame_ptr->Top() != block)
+    return;
   block->set_depth(frame_ptr->size());
-  block->Start();
+  if (sampled)
+    block->Start();
 }
 
 void BlockManager::EndBlock() {
@@ -42,10 +61,19 @@ void BlockManager::EndBlock() {
     return;
 
   Block* block = frame_ptr->Top();
-  block->End();
+  if (block != nullptr) {
+    block->End();
+    if (block->sampled()) {
+      BlockRegistry::Instance()->Record(block->id(), block->duration());
+      event::PerfEventCache::Instance()->AddBlockEvent(
+          block->name(), block->duration(), static_cast<int>(block->depth()));
+      if (log_frames_)
+        frame_ptr->Store(*block);
+    }
+  }
   frame_ptr->Pop();
 
-  if (frame_ptr->finished()) {
+  if (frame_ptr->finished() && frame_ptr->sampled() && log_frames_) {
     const std::string& routine_name = GetRoutineName();
     frame_ptr->DumpToFile(routine_name);
     frame_ptr->Clear();
@@ -61,8 +89,14 @@ std::string BlockManager::GetRoutineName() {
 }
 
 Frame* BlockManager::GetRoutineFrame() {
-  const std::string& routine_name = GetRoutineName();
-  return &routine_frame_map_[routine_name];
+  const auto* routine = croutine::CRoutine::GetCurrentRoutine();
+  const RoutineId routine_id = routine != nullptr ? routine->id() : 0;
+  if (cyber_unlikely(cached_frame_ == nullptr ||
+                     cached_routine_id_ != routine_id)) {
+    cached_frame_ = &routine_frame_map_[routine_id];
+    cached_routine_id_ = routine_id;
+  }
+  return cached_frame_;
 }
 
 }  // namespace profiler
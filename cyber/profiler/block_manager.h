@@ -17,6 +17,7 @@
 #ifndef CYBER_PROFILER_BLOCK_MANAGER_H_
 #define CYBER_PROFILER_BLOCK_MANAGER_H_
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
@@ -30,20 +31,28 @@ namespace profiler {
 
 class BlockManager {
  public:
-  using RoutineName = std::string;
-  using RoutineFrameMap = std::unordered_map<RoutineName, Frame>;
+  using RoutineId = std::uint64_t;
+  using RoutineFrameMap = std::unordered_map<RoutineId, Frame>;
 
  public:
   void StartBlock(Block* block);
 
   void EndBlock();
 
+  std::uint32_t sample_interval() const { return sample_interval_; }
+
  private:
   std::string GetRoutineName();
   Frame* GetRoutineFrame();
 
  private:
+  std::uint32_t sample_interval_ = 1;
+  bool log_frames_ = true;
+
   static thread_local RoutineFrameMap routine_frame_map_;
+  // The frame of the routine which ran the last block on the thread
+  static thread_local RoutineId cached_routine_id_;
+  static thread_local Frame* cached_frame_;
 
   DECLARE_SINGLETON(BlockManager)
 };
@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/profiler/block_registry.h"
+
+#include <algorithm>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace profiler {
+
+using common::GlobalData;
+
+constexpr int BlockHistogram::kBucketNum;
+constexpr uint32_t BlockRegistry::kMaxBlocks;
+constexpr uint32_t BlockRegistry::kInvalidId;
+
+namespace {
+
+int BucketIndex(uint64_t latency_ns) {
+  if (latency_ns < 2) {
+    return 0;
+  }
+  const int index = 63 - __builtin_clzll(latency_ns);
+  return std::min(index, BlockHistogram::kBucketNum - 1);
+}
+
+// Upper bound of the bucket holding the given fraction of the samples
+uint64_t Percentile(const proto::BlockLatency& latency, double fraction) {
+  const uint64_t rank =
+      static_cast<uint64_t>(fraction * static_cast<double>(latency.count()));
+  uint64_t seen = 0;
+  for (int i = 0; i < latency.bucket_size(); ++i) {
+    seen += latency.bucket(i);
+    if (seen > rank) {
+      return std::min(uint64_t(2) << i, latency.max_ns());
+    }
+  }
+  return latency.max_ns();
+}
+
+}  // namespace
+
+void BlockHistogram::Add(uint64_t latency_ns) {
+  buckets_[BucketIndex(latency_ns)].fetch_add(1, std::memory_order_relaxed);
+  total_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+  uint64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+  while (latency_ns > max_ns &&
+         !max_ns_.compare_exchange_weak(max_ns, latency_ns,
+                                        std::memory_order_relaxed)) {
+  }
+  count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BlockHistogram::Fill(proto::BlockLatency* latency) const {
+  int last = -1;
+  std::array<uint64_t, kBucketNum> buckets;
+  uint64_t count = 0;
+  for (int i = 0; i < kBucketNum; ++i) {
+    buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    count += buckets[i];
+    if (buckets[i] > 0) {
+      last = i;
+    }
+  }
+  // the count is the sum of the buckets read, which may be a sample ahead of
+  // the total and the max
+  latency->set_count(count);
+  latency->set_total_ns(total_ns_.load(std::memory_order_relaxed));
+  latency->set_max_ns(max_ns_.load(std::memory_order_relaxed));
+  latency->clear_bucket();
+  for (int i = 0; i <= last; ++i) {
+    latency->add_bucket(buckets[i]);
+  }
+  latency->set_p50_ns(Percentile(*latency, 0.5));
+  latency->set_p99_ns(Percentile(*latency, 0.99));
+}
+
+BlockRegistry::BlockRegistry() {}
+
+uint32_t BlockRegistry::Intern(const std::string& name) {
+  std::lock_guard<std::mutex> lg(mutex_);
+  auto it = ids_.find(name);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+  const uint32_t id = static_cast<uint32_t>(ids_.size());
+  if (id >= kMaxBlocks) {
+    AERROR << "Too many profiler blocks, " << name << " is not profiled";
+    return kInvalidId;
+  }
+  entries_[id].store(new Entry(name), std::memory_order_release);
+  ids_.emplace(name, id);
+  return id;
+}
+
+const std::string& BlockRegistry::Name(uint32_t id) const {
+  static const std::string kUnknown = "unknown_block";
+  const Entry* entry = Get(id);
+  return entry != nullptr ? entry->name : kUnknown;
+}
+
+void BlockRegistry::Record(uint32_t id, uint64_t latency_ns) {
+  Entry* entry = Get(id);
+  if (entry != nullptr) {
+    entry->histogram.Add(latency_ns);
+  }
+}
+
+void BlockRegistry::Collect(proto::ProfilerStats* stats) const {
+  stats->set_timestamp_ns(Time::Now().ToNanosecond());
+  stats->set_process(GlobalData::Instance()->ProcessGroup());
+  stats->set_pid(GlobalData::Instance()->ProcessId());
+  stats->clear_block();
+  for (uint32_t id = 0; id < kMaxBlocks; ++id) {
+    const Entry* entry = Get(id);
+    if (entry == nullptr) {
+      break;
+    }
+    if (entry->histogram.count() == 0) {
+      continue;
+    }
+    auto* latency = stats->add_block();
+    latency->set_name(entry->name);
+    entry->histogram.Fill(latency);
+  }
+}
+
+}  // namespace profiler
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_PROFILER_BLOCK_REGISTRY_H_
+#define CYBER_PROFILER_BLOCK_REGISTRY_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cyber/proto/profiler_stats.pb.h"
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace profiler {
+
+/**
+ * @class BlockHistogram
+ * @brief Latency histogram of a block with power of 2 buckets, updated
+ *        without locks by all the threads running the block.
+ */
+class BlockHistogram {
+ public:
+  static constexpr int kBucketNum = 40;
+
+  void Add(uint64_t latency_ns);
+  void Fill(proto::BlockLatency* latency) const;
+
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> count_ = {0};
+  std::atomic<uint64_t> total_ns_ = {0};
+  std::atomic<uint64_t> max_ns_ = {0};
+  std::array<std::atomic<uint64_t>, kBucketNum> buckets_{};
+};
+
+/**
+ * @class BlockRegistry
+ * @brief Interns the names of the blocks into dense ids, so that profiling a
+ *        block never hashes its name, and keeps the histogram of each id.
+ */
+class BlockRegistry {
+ public:
+  static constexpr uint32_t kMaxBlocks = 4096;
+  static constexpr uint32_t kInvalidId = kMaxBlocks;
+
+  /**
+   * @brief Get the id of a block name, the same name always gets the same id
+   * @return kInvalidId once kMaxBlocks names are interned
+   */
+  uint32_t Intern(const std::string& name);
+
+  const std::string& Name(uint32_t id) const;
+
+  void Record(uint32_t id, uint64_t latency_ns);
+
+  // Fill the latency of all the blocks profiled at least once
+  void Collect(proto::ProfilerStats* stats) const;
+
+ private:
+  struct Entry {
+    explicit Entry(const std::string& block_name) : name(block_name) {}
+    const std::string name;
+    BlockHistogram histogram;
+  };
+
+  Entry* Get(uint32_t id) const {
+    return id < kMaxBlocks ? entries_[id].load(std::memory_order_acquire)
+                           : nullptr;
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, uint32_t> ids_;
+  std::array<std::atomic<Entry*>, kMaxBlocks> entries_{};
+
+  DECLARE_SINGLETON(BlockRegistry)
+};
+
+}  // namespace profiler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_PROFILER_BLOCK_REGISTRY_H_
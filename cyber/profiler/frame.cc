@@ -16,8 +16,6 @@
 
 #include "cyber/profiler/frame.h"
 
-#include <utility>
-
 #include "cyber/common/log.h"
 
 namespace apollo {
@@ -26,26 +24,38 @@ namespace profiler {
 
 constexpr char kModuleName[] = "perf";
 
+constexpr std::uint32_t Frame::kMaxDepth;
+
 void Frame::Push(Block* block) {
-  if (block != nullptr)
-    stack_.push(block);
+  if (block == nullptr)
+    return;
+  if (size_ < kMaxDepth && overflow_.empty()) {
+    stack_[size_++] = block;
+    return;
+  }
+  // Not profiled but still popped once, by PERF_BLOCK_END or else by its
+  // destructor, so that the enclosing blocks end themselves.
+  overflow_.push_back(block);
 }
 
 Block* Frame::Top() {
-  if (stack_.empty())
+  if (size_ == 0 || !overflow_.empty())
     return nullptr;
-  return stack_.top();
+  return stack_[size_ - 1];
 }
 
 void Frame::Pop() {
-  if (stack_.empty())
-    return;
-
-  Block* block_ptr = stack_.top();
-  stack_.pop();
-  storage_.push_back(std::move(*block_ptr));
+  if (!overflow_.empty()) {
+    // ended here as EndBlock does not get it from Top()
+    overflow_.back()->End();
+    overflow_.pop_back();
+  } else if (size_ > 0) {
+    --size_;
+  }
 }
 
+void Frame::Store(const Block& block) { storage_.push_back(block); }
+
 bool Frame::DumpToFile(const std::string& routine_name) {
   // Use 'ALOG_MODULE' instead of 'AINFO' to specify the log file
   ALOG_MODULE(kModuleName, INFO) << "Frame : " << routine_name;
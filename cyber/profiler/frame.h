@@ -17,9 +17,11 @@
 #ifndef CYBER_PROFILER_FRAME_H_
 #define CYBER_PROFILER_FRAME_H_
 
+#include <array>
+#include <cstdint>
 #include <list>
-#include <stack>
 #include <string>
+#include <vector>
 
 #include "cyber/profiler/block.h"
 
@@ -27,20 +29,46 @@ namespace apollo {
 namespace cyber {
 namespace profiler {
 
+/**
+ * @class Frame
+ * @brief The blocks running in a croutine, on a fixed size stack. Blocks
+ *        nested deeper than kMaxDepth are not profiled, they are kept aside
+ *        until they end to keep the stack balanced.
+ */
 class Frame {
  public:
+  static constexpr std::uint32_t kMaxDepth = 64;
+
   void Push(Block* block);
+  // nullptr for a block beyond kMaxDepth
   Block* Top();
   void Pop();
 
+  // Decide if the frame starting with the next top level block is profiled,
+  // one out of interval.
+  bool Sample(std::uint32_t interval) {
+    sampled_ = frame_count_++ % interval == 0;
+    return sampled_;
+  }
+  bool sampled() const { return sampled_; }
+
+  // Keep a profiled block until the frame is dumped
+  void Store(const Block& block);
   bool DumpToFile(const std::string& coroutine_name);
   void Clear();
 
-  std::uint32_t size() const { return stack_.size(); }
-  bool finished() const { return stack_.empty(); }
+  std::uint32_t size() const {
+    return size_ + static_cast<std::uint32_t>(overflow_.size());
+  }
+  bool finished() const { return size() == 0; }
 
  private:
-  std::stack<Block*> stack_;
+  std::array<Block*, kMaxDepth> stack_{};
+  std::uint32_t size_ = 0;
+  // only allocated for blocks beyond kMaxDepth
+  std::vector<Block*> overflow_;
+  std::uint64_t frame_count_ = 0;
+  bool sampled_ = false;
   std::list<Block> storage_;
 };
 
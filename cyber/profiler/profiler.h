@@ -17,8 +17,11 @@
 #ifndef CYBER_PROFILER_PROFILER_H_
 #define CYBER_PROFILER_PROFILER_H_
 
+#include <cstdint>
+
 #include "cyber/profiler/block.h"
 #include "cyber/profiler/block_manager.h"
+#include "cyber/profiler/block_registry.h"
 
 namespace apollo {
 namespace cyber {
@@ -36,10 +39,15 @@ namespace profiler {
 
 #define TOKEN_JOIN(x, y) x ## y
 #define UNIQUE_NAME(x) TOKEN_JOIN(prefix_perf, x)
+#define UNIQUE_ID(x) TOKEN_JOIN(prefix_perf_id, x)
 
-#define PERF_BLOCK(name, ...)                                    \
-  apollo::cyber::profiler::Block UNIQUE_NAME(__LINE__)(name);    \
-  apollo::cyber::profiler::BlockManager::Instance()->StartBlock( \
+// The name of a block is interned on its first run, it must not change
+// between the runs of the block.
+#define PERF_BLOCK(name, ...)                                                \
+  static const std::uint32_t UNIQUE_ID(__LINE__) =                           \
+      apollo::cyber::profiler::BlockRegistry::Instance()->Intern(name);      \
+  apollo::cyber::profiler::Block UNIQUE_NAME(__LINE__)(UNIQUE_ID(__LINE__)); \
+  apollo::cyber::profiler::BlockManager::Instance()->StartBlock(             \
       &UNIQUE_NAME(__LINE__));
 
 #define PERF_BLOCK_END \
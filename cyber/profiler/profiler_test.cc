@@ -14,10 +14,30 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <memory>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "cyber/profiler/profiler.h"
 
+using apollo::cyber::profiler::Block;
+using apollo::cyber::profiler::BlockManager;
+using apollo::cyber::profiler::BlockRegistry;
+using apollo::cyber::profiler::Frame;
+using apollo::cyber::proto::BlockLatency;
+using apollo::cyber::proto::ProfilerStats;
+
+const BlockLatency* FindBlock(const ProfilerStats& stats,
+                              const std::string& name) {
+  for (const auto& block : stats.block()) {
+    if (block.name() == name) {
+      return &block;
+    }
+  }
+  return nullptr;
+}
+
 TEST(ProfilerTest, single_block) {
   PERF_BLOCK("block")
   for (int i = 0; i < 1000; ++i) {
@@ -60,3 +80,124 @@ TEST(ProfilerTest, function) {
   for (int i = 0; i < 1000; ++i) {
   }
 }
+
+TEST(ProfilerTest, block_registry) {
+  auto registry = BlockRegistry::Instance();
+  const uint32_t id = registry->Intern("registry_block");
+  EXPECT_EQ(id, registry->Intern("registry_block"));
+  EXPECT_NE(id, registry->Intern("registry_idle_block"));
+  EXPECT_EQ("registry_block", registry->Name(id));
+  EXPECT_EQ("registry_block", Block(id).name());
+
+  registry->Record(id, 0);
+  registry->Record(id, 1000);
+  registry->Record(id, 3000);
+
+  ProfilerStats stats;
+  registry->Collect(&stats);
+  EXPECT_EQ(nullptr, FindBlock(stats, "registry_idle_block"));
+  const BlockLatency* latency = FindBlock(stats, "registry_block");
+  ASSERT_NE(nullptr, latency);
+  EXPECT_EQ(3, latency->count());
+  EXPECT_EQ(4000, latency->total_ns());
+  EXPECT_EQ(3000, latency->max_ns());
+  ASSERT_EQ(12, latency->bucket_size());
+  EXPECT_EQ(1, latency->bucket(0));
+  EXPECT_EQ(1, latency->bucket(9));
+  EXPECT_EQ(1, latency->bucket(11));
+  EXPECT_EQ(1024, latency->p50_ns());
+  EXPECT_EQ(3000, latency->p99_ns());
+}
+
+TEST(ProfilerTest, block_manager) {
+  auto manager = BlockManager::Instance();
+  ASSERT_EQ(1, manager->sample_interval());
+
+  Block outer("manager_outer_block");
+  manager->StartBlock(&outer);
+  Block inner("manager_inner_block");
+  manager->StartBlock(&inner);
+  EXPECT_EQ(1, outer.depth());
+  EXPECT_EQ(2, inner.depth());
+  EXPECT_TRUE(inner.sampled());
+
+  manager->EndBlock();
+  EXPECT_TRUE(inner.finished());
+  EXPECT_FALSE(outer.finished());
+  manager->EndBlock();
+  EXPECT_TRUE(outer.finished());
+
+  ProfilerStats stats;
+  BlockRegistry::Instance()->Collect(&stats);
+  for (const std::string name :
+       {"manager_outer_block", "manager_inner_block"}) {
+    const BlockLatency* latency = FindBlock(stats, name);
+    ASSERT_NE(nullptr, latency);
+    EXPECT_EQ(1, latency->count());
+  }
+}
+
+TEST(ProfilerTest, block_manager_beyond_max_depth) {
+  auto manager = BlockManager::Instance();
+  const uint32_t id = BlockRegistry::Instance()->Intern("manager_deep_block");
+  std::vector<std::unique_ptr<Block>> blocks;
+  for (uint32_t i = 0; i < Frame::kMaxDepth + 8; ++i) {
+    blocks.emplace_back(new Block(id));
+    manager->StartBlock(blocks.back().get());
+  }
+  EXPECT_EQ(Frame::kMaxDepth, blocks[Frame::kMaxDepth - 1]->depth());
+  EXPECT_TRUE(blocks[Frame::kMaxDepth - 1]->sampled());
+  EXPECT_FALSE(blocks[Frame::kMaxDepth]->sampled());
+
+  // The innermost blocks end either explicitly or when destroyed
+  manager->EndBlock();
+  EXPECT_TRUE(blocks.back()->finished());
+  blocks.pop_back();
+  while (blocks.size() > Frame::kMaxDepth - 1) {
+    EXPECT_FALSE(blocks.back()->finished());
+    blocks.pop_back();
+  }
+  EXPECT_FALSE(blocks.back()->finished());
+  manager->EndBlock();
+  EXPECT_TRUE(blocks.back()->finished());
+  EXPECT_FALSE(blocks.front()->finished());
+  while (!blocks.empty()) {
+    blocks.pop_back();
+  }
+
+  ProfilerStats stats;
+  BlockRegistry::Instance()->Collect(&stats);
+  const BlockLatency* latency = FindBlock(stats, "manager_deep_block");
+  ASSERT_NE(nullptr, latency);
+  EXPECT_EQ(Frame::kMaxDepth, latency->count());
+
+  // balanced again
+  Block next("manager_next_block");
+  manager->StartBlock(&next);
+  EXPECT_EQ(1, next.depth());
+  EXPECT_TRUE(next.sampled());
+}
+
+TEST(ProfilerTest, frame_sample_interval) {
+  Frame frame;
+  std::vector<bool> sampled;
+  for (int i = 0; i < 7; ++i) {
+    sampled.push_back(frame.Sample(3));
+    EXPECT_EQ(sampled.back(), frame.sampled());
+  }
+  EXPECT_EQ(std::vector<bool>({true, false, false, true, false, false, true}),
+            sampled);
+
+  Block outer;
+  Block inner;
+  frame.Push(&outer);
+  frame.Push(&inner);
+  EXPECT_EQ(2, frame.size());
+  EXPECT_EQ(&inner, frame.Top());
+  frame.Pop();
+  frame.Pop();
+  EXPECT_TRUE(frame.finished());
+  // not started by the frame, so they must not end a block when destroyed
+  outer.End();
+  inner.End();
+}
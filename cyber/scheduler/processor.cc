@@ -25,6 +25,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/croutine/croutine.h"
+#include "cyber/event/perf_event_cache.h"
 #include "cyber/time/time.h"
 
 namespace apollo {
@@ -48,7 +49,13 @@ void Processor::Run() {
       if (croutine) {
         snap_shot_->execute_start_time.store(cyber::Time::Now().ToNanosecond());
         snap_shot_->routine_name = croutine->name();
-        croutine->Resume();
+        event::PerfEventCache::Instance()->AddSchedEvent(
+            event::SchedPerf::SWAP_IN, croutine->id(),
+            croutine->processor_id());
+        const auto state = croutine->Resume();
+        event::PerfEventCache::Instance()->AddSchedEvent(
+            event::SchedPerf::SWAP_OUT, croutine->id(),
+            croutine->processor_id(), static_cast<int>(state));
         croutine->Release();
       } else {
         snap_shot_->execute_start_time.store(0);
@@ -25,6 +25,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/util.h"
 #include "cyber/data/data_visitor.h"
+#include "cyber/event/perf_event_cache.h"
 #include "cyber/scheduler/processor.h"
 #include "cyber/scheduler/processor_context.h"
 
@@ -63,6 +64,8 @@ bool Scheduler::CreateTask(std::function<void()>&& func,
       if (cyber_unlikely(stop_.load())) {
         return;
       }
+      event::PerfEventCache::Instance()->AddSchedEvent(
+          event::SchedPerf::NOTIFY_IN, task_id, -1);
       this->NotifyProcessor(task_id);
     });
   }
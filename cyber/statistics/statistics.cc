@@ -115,6 +115,18 @@ StatusVarPtr Statistics::GetTotalMsgsStatusVar(
   return v->second;
 }
 
+ShmVarsPtr Statistics::GetShmVars(const std::string& channel_name) {
+  if (disable_chan_var_) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(shm_vars_mutex_);
+  auto& vars = shm_vars_map_[channel_name];
+  if (vars == nullptr) {
+    vars = std::make_shared<ShmVars>(channel_name);
+  }
+  return vars;
+}
+
 AdderVarPtr Statistics::GetAdderVar(
                       const proto::RoleAttributes& role_attr) {
   auto v = adder_map_.find(GetTotalRecvStatusKey(role_attr));
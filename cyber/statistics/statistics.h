@@ -42,6 +42,24 @@ using LatencyVarPtr = std::shared_ptr<::bvar::LatencyRecorder>;
 using StatusVarPtr = std::shared_ptr<::bvar::Status<uint64_t>>;
 using AdderVarPtr = std::shared_ptr<::bvar::Adder<int32_t>>;
 
+// Shared memory vars of a channel: block_usage is the percentage of the
+// block used by each message written, large_writes the messages written to
+// the large blocks, recreates the times the segment was recreated and
+// overwritten the messages overwritten before this process read them.
+struct ShmVars {
+  explicit ShmVars(const std::string& channel_name)
+      : block_usage(channel_name, "shm-block-usage"),
+        large_writes(channel_name + "-shm-large-writes"),
+        recreates(channel_name + "-shm-recreates"),
+        overwritten(channel_name + "-shm-overwritten") {}
+
+  ::bvar::LatencyRecorder block_usage;
+  ::bvar::Adder<int32_t> large_writes;
+  ::bvar::Adder<int32_t> recreates;
+  ::bvar::Adder<int32_t> overwritten;
+};
+using ShmVarsPtr = std::shared_ptr<ShmVars>;
+
 struct SpanHandler {
   std::string name;
   uint64_t start_time;
@@ -57,6 +75,9 @@ class Statistics {
   ~Statistics() {}
   bool RegisterChanVar(const proto::RoleAttributes& role_attr);
 
+  // The shm vars of a channel, shared by its segments in this process
+  ShmVarsPtr GetShmVars(const std::string& channel_name);
+
   inline bool CreateSpan(std::string name, uint64_t min_ns = 0);
   inline bool StartSpan(std::string name);
   inline bool EndSpan(std::string name);
@@ -248,6 +269,9 @@ class Statistics {
   std::unordered_map<std::string, StatusVarPtr> status_map_;
   std::unordered_map<std::string, AdderVarPtr> adder_map_;
 
+  std::mutex shm_vars_mutex_;
+  std::unordered_map<std::string, ShmVarsPtr> shm_vars_map_;
+
   std::unordered_map<std::string, std::shared_ptr<SpanHandler>> span_handlers_;
 
   bool first_recv_ = true;
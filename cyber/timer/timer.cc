@@ -16,9 +16,8 @@
 
 #include "cyber/timer/timer.h"
 
-#include <cmath>
-
 #include "cyber/common/global_data.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
@@ -61,9 +60,8 @@ bool Timer::InitTimerTask() {
 
   task_.reset(new TimerTask(timer_id_));
   task_->interval_ms = timer_opt_.period;
-  task_->next_fire_duration_ms = task_->interval_ms;
+  std::weak_ptr<TimerTask> task_weak_ptr = task_;
   if (timer_opt_.oneshot) {
-    std::weak_ptr<TimerTask> task_weak_ptr = task_;
     task_->callback = [callback = this->timer_opt_.callback, task_weak_ptr]() {
       auto task = task_weak_ptr.lock();
       if (task) {
@@ -72,54 +70,25 @@ bool Timer::InitTimerTask() {
       }
     };
   } else {
-    std::weak_ptr<TimerTask> task_weak_ptr = task_;
     task_->callback = [callback = this->timer_opt_.callback, task_weak_ptr]() {
       auto task = task_weak_ptr.lock();
       if (!task) {
         return;
       }
       std::lock_guard<std::mutex> lg(task->mutex);
-      auto start = Time::MonoTime().ToNanosecond();
       callback();
-      auto end = Time::MonoTime().ToNanosecond();
-      uint64_t execute_time_ns = end - start;
-      uint64_t execute_time_ms =
-#if defined(__aarch64__)
-          ::llround(static_cast<double>(execute_time_ns) / 1e6);
-#else
-          std::llround(static_cast<double>(execute_time_ns) / 1e6);
-#endif
-      if (task->last_execute_time_ns == 0) {
-        task->last_execute_time_ns = start;
-      } else {
-        task->accumulated_error_ns +=
-            start - task->last_execute_time_ns - task->interval_ms * 1000000;
-      }
-      ADEBUG << "start: " << start << "\t last: " << task->last_execute_time_ns
-             << "\t execut time:" << execute_time_ms
-             << "\t accumulated_error_ns: " << task->accumulated_error_ns;
-      task->last_execute_time_ns = start;
-      if (execute_time_ms >= task->interval_ms) {
-        task->next_fire_duration_ms = TIMER_RESOLUTION_MS;
-      } else {
-#if defined(__aarch64__)
-        int64_t accumulated_error_ms = ::llround(
-#else
-        int64_t accumulated_error_ms = std::llround(
-#endif
-            static_cast<double>(task->accumulated_error_ns) / 1e6);
-        if (static_cast<int64_t>(task->interval_ms - execute_time_ms -
-                                 TIMER_RESOLUTION_MS) >= accumulated_error_ms) {
-          task->next_fire_duration_ms =
-              task->interval_ms - execute_time_ms - accumulated_error_ms;
-        } else {
-          task->next_fire_duration_ms = TIMER_RESOLUTION_MS;
-        }
-        ADEBUG << "error ms: " << accumulated_error_ms
-               << "  execute time: " << execute_time_ms
-               << " next fire: " << task->next_fire_duration_ms
-               << " error ns: " << task->accumulated_error_ns;
+      // the next deadline is anchored to the previous one rather than to the
+      // end of the callback. A callback longer than the period is followed by
+      // an immediate one, the other missed periods are skipped.
+      const uint64_t interval_ns = task->interval_ms * 1000000;
+      const uint64_t now = Time::MonoTime().ToNanosecond();
+      task->deadline_ns += interval_ns;
+      if (task->deadline_ns + interval_ns <= now) {
+        task->deadline_ns +=
+            (now - task->deadline_ns) / interval_ns * interval_ns;
       }
+      ADEBUG << "timer id: " << task->timer_id_
+             << " next deadline: " << task->deadline_ns << " now: " << now;
       TimingWheel::Instance()->AddTask(task);
     };
   }
@@ -133,6 +102,8 @@ void Timer::Start() {
 
   if (!started_.exchange(true)) {
     if (InitTimerTask()) {
+      task_->deadline_ns =
+          Time::MonoTime().ToNanosecond() + task_->interval_ms * 1000000;
       timing_wheel_->AddTask(task_);
       AINFO << "start timer [" << task_->timer_id_ << "]";
     }
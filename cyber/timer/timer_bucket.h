@@ -17,28 +17,81 @@
 #ifndef CYBER_TIMER_TIMER_BUCKET_H_
 #define CYBER_TIMER_TIMER_BUCKET_H_
 
-#include <list>
+#include <atomic>
 #include <memory>
-#include <mutex>
+#include <vector>
 
 #include "cyber/timer/timer_task.h"
 
 namespace apollo {
 namespace cyber {
 
+/**
+ * @class TimerBucket
+ * @brief Slot of the timing wheel, only accessed by the timer thread.
+ */
 class TimerBucket {
  public:
   void AddTask(const std::shared_ptr<TimerTask>& task) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    task_list_.push_back(task);
+    task_list_.emplace_back(task);
   }
 
-  std::mutex& mutex() { return mutex_; }
-  std::list<std::weak_ptr<TimerTask>>& task_list() { return task_list_; }
+  // Take the tasks of the bucket, tasks is expected empty and its storage is
+  // kept by the bucket.
+  void Swap(std::vector<std::weak_ptr<TimerTask>>* tasks) {
+    task_list_.swap(*tasks);
+  }
+
+  bool Empty() const { return task_list_.empty(); }
+
+ private:
+  std::vector<std::weak_ptr<TimerTask>> task_list_;
+};
+
+/**
+ * @class TimerTaskQueue
+ * @brief Lock-free multi producer single consumer queue of the tasks added
+ *        to the timing wheel, consumed by the timer thread.
+ */
+class TimerTaskQueue {
+ public:
+  TimerTaskQueue() = default;
+  ~TimerTaskQueue() {
+    PopAll([](const std::weak_ptr<TimerTask>&) {});
+  }
+
+  void Push(const std::shared_ptr<TimerTask>& task) {
+    Node* node = new Node(task);
+    node->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  // Called by the consumer only, the tasks come in no particular order.
+  template <typename Consumer>
+  void PopAll(Consumer&& consumer) {
+    Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr) {
+      consumer(node->task);
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
 
  private:
-  std::mutex mutex_;
-  std::list<std::weak_ptr<TimerTask>> task_list_;
+  TimerTaskQueue(const TimerTaskQueue&) = delete;
+  TimerTaskQueue& operator=(const TimerTaskQueue&) = delete;
+
+  struct Node {
+    explicit Node(const std::shared_ptr<TimerTask>& t) : task(t) {}
+    std::weak_ptr<TimerTask> task;
+    Node* next = nullptr;
+  };
+
+  std::atomic<Node*> head_ = {nullptr};
 };
 
 }  // namespace cyber
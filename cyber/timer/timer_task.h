@@ -17,6 +17,7 @@
 #ifndef CYBER_TIMER_TIMER_TASK_H_
 #define CYBER_TIMER_TIMER_TASK_H_
 
+#include <cstdint>
 #include <functional>
 #include <mutex>
 
@@ -30,10 +31,9 @@ struct TimerTask {
   uint64_t timer_id_ = 0;
   std::function<void()> callback;
   uint64_t interval_ms = 0;
-  uint64_t remainder_interval_ms = 0;
-  uint64_t next_fire_duration_ms = 0;
-  int64_t accumulated_error_ns = 0;
-  uint64_t last_execute_time_ns = 0;
+  // Monotonic time the task is due at. A periodic task advances it by its
+  // interval, so the period does not drift with the execution time.
+  uint64_t deadline_ns = 0;
   std::mutex mutex;
 };
 
@@ -18,8 +18,11 @@
 
 #include "cyber/timer/timer.h"
 
+#include <atomic>
 #include <memory>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -79,6 +82,52 @@ TEST(TimerTest, start_stop) {
   }
 }
 
+TEST(TimerTest, task_queue) {
+  TimerTaskQueue queue;
+  std::vector<std::shared_ptr<TimerTask>> tasks;
+  for (uint64_t i = 0; i < 4000; i++) {
+    tasks.push_back(std::make_shared<TimerTask>(i));
+  }
+  std::vector<std::thread> producers;
+  for (int i = 0; i < 4; i++) {
+    producers.emplace_back([&queue, &tasks, i]() {
+      for (int j = i * 1000; j < (i + 1) * 1000; j++) {
+        queue.Push(tasks[j]);
+      }
+    });
+  }
+  std::vector<bool> popped(tasks.size(), false);
+  size_t count = 0;
+  auto consume = [&popped, &count](const std::weak_ptr<TimerTask>& task) {
+    auto locked = task.lock();
+    ASSERT_TRUE(locked != nullptr);
+    EXPECT_FALSE(popped[locked->timer_id_]);
+    popped[locked->timer_id_] = true;
+    count++;
+  };
+  while (count < tasks.size() / 2) {
+    queue.PopAll(consume);
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  queue.PopAll(consume);
+  EXPECT_EQ(tasks.size(), count);
+}
+
+TEST(TimerTest, period) {
+  std::atomic<int> count = {0};
+  Timer timer(
+      10, [&count] { count++; }, false);
+  timer.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(1005));
+  timer.Stop();
+  // the periods are anchored to the start of the timer, late callbacks do
+  // not delay the next ones
+  EXPECT_LE(count.load(), 100);
+  EXPECT_GE(count.load(), 90);
+}
+
 TEST(TimerTest, sim_mode) {
   auto count = 0;
 
@@ -16,17 +16,48 @@
 
 #include "cyber/timer/timing_wheel.h"
 
-#include <cmath>
+#include <time.h>
 
+#include <algorithm>
+
+#include "cyber/common/global_data.h"
 #include "cyber/task/task.h"
+#include "cyber/time/time.h"
+#include "cyber/timer/timer_task.h"
 
 namespace apollo {
 namespace cyber {
 
+namespace {
+// Bounds of the resolution of the timer conf
+constexpr uint64_t kMinResolutionUs = 50;
+constexpr uint64_t kMaxResolutionUs = 100000;
+}  // namespace
+
 void TimingWheel::Start() {
   std::lock_guard<std::mutex> lock(running_mutex_);
   if (!running_) {
     ADEBUG << "TimeWheel start ok";
+    // the ticks restart from the current time, the tasks left in the wheel
+    // by a previous run are placed again from their deadlines
+    auto requeue = [this](TimerBucket* bucket) {
+      cascaded_tasks_.clear();
+      bucket->Swap(&cascaded_tasks_);
+      for (const auto& task : cascaded_tasks_) {
+        if (auto locked = task.lock()) {
+          new_tasks_.Push(locked);
+        }
+      }
+      cascaded_tasks_.clear();
+    };
+    for (auto& bucket : work_wheel_) {
+      requeue(&bucket);
+    }
+    for (auto& bucket : assistant_wheel_) {
+      requeue(&bucket);
+    }
+    start_time_ns_ = Time::MonoTime().ToNanosecond();
+    tick_count_ = 0;
     running_ = true;
     tick_thread_ = std::thread([this]() { this->TickFunc(); });
     scheduler::Instance()->SetInnerThreadAttr("timer", &tick_thread_);
@@ -43,105 +74,120 @@ void TimingWheel::Shutdown() {
   }
 }
 
-void TimingWheel::Tick() {
-  auto& bucket = work_wheel_[current_work_wheel_index_];
-  {
-    std::lock_guard<std::mutex> lock(bucket.mutex());
-    auto ite = bucket.task_list().begin();
-    while (ite != bucket.task_list().end()) {
-      auto task = ite->lock();
-      if (task) {
-        ADEBUG << "index: " << current_work_wheel_index_
-               << " timer id: " << task->timer_id_;
-        auto* callback =
-            reinterpret_cast<std::function<void()>*>(&(task->callback));
-        cyber::Async([this, callback] {
-          if (this->running_) {
-            (*callback)();
-          }
-        });
-      }
-      ite = bucket.task_list().erase(ite);
-    }
+void TimingWheel::AddTask(const std::shared_ptr<TimerTask>& task) {
+  if (!running_) {
+    Start();
   }
+  new_tasks_.Push(task);
 }
 
-void TimingWheel::AddTask(const std::shared_ptr<TimerTask>& task) {
-  AddTask(task, current_work_wheel_index_);
+uint64_t TimingWheel::DeadlineTick(const uint64_t time_ns) const {
+  if (time_ns <= start_time_ns_) {
+    return 0;
+  }
+  return (time_ns - start_time_ns_ + resolution_ns_ - 1) / resolution_ns_;
 }
 
-void TimingWheel::AddTask(const std::shared_ptr<TimerTask>& task,
-                          const uint64_t current_work_wheel_index) {
-  if (!running_) {
-    Start();
+void TimingWheel::Schedule(const std::shared_ptr<TimerTask>& task,
+                           const uint64_t tick) {
+  const uint64_t deadline_tick = DeadlineTick(task->deadline_ns);
+  if (deadline_tick <= tick) {
+    Fire(task);
+  } else if (deadline_tick - tick < WORK_WHEEL_SIZE) {
+    work_wheel_[GetWorkWheelIndex(deadline_tick)].AddTask(task);
+  } else {
+    // cascaded into the work wheel when the work wheel reaches the round of
+    // the deadline, tasks more than a full assistant wheel away go around
+    assistant_wheel_[GetAssistantWheelIndex(deadline_tick / WORK_WHEEL_SIZE)]
+        .AddTask(task);
   }
-  auto work_wheel_index = current_work_wheel_index +
-                          static_cast<uint64_t>(std::ceil(
-                              static_cast<double>(task->next_fire_duration_ms) /
-                              TIMER_RESOLUTION_MS));
-  if (work_wheel_index >= WORK_WHEEL_SIZE) {
-    auto real_work_wheel_index = GetWorkWheelIndex(work_wheel_index);
-    task->remainder_interval_ms = real_work_wheel_index;
-    auto assistant_ticks = work_wheel_index / WORK_WHEEL_SIZE;
-    if (assistant_ticks == 1 &&
-        real_work_wheel_index < current_work_wheel_index_) {
-      work_wheel_[real_work_wheel_index].AddTask(task);
-      ADEBUG << "add task to work wheel. index :" << real_work_wheel_index;
-    } else {
-      auto assistant_wheel_index = 0;
-      {
-        std::lock_guard<std::mutex> lock(current_assistant_wheel_index_mutex_);
-        assistant_wheel_index = GetAssistantWheelIndex(
-            current_assistant_wheel_index_ + assistant_ticks);
-        assistant_wheel_[assistant_wheel_index].AddTask(task);
-      }
-      ADEBUG << "add task to assistant wheel. index : "
-             << assistant_wheel_index;
+}
+
+void TimingWheel::Fire(const std::shared_ptr<TimerTask>& task) {
+  ADEBUG << "tick: " << tick_count_ << " timer id: " << task->timer_id_;
+  std::weak_ptr<TimerTask> weak_task = task;
+  cyber::Async([this, weak_task] {
+    auto task = weak_task.lock();
+    if (task && this->running_) {
+      task->callback();
+    }
+  });
+}
+
+void TimingWheel::Tick(const uint64_t tick) {
+  new_tasks_.PopAll([this, tick](const std::weak_ptr<TimerTask>& task) {
+    if (auto locked = task.lock()) {
+      Schedule(locked, tick);
+    }
+  });
+
+  if (GetWorkWheelIndex(tick) == 0) {
+    Cascade(GetAssistantWheelIndex(tick / WORK_WHEEL_SIZE), tick);
+  }
+
+  auto& bucket = work_wheel_[GetWorkWheelIndex(tick)];
+  if (bucket.Empty()) {
+    return;
+  }
+  expired_tasks_.clear();
+  bucket.Swap(&expired_tasks_);
+  for (const auto& task : expired_tasks_) {
+    if (auto locked = task.lock()) {
+      Schedule(locked, tick);
     }
-  } else {
-    work_wheel_[work_wheel_index].AddTask(task);
-    ADEBUG << "add task [" << task->timer_id_
-           << "] to work wheel. index :" << work_wheel_index;
   }
+  expired_tasks_.clear();
 }
 
-void TimingWheel::Cascade(const uint64_t assistant_wheel_index) {
+void TimingWheel::Cascade(const uint64_t assistant_wheel_index,
+                          const uint64_t tick) {
   auto& bucket = assistant_wheel_[assistant_wheel_index];
-  std::lock_guard<std::mutex> lock(bucket.mutex());
-  auto ite = bucket.task_list().begin();
-  while (ite != bucket.task_list().end()) {
-    auto task = ite->lock();
-    if (task) {
-      work_wheel_[task->remainder_interval_ms].AddTask(task);
+  if (bucket.Empty()) {
+    return;
+  }
+  cascaded_tasks_.clear();
+  bucket.Swap(&cascaded_tasks_);
+  for (const auto& task : cascaded_tasks_) {
+    if (auto locked = task.lock()) {
+      Schedule(locked, tick);
     }
-    ite = bucket.task_list().erase(ite);
   }
+  cascaded_tasks_.clear();
 }
 
 void TimingWheel::TickFunc() {
-  Rate rate(TIMER_RESOLUTION_MS * 1000000);  // ms to ns
+  uint64_t tick = tick_count_;
   while (running_) {
-    Tick();
-    // AINFO_EVERY(1000) << "Tick " << TickCount();
-    tick_count_++;
-    rate.Sleep();
-    {
-      std::lock_guard<std::mutex> lock(current_work_wheel_index_mutex_);
-      current_work_wheel_index_ =
-          GetWorkWheelIndex(current_work_wheel_index_ + 1);
-    }
-    if (current_work_wheel_index_ == 0) {
-      {
-        std::lock_guard<std::mutex> lock(current_assistant_wheel_index_mutex_);
-        current_assistant_wheel_index_ =
-            GetAssistantWheelIndex(current_assistant_wheel_index_ + 1);
-      }
-      Cascade(current_assistant_wheel_index_);
+    // sleep until the absolute time of the next tick, so that the ticks do
+    // not drift with the time spent in them
+    const uint64_t next_tick_ns = start_time_ns_ + (tick + 1) * resolution_ns_;
+    struct timespec next_tick_time;
+    next_tick_time.tv_sec = static_cast<time_t>(next_tick_ns / 1000000000);
+    next_tick_time.tv_nsec = static_cast<long>(next_tick_ns % 1000000000);
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_tick_time, nullptr);
+
+    // a late wakeup processes all the ticks missed meanwhile
+    const uint64_t now_ns = Time::MonoTime().ToNanosecond();
+    const uint64_t current_tick = (now_ns - start_time_ns_) / resolution_ns_;
+    while (tick < current_tick) {
+      ++tick;
+      Tick(tick);
     }
+    tick_count_ = tick;
   }
 }
 
-TimingWheel::TimingWheel() {}
+TimingWheel::TimingWheel() {
+  const uint64_t resolution_us = std::min(
+      std::max<uint64_t>(common::GlobalData::Instance()
+                             ->Config()
+                             .timer_conf()
+                             .resolution_us(),
+                         kMinResolutionUs),
+      kMaxResolutionUs);
+  resolution_ns_ = resolution_us * 1000;
+  AINFO << "Timing wheel resolution: " << resolution_us << "us";
+}
 
 }  // namespace cyber
 }  // namespace apollo
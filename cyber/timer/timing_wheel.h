@@ -17,15 +17,15 @@
 #ifndef CYBER_TIMER_TIMING_WHEEL_H_
 #define CYBER_TIMER_TIMING_WHEEL_H_
 
-#include <future>
-#include <list>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
 #include "cyber/scheduler/scheduler_factory.h"
-#include "cyber/time/rate.h"
 #include "cyber/timer/timer_bucket.h"
 
 namespace apollo {
@@ -35,10 +35,15 @@ struct TimerTask;
 
 static const uint64_t WORK_WHEEL_SIZE = 512;
 static const uint64_t ASSISTANT_WHEEL_SIZE = 64;
-static const uint64_t TIMER_RESOLUTION_MS = 2;
-static const uint64_t TIMER_MAX_INTERVAL_MS =
-    WORK_WHEEL_SIZE * ASSISTANT_WHEEL_SIZE * TIMER_RESOLUTION_MS;
-
+static const uint64_t TIMER_MAX_INTERVAL_MS = 65536;
+
+/**
+ * @class TimingWheel
+ * @brief Two level timing wheel ticking every resolution_us of the timer
+ *        conf. Tasks fire at the first tick at or after their deadline_ns.
+ *        The wheel is only touched by the timer thread, AddTask pushes into a
+ *        lock-free queue which the timer thread drains on every tick.
+ */
 class TimingWheel {
  public:
   ~TimingWheel() {
@@ -51,18 +56,10 @@ class TimingWheel {
 
   void Shutdown();
 
-  void Tick();
-
   void AddTask(const std::shared_ptr<TimerTask>& task);
 
-  void AddTask(const std::shared_ptr<TimerTask>& task,
-               const uint64_t current_work_wheel_index);
-
-  void Cascade(const uint64_t assistant_wheel_index);
-
-  void TickFunc();
-
-  inline uint64_t TickCount() const { return tick_count_; }
+  inline uint64_t TickCount() const { return tick_count_.load(); }
+  inline uint64_t ResolutionNs() const { return resolution_ns_; }
 
  private:
   inline uint64_t GetWorkWheelIndex(const uint64_t index) {
@@ -72,15 +69,24 @@ class TimingWheel {
     return index & (ASSISTANT_WHEEL_SIZE - 1);
   }
 
-  bool running_ = false;
-  uint64_t tick_count_ = 0;
+  void TickFunc();
+  void Tick(const uint64_t tick);
+  void Cascade(const uint64_t assistant_wheel_index, const uint64_t tick);
+  void Schedule(const std::shared_ptr<TimerTask>& task, const uint64_t tick);
+  void Fire(const std::shared_ptr<TimerTask>& task);
+  // The first tick at or after the time
+  uint64_t DeadlineTick(const uint64_t time_ns) const;
+
+  std::atomic<bool> running_ = {false};
+  std::atomic<uint64_t> tick_count_ = {0};
   std::mutex running_mutex_;
+  uint64_t resolution_ns_ = 0;
+  uint64_t start_time_ns_ = 0;
+  TimerTaskQueue new_tasks_;
   TimerBucket work_wheel_[WORK_WHEEL_SIZE];
   TimerBucket assistant_wheel_[ASSISTANT_WHEEL_SIZE];
-  uint64_t current_work_wheel_index_ = 0;
-  std::mutex current_work_wheel_index_mutex_;
-  uint64_t current_assistant_wheel_index_ = 0;
-  std::mutex current_assistant_wheel_index_mutex_;
+  std::vector<std::weak_ptr<TimerTask>> expired_tasks_;
+  std::vector<std::weak_ptr<TimerTask>> cascaded_tasks_;
   std::thread tick_thread_;
 
   DECLARE_SINGLETON(TimingWheel)
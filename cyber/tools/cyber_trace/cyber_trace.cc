@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cyber/event/trace_file.h"
+
+void DisplayUsage(const char* binary) {
+  std::cout << "Usage: \n    " << binary
+            << " <output.json> <cyber_perf_*.data>...\n"
+            << "Description: \n"
+            << "    Convert the perf trace files of one or more processes "
+               "into a single Chrome trace JSON timeline, to be opened with "
+               "chrome://tracing or ui.perfetto.dev\n";
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    DisplayUsage(argv[0]);
+    return -1;
+  }
+
+  std::ofstream out(argv[1], std::ios::trunc);
+  if (!out.is_open()) {
+    std::cerr << "Failed to open " << argv[1] << std::endl;
+    return -1;
+  }
+  const std::vector<std::string> trace_files(argv + 2, argv + argc);
+  if (!apollo::cyber::event::ConvertToChromeTrace(trace_files, &out)) {
+    std::cerr << "Failed to convert the trace files" << std::endl;
+    return -1;
+  }
+  std::cout << "Trace written to " << argv[1] << std::endl;
+  return 0;
+}
@@ -26,7 +26,7 @@ const int32_t Block::kRWLockFree = 0;
 const int32_t Block::kWriteExclusive = -1;
 const int32_t Block::kMaxTryLockTimes = 5;
 
-Block::Block() : msg_size_(0), msg_info_size_(0) {}
+Block::Block() : msg_size_(0), msg_info_size_(0), write_seq_(0) {}
 
 Block::~Block() {}
 
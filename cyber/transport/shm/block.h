@@ -39,6 +39,9 @@ class Block {
     msg_info_size_ = msg_info_size;
   }
 
+  // number of the messages written to the block so far
+  uint64_t write_seq() const { return write_seq_; }
+
   static const int32_t kRWLockFree;
   static const int32_t kWriteExclusive;
   static const int32_t kMaxTryLockTimes;
@@ -53,6 +56,7 @@ class Block {
 
   uint64_t msg_size_;
   uint64_t msg_info_size_;
+  uint64_t write_seq_;
 };
 
 }  // namespace transport
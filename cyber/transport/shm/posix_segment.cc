@@ -72,7 +72,9 @@ bool PosixSegment::OpenOrCreate() {
   close(fd);
 
   // create field state_
-  state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
+  state_ = new (managed_shm_) State(conf_.ceiling_msg_size(),
+                                    conf_.large_msg_size(),
+                                    conf_.large_block_num());
   if (state_ == nullptr) {
     AERROR << "create state failed.";
     munmap(managed_shm_, conf_.managed_shm_size());
@@ -81,11 +83,12 @@ bool PosixSegment::OpenOrCreate() {
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  conf_.Update(state_->ceiling_msg_size(), state_->large_msg_size(),
+               state_->large_block_num());
 
   // create field blocks_
   blocks_ = new (static_cast<char*>(managed_shm_) + sizeof(State))
-      Block[conf_.block_num()];
+      Block[conf_.total_block_num()];
   if (blocks_ == nullptr) {
     AERROR << "create blocks failed.";
     state_->~State();
@@ -97,35 +100,7 @@ bool PosixSegment::OpenOrCreate() {
   }
 
   // create block buf
-  uint32_t i = 0;
-  for (; i < conf_.block_num(); ++i) {
-    uint8_t* addr =
-        new (static_cast<char*>(managed_shm_) + sizeof(State) +
-             conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size())
-            uint8_t[conf_.block_buf_size()];
-
-    if (addr == nullptr) {
-      break;
-    }
-
-    std::lock_guard<std::mutex> lg(block_buf_lock_);
-    block_buf_addrs_[i] = addr;
-  }
-
-  if (i != conf_.block_num()) {
-    AERROR << "create block buf failed.";
-    state_->~State();
-    state_ = nullptr;
-    blocks_ = nullptr;
-    {
-      std::lock_guard<std::mutex> lg(block_buf_lock_);
-      block_buf_addrs_.clear();
-    }
-    munmap(managed_shm_, conf_.managed_shm_size());
-    managed_shm_ = nullptr;
-    shm_unlink(shm_name_.c_str());
-    return false;
-  }
+  MapBlockBufs();
 
   state_->IncreaseReferenceCounts();
   init_ = true;
@@ -170,7 +145,8 @@ bool PosixSegment::OpenOnly() {
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  conf_.Update(state_->ceiling_msg_size(), state_->large_msg_size(),
+               state_->large_block_num());
 
   // get field blocks_
   blocks_ = reinterpret_cast<Block*>(static_cast<char*>(managed_shm_) +
@@ -184,30 +160,7 @@ bool PosixSegment::OpenOnly() {
   }
 
   // get block buf
-  uint32_t i = 0;
-  for (; i < conf_.block_num(); ++i) {
-    uint8_t* addr = reinterpret_cast<uint8_t*>(
-        static_cast<char*>(managed_shm_) + sizeof(State) +
-        conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size());
-
-    std::lock_guard<std::mutex> lg(block_buf_lock_);
-    block_buf_addrs_[i] = addr;
-  }
-
-  if (i != conf_.block_num()) {
-    AERROR << "open only failed.";
-    state_->~State();
-    state_ = nullptr;
-    blocks_ = nullptr;
-    {
-      std::lock_guard<std::mutex> lg(block_buf_lock_);
-      block_buf_addrs_.clear();
-    }
-    munmap(managed_shm_, conf_.managed_shm_size());
-    managed_shm_ = nullptr;
-    shm_unlink(shm_name_.c_str());
-    return false;
-  }
+  MapBlockBufs();
 
   state_->IncreaseReferenceCounts();
   init_ = true;
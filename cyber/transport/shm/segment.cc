@@ -16,6 +16,9 @@
 
 #include "cyber/transport/shm/segment.h"
 
+#include <string>
+
+#include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/common/util.h"
 #include "cyber/transport/shm/shm_conf.h"
@@ -32,14 +35,25 @@ Segment::Segment(uint64_t channel_id)
       blocks_(nullptr),
       managed_shm_(nullptr),
       block_buf_lock_(),
-      block_buf_addrs_() {}
+      block_buf_addrs_() {
+  auto channel_name = common::GlobalData::GetChannelById(channel_id);
+  if (channel_name.empty()) {
+    channel_name = std::to_string(channel_id);
+  }
+  shm_vars_ = statistics::Statistics::Instance()->GetShmVars(channel_name);
+}
 
 bool Segment::AcquireBlockToWrite(std::size_t msg_size,
                                   WritableBlock* writable_block) {
   RETURN_VAL_IF_NULL(writable_block, false);
-  if (!init_ && !OpenOrCreate()) {
-    AERROR << "create shm failed, can't write now.";
-    return false;
+  if (!init_) {
+    // a new segment is sized for the first message, an existing one keeps
+    // the size classes it was created with
+    conf_.Update(msg_size);
+    if (!OpenOrCreate()) {
+      AERROR << "create shm failed, can't write now.";
+      return false;
+    }
   }
 
   bool result = true;
@@ -47,11 +61,14 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
     result = Remap();
   }
 
-  if (msg_size > conf_.ceiling_msg_size()) {
+  if (result && msg_size > conf_.max_msg_size()) {
     AINFO << "msg_size: " << msg_size
           << " larger than current shm_buffer_size: "
-          << conf_.ceiling_msg_size() << " , need recreate.";
+          << conf_.max_msg_size() << " , need recreate.";
     result = Recreate(msg_size);
+    if (shm_vars_ != nullptr) {
+      shm_vars_->recreates << 1;
+    }
   }
 
   if (!result) {
@@ -59,7 +76,21 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
     return false;
   }
 
-  uint32_t index = GetNextWritableBlockIndex();
+  uint32_t index = 0;
+  uint64_t block_msg_size = conf_.ceiling_msg_size();
+  if (msg_size > conf_.ceiling_msg_size()) {
+    index = GetNextWritableLargeBlockIndex();
+    block_msg_size = conf_.large_msg_size();
+    if (shm_vars_ != nullptr) {
+      shm_vars_->large_writes << 1;
+    }
+  } else {
+    index = GetNextWritableBlockIndex();
+  }
+  if (shm_vars_ != nullptr) {
+    shm_vars_->block_usage << msg_size * 100 / block_msg_size;
+  }
+  ++blocks_[index].write_seq_;
   writable_block->index = index;
   writable_block->block = &blocks_[index];
   writable_block->buf = block_buf_addrs_[index];
@@ -68,7 +99,7 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
 
 void Segment::ReleaseWrittenBlock(const WritableBlock& writable_block) {
   auto index = writable_block.index;
-  if (index >= conf_.block_num()) {
+  if (index >= conf_.total_block_num()) {
     return;
   }
   blocks_[index].ReleaseWriteLock();
@@ -81,12 +112,6 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
     return false;
   }
 
-  auto index = readable_block->index;
-  if (index >= conf_.block_num()) {
-    AERROR << "invalid block_index[" << index << "].";
-    return false;
-  }
-
   bool result = true;
   if (state_->need_remap()) {
     result = Remap();
@@ -97,9 +122,27 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
     return false;
   }
 
+  auto index = readable_block->index;
+  if (index >= conf_.total_block_num()) {
+    AERROR << "invalid block_index[" << index << "].";
+    return false;
+  }
+
   if (!blocks_[index].TryLockForRead()) {
     return false;
   }
+  // the block was overwritten after the message notified, its current
+  // message was read for the notification of the previous one
+  const uint64_t write_seq = blocks_[index].write_seq_;
+  if (write_seq == read_seqs_[index]) {
+    blocks_[index].ReleaseReadLock();
+    ADEBUG << "block " << index << " was overwritten before read.";
+    if (shm_vars_ != nullptr) {
+      shm_vars_->overwritten << 1;
+    }
+    return false;
+  }
+  read_seqs_[index] = write_seq;
   readable_block->block = blocks_ + index;
   readable_block->buf = block_buf_addrs_[index];
   return true;
@@ -107,7 +150,7 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
 
 void Segment::ReleaseReadBlock(const ReadableBlock& readable_block) {
   auto index = readable_block.index;
-  if (index >= conf_.block_num()) {
+  if (index >= conf_.total_block_num()) {
     return;
   }
   blocks_[index].ReleaseReadLock();
@@ -150,6 +193,17 @@ bool Segment::Recreate(const uint64_t& msg_size) {
   return OpenOrCreate();
 }
 
+void Segment::MapBlockBufs() {
+  uint8_t* bufs = reinterpret_cast<uint8_t*>(managed_shm_) + sizeof(State) +
+                  conf_.total_block_num() * sizeof(Block);
+  std::lock_guard<std::mutex> lg(block_buf_lock_);
+  block_buf_addrs_.clear();
+  for (uint32_t i = 0; i < conf_.total_block_num(); ++i) {
+    block_buf_addrs_[i] = bufs + conf_.block_buf_offset(i);
+  }
+  read_seqs_.assign(conf_.total_block_num(), 0);
+}
+
 uint32_t Segment::GetNextWritableBlockIndex() {
   const auto block_num = conf_.block_num();
   while (1) {
@@ -161,6 +215,19 @@ uint32_t Segment::GetNextWritableBlockIndex() {
   return 0;
 }
 
+uint32_t Segment::GetNextWritableLargeBlockIndex() {
+  const auto block_num = conf_.block_num();
+  const auto large_block_num = conf_.large_block_num();
+  while (1) {
+    uint32_t try_idx =
+        block_num + state_->FetchAddLargeSeq(1) % large_block_num;
+    if (blocks_[try_idx].TryLockForWrite()) {
+      return try_idx;
+    }
+  }
+  return 0;
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -21,7 +21,9 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "cyber/statistics/statistics.h"
 #include "cyber/transport/shm/block.h"
 #include "cyber/transport/shm/shm_conf.h"
 #include "cyber/transport/shm/state.h"
@@ -40,6 +42,13 @@ struct WritableBlock {
 };
 using ReadableBlock = WritableBlock;
 
+/**
+ * @class Segment
+ * @brief Shared memory of a channel, a ring of small blocks sized for the
+ * messages of the channel followed by a few large blocks. Messages larger
+ * than the small blocks are written to the large ones, the segment is only
+ * recreated, and remapped by all its users, for messages larger than both.
+ */
 class Segment {
  public:
   explicit Segment(uint64_t channel_id);
@@ -48,6 +57,12 @@ class Segment {
   bool AcquireBlockToWrite(std::size_t msg_size, WritableBlock* writable_block);
   void ReleaseWrittenBlock(const WritableBlock& writable_block);
 
+  /**
+   * @brief Acquire the block of a message the process was notified of
+   * @return false if the block can not be read, or if it was written again
+   * since this segment last read it, the message notified was then
+   * overwritten before being read
+   */
   bool AcquireBlockToRead(ReadableBlock* readable_block);
   void ReleaseReadBlock(const ReadableBlock& readable_block);
 
@@ -58,6 +73,9 @@ class Segment {
   virtual bool OpenOnly() = 0;
   virtual bool OpenOrCreate() = 0;
 
+  // Fill the addresses of the block buffers once the blocks are mapped
+  void MapBlockBufs();
+
   bool init_;
   ShmConf conf_;
   uint64_t channel_id_;
@@ -72,6 +90,11 @@ class Segment {
   bool Remap();
   bool Recreate(const uint64_t& msg_size);
   uint32_t GetNextWritableBlockIndex();
+  uint32_t GetNextWritableLargeBlockIndex();
+
+  // write_seq of each block when this segment last read it
+  std::vector<uint64_t> read_seqs_;
+  statistics::ShmVarsPtr shm_vars_ = nullptr;
 };
 
 }  // namespace transport
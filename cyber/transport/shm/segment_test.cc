@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/posix_segment.h"
+
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+// a segment sized for messages of 16K has 512 small blocks, followed by 4
+// large blocks for messages up to 1M
+constexpr uint32_t kSmallBlockNum = 512;
+constexpr size_t kLargeMsgSize = 128 * 1024;
+
+bool Write(Segment* segment, const std::string& msg, uint32_t* index) {
+  WritableBlock wb;
+  if (!segment->AcquireBlockToWrite(msg.size(), &wb)) {
+    return false;
+  }
+  std::memcpy(wb.buf, msg.data(), msg.size());
+  wb.block->set_msg_size(msg.size());
+  segment->ReleaseWrittenBlock(wb);
+  *index = wb.index;
+  return true;
+}
+
+bool Read(Segment* segment, uint32_t index, std::string* msg) {
+  ReadableBlock rb;
+  rb.index = index;
+  if (!segment->AcquireBlockToRead(&rb)) {
+    return false;
+  }
+  msg->assign(reinterpret_cast<char*>(rb.buf), rb.block->msg_size());
+  segment->ReleaseReadBlock(rb);
+  return true;
+}
+
+}  // namespace
+
+TEST(SegmentTest, large_block) {
+  PosixSegment writer(0x5E6A);
+  PosixSegment reader(0x5E6A);
+
+  // the first message sizes the small blocks
+  uint32_t small_index = 0;
+  std::string small(1024, 's');
+  EXPECT_TRUE(Write(&writer, small, &small_index));
+  EXPECT_LT(small_index, kSmallBlockNum);
+
+  // larger than the small blocks, written to a large one without recreate
+  uint32_t large_index = 0;
+  std::string large(kLargeMsgSize, 'l');
+  EXPECT_TRUE(Write(&writer, large, &large_index));
+  EXPECT_GE(large_index, kSmallBlockNum);
+
+  std::string msg;
+  EXPECT_TRUE(Read(&reader, small_index, &msg));
+  EXPECT_EQ(small, msg);
+  EXPECT_TRUE(Read(&reader, large_index, &msg));
+  EXPECT_EQ(large, msg);
+}
+
+TEST(SegmentTest, overwritten_before_read) {
+  PosixSegment writer(0x5E6B);
+  PosixSegment reader(0x5E6B);
+
+  // the first message sizes the small blocks
+  uint32_t index = 0;
+  EXPECT_TRUE(Write(&writer, std::string(1024, 's'), &index));
+
+  std::string large(kLargeMsgSize, 'a');
+  uint32_t first_index = 0;
+  EXPECT_TRUE(Write(&writer, large, &first_index));
+  // wrap around the large blocks, overwriting the first one
+  for (int i = 1; i <= 4; ++i) {
+    large.assign(kLargeMsgSize, static_cast<char>('a' + i));
+    EXPECT_TRUE(Write(&writer, large, &index));
+  }
+  EXPECT_EQ(first_index, index);
+
+  // the notification of the last message reads it, the one of the first
+  // message finds the block already read
+  std::string msg;
+  EXPECT_TRUE(Read(&reader, index, &msg));
+  EXPECT_EQ(large, msg);
+  EXPECT_FALSE(Read(&reader, first_index, &msg));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -15,6 +15,8 @@
  *****************************************************************************/
 
 #include "cyber/transport/shm/shm_conf.h"
+
+#include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 
 namespace apollo {
@@ -31,8 +33,33 @@ void ShmConf::Update(const uint64_t& real_msg_size) {
   ceiling_msg_size_ = GetCeilingMessageSize(real_msg_size);
   block_buf_size_ = GetBlockBufSize(ceiling_msg_size_);
   block_num_ = GetBlockNum(ceiling_msg_size_);
+  large_msg_size_ =
+      GetCeilingMessageSize(ceiling_msg_size_ * LARGE_SIZE_RATIO);
+  large_block_num_ =
+      large_msg_size_ > ceiling_msg_size_ ? GetLargeBlockNum() : 0;
+  if (large_block_num_ == 0) {
+    large_msg_size_ = ceiling_msg_size_;
+  }
+  large_block_buf_size_ = GetBlockBufSize(large_msg_size_);
+  UpdateManagedShmSize();
+}
+
+void ShmConf::Update(const uint64_t& ceiling_msg_size,
+                     const uint64_t& large_msg_size,
+                     const uint32_t& large_block_num) {
+  ceiling_msg_size_ = ceiling_msg_size;
+  block_buf_size_ = GetBlockBufSize(ceiling_msg_size_);
+  block_num_ = GetBlockNum(ceiling_msg_size_);
+  large_msg_size_ = large_msg_size;
+  large_block_buf_size_ = GetBlockBufSize(large_msg_size_);
+  large_block_num_ = large_block_num;
+  UpdateManagedShmSize();
+}
+
+void ShmConf::UpdateManagedShmSize() {
   managed_shm_size_ =
-      EXTRA_SIZE + STATE_SIZE + (BLOCK_SIZE + block_buf_size_) * block_num_;
+      EXTRA_SIZE + STATE_SIZE + (BLOCK_SIZE + block_buf_size_) * block_num_ +
+      (BLOCK_SIZE + large_block_buf_size_) * large_block_num_;
 }
 
 const uint64_t ShmConf::EXTRA_SIZE = 1024 * 4;
@@ -58,6 +85,8 @@ const uint64_t ShmConf::MESSAGE_SIZE_16M = 1024 * 1024 * 16;
 const uint32_t ShmConf::BLOCK_NUM_MORE = 8;
 const uint64_t ShmConf::MESSAGE_SIZE_MORE = 1024 * 1024 * 32;
 
+const uint64_t ShmConf::LARGE_SIZE_RATIO = 16;
+
 uint64_t ShmConf::GetCeilingMessageSize(const uint64_t& real_msg_size) {
   uint64_t ceiling_msg_size = MESSAGE_SIZE_16K;
   if (real_msg_size <= MESSAGE_SIZE_16K) {
@@ -80,6 +109,14 @@ uint64_t ShmConf::GetBlockBufSize(const uint64_t& ceiling_msg_size) {
   return ceiling_msg_size + MESSAGE_INFO_SIZE;
 }
 
+uint32_t ShmConf::GetLargeBlockNum() {
+  auto& g_conf = common::GlobalData::Instance()->Config();
+  if (g_conf.has_transport_conf() && g_conf.transport_conf().has_shm_conf()) {
+    return g_conf.transport_conf().shm_conf().large_block_num();
+  }
+  return proto::ShmConf().large_block_num();
+}
+
 uint32_t ShmConf::GetBlockNum(const uint64_t& ceiling_msg_size) {
   uint32_t num = 0;
   switch (ceiling_msg_size) {
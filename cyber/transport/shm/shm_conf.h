@@ -31,21 +31,48 @@ class ShmConf {
   virtual ~ShmConf();
 
   void Update(const uint64_t& real_msg_size);
+  // Update to the size classes of an existing segment
+  void Update(const uint64_t& ceiling_msg_size, const uint64_t& large_msg_size,
+              const uint32_t& large_block_num);
 
   const uint64_t& ceiling_msg_size() { return ceiling_msg_size_; }
   const uint64_t& block_buf_size() { return block_buf_size_; }
   const uint32_t& block_num() { return block_num_; }
   const uint64_t& managed_shm_size() { return managed_shm_size_; }
 
+  const uint64_t& large_msg_size() { return large_msg_size_; }
+  const uint64_t& large_block_buf_size() { return large_block_buf_size_; }
+  const uint32_t& large_block_num() { return large_block_num_; }
+
+  // The small blocks come first, indexes from block_num() are large blocks
+  uint32_t total_block_num() const { return block_num_ + large_block_num_; }
+  // The largest message held without recreating the segment
+  uint64_t max_msg_size() const {
+    return large_block_num_ > 0 ? large_msg_size_ : ceiling_msg_size_;
+  }
+  // Offset of the buffer of a block from the buffer of the first block
+  uint64_t block_buf_offset(const uint32_t index) const {
+    if (index < block_num_) {
+      return index * block_buf_size_;
+    }
+    return block_num_ * block_buf_size_ +
+           (index - block_num_) * large_block_buf_size_;
+  }
+
  private:
   uint64_t GetCeilingMessageSize(const uint64_t& real_msg_size);
   uint64_t GetBlockBufSize(const uint64_t& ceiling_msg_size);
   uint32_t GetBlockNum(const uint64_t& ceiling_msg_size);
+  uint32_t GetLargeBlockNum();
+  void UpdateManagedShmSize();
 
   uint64_t ceiling_msg_size_;
   uint64_t block_buf_size_;
   uint32_t block_num_;
   uint64_t managed_shm_size_;
+  uint64_t large_msg_size_;
+  uint64_t large_block_buf_size_;
+  uint32_t large_block_num_;
 
   // Extra size, Byte
   static const uint64_t EXTRA_SIZE;
@@ -73,6 +100,8 @@ class ShmConf {
   // For message 10M+
   static const uint32_t BLOCK_NUM_MORE;
   static const uint64_t MESSAGE_SIZE_MORE;
+  // The large blocks hold messages up to this ratio of the small ones
+  static const uint64_t LARGE_SIZE_RATIO;
 };
 
 }  // namespace transport
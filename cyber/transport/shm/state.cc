@@ -20,8 +20,11 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
-State::State(const uint64_t& ceiling_msg_size)
-    : ceiling_msg_size_(ceiling_msg_size) {}
+State::State(const uint64_t& ceiling_msg_size, const uint64_t& large_msg_size,
+             const uint32_t& large_block_num)
+    : ceiling_msg_size_(ceiling_msg_size),
+      large_msg_size_(large_msg_size),
+      large_block_num_(large_block_num) {}
 
 State::~State() {}
 
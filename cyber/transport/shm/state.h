@@ -28,7 +28,8 @@ namespace transport {
 
 class State {
  public:
-  explicit State(const uint64_t& ceiling_msg_size);
+  State(const uint64_t& ceiling_msg_size, const uint64_t& large_msg_size,
+        const uint32_t& large_block_num);
   virtual ~State();
 
   void DecreaseReferenceCounts() {
@@ -46,17 +47,27 @@ class State {
   uint32_t FetchAddSeq(uint32_t diff) { return seq_.fetch_add(diff); }
   uint32_t seq() { return seq_.load(); }
 
+  uint32_t FetchAddLargeSeq(uint32_t diff) {
+    return large_seq_.fetch_add(diff);
+  }
+
   void set_need_remap(bool need) { need_remap_.store(need); }
   bool need_remap() { return need_remap_; }
 
   uint64_t ceiling_msg_size() { return ceiling_msg_size_.load(); }
   uint32_t reference_counts() { return reference_count_.load(); }
+  uint64_t large_msg_size() { return large_msg_size_; }
+  uint32_t large_block_num() { return large_block_num_; }
 
  private:
   std::atomic<bool> need_remap_ = {false};
   std::atomic<uint32_t> seq_ = {0};
   std::atomic<uint32_t> reference_count_ = {0};
   std::atomic<uint64_t> ceiling_msg_size_;
+  // the size class of the large blocks, which follow the small ones
+  const uint64_t large_msg_size_;
+  const uint32_t large_block_num_;
+  std::atomic<uint32_t> large_seq_ = {0};
 };
 
 }  // namespace transport
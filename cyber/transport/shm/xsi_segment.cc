@@ -76,7 +76,9 @@ bool XsiSegment::OpenOrCreate() {
   }
 
   // create field state_
-  state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
+  state_ = new (managed_shm_) State(conf_.ceiling_msg_size(),
+                                    conf_.large_msg_size(),
+                                    conf_.large_block_num());
   if (state_ == nullptr) {
     AERROR << "create state failed.";
     shmdt(managed_shm_);
@@ -85,11 +87,12 @@ bool XsiSegment::OpenOrCreate() {
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  conf_.Update(state_->ceiling_msg_size(), state_->large_msg_size(),
+               state_->large_block_num());
 
   // create field blocks_
   blocks_ = new (static_cast<char*>(managed_shm_) + sizeof(State))
-      Block[conf_.block_num()];
+      Block[conf_.total_block_num()];
   if (blocks_ == nullptr) {
     AERROR << "create blocks failed.";
     state_->~State();
@@ -101,31 +104,7 @@ bool XsiSegment::OpenOrCreate() {
   }
 
   // create block buf
-  uint32_t i = 0;
-  for (; i < conf_.block_num(); ++i) {
-    uint8_t* addr =
-        new (static_cast<char*>(managed_shm_) + sizeof(State) +
-             conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size())
-            uint8_t[conf_.block_buf_size()];
-
-    std::lock_guard<std::mutex> _g(block_buf_lock_);
-    block_buf_addrs_[i] = addr;
-  }
-
-  if (i != conf_.block_num()) {
-    AERROR << "create block buf failed.";
-    state_->~State();
-    state_ = nullptr;
-    blocks_ = nullptr;
-    {
-      std::lock_guard<std::mutex> _g(block_buf_lock_);
-      block_buf_addrs_.clear();
-    }
-    shmdt(managed_shm_);
-    managed_shm_ = nullptr;
-    shmctl(shmid, IPC_RMID, 0);
-    return false;
-  }
+  MapBlockBufs();
 
   state_->IncreaseReferenceCounts();
   init_ = true;
@@ -161,7 +140,8 @@ bool XsiSegment::OpenOnly() {
     return false;
   }
 
-  conf_.Update(state_->ceiling_msg_size());
+  conf_.Update(state_->ceiling_msg_size(), state_->large_msg_size(),
+               state_->large_block_num());
 
   // get field blocks_
   blocks_ = reinterpret_cast<Block*>(static_cast<char*>(managed_shm_) +
@@ -175,33 +155,7 @@ bool XsiSegment::OpenOnly() {
   }
 
   // get block buf
-  uint32_t i = 0;
-  for (; i < conf_.block_num(); ++i) {
-    uint8_t* addr = reinterpret_cast<uint8_t*>(
-        static_cast<char*>(managed_shm_) + sizeof(State) +
-        conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size());
-
-    if (addr == nullptr) {
-      break;
-    }
-    std::lock_guard<std::mutex> _g(block_buf_lock_);
-    block_buf_addrs_[i] = addr;
-  }
-
-  if (i != conf_.block_num()) {
-    AERROR << "open only failed.";
-    state_->~State();
-    state_ = nullptr;
-    blocks_ = nullptr;
-    {
-      std::lock_guard<std::mutex> _g(block_buf_lock_);
-      block_buf_addrs_.clear();
-    }
-    shmdt(managed_shm_);
-    managed_shm_ = nullptr;
-    shmctl(shmid, IPC_RMID, 0);
-    return false;
-  }
+  MapBlockBufs();
 
   state_->IncreaseReferenceCounts();
   init_ = true;
@@ -18,3 +18,5 @@
 
 DEFINE_string(bridge_module_name, "Bridge", "Bridge module name");
 DEFINE_double(timeout, 1.0, "receive/send proto msg time out");
+DEFINE_int32(udp_bridge_receive_threads, 2,
+             "threads receiving the frames of an udp bridge receiver");
@@ -93,5 +93,50 @@ TEST(BridgeProtoBufTest, Simple) {
   }
 }
 
+TEST(BridgeProtoBufTest, Reuse) {
+  BridgeProtoDiserializedBuf<planning::ADCTrajectory> proto_recv_buf;
+  // the buffer of a large message is reset and reused for a smaller one
+  for (size_t point_num : {200, 50}) {
+    auto adc_trajectory = std::make_shared<planning::ADCTrajectory>();
+    for (size_t i = 0; i < point_num; ++i) {
+      auto *point = adc_trajectory->add_trajectory_point();
+      point->mutable_path_point()->set_x(static_cast<double>(i));
+    }
+    adc_trajectory->mutable_header()->set_sequence_num(
+        static_cast<uint32_t>(point_num));
+    BridgeProtoSerializedBuf<planning::ADCTrajectory> proto_buf;
+    proto_buf.Serialize(adc_trajectory, "planning::ADCTrajectory");
+
+    proto_recv_buf.Reset();
+    const size_t frame_count = proto_buf.GetSerializedBufCount();
+    // frames arrive in any order
+    for (size_t i = frame_count; i > 0; --i) {
+      const char *frame = proto_buf.GetSerializedBuf(i - 1);
+      const bsize offset =
+          static_cast<bsize>(HEADER_FLAG_SIZE + 1 + sizeof(hsize) + 1);
+      hsize header_size =
+          *(reinterpret_cast<const hsize *>(frame + HEADER_FLAG_SIZE + 1));
+      BridgeHeader header;
+      EXPECT_TRUE(header.Diserialize(frame + offset, header_size - offset));
+      if (!proto_recv_buf.IsTheProto(header)) {
+        EXPECT_TRUE(proto_recv_buf.Initialize(header));
+      }
+      memcpy(proto_recv_buf.GetBuf(header.GetFramePos()), frame + header_size,
+             header.GetFrameSize());
+      proto_recv_buf.UpdateStatus(header.GetIndex());
+      EXPECT_EQ(proto_recv_buf.IsReadyDiserialize(), i == 1);
+    }
+
+    auto pb_msg = std::make_shared<planning::ADCTrajectory>();
+    EXPECT_TRUE(proto_recv_buf.Diserialized(pb_msg));
+    EXPECT_EQ(pb_msg->header().sequence_num(), point_num);
+    ASSERT_EQ(pb_msg->trajectory_point_size(), static_cast<int>(point_num));
+    EXPECT_EQ(pb_msg->trajectory_point(static_cast<int>(point_num) - 1)
+                  .path_point()
+                  .x(),
+              static_cast<double>(point_num - 1));
+  }
+}
+
 }  // namespace bridge
 }  // namespace apollo
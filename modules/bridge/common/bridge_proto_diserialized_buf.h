@@ -36,6 +36,9 @@ class ProtoDiserializedBufBase {
 
   virtual bool Initialize(const BridgeHeader &header,
                           std::shared_ptr<cyber::Node> node) = 0;
+  virtual bool Initialize(const BridgeHeader &header) = 0;
+  // Forget the message to reuse the buffer for another one
+  virtual void Reset() = 0;
 
   virtual bool DiserializedAndPub() = 0;
   virtual bool IsReadyDiserialize() const = 0;
@@ -62,7 +65,8 @@ class BridgeProtoDiserializedBuf : public ProtoDiserializedBufBase {
   virtual void UpdateStatus(uint32_t frame_index);
   virtual bool IsTheProto(const BridgeHeader &header);
 
-  bool Initialize(const BridgeHeader &header);
+  virtual bool Initialize(const BridgeHeader &header);
+  virtual void Reset();
   bool Diserialized(std::shared_ptr<T> proto);
   virtual char *GetBuf(size_t offset) { return proto_buf_ + offset; }
   virtual uint32_t GetMsgID() const { return sequence_num_; }
@@ -74,6 +78,7 @@ class BridgeProtoDiserializedBuf : public ProtoDiserializedBufBase {
   std::string proto_name_ = "";
   std::vector<uint32_t> status_list_;
   char *proto_buf_ = nullptr;
+  size_t proto_buf_capacity_ = 0;
   bool is_ready_diser = false;
   uint32_t sequence_num_ = 0;
   std::shared_ptr<cyber::Writer<T>> writer_;
@@ -104,12 +109,14 @@ void BridgeProtoDiserializedBuf<T>::UpdateStatus(uint32_t frame_index) {
     return;
   }
 
-  status_list_[status_index] |= (1 << (frame_index % INT_BITS));
+  status_list_[status_index] |= (1U << (frame_index % INT_BITS));
+  const uint32_t last_frames = static_cast<uint32_t>(total_frames_ % INT_BITS);
+  const uint32_t last_status =
+      last_frames == 0 ? 0xffffffff : (1U << last_frames) - 1;
   for (size_t i = 0; i < status_size; i++) {
     if (i == status_size - 1) {
-      if (static_cast<int>(status_list_[i]) ==
-          (1 << total_frames_ % INT_BITS) - 1) {
-        AINFO << "diserialized is ready";
+      if (status_list_[i] == last_status) {
+        ADEBUG << "diserialized is ready";
         is_ready_diser = true;
       } else {
         is_ready_diser = false;
@@ -151,17 +158,31 @@ bool BridgeProtoDiserializedBuf<T>::Initialize(const BridgeHeader &header) {
     }
   }
 
-  if (!proto_buf_) {
+  // a reused buffer is only reallocated for a larger message
+  if (!proto_buf_ || proto_buf_capacity_ < total_size_) {
+    FREE_ARRY(proto_buf_);
+    proto_buf_capacity_ = 0;
     try {
       proto_buf_ = new char[total_size_];
     } catch (const std::bad_alloc& e) {
       AERROR << "Memory allocation failed: " << e.what();
       return false;
     }
+    proto_buf_capacity_ = total_size_;
   }
   return true;
 }
 
+template <typename T>
+void BridgeProtoDiserializedBuf<T>::Reset() {
+  total_frames_ = 0;
+  total_size_ = 0;
+  proto_name_.clear();
+  status_list_.clear();
+  is_ready_diser = false;
+  sequence_num_ = 0;
+}
+
 template <typename T>
 bool BridgeProtoDiserializedBuf<T>::Initialize(
     const BridgeHeader &header, std::shared_ptr<cyber::Node> node) {
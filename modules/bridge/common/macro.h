@@ -34,5 +34,7 @@ namespace bridge {
   p = nullptr
 
 constexpr uint32_t FRAME_SIZE = 1024;
+// Buffers of completed messages kept by a receiver for the next ones
+constexpr uint32_t MAX_FREE_BUFS = 8;
 }  // namespace bridge
 }  // namespace apollo
@@ -17,59 +17,68 @@
 #pragma once
 
 #include <arpa/inet.h>
-#include <fcntl.h>
 #include <netinet/in.h>
-#include <pthread.h>
-#include <sys/epoll.h>
-#include <sys/resource.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <sys/types.h>
-#include <sys/wait.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "cyber/common/log.h"
+#include "modules/bridge/common/bridge_gflags.h"
+#include "modules/bridge/common/macro.h"
+
 namespace apollo {
 namespace bridge {
 
-constexpr int MAXEPOLLSIZE = 100;
-
+// Datagrams received by a worker with a single recvmmsg
+constexpr unsigned int RECV_BATCH_SIZE = 64;
+// Largest datagram accepted, a frame and its header
+constexpr size_t RECV_BUF_SIZE = 2 * FRAME_SIZE;
+// Period of the workers checking whether the listener is stopped
+constexpr int RECV_TIMEOUT_MS = 100;
+
+/**
+ * @class UDPListener
+ * @brief Receives the frames on a UDP port with a fixed pool of workers, each
+ *        of them draining the socket by batches with recvmmsg into its own
+ *        buffers, and hands every frame to the receiver.
+ */
 template <typename T>
 class UDPListener {
  public:
-  typedef bool (T::*func)(int fd);
+  typedef bool (T::*func)(const char *buf, size_t size);
   UDPListener() {}
   UDPListener(T *receiver, uint16_t port, func msg_handle) {
     receiver_ = receiver;
     listened_port_ = port;
     msg_handle_ = msg_handle;
   }
-  ~UDPListener() {
-    if (listener_sock_ != -1) {
-      close(listener_sock_);
-    }
-  }
+  ~UDPListener() { Stop(); }
 
   void SetMsgHandle(func msg_handle) { msg_handle_ = msg_handle; }
   bool Initialize(T *receiver, func msg_handle, uint16_t port);
+  // Start the workers, returns at once
   bool Listen();
-
-  static void *pthread_handle_message(void *param);
-
- public:
-  struct Param {
-    int fd_ = 0;
-    UDPListener<T> *listener_ = nullptr;
-  };
+  void Stop();
 
  private:
-  bool setnonblocking(int sockfd);
-  void MessageHandle(int fd);
+  void Receive();
 
  private:
   T *receiver_ = nullptr;
   uint16_t listened_port_ = 0;
   int listener_sock_ = -1;
   func msg_handle_ = nullptr;
-  int kdpfd_ = 0;
+  std::atomic<bool> stop_ = {false};
+  std::vector<std::thread> workers_;
 };
 
 template <typename T>
@@ -84,11 +93,6 @@ bool UDPListener<T>::Initialize(T *receiver, func msg_handle, uint16_t port) {
     return false;
   }
   listened_port_ = port;
-  struct rlimit rt;
-  rt.rlim_max = rt.rlim_cur = MAXEPOLLSIZE;
-  if (setrlimit(RLIMIT_NOFILE, &rt) == -1) {
-    return false;
-  }
 
   listener_sock_ = socket(AF_INET, SOCK_DGRAM, 0);
   if (listener_sock_ == -1) {
@@ -96,7 +100,12 @@ bool UDPListener<T>::Initialize(T *receiver, func msg_handle, uint16_t port) {
   }
   int opt = SO_REUSEADDR;
   setsockopt(listener_sock_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-  setnonblocking(listener_sock_);
+  // the workers block in recvmmsg, the timeout lets them notice Stop()
+  struct timeval timeout;
+  timeout.tv_sec = 0;
+  timeout.tv_usec = RECV_TIMEOUT_MS * 1000;
+  setsockopt(listener_sock_, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+             sizeof(timeout));
 
   struct sockaddr_in serv_addr;
   serv_addr.sin_family = PF_INET;
@@ -105,14 +114,7 @@ bool UDPListener<T>::Initialize(T *receiver, func msg_handle, uint16_t port) {
   if (bind(listener_sock_, (struct sockaddr *)&serv_addr,
            sizeof(struct sockaddr)) == -1) {
     close(listener_sock_);
-    return false;
-  }
-  kdpfd_ = epoll_create(MAXEPOLLSIZE);
-  struct epoll_event ev;
-  ev.events = EPOLLIN | EPOLLET;
-  ev.data.fd = listener_sock_;
-  if (epoll_ctl(kdpfd_, EPOLL_CTL_ADD, listener_sock_, &ev) < 0) {
-    close(listener_sock_);
+    listener_sock_ = -1;
     return false;
   }
   return true;
@@ -120,69 +122,64 @@ bool UDPListener<T>::Initialize(T *receiver, func msg_handle, uint16_t port) {
 
 template <typename T>
 bool UDPListener<T>::Listen() {
-  int nfds = -1;
-  bool res = true;
-  struct epoll_event events[MAXEPOLLSIZE];
-  while (true) {
-    nfds = epoll_wait(kdpfd_, events, 10000, -1);
-    if (nfds == -1) {
-      res = false;
-      break;
-    }
-
-    for (int i = 0; i < nfds; ++i) {
-      if (events[i].data.fd == listener_sock_) {
-        pthread_t thread;
-        pthread_attr_t attr;
-        pthread_attr_init(&attr);
-        pthread_attr_setscope(&attr, PTHREAD_SCOPE_SYSTEM);
-        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
-        Param *par = new Param;
-        par->fd_ = events[i].data.fd;
-        par->listener_ = this;
-        if (pthread_create(&thread, &attr,
-                           &UDPListener<T>::pthread_handle_message,
-                           reinterpret_cast<void *>(par))) {
-          res = false;
-          return res;
-        }
-      }
-    }
-  }
-  close(listener_sock_);
-  return res;
-}
-
-template <typename T>
-bool UDPListener<T>::setnonblocking(int sockfd) {
-  if (fcntl(sockfd, F_SETFL, fcntl(sockfd, F_GETFD, 0) | O_NONBLOCK) == -1) {
+  if (listener_sock_ == -1 || !workers_.empty()) {
     return false;
   }
+  const int worker_num = std::max(FLAGS_udp_bridge_receive_threads, 1);
+  for (int i = 0; i < worker_num; ++i) {
+    workers_.emplace_back(&UDPListener<T>::Receive, this);
+  }
   return true;
 }
 
 template <typename T>
-void *UDPListener<T>::pthread_handle_message(void *param) {
-  Param *par = static_cast<Param *>(param);
-  int fd = par->fd_;
-  UDPListener<T> *listener = par->listener_;
-  if (par) {
-    delete par;
+void UDPListener<T>::Stop() {
+  stop_ = true;
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
   }
-  par = nullptr;
-  if (!listener) {
-    pthread_exit(nullptr);
+  workers_.clear();
+  if (listener_sock_ != -1) {
+    close(listener_sock_);
+    listener_sock_ = -1;
   }
-  listener->MessageHandle(fd);
-  pthread_exit(nullptr);
 }
 
 template <typename T>
-void UDPListener<T>::MessageHandle(int fd) {
-  if (!receiver_ || !msg_handle_) {
-    return;
+void UDPListener<T>::Receive() {
+  std::vector<char> bufs(RECV_BATCH_SIZE * RECV_BUF_SIZE);
+  std::vector<struct iovec> iovecs(RECV_BATCH_SIZE);
+  std::vector<struct mmsghdr> msgs(RECV_BATCH_SIZE);
+  for (unsigned int i = 0; i < RECV_BATCH_SIZE; ++i) {
+    iovecs[i].iov_base = bufs.data() + i * RECV_BUF_SIZE;
+    iovecs[i].iov_len = RECV_BUF_SIZE;
+    memset(&msgs[i], 0, sizeof(msgs[i]));
+    msgs[i].msg_hdr.msg_iov = &iovecs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  while (!stop_.load()) {
+    // blocks until a datagram arrives, then takes the ones already queued
+    int count = recvmmsg(listener_sock_, msgs.data(), RECV_BATCH_SIZE,
+                         MSG_WAITFORONE, nullptr);
+    if (count < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        AERROR << "recvmmsg failed: " << strerror(errno);
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(RECV_TIMEOUT_MS));
+      }
+      continue;
+    }
+    for (int i = 0; i < count; ++i) {
+      if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+        continue;
+      }
+      (receiver_->*msg_handle_)(static_cast<const char *>(iovecs[i].iov_base),
+                                msgs[i].msg_len);
+    }
   }
-  (receiver_->*msg_handle_)(fd);
 }
 
 }  // namespace bridge
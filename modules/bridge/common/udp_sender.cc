@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/bridge/common/udp_sender.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace bridge {
+
+namespace {
+// Largest batch the kernel accepts in a single sendmmsg, UIO_MAXIOV
+constexpr size_t kMaxSendBatch = 1024;
+}  // namespace
+
+bool UDPSender::Connect(const std::string &remote_ip, uint16_t remote_port) {
+  Close();
+  struct sockaddr_in server_addr;
+  memset(&server_addr, 0, sizeof(server_addr));
+  server_addr.sin_addr.s_addr = inet_addr(remote_ip.c_str());
+  server_addr.sin_family = AF_INET;
+  server_addr.sin_port = htons(remote_port);
+
+  int sock_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (sock_fd == -1) {
+    AERROR << "failed to create udp socket: " << strerror(errno);
+    return false;
+  }
+  if (connect(sock_fd, (struct sockaddr *)&server_addr, sizeof(server_addr)) <
+      0) {
+    AERROR << "failed to connect to " << remote_ip << ":" << remote_port
+           << ": " << strerror(errno);
+    close(sock_fd);
+    return false;
+  }
+  sock_fd_ = sock_fd;
+  return true;
+}
+
+void UDPSender::Close() {
+  if (sock_fd_ != -1) {
+    close(sock_fd_);
+    sock_fd_ = -1;
+  }
+}
+
+bool UDPSender::SendFrames(size_t frame_count) {
+  if (sock_fd_ == -1) {
+    return false;
+  }
+  for (size_t i = 0; i < frame_count; ++i) {
+    memset(&msgs_[i], 0, sizeof(msgs_[i]));
+    msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+    msgs_[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  size_t sent = 0;
+  while (sent < frame_count) {
+    const unsigned int batch = static_cast<unsigned int>(
+        std::min(frame_count - sent, kMaxSendBatch));
+    int res = sendmmsg(sock_fd_, &msgs_[sent], batch, 0);
+    if (res < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AERROR_EVERY(100) << "failed to send " << frame_count - sent
+                        << " frames: " << strerror(errno);
+      if (errno != ENOBUFS && errno != EAGAIN) {
+        Close();
+      }
+      return false;
+    }
+    sent += static_cast<size_t>(res);
+  }
+  return true;
+}
+
+}  // namespace bridge
+}  // namespace apollo
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <string>
+#include <vector>
+
+#include "modules/bridge/common/bridge_proto_serialized_buf.h"
+
+namespace apollo {
+namespace bridge {
+
+/**
+ * @class UDPSender
+ * @brief Keeps a connected UDP socket to the remote bridge receiver for the
+ *        lifetime of the sender, and sends all the frames of a message with
+ *        a few sendmmsg calls.
+ */
+class UDPSender {
+ public:
+  UDPSender() {}
+  ~UDPSender() { Close(); }
+
+  bool Connect(const std::string &remote_ip, uint16_t remote_port);
+  bool IsConnected() const { return sock_fd_ != -1; }
+  void Close();
+
+  /**
+   * @brief Send the frames of a serialized message
+   * @return False if not all the frames were sent, the socket is closed on
+   *         errors other than a full send buffer so that the next message
+   *         reconnects
+   */
+  template <typename T>
+  bool Send(const BridgeProtoSerializedBuf<T> &proto_buf);
+
+ private:
+  UDPSender(const UDPSender &) = delete;
+  UDPSender &operator=(const UDPSender &) = delete;
+
+  bool SendFrames(size_t frame_count);
+
+ private:
+  int sock_fd_ = -1;
+  // reused from a message to the next, only grow
+  std::vector<struct iovec> iovecs_;
+  std::vector<struct mmsghdr> msgs_;
+};
+
+template <typename T>
+bool UDPSender::Send(const BridgeProtoSerializedBuf<T> &proto_buf) {
+  const size_t frame_count = proto_buf.GetSerializedBufCount();
+  if (iovecs_.size() < frame_count) {
+    iovecs_.resize(frame_count);
+    msgs_.resize(frame_count);
+  }
+  for (size_t i = 0; i < frame_count; ++i) {
+    iovecs_[i].iov_base = const_cast<char *>(proto_buf.GetSerializedBuf(i));
+    iovecs_[i].iov_len = proto_buf.GetSerializedBufSize(i);
+  }
+  return SendFrames(frame_count);
+}
+
+}  // namespace bridge
+}  // namespace apollo
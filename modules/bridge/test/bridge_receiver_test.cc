@@ -14,22 +14,20 @@
  * limitations under the License.
  *****************************************************************************/
 
-#include <arpa/inet.h>
-#include <fcntl.h>
-#include <netinet/in.h>
-#include <pthread.h>
-#include <sys/epoll.h>
-#include <sys/resource.h>
-#include <sys/socket.h>
-#include <sys/types.h>
-#include <sys/wait.h>
-#include <unistd.h>
-
+#include <atomic>
 #include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #include "modules/common_msgs/chassis_msgs/chassis.pb.h"
+#include "modules/common_msgs/planning_msgs/planning.pb.h"
 
 #include "cyber/common/log.h"
+#include "cyber/time/clock.h"
 #include "modules/bridge/common/bridge_proto_diserialized_buf.h"
 #include "modules/bridge/common/macro.h"
 #include "modules/bridge/common/udp_listener.h"
@@ -40,156 +38,117 @@ using apollo::bridge::BridgeHeader;
 using apollo::bridge::FRAME_SIZE;
 using apollo::bridge::HEADER_FLAG_SIZE;
 using apollo::bridge::hsize;
-using apollo::bridge::MAXEPOLLSIZE;
+using apollo::bridge::ProtoDiserializedBufBase;
+using apollo::bridge::UDPListener;
 using apollo::canbus::Chassis;
+using apollo::cyber::Clock;
+using apollo::planning::ADCTrajectory;
 using BPDBChassis = apollo::bridge::BridgeProtoDiserializedBuf<Chassis>;
+using BPDBTrajectory =
+    apollo::bridge::BridgeProtoDiserializedBuf<ADCTrajectory>;
+
+// Reassembles the Chassis or ADCTrajectory messages of bridge_sender_test
+// and counts them
+class TestReceiver {
+ public:
+  bool MsgHandle(const char *total_buf, size_t bytes) {
+    ADEBUG << "total recv " << bytes;
+    if (bytes < HEADER_FLAG_SIZE + sizeof(hsize) + 2 ||
+        bytes > 2 * FRAME_SIZE) {
+      return false;
+    }
+    if (strncmp(total_buf, BRIDGE_HEADER_FLAG, HEADER_FLAG_SIZE) != 0) {
+      ADEBUG << "header flag not match!";
+      return false;
+    }
+    size_t offset = HEADER_FLAG_SIZE + 1;
+    hsize header_size = *(reinterpret_cast<const hsize *>(total_buf + offset));
+    offset += sizeof(hsize) + 1;
+    if (header_size > FRAME_SIZE || header_size < offset ||
+        header_size > bytes) {
+      ADEBUG << "header size is invalid!";
+      return false;
+    }
 
-void *pthread_handle_message(void *pfd) {
-  struct sockaddr_in client_addr;
-  socklen_t sock_len = static_cast<socklen_t>(sizeof(client_addr));
-  int bytes = 0;
-  int total_recv = 2 * FRAME_SIZE;
-  char total_buf[2 * FRAME_SIZE] = {0};
-  bytes =
-      static_cast<int>(recvfrom(*static_cast<int *>(pfd), total_buf, total_recv,
-                                0, (struct sockaddr *)&client_addr, &sock_len));
-  ADEBUG << "total recv " << bytes;
-  if (bytes <= 0 || bytes > total_recv) {
-    pthread_exit(nullptr);
-  }
-  char header_flag[sizeof(BRIDGE_HEADER_FLAG) + 1] = {0};
-  size_t offset = 0;
-  memcpy(header_flag, total_buf, HEADER_FLAG_SIZE);
-  if (strcmp(header_flag, BRIDGE_HEADER_FLAG) != 0) {
-    ADEBUG << "header flag not match!";
-    pthread_exit(nullptr);
-  }
-  offset += sizeof(BRIDGE_HEADER_FLAG) + 1;
-
-  char header_size_buf[sizeof(hsize) + 1] = {0};
-  const char *cursor = total_buf + offset;
-  memcpy(header_size_buf, cursor, sizeof(hsize));
-  hsize header_size = *(reinterpret_cast<hsize *>(header_size_buf));
-  if (header_size > FRAME_SIZE) {
-    ADEBUG << "header size is more than FRAME_SIZE!";
-    pthread_exit(nullptr);
-  }
-  offset += sizeof(hsize) + 1;
+    BridgeHeader header;
+    if (!header.Diserialize(total_buf + offset, header_size - offset)) {
+      ADEBUG << "header diserialize failed!";
+      return false;
+    }
+    if (header.GetFrameSize() > bytes - header_size ||
+        header.GetFramePos() > header.GetMsgSize() ||
+        header.GetFrameSize() > header.GetMsgSize() - header.GetFramePos()) {
+      return false;
+    }
 
-  BridgeHeader header;
-  size_t buf_size = header_size - offset;
-  cursor = total_buf + offset;
-  if (!header.Diserialize(cursor, buf_size)) {
-    ADEBUG << "header diserialize failed!";
-    pthread_exit(nullptr);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &proto_buf = proto_bufs_[header.GetMsgID()];
+    if (!proto_buf) {
+      if (header.GetMsgName() == "ADCTrajectory") {
+        proto_buf.reset(new BPDBTrajectory());
+      } else {
+        proto_buf.reset(new BPDBChassis());
+      }
+      if (!proto_buf->Initialize(header)) {
+        proto_bufs_.erase(header.GetMsgID());
+        return false;
+      }
+    }
+    memcpy(proto_buf->GetBuf(header.GetFramePos()), total_buf + header_size,
+           header.GetFrameSize());
+    proto_buf->UpdateStatus(header.GetIndex());
+    if (proto_buf->IsReadyDiserialize()) {
+      ++messages_;
+      bytes_ += header.GetMsgSize();
+      // the older messages missed frames, they never complete
+      proto_bufs_.erase(proto_bufs_.begin(),
+                        proto_bufs_.upper_bound(header.GetMsgID()));
+    }
+    return true;
   }
 
-  ADEBUG << "proto name : " << header.GetMsgName().c_str();
-  ADEBUG << "proto sequence num: " << header.GetMsgID();
-  ADEBUG << "proto total frames: " << header.GetTotalFrames();
-  ADEBUG << "proto frame index: " << header.GetIndex();
+  uint64_t messages() const { return messages_.load(); }
+  uint64_t bytes() const { return bytes_.load(); }
 
-  BPDBChassis *proto_buf = new BPDBChassis();
-  proto_buf->Initialize(header);
-  if (!proto_buf) {
-    pthread_exit(nullptr);
-  }
-
-  cursor = total_buf + header_size;
-  char *buf = proto_buf->GetBuf(header.GetFramePos());
-  memcpy(buf, cursor, header.GetFrameSize());
-  proto_buf->UpdateStatus(header.GetIndex());
-  if (proto_buf->IsReadyDiserialize()) {
-    auto pb_msg = std::make_shared<Chassis>();
-    proto_buf->Diserialized(pb_msg);
-    ADEBUG << "sequence num: " << pb_msg->header().sequence_num();
-    ADEBUG << "timestamp sec: " << pb_msg->header().timestamp_sec();
-    ADEBUG << "engine rpm: " << pb_msg->engine_rpm();
-    ADEBUG << "odometer m: " << pb_msg->odometer_m();
-    ADEBUG << "throttle percentage: " << pb_msg->throttle_percentage();
-    ADEBUG << "brake percentage: " << pb_msg->brake_percentage();
-    ADEBUG << "steering percentage: " << pb_msg->steering_percentage();
-    ADEBUG << "steering torque nm: " << pb_msg->steering_torque_nm();
-    ADEBUG << "parking brake: " << pb_msg->parking_brake();
-  }
-  pthread_exit(nullptr);
-}
+ private:
+  std::mutex mutex_;
+  std::map<uint32_t, std::unique_ptr<ProtoDiserializedBufBase>> proto_bufs_;
+  std::atomic<uint64_t> messages_ = {0};
+  std::atomic<uint64_t> bytes_ = {0};
+};
 
 bool receive(uint16_t port) {
-  struct rlimit rt;
-  rt.rlim_max = rt.rlim_cur = MAXEPOLLSIZE;
-  if (setrlimit(RLIMIT_NOFILE, &rt) == -1) {
-    ADEBUG << "set resource limitation failed";
-    return false;
-  }
-
-  int listener_sock = socket(AF_INET, SOCK_DGRAM, 0);
-  if (listener_sock == -1) {
-    ADEBUG << "create socket failed";
+  TestReceiver receiver;
+  UDPListener<TestReceiver> listener;
+  if (!listener.Initialize(&receiver, &TestReceiver::MsgHandle, port)) {
+    AERROR << "bind port " << port << " failed";
     return false;
   }
-  int opt = SO_REUSEADDR;
-  setsockopt(listener_sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-  if (fcntl(listener_sock, F_SETFL,
-            fcntl(listener_sock, F_GETFD, 0) | O_NONBLOCK) == -1) {
-    ADEBUG << "set nonblocking failed";
+  if (!listener.Listen()) {
     return false;
   }
+  AINFO << "Ready!";
 
-  struct sockaddr_in serv_addr;
-  serv_addr.sin_family = PF_INET;
-  serv_addr.sin_port = htons((uint16_t)port);
-  serv_addr.sin_addr.s_addr = INADDR_ANY;
-  if (bind(listener_sock, (struct sockaddr *)&serv_addr,
-           sizeof(struct sockaddr)) == -1) {
-    close(listener_sock);
-    ADEBUG << "bind socket failed";
-    return false;
-  }
-  int kdpfd = epoll_create(MAXEPOLLSIZE);
-  struct epoll_event ev;
-  ev.events = EPOLLIN | EPOLLET;
-  ev.data.fd = listener_sock;
-  if (epoll_ctl(kdpfd, EPOLL_CTL_ADD, listener_sock, &ev) < 0) {
-    ADEBUG << "set control interface for an epoll descriptor failed";
-    close(listener_sock);
-    return false;
-  }
-
-  ADEBUG << "Ready!";
-
-  int nfds = -1;
-  bool res = true;
-  struct epoll_event events[MAXEPOLLSIZE];
+  uint64_t last_messages = 0;
+  uint64_t last_bytes = 0;
+  double last_time = Clock::NowInSeconds();
   while (true) {
-    nfds = epoll_wait(kdpfd, events, 10000, -1);
-    if (nfds == -1) {
-      ADEBUG << "some error occurs while waiting for I/O event";
-      res = false;
-      break;
-    }
-
-    for (int i = 0; i < nfds; ++i) {
-      if (events[i].data.fd == listener_sock) {
-        pthread_t thread;
-        pthread_attr_t attr;
-        pthread_attr_init(&attr);
-        pthread_attr_setscope(&attr, PTHREAD_SCOPE_SYSTEM);
-        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
-        if (pthread_create(&thread, &attr, &pthread_handle_message,
-                           reinterpret_cast<void *>(&events[i].data.fd))) {
-          ADEBUG << "message handler creation failed";
-          res = false;
-          break;
-        }
-      }
-    }
-    if (!res) {
-      break;
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    const double now = Clock::NowInSeconds();
+    const uint64_t messages = receiver.messages();
+    const uint64_t bytes = receiver.bytes();
+    if (messages != last_messages) {
+      AINFO << "received " << messages << " messages, "
+            << (messages - last_messages) / (now - last_time) << " msg/s, "
+            << static_cast<double>(bytes - last_bytes) / (now - last_time) /
+                   1e6
+            << " MB/s";
     }
+    last_messages = messages;
+    last_bytes = bytes;
+    last_time = now;
   }
-  close(listener_sock);
-  return res;
+  return true;
 }
 
 int main(int argc, char *argv[]) {
@@ -14,20 +14,17 @@
  * limitations under the License.
  *****************************************************************************/
 
-#include <arpa/inet.h>
-#include <netinet/in.h>
-#include <sys/socket.h>
-#include <unistd.h>
-
 #include <cstdlib>
 #include <thread>
 
 #include "modules/common_msgs/chassis_msgs/chassis.pb.h"
+#include "modules/common_msgs/planning_msgs/planning.pb.h"
 
 #include "cyber/common/log.h"
 #include "cyber/scheduler/scheduler_factory.h"
 #include "cyber/time/clock.h"
 #include "modules/bridge/common/bridge_proto_serialized_buf.h"
+#include "modules/bridge/common/udp_sender.h"
 
 using apollo::cyber::Clock;
 
@@ -35,6 +32,10 @@ bool send(const std::string &remote_ip, uint16_t remote_port, uint32_t count) {
   if (count == 0) {
     count = 10000;
   }
+  apollo::bridge::UDPSender sender;
+  if (!sender.Connect(remote_ip, remote_port)) {
+    return false;
+  }
   float total = static_cast<float>(count);
   float hundred = 100.00;
   for (uint32_t i = 0; i < count; i++) {
@@ -63,43 +64,73 @@ bool send(const std::string &remote_ip, uint16_t remote_port, uint32_t count) {
     pb_msg->set_error_code(apollo::canbus::Chassis::NO_ERROR);
     pb_msg->set_gear_location(apollo::canbus::Chassis::GEAR_NEUTRAL);
 
-    struct sockaddr_in server_addr;
-    server_addr.sin_addr.s_addr = inet_addr(remote_ip.c_str());
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(remote_port);
+    apollo::bridge::BridgeProtoSerializedBuf<apollo::canbus::Chassis> proto_buf;
+    proto_buf.Serialize(pb_msg, "Chassis");
+    if (!sender.Send(proto_buf) && !sender.IsConnected()) {
+      ADEBUG << "sent msg failed, reconnecting";
+      sender.Connect(remote_ip, remote_port);
+    }
+    ADEBUG << "sent " << proto_buf.GetSerializedBufCount()
+           << " frames to server with sequence num " << i;
 
-    ADEBUG << "connecting to server... ";
+    // 1000Hz
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
 
-    int sock_fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+// Send trajectories of point_num points as fast as possible and report the
+// throughput of the sender
+bool send_trajectory(const std::string &remote_ip, uint16_t remote_port,
+                     uint32_t count, uint32_t point_num) {
+  apollo::bridge::UDPSender sender;
+  if (!sender.Connect(remote_ip, remote_port)) {
+    return false;
+  }
+  auto pb_msg = std::make_shared<apollo::planning::ADCTrajectory>();
+  for (uint32_t j = 0; j < point_num; j++) {
+    auto *point = pb_msg->add_trajectory_point();
+    point->set_relative_time(0.01 * j);
+    point->set_v(10.0);
+    point->mutable_path_point()->set_x(static_cast<double>(j));
+    point->mutable_path_point()->set_y(static_cast<double>(j));
+    point->mutable_path_point()->set_s(static_cast<double>(j));
+  }
 
-    int res =
-        connect(sock_fd, (struct sockaddr *)&server_addr, sizeof(server_addr));
-    if (res < 0) {
-      ADEBUG << "connected server failed ";
+  uint64_t frames = 0;
+  uint64_t bytes = 0;
+  uint32_t failed = 0;
+  const double start = Clock::NowInSeconds();
+  for (uint32_t i = 0; i < count; i++) {
+    pb_msg->mutable_header()->set_sequence_num(i);
+    pb_msg->mutable_header()->set_timestamp_sec(Clock::NowInSeconds());
+    apollo::bridge::BridgeProtoSerializedBuf<apollo::planning::ADCTrajectory>
+        proto_buf;
+    proto_buf.Serialize(pb_msg, "ADCTrajectory");
+    if (!sender.Send(proto_buf)) {
+      ++failed;
+      if (!sender.IsConnected()) {
+        sender.Connect(remote_ip, remote_port);
+      }
       continue;
     }
-
-    ADEBUG << "connected to server success. port [" << remote_port << "]";
-
-    apollo::bridge::BridgeProtoSerializedBuf<apollo::canbus::Chassis> proto_buf;
-    proto_buf.Serialize(pb_msg, "Chassis");
+    frames += proto_buf.GetSerializedBufCount();
     for (size_t j = 0; j < proto_buf.GetSerializedBufCount(); j++) {
-      ssize_t nbytes = send(sock_fd, proto_buf.GetSerializedBuf(j),
-                            proto_buf.GetSerializedBufSize(j), 0);
-      if (nbytes != static_cast<ssize_t>(proto_buf.GetSerializedBufSize(j))) {
-        ADEBUG << "sent msg failed ";
-        break;
-      }
-      ADEBUG << "sent " << nbytes << " bytes to server with sequence num " << i;
+      bytes += proto_buf.GetSerializedBufSize(j);
     }
-    close(sock_fd);
-
-    // 1000Hz
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
   }
+  const double elapsed = Clock::NowInSeconds() - start;
+  AINFO << "sent " << count - failed << " trajectories of "
+        << pb_msg->ByteSizeLong() << " bytes, " << frames << " frames in "
+        << elapsed << " s: " << (count - failed) / elapsed << " msg/s, "
+        << static_cast<double>(bytes) / elapsed / 1e6 << " MB/s, " << failed
+        << " failed";
   return true;
 }
 
+// Usage: bridge_sender_test [count] [trajectory_points]
+// Chassis messages are sent at 1000Hz, or trajectories of trajectory_points
+// points as fast as possible if given
 int main(int argc, char *argv[]) {
   uint32_t count = 0;
   if (argc < 2) {
@@ -108,6 +139,11 @@ int main(int argc, char *argv[]) {
     count = atoi(argv[1]);
     CHECK_LE(count, 20000U);
   }
-  send("127.0.0.1", 8900, count);
+  if (argc > 2) {
+    send_trajectory("127.0.0.1", 8900, count,
+                    static_cast<uint32_t>(atoi(argv[2])));
+  } else {
+    send("127.0.0.1", 8900, count);
+  }
   return 0;
 }
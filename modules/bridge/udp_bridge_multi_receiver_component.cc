@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/bridge/udp_bridge_multi_receiver_component.h"
 
+#include <algorithm>
+
 #include "cyber/time/clock.h"
 #include "modules/bridge/common/bridge_proto_diser_buf_factory.h"
 #include "modules/bridge/common/macro.h"
@@ -26,6 +28,10 @@ namespace bridge {
 UDPBridgeMultiReceiverComponent::UDPBridgeMultiReceiverComponent()
     : monitor_logger_buffer_(common::monitor::MonitorMessageItem::CONTROL) {}
 
+UDPBridgeMultiReceiverComponent::~UDPBridgeMultiReceiverComponent() {
+  listener_->Stop();
+}
+
 bool UDPBridgeMultiReceiverComponent::Init() {
   AINFO << "UDP bridge multi :receiver init, startin...";
   apollo::bridge::UDPBridgeReceiverRemoteInfo udp_bridge_remote;
@@ -64,6 +70,7 @@ UDPBridgeMultiReceiverComponent::CreateBridgeProtoBuf(
         proto_list_.begin();
     for (; itor != proto_list_.end();) {
       if ((*itor)->IsTheProto(header)) {
+        RecycleBuf(*itor);
         itor = proto_list_.erase(itor);
         break;
       }
@@ -78,11 +85,23 @@ UDPBridgeMultiReceiverComponent::CreateBridgeProtoBuf(
     }
   }
 
-  proto_buf = ProtoDiserializedBufBaseFactory::CreateObj(header);
-  if (!proto_buf) {
-    return proto_buf;
+  auto &free_list = free_lists_[header.GetMsgName()];
+  if (!free_list.empty()) {
+    proto_buf = free_list.back();
+    free_list.pop_back();
+    if (!proto_buf->Initialize(header)) {
+      RecycleBuf(proto_buf);
+      return nullptr;
+    }
+  } else {
+    proto_buf = ProtoDiserializedBufBaseFactory::CreateObj(header);
+    if (!proto_buf) {
+      return proto_buf;
+    }
+    if (!proto_buf->Initialize(header, node_)) {
+      return nullptr;
+    }
   }
-  proto_buf->Initialize(header, node_);
   proto_list_.push_back(proto_buf);
   return proto_buf;
 }
@@ -110,15 +129,10 @@ bool UDPBridgeMultiReceiverComponent::IsTimeout(double time_stamp) {
   return false;
 }
 
-bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
-  struct sockaddr_in client_addr;
-  socklen_t sock_len = static_cast<socklen_t>(sizeof(client_addr));
-  int total_recv = 2 * FRAME_SIZE;
-  char total_buf[2 * FRAME_SIZE] = {0};
-  int bytes =
-      static_cast<int>(recvfrom(fd, total_buf, total_recv, 0,
-                                (struct sockaddr *)&client_addr, &sock_len));
-  if (bytes <= 0 || bytes > total_recv) {
+bool UDPBridgeMultiReceiverComponent::MsgHandle(const char *total_buf,
+                                                size_t bytes) {
+  if (bytes < HEADER_FLAG_SIZE + sizeof(hsize) + 2 ||
+      bytes > 2 * FRAME_SIZE) {
     return false;
   }
 
@@ -132,7 +146,8 @@ bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
   hsize header_size = *(reinterpret_cast<const hsize *>(cursor));
   offset += sizeof(hsize) + 1;
 
-  if (header_size < offset || header_size > FRAME_SIZE) {
+  if (header_size < offset || header_size > FRAME_SIZE ||
+      header_size > bytes) {
     AERROR << "header size is more than FRAME_SIZE!";
     return false;
   }
@@ -164,7 +179,7 @@ bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
   char *buf = proto_buf->GetBuf(header.GetFramePos());
   // check cursor size
   if (header.GetFrameSize() < 0 ||
-    header.GetFrameSize() > (total_recv - header_size)) {
+      header.GetFrameSize() > (bytes - header_size)) {
     return false;
   }
   // check buf size
@@ -177,6 +192,7 @@ bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
     proto_buf->DiserializedAndPub();
     RemoveInvalidBuf(proto_buf->GetMsgID(), proto_buf->GetMsgName());
     RemoveItem(&proto_list_, proto_buf);
+    RecycleBuf(proto_buf);
   }
   return true;
 }
@@ -191,6 +207,7 @@ bool UDPBridgeMultiReceiverComponent::RemoveInvalidBuf(
   for (; itor != proto_list_.end();) {
     if ((*itor)->GetMsgID() < msg_id &&
         strcmp((*itor)->GetMsgName().c_str(), msg_name.c_str()) == 0) {
+      RecycleBuf(*itor);
       itor = proto_list_.erase(itor);
       continue;
     }
@@ -199,5 +216,15 @@ bool UDPBridgeMultiReceiverComponent::RemoveInvalidBuf(
   return true;
 }
 
+void UDPBridgeMultiReceiverComponent::RecycleBuf(
+    const std::shared_ptr<ProtoDiserializedBufBase> &proto_buf) {
+  auto &free_list = free_lists_[proto_buf->GetMsgName()];
+  if (free_list.size() >= MAX_FREE_BUFS) {
+    return;
+  }
+  proto_buf->Reset();
+  free_list.push_back(proto_buf);
+}
+
 }  // namespace bridge
 }  // namespace apollo
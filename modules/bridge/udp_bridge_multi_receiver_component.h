@@ -22,6 +22,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "modules/bridge/proto/udp_bridge_remote_info.pb.h"
@@ -43,7 +44,7 @@ namespace bridge {
 class UDPBridgeMultiReceiverComponent final : public cyber::Component<> {
  public:
   UDPBridgeMultiReceiverComponent();
-  ~UDPBridgeMultiReceiverComponent() = default;
+  ~UDPBridgeMultiReceiverComponent();
 
   bool Init() override;
   std::string Name() const { return FLAGS_bridge_module_name; }
@@ -53,10 +54,11 @@ class UDPBridgeMultiReceiverComponent final : public cyber::Component<> {
   bool IsTimeout(double time_stamp);
   void MsgDispatcher();
   bool InitSession(uint16_t port);
-  bool MsgHandle(int fd);
+  bool MsgHandle(const char *buf, size_t size);
 
  private:
   bool RemoveInvalidBuf(uint32_t msg_id, const std::string &msg_name);
+  void RecycleBuf(const std::shared_ptr<ProtoDiserializedBufBase> &proto_buf);
 
  private:
   common::monitor::MonitorLogBuffer monitor_logger_buffer_;
@@ -66,6 +68,10 @@ class UDPBridgeMultiReceiverComponent final : public cyber::Component<> {
   bool enable_timeout_ = true;
   std::mutex mutex_;
   std::vector<std::shared_ptr<ProtoDiserializedBufBase>> proto_list_;
+  // buffers reset for reuse by message name, they keep their writer
+  std::unordered_map<std::string,
+                     std::vector<std::shared_ptr<ProtoDiserializedBufBase>>>
+      free_lists_;
 };
 
 CYBER_REGISTER_COMPONENT(UDPBridgeMultiReceiverComponent)
@@ -16,6 +16,8 @@
 
 #include "modules/bridge/udp_bridge_receiver_component.h"
 
+#include <algorithm>
+
 #include "cyber/time/clock.h"
 #include "modules/bridge/common/macro.h"
 #include "modules/bridge/common/util.h"
@@ -32,9 +34,13 @@ UDPBridgeReceiverComponent<T>::UDPBridgeReceiverComponent()
 
 template <typename T>
 UDPBridgeReceiverComponent<T>::~UDPBridgeReceiverComponent() {
+  listener_->Stop();
   for (auto proto : proto_list_) {
     FREE_POINTER(proto);
   }
+  for (auto proto : free_list_) {
+    FREE_POINTER(proto);
+  }
 }
 
 template <typename T>
@@ -52,6 +58,9 @@ bool UDPBridgeReceiverComponent<T>::Init() {
   ADEBUG << "UDP Bridge remote port is: " << bind_port_;
   ADEBUG << "UDP Bridge for Proto is: " << proto_name_;
   writer_ = node_->CreateWriter<T>(topic_name_.c_str());
+  for (uint32_t i = 0; i < MAX_FREE_BUFS; ++i) {
+    free_list_.push_back(new BridgeProtoDiserializedBuf<T>);
+  }
 
   if (!InitSession((uint16_t)bind_port_)) {
     return false;
@@ -82,8 +91,7 @@ BridgeProtoDiserializedBuf<T>
         proto_list_.begin();
     for (; itor != proto_list_.end();) {
       if ((*itor)->IsTheProto(header)) {
-        BridgeProtoDiserializedBuf<T> *tmp = *itor;
-        FREE_POINTER(tmp);
+        RecycleBuf(*itor);
         itor = proto_list_.erase(itor);
         break;
       }
@@ -97,11 +105,17 @@ BridgeProtoDiserializedBuf<T>
       return proto;
     }
   }
-  BridgeProtoDiserializedBuf<T> *proto_buf = new BridgeProtoDiserializedBuf<T>;
-  if (!proto_buf) {
+  BridgeProtoDiserializedBuf<T> *proto_buf = nullptr;
+  if (free_list_.empty()) {
+    proto_buf = new BridgeProtoDiserializedBuf<T>;
+  } else {
+    proto_buf = free_list_.back();
+    free_list_.pop_back();
+  }
+  if (!proto_buf->Initialize(header)) {
+    RecycleBuf(proto_buf);
     return nullptr;
   }
-  proto_buf->Initialize(header);
   proto_list_.push_back(proto_buf);
   return proto_buf;
 }
@@ -132,17 +146,11 @@ bool UDPBridgeReceiverComponent<T>::IsTimeout(double time_stamp) {
 }
 
 template <typename T>
-bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
-  struct sockaddr_in client_addr;
-  socklen_t sock_len = static_cast<socklen_t>(sizeof(client_addr));
-  int bytes = 0;
-  int total_recv = 2 * FRAME_SIZE;
-  char total_buf[2 * FRAME_SIZE] = {0};
-  bytes =
-      static_cast<int>(recvfrom(fd, total_buf, total_recv, 0,
-                                (struct sockaddr *)&client_addr, &sock_len));
+bool UDPBridgeReceiverComponent<T>::MsgHandle(const char *total_buf,
+                                              size_t bytes) {
   ADEBUG << "total recv " << bytes;
-  if (bytes <= 0 || bytes > total_recv) {
+  if (bytes < HEADER_FLAG_SIZE + sizeof(hsize) + 2 ||
+      bytes > 2 * FRAME_SIZE) {
     return false;
   }
   char header_flag[sizeof(BRIDGE_HEADER_FLAG) + 1] = {0};
@@ -159,7 +167,8 @@ bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
   memcpy(header_size_buf, cursor, sizeof(hsize));
   hsize header_size = *(reinterpret_cast<hsize *>(header_size_buf));
   offset += sizeof(hsize) + 1;
-  if (header_size > FRAME_SIZE || header_size < offset) {
+  if (header_size > FRAME_SIZE || header_size < offset ||
+      header_size > bytes) {
     AINFO << "header size is more than FRAME_SIZE or less than offset!";
     return false;
   }
@@ -190,7 +199,7 @@ bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
   char *buf = proto_buf->GetBuf(header.GetFramePos());
   // check cursor size
   if (header.GetFrameSize() < 0 ||
-    header.GetFrameSize() > (total_recv - header_size)) {
+      header.GetFrameSize() > (bytes - header_size)) {
     return false;
   }
   // check buf size
@@ -204,7 +213,9 @@ bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
     proto_buf->Diserialized(pb_msg);
     writer_->Write(pb_msg);
     RemoveInvalidBuf(proto_buf->GetMsgID());
-    RemoveItem(&proto_list_, proto_buf);
+    proto_list_.erase(
+        std::find(proto_list_.begin(), proto_list_.end(), proto_buf));
+    RecycleBuf(proto_buf);
   }
   return true;
 }
@@ -218,8 +229,7 @@ bool UDPBridgeReceiverComponent<T>::RemoveInvalidBuf(uint32_t msg_id) {
       proto_list_.begin();
   for (; itor != proto_list_.end();) {
     if ((*itor)->GetMsgID() < msg_id) {
-      BridgeProtoDiserializedBuf<T> *tmp = *itor;
-      FREE_POINTER(tmp);
+      RecycleBuf(*itor);
       itor = proto_list_.erase(itor);
       continue;
     }
@@ -228,6 +238,17 @@ bool UDPBridgeReceiverComponent<T>::RemoveInvalidBuf(uint32_t msg_id) {
   return true;
 }
 
+template <typename T>
+void UDPBridgeReceiverComponent<T>::RecycleBuf(
+    BridgeProtoDiserializedBuf<T> *proto_buf) {
+  if (free_list_.size() >= MAX_FREE_BUFS) {
+    FREE_POINTER(proto_buf);
+    return;
+  }
+  proto_buf->Reset();
+  free_list_.push_back(proto_buf);
+}
+
 BRIDGE_RECV_IMPL(canbus::Chassis);
 }  // namespace bridge
 }  // namespace apollo
@@ -43,6 +43,9 @@ bool UDPBridgeSenderComponent<T>::Init() {
   ADEBUG << "UDP Bridge remote ip is: " << remote_ip_;
   ADEBUG << "UDP Bridge remote port is: " << remote_port_;
   ADEBUG << "UDP Bridge for Proto is: " << proto_name_;
+  if (!sender_.Connect(remote_ip_, static_cast<uint16_t>(remote_port_))) {
+    AWARN << "UDP bridge sender failed to connect, retry on next message";
+  }
   return true;
 }
 
@@ -58,31 +61,18 @@ bool UDPBridgeSenderComponent<T>::Proc(const std::shared_ptr<T> &pb_msg) {
     return false;
   }
 
-  struct sockaddr_in server_addr;
-  server_addr.sin_addr.s_addr = inet_addr(remote_ip_.c_str());
-  server_addr.sin_family = AF_INET;
-  server_addr.sin_port = htons(static_cast<uint16_t>(remote_port_));
-  int sock_fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
-
-  int res =
-      connect(sock_fd, (struct sockaddr *)&server_addr, sizeof(server_addr));
-  if (res < 0) {
-    close(sock_fd);
+  BridgeProtoSerializedBuf<T> proto_buf;
+  if (!proto_buf.Serialize(pb_msg, proto_name_)) {
+    AERROR << "serialize proto msg failed!";
     return false;
   }
 
-  BridgeProtoSerializedBuf<T> proto_buf;
-  proto_buf.Serialize(pb_msg, proto_name_);
-  for (size_t j = 0; j < proto_buf.GetSerializedBufCount(); j++) {
-    ssize_t nbytes = send(sock_fd, proto_buf.GetSerializedBuf(j),
-                          proto_buf.GetSerializedBufSize(j), 0);
-    if (nbytes != static_cast<ssize_t>(proto_buf.GetSerializedBufSize(j))) {
-      break;
-    }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!sender_.IsConnected() &&
+      !sender_.Connect(remote_ip_, static_cast<uint16_t>(remote_port_))) {
+    return false;
   }
-  close(sock_fd);
-
-  return true;
+  return sender_.Send(proto_buf);
 }
 
 BRIDGE_IMPL(LocalizationEstimate);
@@ -35,6 +35,7 @@
 #include "cyber/io/session.h"
 #include "cyber/scheduler/scheduler_factory.h"
 #include "modules/bridge/common/bridge_gflags.h"
+#include "modules/bridge/common/udp_sender.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/util/util.h"
 
@@ -60,6 +61,7 @@ class UDPBridgeSenderComponent final : public cyber::Component<T> {
   unsigned int remote_port_ = 0;
   std::string remote_ip_ = "";
   std::string proto_name_ = "";
+  UDPSender sender_;
   std::mutex mutex_;
 };
 
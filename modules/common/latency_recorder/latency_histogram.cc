@@ -0,0 +1,184 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/latency_recorder/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace apollo {
+namespace common {
+
+constexpr uint32_t LatencyHistogram::kSubBucketBits;
+constexpr uint32_t LatencyHistogram::kSubBucketCount;
+
+namespace {
+
+// Buckets of the highest values, up to 2^64 - 1
+constexpr uint32_t kMaxBucketCount =
+    (64 - LatencyHistogram::kSubBucketBits + 1) *
+    LatencyHistogram::kSubBucketCount;
+
+uint32_t HighestBit(uint64_t value) {
+  return 63 - static_cast<uint32_t>(__builtin_clzll(value));
+}
+
+}  // namespace
+
+// Values below kSubBucketCount have a bucket each. Above, a value with its
+// highest bit at position e is in the group e - kSubBucketBits + 1, which
+// splits [2^e, 2^(e+1)) into kSubBucketCount buckets.
+uint32_t LatencyHistogram::BucketIndex(uint64_t value) {
+  if (value < kSubBucketCount) {
+    return static_cast<uint32_t>(value);
+  }
+  const uint32_t shift = HighestBit(value) - kSubBucketBits;
+  const uint32_t sub_bucket =
+      static_cast<uint32_t>(value >> shift) - kSubBucketCount;
+  return (shift + 1) * kSubBucketCount + sub_bucket;
+}
+
+uint64_t LatencyHistogram::BucketLowest(uint32_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  const uint32_t shift = index / kSubBucketCount - 1;
+  const uint64_t mantissa = kSubBucketCount + index % kSubBucketCount;
+  return mantissa << shift;
+}
+
+uint64_t LatencyHistogram::BucketHighest(uint32_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  const uint32_t shift = index / kSubBucketCount - 1;
+  return BucketLowest(index) + ((uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::Record(uint64_t value) {
+  const uint32_t index = BucketIndex(value);
+  if (index >= buckets_.size()) {
+    buckets_.resize(index + 1, 0);
+  }
+  ++buckets_[index];
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+  total_ += value;
+  ++sample_size_;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  if (other.buckets_.size() > buckets_.size()) {
+    buckets_.resize(other.buckets_.size(), 0);
+  }
+  for (size_t i = 0; i < other.buckets_.size(); ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  total_ += other.total_;
+  sample_size_ += other.sample_size_;
+}
+
+bool LatencyHistogram::Merge(const LatencyDistribution& distribution) {
+  if (distribution.sub_bucket_bits() != kSubBucketBits ||
+      distribution.bucket_index_size() != distribution.bucket_count_size()) {
+    return false;
+  }
+  for (int i = 0; i < distribution.bucket_index_size(); ++i) {
+    const uint32_t index = distribution.bucket_index(i);
+    if (index >= kMaxBucketCount) {
+      return false;
+    }
+  }
+  for (int i = 0; i < distribution.bucket_index_size(); ++i) {
+    const uint32_t index = distribution.bucket_index(i);
+    if (index >= buckets_.size()) {
+      buckets_.resize(index + 1, 0);
+    }
+    buckets_[index] += distribution.bucket_count(i);
+  }
+  if (distribution.sample_size() > 0) {
+    min_ = std::min(min_, distribution.min_duration());
+    max_ = std::max(max_, distribution.max_duration());
+  }
+  total_ += distribution.total_duration();
+  sample_size_ += distribution.sample_size();
+  return true;
+}
+
+void LatencyHistogram::Clear() {
+  buckets_.clear();
+  min_ = UINT64_MAX;
+  max_ = 0;
+  total_ = 0;
+  sample_size_ = 0;
+}
+
+void LatencyHistogram::ToProto(LatencyDistribution* distribution) const {
+  distribution->Clear();
+  distribution->set_sub_bucket_bits(kSubBucketBits);
+  for (size_t i = 0; i < buckets_.size(); ++i) {
+    if (buckets_[i] != 0) {
+      distribution->add_bucket_index(static_cast<uint32_t>(i));
+      distribution->add_bucket_count(buckets_[i]);
+    }
+  }
+  if (sample_size_ > 0) {
+    distribution->set_min_duration(min_);
+    distribution->set_max_duration(max_);
+  }
+  distribution->set_total_duration(total_);
+  distribution->set_sample_size(sample_size_);
+}
+
+void LatencyHistogram::ToStat(LatencyStat* stat) const {
+  if (sample_size_ > 0) {
+    stat->set_min_duration(min_);
+  }
+  stat->set_max_duration(max_);
+  stat->set_aver_duration(average());
+  stat->set_sample_size(static_cast<uint32_t>(sample_size_));
+  stat->set_p50_duration(ValueAtPercentile(50.0));
+  stat->set_p90_duration(ValueAtPercentile(90.0));
+  stat->set_p99_duration(ValueAtPercentile(99.0));
+  stat->set_p999_duration(ValueAtPercentile(99.9));
+}
+
+uint64_t LatencyHistogram::ValueAtPercentile(double percentile) const {
+  if (sample_size_ == 0) {
+    return 0;
+  }
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  const uint64_t rank = std::max<uint64_t>(
+      static_cast<uint64_t>(
+          std::ceil(percentile / 100.0 * static_cast<double>(sample_size_))),
+      1);
+  uint64_t count = 0;
+  for (size_t i = 0; i < buckets_.size(); ++i) {
+    count += buckets_[i];
+    if (count >= rank) {
+      // the highest value of the bucket, as HdrHistogram does, within the
+      // values actually recorded
+      const uint64_t value = BucketHighest(static_cast<uint32_t>(i));
+      return std::min(std::max(value, min_), max_);
+    }
+  }
+  return max_;
+}
+
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "modules/common/latency_recorder/proto/latency_record.pb.h"
+
+namespace apollo {
+namespace common {
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of durations, in the spirit of HdrHistogram:
+ *        values are bucketed by their power of 2 and the kSubBucketBits
+ *        following bits, which bounds the relative error of a percentile to
+ *        1 / 2^kSubBucketBits whatever the range. Histograms with the same
+ *        layout are merged by adding their buckets.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr uint32_t kSubBucketBits = 5;
+  static constexpr uint32_t kSubBucketCount = 1 << kSubBucketBits;
+
+  void Record(uint64_t value);
+  void Merge(const LatencyHistogram& other);
+  // False if the distribution has another layout, it is then ignored
+  bool Merge(const LatencyDistribution& distribution);
+  void Clear();
+
+  void ToProto(LatencyDistribution* distribution) const;
+  // Fill the min, max, average, sample size and percentiles of stat
+  void ToStat(LatencyStat* stat) const;
+
+  // The value below which percentile % of the values are, within the
+  // precision of the buckets, 0 if the histogram is empty.
+  uint64_t ValueAtPercentile(double percentile) const;
+
+  bool empty() const { return sample_size_ == 0; }
+  uint64_t sample_size() const { return sample_size_; }
+  uint64_t min() const { return min_; }
+  uint64_t max() const { return max_; }
+  uint64_t average() const {
+    return sample_size_ == 0 ? 0 : total_ / sample_size_;
+  }
+
+  static uint32_t BucketIndex(uint64_t value);
+  // Lowest and highest values of the bucket
+  static uint64_t BucketLowest(uint32_t index);
+  static uint64_t BucketHighest(uint32_t index);
+
+ private:
+  // grown up to the highest bucket recorded
+  std::vector<uint64_t> buckets_;
+  uint64_t min_ = UINT64_MAX;
+  uint64_t max_ = 0;
+  uint64_t total_ = 0;
+  uint64_t sample_size_ = 0;
+};
+
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/latency_recorder/latency_histogram.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+
+TEST(LatencyHistogramTest, BucketBounds) {
+  for (uint64_t value : {0UL, 1UL, 31UL, 32UL, 33UL, 1000UL, 123456789UL,
+                         UINT64_MAX}) {
+    const uint32_t index = LatencyHistogram::BucketIndex(value);
+    EXPECT_LE(LatencyHistogram::BucketLowest(index), value);
+    EXPECT_GE(LatencyHistogram::BucketHighest(index), value);
+  }
+  // the width of a bucket is bounded by 1 / kSubBucketCount of its values
+  const uint32_t index = LatencyHistogram::BucketIndex(123456789UL);
+  EXPECT_LE(LatencyHistogram::BucketHighest(index) -
+                LatencyHistogram::BucketLowest(index),
+            123456789UL / LatencyHistogram::kSubBucketCount);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(UINT64_MAX) + 1,
+            (64 - LatencyHistogram::kSubBucketBits + 1) *
+                LatencyHistogram::kSubBucketCount);
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.ValueAtPercentile(50.0), 0);
+  // 1ms to 1000ms, with one spike of 5s
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.Record(i * 1000000);
+  }
+  histogram.Record(5000000000UL);
+  EXPECT_EQ(histogram.sample_size(), 1001);
+  EXPECT_EQ(histogram.min(), 1000000);
+  EXPECT_EQ(histogram.max(), 5000000000UL);
+
+  const double kTolerance = 1.0 / LatencyHistogram::kSubBucketCount;
+  EXPECT_NEAR(histogram.ValueAtPercentile(50.0), 501e6, 501e6 * kTolerance);
+  EXPECT_NEAR(histogram.ValueAtPercentile(90.0), 901e6, 901e6 * kTolerance);
+  EXPECT_NEAR(histogram.ValueAtPercentile(99.0), 991e6, 991e6 * kTolerance);
+  EXPECT_EQ(histogram.ValueAtPercentile(100.0), 5000000000UL);
+}
+
+TEST(LatencyHistogramTest, MergeDistribution) {
+  LatencyHistogram first;
+  LatencyHistogram second;
+  LatencyHistogram all;
+  for (uint64_t i = 0; i < 500; ++i) {
+    first.Record(i * 997);
+    second.Record(i * 1013 + 7);
+    all.Record(i * 997);
+    all.Record(i * 1013 + 7);
+  }
+
+  LatencyDistribution distribution;
+  second.ToProto(&distribution);
+  EXPECT_LT(distribution.bucket_index_size(), 500);
+  LatencyHistogram merged;
+  merged.Merge(first);
+  EXPECT_TRUE(merged.Merge(distribution));
+
+  EXPECT_EQ(merged.sample_size(), all.sample_size());
+  EXPECT_EQ(merged.min(), all.min());
+  EXPECT_EQ(merged.max(), all.max());
+  EXPECT_EQ(merged.average(), all.average());
+  for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+    EXPECT_EQ(merged.ValueAtPercentile(percentile),
+              all.ValueAtPercentile(percentile));
+  }
+
+  distribution.set_sub_bucket_bits(LatencyHistogram::kSubBucketBits + 1);
+  EXPECT_FALSE(merged.Merge(distribution));
+  EXPECT_EQ(merged.sample_size(), all.sample_size());
+}
+
+}  // namespace common
+}  // namespace apollo
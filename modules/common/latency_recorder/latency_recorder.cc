@@ -63,6 +63,7 @@ void LatencyRecorder::AppendLatencyRecord(const uint64_t message_id,
   latency_record->set_begin_time(begin_time.ToNanosecond());
   latency_record->set_end_time(end_time.ToNanosecond());
   latency_record->set_message_id(message_id);
+  histogram_.Record(end_time.ToNanosecond() - begin_time.ToNanosecond());
 
   const auto now = Clock::Now();
   const apollo::cyber::Duration kPublishInterval(3.0);
@@ -95,6 +96,8 @@ LatencyRecorder::CreateWriter() {
 void LatencyRecorder::PublishLatencyRecords(
     const std::shared_ptr<apollo::cyber::Writer<LatencyRecordMap>>& writer) {
   records_->set_module_name(module_name_);
+  histogram_.ToProto(records_->mutable_latency_distribution());
+  histogram_.Clear();
   apollo::common::util::FillHeader("LatencyRecorderMap", records_.get());
   writer->Write(*records_);
   records_.reset(new LatencyRecordMap);
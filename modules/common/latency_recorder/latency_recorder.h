@@ -22,6 +22,7 @@
 
 #include "cyber/cyber.h"
 
+#include "modules/common/latency_recorder/latency_histogram.h"
 #include "modules/common/latency_recorder/proto/latency_record.pb.h"
 
 namespace apollo {
@@ -44,6 +45,8 @@ class LatencyRecorder {
   std::string module_name_;
   std::mutex mutex_;
   std::unique_ptr<LatencyRecordMap> records_;
+  // latencies since the last publication, published in compact form
+  LatencyHistogram histogram_;
   apollo::cyber::Time current_time_;
   std::shared_ptr<apollo::cyber::Node> node_;
 };
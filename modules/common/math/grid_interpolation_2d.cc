@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/grid_interpolation_2d.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// Piecewise linear curve of a row at y, clamped to its first and last keys
+double InterpolateRow(const std::map<double, double> &row, const double y) {
+  if (y <= row.begin()->first) {
+    return row.begin()->second;
+  }
+  if (y >= row.rbegin()->first) {
+    return row.rbegin()->second;
+  }
+  auto after = row.lower_bound(y);
+  if (after->first == y) {
+    return after->second;
+  }
+  auto before = std::prev(after);
+  const double ratio = (y - before->first) / (after->first - before->first);
+  return before->second * (1.0 - ratio) + after->second * ratio;
+}
+
+}  // namespace
+
+bool GridInterpolation2D::Init(const DataType &xyz) {
+  if (xyz.empty()) {
+    AERROR << "empty input.";
+    return false;
+  }
+  // sorted rows, the last value of a duplicated key is kept
+  std::map<double, std::map<double, double>> rows;
+  for (const auto &t : xyz) {
+    rows[std::get<0>(t)][std::get<1>(t)] = std::get<2>(t);
+  }
+
+  x_axis_.clear();
+  y_axis_.clear();
+  values_.clear();
+  x_cell_ = 0;
+  y_cell_ = 0;
+
+  std::vector<const std::map<double, double> *> grid_rows;
+  for (const auto &row : rows) {
+    x_axis_.push_back(row.first);
+    grid_rows.push_back(&row.second);
+    for (const auto &yz : row.second) {
+      y_axis_.push_back(yz.first);
+    }
+  }
+  std::sort(y_axis_.begin(), y_axis_.end());
+  y_axis_.erase(std::unique(y_axis_.begin(), y_axis_.end()), y_axis_.end());
+
+  // a single key is widened to a cell of constant values
+  if (x_axis_.size() == 1) {
+    x_axis_.push_back(x_axis_.front() + 1.0);
+    grid_rows.push_back(grid_rows.front());
+  }
+  if (y_axis_.size() == 1) {
+    y_axis_.push_back(y_axis_.front() + 1.0);
+  }
+
+  values_.reserve(x_axis_.size() * y_axis_.size());
+  for (const auto *row : grid_rows) {
+    for (const double y : y_axis_) {
+      values_.push_back(InterpolateRow(*row, y));
+    }
+  }
+  AINFO << "Interpolation grid of " << x_axis_.size() << " x "
+        << y_axis_.size() << " from " << xyz.size() << " points";
+  return true;
+}
+
+double GridInterpolation2D::Interpolate(const KeyType &xy) const {
+  const double x =
+      std::min(std::max(xy.first, x_axis_.front()), x_axis_.back());
+  const double y =
+      std::min(std::max(xy.second, y_axis_.front()), y_axis_.back());
+  const size_t i = FindCell(x_axis_, x, &x_cell_);
+  const size_t j = FindCell(y_axis_, y, &y_cell_);
+
+  const double x_ratio = (x - x_axis_[i]) / (x_axis_[i + 1] - x_axis_[i]);
+  const double y_ratio = (y - y_axis_[j]) / (y_axis_[j + 1] - y_axis_[j]);
+  const double *z_before = &values_[i * y_axis_.size() + j];
+  const double *z_after = z_before + y_axis_.size();
+  // weighted sums, exact on both sides of a cell
+  const double z_x_before =
+      z_before[0] * (1.0 - y_ratio) + z_before[1] * y_ratio;
+  const double z_x_after = z_after[0] * (1.0 - y_ratio) + z_after[1] * y_ratio;
+  return z_x_before * (1.0 - x_ratio) + z_x_after * x_ratio;
+}
+
+size_t GridInterpolation2D::FindCell(const std::vector<double> &axis,
+                                     const double value, size_t *hint) {
+  const size_t cell = *hint;
+  if (axis[cell] <= value && value <= axis[cell + 1]) {
+    return cell;
+  }
+  if (cell + 2 < axis.size() && axis[cell + 1] <= value &&
+      value <= axis[cell + 2]) {
+    *hint = cell + 1;
+    return *hint;
+  }
+  if (cell > 0 && axis[cell - 1] <= value && value <= axis[cell]) {
+    *hint = cell - 1;
+    return *hint;
+  }
+  // last cell starting at or before value, by a binary search whose steps
+  // are conditional moves instead of branches
+  const double *first = axis.data();
+  size_t size = axis.size() - 1;
+  while (size > 1) {
+    const size_t half = size / 2;
+    first = first[half] <= value ? first + half : first;
+    size -= half;
+  }
+  *hint = static_cast<size_t>(first - axis.data());
+  return *hint;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Bilinear interpolation on a dense grid.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class GridInterpolation2D
+ *
+ * @brief bilinear interpolation from key (double, double) to one double value
+ * on a dense grid, a drop-in replacement of the map based Interpolation2D of
+ * control.
+ *
+ * The rows of the input, one per x, may have different y keys, such as the
+ * accelerations of a calibration table. Each row is resampled at the union of
+ * all the y keys, where its piecewise linear curve is exact, so the results
+ * are those of the map based Interpolation2D. The cells of the last lookup
+ * are tried first, as the keys move little from one control cycle to the
+ * next; a table is queried by a single thread.
+ */
+class GridInterpolation2D {
+ public:
+  typedef std::vector<std::tuple<double, double, double>> DataType;
+  typedef std::pair<double, double> KeyType;
+
+  GridInterpolation2D() = default;
+
+  /**
+   * @brief initialize GridInterpolation2D internal table
+   * @param xyz passing interpolation initialization table data
+   * @return true if init is ok.
+   */
+  bool Init(const DataType &xyz);
+
+  /**
+   * @brief linear interpolate from 2D key (double, double) to one double value.
+   * Keys out of the table are clamped to its border.
+   */
+  double Interpolate(const KeyType &xy) const;
+
+ private:
+  // Index i of the cell [axis[i], axis[i + 1]] holding value, which is
+  // within the axis; the cell in hint and its neighbours are tried first
+  static size_t FindCell(const std::vector<double> &axis, const double value,
+                         size_t *hint);
+
+  std::vector<double> x_axis_;
+  std::vector<double> y_axis_;
+  // value at (x_axis_[i], y_axis_[j]) in values_[i * y_axis_.size() + j]
+  std::vector<double> values_;
+
+  mutable size_t x_cell_ = 0;
+  mutable size_t y_cell_ = 0;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/grid_interpolation_2d.h"
+
+#include <tuple>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+TEST(GridInterpolation2DTest, normal) {
+  GridInterpolation2D::DataType xyz{std::make_tuple(0.3, 0.2, 0.6),
+                                    std::make_tuple(10.1, 15.2, 5.5),
+                                    std::make_tuple(20.2, 10.3, 30.5)};
+
+  GridInterpolation2D estimator;
+  EXPECT_TRUE(estimator.Init(xyz));
+
+  for (unsigned i = 0; i < xyz.size(); i++) {
+    EXPECT_DOUBLE_EQ(std::get<2>(xyz[i]),
+                     estimator.Interpolate(std::make_pair(
+                         std::get<0>(xyz[i]), std::get<1>(xyz[i]))));
+  }
+
+  EXPECT_DOUBLE_EQ(4.7000000000000002,
+                   estimator.Interpolate(std::make_pair(8.5, 14)));
+  EXPECT_DOUBLE_EQ(26.292079207920793,
+                   estimator.Interpolate(std::make_pair(18.5, 12)));
+
+  // out of range
+  EXPECT_DOUBLE_EQ(0.59999999999999998,
+                   estimator.Interpolate(std::make_pair(-5, 12)));
+  EXPECT_DOUBLE_EQ(30.5, estimator.Interpolate(std::make_pair(30, 12)));
+  EXPECT_DOUBLE_EQ(30.5, estimator.Interpolate(std::make_pair(30, -0.5)));
+  EXPECT_DOUBLE_EQ(5.4500000000000002,
+                   estimator.Interpolate(std::make_pair(10, -0.5)));
+  EXPECT_DOUBLE_EQ(5.4500000000000002,
+                   estimator.Interpolate(std::make_pair(10, 40)));
+  EXPECT_DOUBLE_EQ(30.5, estimator.Interpolate(std::make_pair(40, 40)));
+}
+
+TEST(GridInterpolation2DTest, single_point) {
+  GridInterpolation2D::DataType xyz{std::make_tuple(1.0, 2.0, 3.0)};
+
+  GridInterpolation2D estimator;
+  EXPECT_TRUE(estimator.Init(xyz));
+  EXPECT_DOUBLE_EQ(3.0, estimator.Interpolate(std::make_pair(1.0, 2.0)));
+  EXPECT_DOUBLE_EQ(3.0, estimator.Interpolate(std::make_pair(-5.0, 12.0)));
+  EXPECT_DOUBLE_EQ(3.0, estimator.Interpolate(std::make_pair(1.5, 2.5)));
+}
+
+// Each row is linear between its own keys, clamped beyond them.
+TEST(GridInterpolation2DTest, rows_with_different_keys) {
+  GridInterpolation2D::DataType xyz{
+      std::make_tuple(0.0, 0.0, 0.0), std::make_tuple(0.0, 2.0, 2.0),
+      std::make_tuple(1.0, 1.0, 10.0), std::make_tuple(1.0, 3.0, 30.0)};
+
+  GridInterpolation2D estimator;
+  EXPECT_TRUE(estimator.Init(xyz));
+  EXPECT_DOUBLE_EQ(1.0, estimator.Interpolate(std::make_pair(0.0, 1.0)));
+  EXPECT_DOUBLE_EQ(2.0, estimator.Interpolate(std::make_pair(0.0, 2.5)));
+  EXPECT_DOUBLE_EQ(10.0, estimator.Interpolate(std::make_pair(1.0, 0.5)));
+  EXPECT_DOUBLE_EQ(20.0, estimator.Interpolate(std::make_pair(1.0, 2.0)));
+  EXPECT_DOUBLE_EQ(8.25, estimator.Interpolate(std::make_pair(0.5, 1.5)));
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
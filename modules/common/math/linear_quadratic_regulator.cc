@@ -16,6 +16,8 @@
 
 #include "modules/common/math/linear_quadratic_regulator.h"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
 #include "Eigen/Dense"
@@ -82,6 +84,68 @@ void SolveLQRProblem(const Matrix &A, const Matrix &B, const Matrix &Q,
                   iterate_num, result_diff);
 }
 
+bool LqrGainTable::Build(const double min_value, const double max_value,
+                         const double step, const SystemFunction &system,
+                         const Matrix &R, const double tolerance,
+                         const uint max_num_iteration) {
+  gains_.clear();
+  if (step <= 0.0 || max_value < min_value) {
+    AERROR << "LQR gain table: invalid range [" << min_value << ", "
+           << max_value << "] with step " << step;
+    return false;
+  }
+  min_value_ = min_value;
+  max_value_ = max_value;
+  step_ = step;
+  // The last step is shorter when the range is not a multiple of step, it
+  // ends on max_value. The tolerance keeps rounding from adding a step.
+  const size_t size =
+      static_cast<size_t>(std::ceil((max_value - min_value) / step - 1e-9)) +
+      1;
+  gains_.reserve(size);
+
+  Matrix A;
+  Matrix B;
+  Matrix Q;
+  uint not_converged = 0;
+  for (size_t i = 0; i < size; ++i) {
+    system(std::min(min_value + step * static_cast<double>(i), max_value), &A,
+           &B, &Q);
+    Matrix K;
+    uint num_iteration = 0;
+    double result_diff = 0.0;
+    SolveLQRProblem(A, B, Q, R, tolerance, max_num_iteration, &K,
+                    &num_iteration, &result_diff);
+    if (num_iteration >= max_num_iteration) {
+      ++not_converged;
+    }
+    gains_.push_back(K);
+  }
+  AINFO << "LQR gain table of " << size << " gains over [" << min_value_
+        << ", " << max_value_ << "], " << not_converged
+        << " of them did not converge";
+  return true;
+}
+
+bool LqrGainTable::Interpolate(const double value, Matrix *ptr_K) const {
+  if (gains_.empty() || !(value >= min_value_ && value <= max_value_)) {
+    return false;
+  }
+  if (gains_.size() == 1) {
+    *ptr_K = gains_.front();
+    return true;
+  }
+  const size_t index =
+      std::min(static_cast<size_t>((value - min_value_) / step_),
+               gains_.size() - 2);
+  const double lower = min_value_ + step_ * static_cast<double>(index);
+  const double upper = std::min(lower + step_, max_value_);
+  const double ratio =
+      std::min(std::max((value - lower) / (upper - lower), 0.0), 1.0);
+  *ptr_K = (1.0 - ratio) * gains_[index] + ratio * gains_[index + 1];
+  return true;
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "Eigen/Core"
 
 /**
@@ -66,6 +69,52 @@ void SolveLQRProblem(const Eigen::MatrixXd &A, const Eigen::MatrixXd &B,
                      Eigen::MatrixXd *ptr_K, uint *iterate_num,
                      double *result_diff);
 
+/**
+ * @class LqrGainTable
+ * @brief Feedback gains solved ahead of time on a grid of a scheduling
+ *        variable, typically the speed, and linearly interpolated in between,
+ *        for systems whose matrices depend mainly on that variable.
+ */
+class LqrGainTable {
+ public:
+  /**
+   * @brief Fill the system dynamic matrix A, the control matrix B and the
+   *        state cost matrix Q at a value of the scheduling variable.
+   */
+  using SystemFunction = std::function<void(
+      const double value, Eigen::MatrixXd *A, Eigen::MatrixXd *B,
+      Eigen::MatrixXd *Q)>;
+
+  /**
+   * @brief Solve the gains from min_value every step, and at max_value.
+   * @param R The cost matrix for control output
+   * @param tolerance The numerical tolerance for solving DARE
+   * @param max_num_iteration The maximum iterations for solving DARE
+   * @return False when the range or step is invalid, the table is empty
+   */
+  bool Build(const double min_value, const double max_value,
+             const double step, const SystemFunction &system,
+             const Eigen::MatrixXd &R, const double tolerance,
+             const uint max_num_iteration);
+
+  /**
+   * @brief Interpolate the gain at value.
+   * @return False when the table is empty or value is out of its range, the
+   *         gain is then left to the iterative solver
+   */
+  bool Interpolate(const double value, Eigen::MatrixXd *ptr_K) const;
+
+  bool empty() const { return gains_.empty(); }
+  double min_value() const { return min_value_; }
+  double max_value() const { return max_value_; }
+
+ private:
+  double min_value_ = 0.0;
+  double max_value_ = 0.0;
+  double step_ = 0.0;
+  std::vector<Eigen::MatrixXd> gains_;
+};
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
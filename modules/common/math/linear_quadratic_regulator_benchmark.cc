@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/* Compare the iterative DARE solve of every control cycle with a gain
+ * table built at startup, on the lateral dynamic model of the lateral LQR
+ * controller with its default parameters. The speed sweeps from 0 to
+ * 30 m/s like a drive, worst_us is the worst control cycle of the sweep.
+ *
+ * Usage:
+ *   linear_quadratic_regulator_benchmark --benchmark_min_time=1
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "Eigen/Dense"
+#include "benchmark/benchmark.h"
+
+#include "modules/common/math/linear_quadratic_regulator.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+constexpr double kTs = 0.01;
+constexpr double kMaxSpeed = 30.0;
+constexpr double kEps = 0.01;
+constexpr uint kMaxIteration = 150;
+
+/* range(0) is the preview window, which grows the state */
+void LateralSystem(const int preview_window, const double speed,
+                   Eigen::MatrixXd *A, Eigen::MatrixXd *B,
+                   Eigen::MatrixXd *Q) {
+  const double cf = 155494.663;
+  const double cr = 155494.663;
+  const double mass = 2080.0;
+  const double lf = 1.4;
+  const double lr = 1.4;
+  const double iz = lf * lf * 1040.0 + lr * lr * 1040.0;
+  const double v = std::max(speed, 0.2);
+  const int size = 4 + preview_window;
+
+  Eigen::MatrixXd a = Eigen::MatrixXd::Zero(4, 4);
+  a(0, 1) = 1.0;
+  a(1, 1) = -(cf + cr) / mass / v;
+  a(1, 2) = (cf + cr) / mass;
+  a(1, 3) = (lr * cr - lf * cf) / mass / v;
+  a(2, 3) = 1.0;
+  a(3, 1) = (lr * cr - lf * cf) / iz / v;
+  a(3, 2) = (lf * cf - lr * cr) / iz;
+  a(3, 3) = -(lf * lf * cf + lr * lr * cr) / iz / v;
+  const Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(4, 4);
+  *A = Eigen::MatrixXd::Zero(size, size);
+  A->block(0, 0, 4, 4) =
+      (identity - kTs * 0.5 * a).inverse() * (identity + kTs * 0.5 * a);
+  for (int i = 0; i < preview_window - 1; ++i) {
+    (*A)(4 + i, 5 + i) = 1.0;
+  }
+
+  *B = Eigen::MatrixXd::Zero(size, 1);
+  (*B)(1, 0) = cf / mass * kTs;
+  (*B)(3, 0) = lf * cf / iz * kTs;
+  if (preview_window > 0) {
+    (*B)(size - 1, 0) = 1.0;
+  }
+
+  *Q = Eigen::MatrixXd::Zero(size, size);
+  (*Q)(0, 0) = 0.05;
+  (*Q)(2, 2) = 1.0;
+}
+
+/* One control cycle per speed of the sweep, each timed on its own. The
+ * worst cycle is the slowest speed on average, a single max would mostly
+ * catch the preemptions of the benchmark thread.
+ */
+template <typename Cycle>
+void RunSweep(benchmark::State &state, const Cycle &cycle) {
+  constexpr double kSpeedStep = 0.37;
+  const size_t step_num = static_cast<size_t>(kMaxSpeed / kSpeedStep) + 1;
+  std::vector<double> total_us(step_num, 0.0);
+  std::vector<int> count(step_num, 0);
+  size_t step = 0;
+  for (auto _ : state) {
+    const double speed = kSpeedStep * static_cast<double>(step);
+    const auto start = std::chrono::steady_clock::now();
+    cycle(speed);
+    const auto end = std::chrono::steady_clock::now();
+    total_us[step] +=
+        std::chrono::duration<double, std::micro>(end - start).count();
+    ++count[step];
+    step = (step + 1) % step_num;
+  }
+  double worst_us = 0.0;
+  for (size_t i = 0; i < step_num; ++i) {
+    if (count[i] > 0) {
+      worst_us = std::max(worst_us, total_us[i] / count[i]);
+    }
+  }
+  state.counters["worst_us"] = worst_us;
+}
+
+void BM_SolveEveryCycle(benchmark::State &state) {
+  const int preview_window = static_cast<int>(state.range(0));
+  const Eigen::MatrixXd R = Eigen::MatrixXd::Identity(1, 1);
+  Eigen::MatrixXd A;
+  Eigen::MatrixXd B;
+  Eigen::MatrixXd Q;
+  Eigen::MatrixXd K;
+  RunSweep(state, [&](const double speed) {
+    uint num_iteration = 0;
+    double result_diff = 0.0;
+    LateralSystem(preview_window, speed, &A, &B, &Q);
+    SolveLQRProblem(A, B, Q, R, kEps, kMaxIteration, &K, &num_iteration,
+                    &result_diff);
+    benchmark::DoNotOptimize(K.data());
+  });
+}
+
+void BM_GainTable(benchmark::State &state) {
+  const int preview_window = static_cast<int>(state.range(0));
+  const Eigen::MatrixXd R = Eigen::MatrixXd::Identity(1, 1);
+  LqrGainTable table;
+  table.Build(
+      0.0, kMaxSpeed, 0.1,
+      [preview_window](const double speed, Eigen::MatrixXd *A,
+                       Eigen::MatrixXd *B, Eigen::MatrixXd *Q) {
+        LateralSystem(preview_window, speed, A, B, Q);
+      },
+      R, kEps, kMaxIteration);
+  Eigen::MatrixXd K;
+  RunSweep(state, [&](const double speed) {
+    table.Interpolate(speed, &K);
+    benchmark::DoNotOptimize(K.data());
+  });
+}
+
+BENCHMARK(BM_SolveEveryCycle)->Arg(0)->Arg(5)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GainTable)->Arg(0)->Arg(5)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+BENCHMARK_MAIN();
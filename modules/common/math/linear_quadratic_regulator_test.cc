@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/linear_quadratic_regulator.h"
+
+#include <algorithm>
+
+#include "Eigen/Dense"
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// Discretized lateral dynamic bicycle model, whose matrices depend on the
+// speed like the ones of the lateral controller
+void LateralSystem(const double speed, Eigen::MatrixXd *A, Eigen::MatrixXd *B,
+                   Eigen::MatrixXd *Q) {
+  const double ts = 0.01;
+  const double cf = 155494.663;
+  const double cr = 155494.663;
+  const double mass = 2080.0;
+  const double lf = 1.4;
+  const double lr = 1.4;
+  const double iz = lf * lf * 1040.0 + lr * lr * 1040.0;
+  const double v = std::max(speed, 0.2);
+
+  Eigen::MatrixXd a = Eigen::MatrixXd::Zero(4, 4);
+  a(0, 1) = 1.0;
+  a(1, 1) = -(cf + cr) / mass / v;
+  a(1, 2) = (cf + cr) / mass;
+  a(1, 3) = (lr * cr - lf * cf) / mass / v;
+  a(2, 3) = 1.0;
+  a(3, 1) = (lr * cr - lf * cf) / iz / v;
+  a(3, 2) = (lf * cf - lr * cr) / iz;
+  a(3, 3) = -(lf * lf * cf + lr * lr * cr) / iz / v;
+  const Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(4, 4);
+  *A = (identity - ts * 0.5 * a).inverse() * (identity + ts * 0.5 * a);
+
+  *B = Eigen::MatrixXd::Zero(4, 1);
+  (*B)(1, 0) = cf / mass * ts;
+  (*B)(3, 0) = lf * cf / iz * ts;
+
+  *Q = Eigen::MatrixXd::Zero(4, 4);
+  (*Q)(0, 0) = 0.05;
+  (*Q)(2, 2) = 1.0;
+}
+
+}  // namespace
+
+TEST(LqrGainTableTest, MatchesSolverOnTheGrid) {
+  const Eigen::MatrixXd R = Eigen::MatrixXd::Identity(1, 1);
+  LqrGainTable table;
+  ASSERT_TRUE(table.Build(0.0, 30.0, 0.5, LateralSystem, R, 0.01, 150));
+  EXPECT_DOUBLE_EQ(table.max_value(), 30.0);
+
+  Eigen::MatrixXd A;
+  Eigen::MatrixXd B;
+  Eigen::MatrixXd Q;
+  Eigen::MatrixXd K_solved;
+  Eigen::MatrixXd K_table;
+  uint num_iteration = 0;
+  double result_diff = 0.0;
+  for (const double speed : {0.0, 5.0, 12.5, 30.0}) {
+    LateralSystem(speed, &A, &B, &Q);
+    SolveLQRProblem(A, B, Q, R, 0.01, 150, &K_solved, &num_iteration,
+                    &result_diff);
+    ASSERT_TRUE(table.Interpolate(speed, &K_table));
+    EXPECT_TRUE(K_solved.isApprox(K_table)) << "speed " << speed;
+  }
+}
+
+TEST(LqrGainTableTest, InterpolatesBetweenTheGrid) {
+  const Eigen::MatrixXd R = Eigen::MatrixXd::Identity(1, 1);
+  LqrGainTable table;
+  ASSERT_TRUE(table.Build(0.0, 30.0, 0.1, LateralSystem, R, 0.01, 150));
+
+  Eigen::MatrixXd A;
+  Eigen::MatrixXd B;
+  Eigen::MatrixXd Q;
+  Eigen::MatrixXd K_solved;
+  Eigen::MatrixXd K_table;
+  uint num_iteration = 0;
+  double result_diff = 0.0;
+  for (const double speed : {3.05, 10.42, 24.97}) {
+    LateralSystem(speed, &A, &B, &Q);
+    SolveLQRProblem(A, B, Q, R, 0.01, 150, &K_solved, &num_iteration,
+                    &result_diff);
+    ASSERT_TRUE(table.Interpolate(speed, &K_table));
+    EXPECT_LT((K_solved - K_table).cwiseAbs().maxCoeff(),
+              1e-2 * K_solved.cwiseAbs().maxCoeff())
+        << "speed " << speed;
+  }
+}
+
+TEST(LqrGainTableTest, OutOfRange) {
+  const Eigen::MatrixXd R = Eigen::MatrixXd::Identity(1, 1);
+  LqrGainTable table;
+  Eigen::MatrixXd K;
+  EXPECT_TRUE(table.empty());
+  EXPECT_FALSE(table.Interpolate(1.0, &K));
+  EXPECT_FALSE(table.Build(1.0, 0.0, 0.1, LateralSystem, R, 0.01, 150));
+
+  ASSERT_TRUE(table.Build(1.0, 2.0, 0.1, LateralSystem, R, 0.01, 150));
+  EXPECT_FALSE(table.Interpolate(0.9, &K));
+  EXPECT_FALSE(table.Interpolate(2.1, &K));
+  EXPECT_TRUE(table.Interpolate(1.0, &K));
+  EXPECT_TRUE(table.Interpolate(2.0, &K));
+}
+
+TEST(LqrGainTableTest, LastStepEndsOnMax) {
+  const Eigen::MatrixXd R = Eigen::MatrixXd::Identity(1, 1);
+  LqrGainTable table;
+  ASSERT_TRUE(table.Build(0.0, 1.05, 0.1, LateralSystem, R, 0.01, 150));
+  EXPECT_DOUBLE_EQ(table.max_value(), 1.05);
+
+  Eigen::MatrixXd A;
+  Eigen::MatrixXd B;
+  Eigen::MatrixXd Q;
+  Eigen::MatrixXd K_solved;
+  Eigen::MatrixXd K_table;
+  uint num_iteration = 0;
+  double result_diff = 0.0;
+  for (const double speed : {1.0, 1.05}) {
+    LateralSystem(speed, &A, &B, &Q);
+    SolveLQRProblem(A, B, Q, R, 0.01, 150, &K_solved, &num_iteration,
+                    &result_diff);
+    ASSERT_TRUE(table.Interpolate(speed, &K_table));
+    EXPECT_TRUE(K_solved.isApprox(K_table)) << "speed " << speed;
+  }
+  EXPECT_FALSE(table.Interpolate(1.06, &K_table));
+
+  ASSERT_TRUE(table.Build(2.0, 2.0, 0.1, LateralSystem, R, 0.01, 150));
+  EXPECT_TRUE(table.Interpolate(2.0, &K_table));
+  EXPECT_FALSE(table.Interpolate(2.05, &K_table));
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/packed_point_cloud.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+void ToPackedPointCloud(const drivers::PointCloud& cloud,
+                        drivers::PackedPointCloud* packed) {
+  packed->mutable_header()->CopyFrom(cloud.header());
+  packed->set_frame_id(cloud.frame_id());
+  packed->set_is_dense(cloud.is_dense());
+  packed->set_measurement_time(cloud.measurement_time());
+  packed->set_width(cloud.width());
+  packed->set_height(cloud.height());
+
+  MutablePackedPointCloudView points(packed);
+  points.Resize(cloud.point_size());
+  PackedPoint* point = points.begin();
+  for (const auto& src : cloud.point()) {
+    point->x = src.x();
+    point->y = src.y();
+    point->z = src.z();
+    point->intensity = src.intensity();
+    point->timestamp = src.timestamp();
+    ++point;
+  }
+}
+
+void ToPointCloud(const drivers::PackedPointCloud& packed,
+                  drivers::PointCloud* cloud) {
+  cloud->mutable_header()->CopyFrom(packed.header());
+  cloud->set_frame_id(packed.frame_id());
+  cloud->set_is_dense(packed.is_dense());
+  cloud->set_measurement_time(packed.measurement_time());
+  cloud->set_width(packed.width());
+  cloud->set_height(packed.height());
+
+  PackedPointCloudView points(packed);
+  cloud->clear_point();
+  cloud->mutable_point()->Reserve(static_cast<int>(points.size()));
+  for (const auto& src : points) {
+    auto* point = cloud->add_point();
+    point->set_x(src.x);
+    point->set_y(src.y);
+    point->set_z(src.z);
+    point->set_intensity(src.intensity);
+    point->set_timestamp(src.timestamp);
+  }
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
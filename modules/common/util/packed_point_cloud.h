@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Views of the points of a PackedPointCloud and conversions from and
+ * to PointCloud.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "modules/common_msgs/sensor_msgs/pointcloud.pb.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @brief A point of PackedPointCloud::data, see pointcloud.proto for the
+ * layout.
+ */
+struct PackedPoint {
+  float x;
+  float y;
+  float z;
+  uint32_t intensity;
+  uint64_t timestamp;
+};
+
+static_assert(sizeof(PackedPoint) == 24, "PackedPoint must be packed");
+static_assert(offsetof(PackedPoint, timestamp) == 16,
+              "PackedPoint layout must match pointcloud.proto");
+
+/**
+ * @class PackedPointCloudView
+ * @brief Read only view of the points of a PackedPointCloud, valid while
+ * the data of the cloud is not modified.
+ */
+class PackedPointCloudView {
+ public:
+  explicit PackedPointCloudView(const drivers::PackedPointCloud& cloud)
+      : points_(reinterpret_cast<const PackedPoint*>(cloud.data().data())),
+        size_(cloud.data().size() / sizeof(PackedPoint)) {}
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const PackedPoint& operator[](size_t i) const { return points_[i]; }
+  const PackedPoint* begin() const { return points_; }
+  const PackedPoint* end() const { return points_ + size_; }
+
+ private:
+  const PackedPoint* points_;
+  size_t size_;
+};
+
+/**
+ * @class MutablePackedPointCloudView
+ * @brief View writing the points of a PackedPointCloud in place. The
+ * pointers returned are invalidated by Resize() and PushBack().
+ */
+class MutablePackedPointCloudView {
+ public:
+  explicit MutablePackedPointCloudView(drivers::PackedPointCloud* cloud)
+      : data_(cloud->mutable_data()) {}
+
+  size_t size() const { return data_->size() / sizeof(PackedPoint); }
+  bool empty() const { return data_->empty(); }
+
+  PackedPoint& operator[](size_t i) { return begin()[i]; }
+  PackedPoint* begin() { return reinterpret_cast<PackedPoint*>(&(*data_)[0]); }
+  PackedPoint* end() { return begin() + size(); }
+
+  void Reserve(size_t size) { data_->reserve(size * sizeof(PackedPoint)); }
+  // New points are zeroed
+  void Resize(size_t size) { data_->resize(size * sizeof(PackedPoint)); }
+  void PushBack(const PackedPoint& point) {
+    data_->append(reinterpret_cast<const char*>(&point), sizeof(point));
+  }
+
+ private:
+  std::string* data_;
+};
+
+/**
+ * @brief Copy a point cloud into a packed one, the points of packed are
+ * replaced.
+ */
+void ToPackedPointCloud(const drivers::PointCloud& cloud,
+                        drivers::PackedPointCloud* packed);
+
+/**
+ * @brief Copy a packed point cloud into a point cloud, for the consumers of
+ * PointCloud. The points of cloud are replaced.
+ */
+void ToPointCloud(const drivers::PackedPointCloud& packed,
+                  drivers::PointCloud* cloud);
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/packed_point_cloud.h"
+
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(PackedPointCloudTest, RoundTrip) {
+  drivers::PointCloud cloud;
+  cloud.mutable_header()->set_frame_id("velodyne128");
+  cloud.set_frame_id("velodyne128");
+  cloud.set_measurement_time(1.5);
+  cloud.set_width(3);
+  cloud.set_height(1);
+  for (int i = 0; i < 3; ++i) {
+    auto* point = cloud.add_point();
+    point->set_x(static_cast<float>(i));
+    point->set_y(static_cast<float>(i) + 0.5f);
+    point->set_z(-1.0f);
+    point->set_intensity(10 + i);
+    point->set_timestamp(1000000000ULL + i);
+  }
+  cloud.mutable_point(1)->set_x(std::numeric_limits<float>::quiet_NaN());
+
+  drivers::PackedPointCloud packed;
+  ToPackedPointCloud(cloud, &packed);
+  EXPECT_EQ(3 * sizeof(PackedPoint), packed.data().size());
+  EXPECT_EQ("velodyne128", packed.header().frame_id());
+  EXPECT_EQ(3, packed.width());
+
+  PackedPointCloudView points(packed);
+  ASSERT_EQ(3, points.size());
+  EXPECT_FLOAT_EQ(2.5f, points[2].y);
+  EXPECT_TRUE(std::isnan(points[1].x));
+  EXPECT_EQ(12, points[2].intensity);
+  EXPECT_EQ(1000000002ULL, points[2].timestamp);
+
+  drivers::PointCloud converted;
+  ToPointCloud(packed, &converted);
+  ASSERT_EQ(3, converted.point_size());
+  EXPECT_DOUBLE_EQ(1.5, converted.measurement_time());
+  EXPECT_FLOAT_EQ(0.5f, converted.point(0).y());
+  EXPECT_TRUE(std::isnan(converted.point(1).x()));
+  EXPECT_EQ(1000000001ULL, converted.point(1).timestamp());
+}
+
+TEST(PackedPointCloudTest, MutableView) {
+  drivers::PackedPointCloud packed;
+  MutablePackedPointCloudView points(&packed);
+  EXPECT_TRUE(points.empty());
+  points.PushBack({1.0f, 2.0f, 3.0f, 4, 5});
+  points.Resize(2);
+  points[1].z = 6.0f;
+  ASSERT_EQ(2, points.size());
+
+  PackedPointCloudView view(packed);
+  EXPECT_FLOAT_EQ(2.0f, view[0].y);
+  EXPECT_EQ(5, view[0].timestamp);
+  EXPECT_FLOAT_EQ(6.0f, view[1].z);
+  EXPECT_EQ(0, view[1].intensity);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/* Compare the calibration table lookups of Interpolation2D and
+ * GridInterpolation2D on the default calibration table. The keys either
+ * move slowly like the speed and acceleration of consecutive control
+ * cycles, range(0) == 0, or jump anywhere in the table, range(0) == 1.
+ *
+ * Usage:
+ *   grid_interpolation_2d_benchmark --benchmark_min_time=1
+ */
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/control/control_component/proto/calibration_table.pb.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/common/math/grid_interpolation_2d.h"
+#include "modules/control/control_component/controller_task_base/common/interpolation_2d.h"
+
+namespace apollo {
+namespace control {
+namespace {
+
+using apollo::common::math::GridInterpolation2D;
+
+constexpr int kKeyNum = 4096;
+
+Interpolation2D::DataType CalibrationTable() {
+  calibration_table table;
+  ACHECK(cyber::common::GetProtoFromFile(
+      "/apollo/modules/control/control_component/conf/calibration_table.pb.txt",
+      &table));
+  Interpolation2D::DataType xyz;
+  for (const auto &calibration : table.calibration()) {
+    xyz.push_back(std::make_tuple(calibration.speed(),
+                                  calibration.acceleration(),
+                                  calibration.command()));
+  }
+  return xyz;
+}
+
+std::vector<Interpolation2D::KeyType> Keys(const bool jump) {
+  std::mt19937 generator(kKeyNum);
+  std::uniform_real_distribution<double> speed(0.0, 10.0);
+  std::uniform_real_distribution<double> acceleration(-5.0, 3.0);
+  std::uniform_real_distribution<double> step(-0.02, 0.02);
+  std::vector<Interpolation2D::KeyType> keys;
+  auto key = std::make_pair(speed(generator), acceleration(generator));
+  for (int i = 0; i < kKeyNum; ++i) {
+    if (jump) {
+      key = std::make_pair(speed(generator), acceleration(generator));
+    } else {
+      key.first = std::max(0.0, key.first + step(generator));
+      key.second += step(generator);
+    }
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+template <typename Table>
+void BM_Interpolate(benchmark::State &state) {
+  Table table;
+  table.Init(CalibrationTable());
+  const auto keys = Keys(state.range(0) != 0);
+  for (auto _ : state) {
+    for (const auto &key : keys) {
+      benchmark::DoNotOptimize(table.Interpolate(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+BENCHMARK_TEMPLATE(BM_Interpolate, Interpolation2D)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_Interpolate, GridInterpolation2D)->Arg(0)->Arg(1);
+
+}  // namespace
+}  // namespace control
+}  // namespace apollo
+
+BENCHMARK_MAIN();
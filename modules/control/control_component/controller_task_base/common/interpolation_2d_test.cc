@@ -16,6 +16,7 @@
 
 #include "modules/control/control_component/controller_task_base/common/interpolation_2d.h"
 
+#include <random>
 #include <string>
 #include <utility>
 
@@ -25,6 +26,7 @@
 
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
+#include "modules/common/math/grid_interpolation_2d.h"
 
 namespace apollo {
 namespace control {
@@ -96,5 +98,40 @@ TEST_F(Interpolation2DTest, calibration_table) {
   }
 }
 
+// The controllers look the table up with the dense grid of common/math.
+TEST_F(Interpolation2DTest, same_as_grid_table) {
+  Interpolation2D::DataType xyz;
+  for (const auto &calibration : calibration_table_.calibration()) {
+    xyz.push_back(std::make_tuple(calibration.speed(),
+                                  calibration.acceleration(),
+                                  calibration.command()));
+  }
+  Interpolation2D map_estimator;
+  EXPECT_TRUE(map_estimator.Init(xyz));
+  common::math::GridInterpolation2D grid_estimator;
+  EXPECT_TRUE(grid_estimator.Init(xyz));
+
+  for (const auto &elem : xyz) {
+    EXPECT_DOUBLE_EQ(std::get<2>(elem),
+                     grid_estimator.Interpolate(
+                         std::make_pair(std::get<0>(elem), std::get<1>(elem))));
+  }
+
+  // random jumps and slowly moving keys, beyond the table too
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> speed(-1.0, 12.0);
+  std::uniform_real_distribution<double> acceleration(-12.0, 6.0);
+  std::uniform_real_distribution<double> step(-0.05, 0.05);
+  for (int i = 0; i < 100; ++i) {
+    auto key = std::make_pair(speed(generator), acceleration(generator));
+    for (int j = 0; j < 100; ++j) {
+      EXPECT_NEAR(map_estimator.Interpolate(key),
+                  grid_estimator.Interpolate(key), 1e-3);
+      key.first += step(generator);
+      key.second += step(generator);
+    }
+  }
+}
+
 }  // namespace control
 }  // namespace apollo
@@ -35,13 +35,8 @@ namespace apollo {
 namespace control {
 namespace {
 
-// Squared distance from the point to (x, y).
-double PointDistanceSquare(const TrajectoryPoint &point, const double x,
-                           const double y) {
-  const double dx = point.path_point().x() - x;
-  const double dy = point.path_point().y() - y;
-  return dx * dx + dy * dy;
-}
+// Segments of the index hold up to this number of points
+constexpr size_t kSegmentLeafSize = 8;
 
 PathPoint TrajectoryPointToPathPoint(const TrajectoryPoint &point) {
   if (point.has_path_point()) {
@@ -67,22 +62,14 @@ TrajectoryAnalyzer::TrajectoryAnalyzer(
       path_point->set_z(0.0);
     }
   }
+  BuildIndex();
 }
 
 PathPoint TrajectoryAnalyzer::QueryMatchedPathPoint(const double x,
                                                     const double y) const {
   CHECK_GT(trajectory_points_.size(), 0U);
 
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
-  size_t index_min = 0;
-
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
-    double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
-    if (d_temp < d_min) {
-      d_min = d_temp;
-      index_min = i;
-    }
-  }
+  const size_t index_min = QueryNearestIndex(x, y);
 
   size_t index_start = index_min == 0 ? index_min : index_min - 1;
   size_t index_end =
@@ -187,17 +174,113 @@ TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByRelativeTime(
 
 TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByPosition(
     const double x, const double y) const {
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
-  size_t index_min = 0;
-
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
-    double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
-    if (d_temp < d_min) {
-      d_min = d_temp;
-      index_min = i;
+  return trajectory_points_[QueryNearestIndex(x, y)];
+}
+
+void TrajectoryAnalyzer::BuildIndex() {
+  point_xy_.clear();
+  point_xy_.reserve(trajectory_points_.size() * 2);
+  for (const auto &point : trajectory_points_) {
+    point_xy_.push_back(point.path_point().x());
+    point_xy_.push_back(point.path_point().y());
+  }
+  segment_boxes_.clear();
+  last_nearest_index_ = 0;
+  if (!trajectory_points_.empty()) {
+    BuildSegmentBox(0, 0, trajectory_points_.size());
+  }
+}
+
+TrajectoryAnalyzer::SegmentBox TrajectoryAnalyzer::BuildSegmentBox(
+    const size_t node, const size_t begin, const size_t end) {
+  SegmentBox box;
+  if (end - begin <= kSegmentLeafSize) {
+    box.min_x = box.max_x = point_xy_[2 * begin];
+    box.min_y = box.max_y = point_xy_[2 * begin + 1];
+    for (size_t i = begin + 1; i < end; ++i) {
+      box.min_x = std::min(box.min_x, point_xy_[2 * i]);
+      box.max_x = std::max(box.max_x, point_xy_[2 * i]);
+      box.min_y = std::min(box.min_y, point_xy_[2 * i + 1]);
+      box.max_y = std::max(box.max_y, point_xy_[2 * i + 1]);
+    }
+  } else {
+    const size_t middle = begin + (end - begin) / 2;
+    const SegmentBox left = BuildSegmentBox(2 * node + 1, begin, middle);
+    const SegmentBox right = BuildSegmentBox(2 * node + 2, middle, end);
+    box.min_x = std::min(left.min_x, right.min_x);
+    box.max_x = std::max(left.max_x, right.max_x);
+    box.min_y = std::min(left.min_y, right.min_y);
+    box.max_y = std::max(left.max_y, right.max_y);
+  }
+  if (node >= segment_boxes_.size()) {
+    segment_boxes_.resize(node + 1);
+  }
+  segment_boxes_[node] = box;
+  return box;
+}
+
+double TrajectoryAnalyzer::PointDistanceSquare(const size_t index,
+                                               const double x,
+                                               const double y) const {
+  const double dx = point_xy_[2 * index] - x;
+  const double dy = point_xy_[2 * index + 1] - y;
+  return dx * dx + dy * dy;
+}
+
+size_t TrajectoryAnalyzer::QueryNearestIndex(const double x,
+                                             const double y) const {
+  const size_t size = trajectory_points_.size();
+  // Walk down the distance along the trajectory from the last match, the
+  // vehicle moves little between two queries so the bound is tight
+  size_t index_min = std::min(last_nearest_index_, size - 1);
+  double d_min = PointDistanceSquare(index_min, x, y);
+  while (index_min + 1 < size) {
+    const double d_temp = PointDistanceSquare(index_min + 1, x, y);
+    if (d_temp >= d_min) {
+      break;
+    }
+    d_min = d_temp;
+    ++index_min;
+  }
+  while (index_min > 0) {
+    const double d_temp = PointDistanceSquare(index_min - 1, x, y);
+    if (d_temp > d_min) {
+      break;
+    }
+    d_min = d_temp;
+    --index_min;
+  }
+  SearchNearestIndex(0, 0, size, x, y, &index_min, &d_min);
+  last_nearest_index_ = index_min;
+  return index_min;
+}
+
+void TrajectoryAnalyzer::SearchNearestIndex(const size_t node,
+                                            const size_t begin,
+                                            const size_t end, const double x,
+                                            const double y, size_t *index_min,
+                                            double *d_min) const {
+  // Rounding is monotonic, so the distance to the box is not more than the
+  // one to any point in it and no closer point is skipped
+  const SegmentBox &box = segment_boxes_[node];
+  const double dx = std::max({box.min_x - x, x - box.max_x, 0.0});
+  const double dy = std::max({box.min_y - y, y - box.max_y, 0.0});
+  if (dx * dx + dy * dy > *d_min) {
+    return;
+  }
+  if (end - begin <= kSegmentLeafSize) {
+    for (size_t i = begin; i < end; ++i) {
+      const double d_temp = PointDistanceSquare(i, x, y);
+      if (d_temp < *d_min || (d_temp == *d_min && i < *index_min)) {
+        *d_min = d_temp;
+        *index_min = i;
+      }
     }
+    return;
   }
-  return trajectory_points_[index_min];
+  const size_t middle = begin + (end - begin) / 2;
+  SearchNearestIndex(2 * node + 1, begin, middle, x, y, index_min, d_min);
+  SearchNearestIndex(2 * node + 2, middle, end, x, y, index_min, d_min);
 }
 
 const std::vector<TrajectoryPoint> &TrajectoryAnalyzer::trajectory_points()
@@ -248,6 +331,7 @@ void TrajectoryAnalyzer::TrajectoryTransformToCOM(
     trajectory_points_[i].mutable_path_point()->set_x(com.x());
     trajectory_points_[i].mutable_path_point()->set_y(com.y());
   }
+  BuildIndex();
 }
 
 common::math::Vec2d TrajectoryAnalyzer::ComputeCOMPosition(
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 #include "modules/common_msgs/basic_msgs/pnc_point.pb.h"
@@ -154,9 +155,44 @@ class TrajectoryAnalyzer {
   unsigned int seq_num_ = 0;
 
  private:
+  // Bounding box of the points of a node of the segment index
+  struct SegmentBox {
+    double min_x = 0.0;
+    double min_y = 0.0;
+    double max_x = 0.0;
+    double max_y = 0.0;
+  };
+
   common::PathPoint FindMinDistancePoint(const common::TrajectoryPoint &p0,
                                          const common::TrajectoryPoint &p1,
                                          const double x, const double y) const;
+
+  // Build the coordinate array and the segment index of trajectory_points_
+  void BuildIndex();
+
+  SegmentBox BuildSegmentBox(const size_t node, const size_t begin,
+                             const size_t end);
+
+  double PointDistanceSquare(const size_t index, const double x,
+                             const double y) const;
+
+  /**
+   * @brief index of the point closest to (x, y), the first one on ties, as
+   * a scan of all the points would find. The search starts from the last
+   * match and skips the segments whose box is farther than the best point.
+   */
+  size_t QueryNearestIndex(const double x, const double y) const;
+
+  void SearchNearestIndex(const size_t node, const size_t begin,
+                          const size_t end, const double x, const double y,
+                          size_t *index_min, double *d_min) const;
+
+  // x and y of the trajectory points, interleaved
+  std::vector<double> point_xy_;
+  // binary tree over index ranges, the children of node i are 2i+1 and 2i+2
+  std::vector<SegmentBox> segment_boxes_;
+  // warm start of the next query, an analyzer is queried by a single thread
+  mutable size_t last_nearest_index_ = 0;
 };
 
 }  // namespace control
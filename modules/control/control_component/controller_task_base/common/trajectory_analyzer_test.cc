@@ -16,6 +16,9 @@
 
 #include "modules/control/control_component/controller_task_base/common/trajectory_analyzer.h"
 
+#include <cmath>
+#include <random>
+
 #include "gtest/gtest.h"
 
 #include "cyber/common/log.h"
@@ -43,6 +46,24 @@ void SetTrajectory(const std::vector<double> &xs, const std::vector<double> &ys,
   adc_trajectory->mutable_header()->set_sequence_num(123);
 }
 
+// Index of the first point closest to (x, y), by scanning all the points
+size_t NearestIndex(const planning::ADCTrajectory &adc_trajectory,
+                    const double x, const double y) {
+  size_t index_min = 0;
+  double d_min = 0.0;
+  for (int i = 0; i < adc_trajectory.trajectory_point_size(); ++i) {
+    const auto &point = adc_trajectory.trajectory_point(i).path_point();
+    const double dx = point.x() - x;
+    const double dy = point.y() - y;
+    const double d = dx * dx + dy * dy;
+    if (i == 0 || d < d_min) {
+      d_min = d;
+      index_min = i;
+    }
+  }
+  return index_min;
+}
+
 void SetTrajectoryWithTime(const std::vector<double> &xs,
                            const std::vector<double> &ys,
                            const std::vector<double> &ts,
@@ -169,5 +190,50 @@ TEST_F(TrajectoryAnalyzerTest, QueryNearestPointByAbsoluteTimeInterpolation) {
   EXPECT_NEAR(point_6.path_point().x(), 1.0, 1e-6);
 }
 
+TEST_F(TrajectoryAnalyzerTest, QueryNearestPointByPositionSameAsScan) {
+  // a loop driven twice with repeated points, so that far apart points of
+  // the trajectory are equally close
+  planning::ADCTrajectory adc_trajectory;
+  std::vector<double> xs;
+  std::vector<double> ys;
+  std::vector<double> ss;
+  for (int i = 0; i < 500; ++i) {
+    const double angle = 4.0 * M_PI * (i / 2) / 250.0;
+    xs.push_back(std::round(20.0 * std::cos(angle) * 10.0) / 10.0);
+    ys.push_back(std::round(20.0 * std::sin(angle) * 10.0) / 10.0);
+    ss.push_back(0.5 * i);
+  }
+  SetTrajectory(xs, ys, ss, &adc_trajectory);
+  TrajectoryAnalyzer trajectory_analyzer(&adc_trajectory);
+
+  // random jumps, then a vehicle going around the loop
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> position(-30.0, 30.0);
+  for (int i = 0; i < 2000; ++i) {
+    double x = position(generator);
+    double y = position(generator);
+    if (i >= 1000) {
+      const double angle = 2.0 * M_PI * (i - 1000) / 1000.0;
+      x = 20.5 * std::cos(angle);
+      y = 20.5 * std::sin(angle);
+    } else if (i % 10 == 0) {
+      x = xs[i % xs.size()];
+      y = ys[i % ys.size()];
+    }
+    const size_t index = NearestIndex(adc_trajectory, x, y);
+    const TrajectoryPoint point =
+        trajectory_analyzer.QueryNearestPointByPosition(x, y);
+    EXPECT_EQ(adc_trajectory.trajectory_point(index).path_point().s(),
+              point.path_point().s());
+  }
+
+  // the index follows the points moved to the center of mass
+  trajectory_analyzer.TrajectoryTransformToCOM(1.5);
+  const auto &points = trajectory_analyzer.trajectory_points();
+  const TrajectoryPoint point = trajectory_analyzer.QueryNearestPointByPosition(
+      points[100].path_point().x(), points[100].path_point().y());
+  EXPECT_EQ(points[100].path_point().s(), point.path_point().s());
+}
+
 }  // namespace control
 }  // namespace apollo
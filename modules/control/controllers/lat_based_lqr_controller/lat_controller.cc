@@ -247,6 +247,7 @@ Status LatController::Init(std::shared_ptr<DependencyInjector> injector) {
   matrix_q_updated_ = matrix_q_;
   InitializeFilters();
   LoadLatGainScheduler();
+  BuildGainTables();
   LogInitParameters();
 
   enable_leadlag_ =
@@ -297,142 +298,150 @@ void LatController::LoadLatGainScheduler() {
       << "Fail to load heading error gain scheduler";
 }
 
+void LatController::BuildGainTables() {
+  drive_gain_table_ = common::math::LqrGainTable();
+  reverse_gain_table_ = common::math::LqrGainTable();
+  const auto &table_conf = lat_based_lqr_controller_conf_.lqr_gain_table_conf();
+  if (!table_conf.enabled()) {
+    return;
+  }
+  for (const bool reverse : {false, true}) {
+    UpdateGearCoefficients(reverse);
+    const auto system = [this, reverse](const double linear_velocity,
+                                        Matrix *matrix_a, Matrix *matrix_b,
+                                        Matrix *matrix_q) {
+      UpdateMatrix(reverse, linear_velocity);
+      UpdateMatrixCompound();
+      *matrix_a = matrix_adc_;
+      *matrix_b = matrix_bdc_;
+      *matrix_q = UpdateMatrixQ(reverse, linear_velocity);
+    };
+    if (reverse) {
+      reverse_gain_table_.Build(-table_conf.max_reverse_speed(), 0.0,
+                                table_conf.speed_step(), system, matrix_r_,
+                                lqr_eps_, lqr_max_iteration_);
+    } else {
+      drive_gain_table_.Build(0.0, table_conf.max_speed(),
+                              table_conf.speed_step(), system, matrix_r_,
+                              lqr_eps_, lqr_max_iteration_);
+    }
+  }
+  // The cycles start from the drive gear model
+  UpdateGearCoefficients(false);
+  UpdateMatrixQ(false, 0.0);
+}
+
 void LatController::Stop() { CloseLogFile(); }
 
 std::string LatController::Name() const { return name_; }
 
-Status LatController::ComputeControlCommand(
+void LatController::UpdateNavigationModeTrajectory(
     const localization::LocalizationEstimate *localization,
-    const canbus::Chassis *chassis,
-    const planning::ADCTrajectory *planning_published_trajectory,
-    ControlCommand *cmd) {
-  auto vehicle_state = injector_->vehicle_state();
-  auto previous_lon_debug = injector_->Get_previous_lon_debug_info();
-  auto target_tracking_trajectory = *planning_published_trajectory;
+    planning::ADCTrajectory *trajectory) {
+  auto time_stamp_diff =
+      trajectory->header().timestamp_sec() - current_trajectory_timestamp_;
 
-  if (FLAGS_use_navigation_mode &&
-      lat_based_lqr_controller_conf_.enable_navigation_mode_position_update()) {
-    auto time_stamp_diff =
-        planning_published_trajectory->header().timestamp_sec() -
-        current_trajectory_timestamp_;
+  auto curr_vehicle_x = localization->pose().position().x();
+  auto curr_vehicle_y = localization->pose().position().y();
 
-    auto curr_vehicle_x = localization->pose().position().x();
-    auto curr_vehicle_y = localization->pose().position().y();
+  double curr_vehicle_heading = 0.0;
+  const auto &orientation = localization->pose().orientation();
+  if (localization->pose().has_heading()) {
+    curr_vehicle_heading = localization->pose().heading();
+  } else {
+    curr_vehicle_heading =
+        common::math::QuaternionToHeading(orientation.qw(), orientation.qx(),
+                                          orientation.qy(), orientation.qz());
+  }
 
-    double curr_vehicle_heading = 0.0;
-    const auto &orientation = localization->pose().orientation();
-    if (localization->pose().has_heading()) {
-      curr_vehicle_heading = localization->pose().heading();
-    } else {
-      curr_vehicle_heading =
-          common::math::QuaternionToHeading(orientation.qw(), orientation.qx(),
-                                            orientation.qy(), orientation.qz());
-    }
+  // new planning trajectory
+  if (time_stamp_diff > 1.0e-6) {
+    init_vehicle_x_ = curr_vehicle_x;
+    init_vehicle_y_ = curr_vehicle_y;
+    init_vehicle_heading_ = curr_vehicle_heading;
 
-    // new planning trajectory
-    if (time_stamp_diff > 1.0e-6) {
-      init_vehicle_x_ = curr_vehicle_x;
-      init_vehicle_y_ = curr_vehicle_y;
-      init_vehicle_heading_ = curr_vehicle_heading;
+    current_trajectory_timestamp_ = trajectory->header().timestamp_sec();
+  } else {
+    auto x_diff_map = curr_vehicle_x - init_vehicle_x_;
+    auto y_diff_map = curr_vehicle_y - init_vehicle_y_;
+    auto theta_diff = curr_vehicle_heading - init_vehicle_heading_;
 
-      current_trajectory_timestamp_ =
-          planning_published_trajectory->header().timestamp_sec();
-    } else {
-      auto x_diff_map = curr_vehicle_x - init_vehicle_x_;
-      auto y_diff_map = curr_vehicle_y - init_vehicle_y_;
-      auto theta_diff = curr_vehicle_heading - init_vehicle_heading_;
-
-      auto cos_map_veh = std::cos(init_vehicle_heading_);
-      auto sin_map_veh = std::sin(init_vehicle_heading_);
-
-      auto x_diff_veh = cos_map_veh * x_diff_map + sin_map_veh * y_diff_map;
-      auto y_diff_veh = -sin_map_veh * x_diff_map + cos_map_veh * y_diff_map;
-
-      auto cos_theta_diff = std::cos(-theta_diff);
-      auto sin_theta_diff = std::sin(-theta_diff);
-
-      auto tx = -(cos_theta_diff * x_diff_veh - sin_theta_diff * y_diff_veh);
-      auto ty = -(sin_theta_diff * x_diff_veh + cos_theta_diff * y_diff_veh);
-
-      auto ptr_trajectory_points =
-          target_tracking_trajectory.mutable_trajectory_point();
-      std::for_each(
-          ptr_trajectory_points->begin(), ptr_trajectory_points->end(),
-          [&cos_theta_diff, &sin_theta_diff, &tx, &ty,
-           &theta_diff](common::TrajectoryPoint &p) {
-            auto x = p.path_point().x();
-            auto y = p.path_point().y();
-            auto theta = p.path_point().theta();
-
-            auto x_new = cos_theta_diff * x - sin_theta_diff * y + tx;
-            auto y_new = sin_theta_diff * x + cos_theta_diff * y + ty;
-            auto theta_new = common::math::NormalizeAngle(theta - theta_diff);
-
-            p.mutable_path_point()->set_x(x_new);
-            p.mutable_path_point()->set_y(y_new);
-            p.mutable_path_point()->set_theta(theta_new);
-          });
-    }
+    auto cos_map_veh = std::cos(init_vehicle_heading_);
+    auto sin_map_veh = std::sin(init_vehicle_heading_);
+
+    auto x_diff_veh = cos_map_veh * x_diff_map + sin_map_veh * y_diff_map;
+    auto y_diff_veh = -sin_map_veh * x_diff_map + cos_map_veh * y_diff_map;
+
+    auto cos_theta_diff = std::cos(-theta_diff);
+    auto sin_theta_diff = std::sin(-theta_diff);
+
+    auto tx = -(cos_theta_diff * x_diff_veh - sin_theta_diff * y_diff_veh);
+    auto ty = -(sin_theta_diff * x_diff_veh + cos_theta_diff * y_diff_veh);
+
+    auto ptr_trajectory_points = trajectory->mutable_trajectory_point();
+    std::for_each(
+        ptr_trajectory_points->begin(), ptr_trajectory_points->end(),
+        [&cos_theta_diff, &sin_theta_diff, &tx, &ty,
+         &theta_diff](common::TrajectoryPoint &p) {
+          auto x = p.path_point().x();
+          auto y = p.path_point().y();
+          auto theta = p.path_point().theta();
+
+          auto x_new = cos_theta_diff * x - sin_theta_diff * y + tx;
+          auto y_new = sin_theta_diff * x + cos_theta_diff * y + ty;
+          auto theta_new = common::math::NormalizeAngle(theta - theta_diff);
+
+          p.mutable_path_point()->set_x(x_new);
+          p.mutable_path_point()->set_y(y_new);
+          p.mutable_path_point()->set_theta(theta_new);
+        });
   }
+}
 
-  trajectory_analyzer_ =
-      std::move(TrajectoryAnalyzer(&target_tracking_trajectory));
+Status LatController::ComputeControlCommand(
+    const localization::LocalizationEstimate *localization,
+    const canbus::Chassis *chassis,
+    const planning::ADCTrajectory *planning_published_trajectory,
+    ControlCommand *cmd) {
+  auto vehicle_state = injector_->vehicle_state();
+  auto previous_lon_debug = injector_->Get_previous_lon_debug_info();
 
+  const bool navigation_position_update =
+      FLAGS_use_navigation_mode &&
+      lat_based_lqr_controller_conf_.enable_navigation_mode_position_update();
   // Transform the coordinate of the planning trajectory from the center of the
   // rear-axis to the center of mass, if conditions matched
-  if (((lat_based_lqr_controller_conf_.trajectory_transform_to_com_reverse() &&
+  const bool transform_to_com =
+      ((lat_based_lqr_controller_conf_.trajectory_transform_to_com_reverse() &&
         vehicle_state->gear() == canbus::Chassis::GEAR_REVERSE) ||
        (lat_based_lqr_controller_conf_.trajectory_transform_to_com_drive() &&
         vehicle_state->gear() == canbus::Chassis::GEAR_DRIVE)) &&
-      enable_look_ahead_back_control_) {
-    trajectory_analyzer_.TrajectoryTransformToCOM(lr_);
+      enable_look_ahead_back_control_;
+
+  // The analyzer and its index are kept as long as the trajectory is the
+  // same, the navigation mode moves it in every cycle
+  if (navigation_position_update ||
+      trajectory_analyzer_.trajectory_points().empty() ||
+      trajectory_analyzer_.seq_num() !=
+          planning_published_trajectory->header().sequence_num() ||
+      trajectory_transformed_to_com_ != transform_to_com) {
+    auto target_tracking_trajectory = *planning_published_trajectory;
+    if (navigation_position_update) {
+      UpdateNavigationModeTrajectory(localization, &target_tracking_trajectory);
+    }
+    trajectory_analyzer_ =
+        std::move(TrajectoryAnalyzer(&target_tracking_trajectory));
+    if (transform_to_com) {
+      trajectory_analyzer_.TrajectoryTransformToCOM(lr_);
+    }
+    trajectory_transformed_to_com_ = transform_to_com;
   }
 
   // Re-build the vehicle dynamic models at reverse driving (in particular,
   // replace the lateral translational motion dynamics with the corresponding
   // kinematic models)
-  if (vehicle_state->gear() == canbus::Chassis::GEAR_REVERSE) {
-    /*
-    A matrix (Gear Reverse)
-    [0.0, 0.0, 1.0 * v 0.0;
-     0.0, (-(c_f + c_r) / m) / v, (c_f + c_r) / m,
-     (l_r * c_r - l_f * c_f) / m / v;
-     0.0, 0.0, 0.0, 1.0;
-     0.0, ((lr * cr - lf * cf) / i_z) / v, (l_f * c_f - l_r * c_r) / i_z,
-     (-1.0 * (l_f^2 * c_f + l_r^2 * c_r) / i_z) / v;]
-    */
-    cf_ = -lat_based_lqr_controller_conf_.cf();
-    cr_ = -lat_based_lqr_controller_conf_.cr();
-    matrix_a_(0, 1) = 0.0;
-    matrix_a_coeff_(0, 2) = 1.0;
-  } else {
-    /*
-    A matrix (Gear Drive)
-    [0.0, 1.0, 0.0, 0.0;
-     0.0, (-(c_f + c_r) / m) / v, (c_f + c_r) / m,
-     (l_r * c_r - l_f * c_f) / m / v;
-     0.0, 0.0, 0.0, 1.0;
-     0.0, ((lr * cr - lf * cf) / i_z) / v, (l_f * c_f - l_r * c_r) / i_z,
-     (-1.0 * (l_f^2 * c_f + l_r^2 * c_r) / i_z) / v;]
-    */
-    cf_ = lat_based_lqr_controller_conf_.cf();
-    cr_ = lat_based_lqr_controller_conf_.cr();
-    matrix_a_(0, 1) = 1.0;
-    matrix_a_coeff_(0, 2) = 0.0;
-  }
-  matrix_a_(1, 2) = (cf_ + cr_) / mass_;
-  matrix_a_(3, 2) = (lf_ * cf_ - lr_ * cr_) / iz_;
-  matrix_a_coeff_(1, 1) = -(cf_ + cr_) / mass_;
-  matrix_a_coeff_(1, 3) = (lr_ * cr_ - lf_ * cf_) / mass_;
-  matrix_a_coeff_(3, 1) = (lr_ * cr_ - lf_ * cf_) / iz_;
-  matrix_a_coeff_(3, 3) = -1.0 * (lf_ * lf_ * cf_ + lr_ * lr_ * cr_) / iz_;
-
-  /*
-  b = [0.0, c_f / m, 0.0, l_f * c_f / i_z]^T
-  */
-  matrix_b_(1, 0) = cf_ / mass_;
-  matrix_b_(3, 0) = lf_ * cf_ / iz_;
-  matrix_bd_ = matrix_b_ * ts_;
+  const bool reverse = vehicle_state->gear() == canbus::Chassis::GEAR_REVERSE;
+  UpdateGearCoefficients(reverse);
 
   UpdateDrivingOrientation();
 
@@ -443,48 +452,26 @@ Status LatController::ComputeControlCommand(
   // Error Rate, preview lateral error1 , preview lateral error2, ...]
   UpdateState(debug, chassis);
 
-  UpdateMatrix();
+  const double linear_velocity = vehicle_state->linear_velocity();
+  const auto &gain_table = reverse ? reverse_gain_table_ : drive_gain_table_;
+  if (!gain_table.Interpolate(linear_velocity, &matrix_k_)) {
+    UpdateMatrix(reverse, linear_velocity);
 
-  // Compound discrete matrix with road preview model
-  UpdateMatrixCompound();
+    // Compound discrete matrix with road preview model
+    UpdateMatrixCompound();
 
-  // Adjust matrix_q_updated when in reverse gear
-  int q_param_size = lat_based_lqr_controller_conf_.matrix_q_size();
-  int reverse_q_param_size =
-      lat_based_lqr_controller_conf_.reverse_matrix_q_size();
-  if (injector_->vehicle_state()->gear() == canbus::Chassis::GEAR_REVERSE) {
-    for (int i = 0; i < reverse_q_param_size; ++i) {
-      matrix_q_(i, i) = lat_based_lqr_controller_conf_.reverse_matrix_q(i);
-    }
-  } else {
-    for (int i = 0; i < q_param_size; ++i) {
-      matrix_q_(i, i) = lat_based_lqr_controller_conf_.matrix_q(i);
-    }
-  }
+    uint num_iteration;
+    double result_diff;
+    common::math::SolveLQRProblem(
+        matrix_adc_, matrix_bdc_, UpdateMatrixQ(reverse, linear_velocity),
+        matrix_r_, lqr_eps_, lqr_max_iteration_, &matrix_k_, &num_iteration,
+        &result_diff);
 
-  uint num_iteration;
-  double result_diff;
-  // Add gain scheduler for higher speed steering
-  if (FLAGS_enable_gain_scheduler) {
-    matrix_q_updated_(0, 0) =
-        matrix_q_(0, 0) * lat_err_interpolation_->Interpolate(
-                              std::fabs(vehicle_state->linear_velocity()));
-    matrix_q_updated_(2, 2) =
-        matrix_q_(2, 2) * heading_err_interpolation_->Interpolate(
-                              std::fabs(vehicle_state->linear_velocity()));
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_updated_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_, &num_iteration, &result_diff);
-  } else {
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_, &num_iteration, &result_diff);
+    ADEBUG << "LQR num_iteration is " << num_iteration
+           << ", max iteration threshold is " << lqr_max_iteration_
+           << "; result_diff is " << result_diff;
   }
 
-  ADEBUG << "LQR num_iteration is " << num_iteration
-        << ", max iteration threshold is " << lqr_max_iteration_
-        << "; result_diff is " << result_diff;
-
   // feedback = - K * state
   // Convert vehicle steer angle from rad to degree and then to steer degree
   // then to 100% ratio
@@ -708,18 +695,70 @@ void LatController::UpdateState(SimpleLateralDebug *debug,
   }
 }
 
-void LatController::UpdateMatrix() {
+void LatController::UpdateGearCoefficients(const bool reverse) {
+  if (reverse) {
+    /*
+    A matrix (Gear Reverse)
+    [0.0, 0.0, 1.0 * v 0.0;
+     0.0, (-(c_f + c_r) / m) / v, (c_f + c_r) / m,
+     (l_r * c_r - l_f * c_f) / m / v;
+     0.0, 0.0, 0.0, 1.0;
+     0.0, ((lr * cr - lf * cf) / i_z) / v, (l_f * c_f - l_r * c_r) / i_z,
+     (-1.0 * (l_f^2 * c_f + l_r^2 * c_r) / i_z) / v;]
+    */
+    cf_ = -lat_based_lqr_controller_conf_.cf();
+    cr_ = -lat_based_lqr_controller_conf_.cr();
+    matrix_a_(0, 1) = 0.0;
+    matrix_a_coeff_(0, 2) = 1.0;
+  } else {
+    /*
+    A matrix (Gear Drive)
+    [0.0, 1.0, 0.0, 0.0;
+     0.0, (-(c_f + c_r) / m) / v, (c_f + c_r) / m,
+     (l_r * c_r - l_f * c_f) / m / v;
+     0.0, 0.0, 0.0, 1.0;
+     0.0, ((lr * cr - lf * cf) / i_z) / v, (l_f * c_f - l_r * c_r) / i_z,
+     (-1.0 * (l_f^2 * c_f + l_r^2 * c_r) / i_z) / v;]
+    */
+    cf_ = lat_based_lqr_controller_conf_.cf();
+    cr_ = lat_based_lqr_controller_conf_.cr();
+    matrix_a_(0, 1) = 1.0;
+    matrix_a_coeff_(0, 2) = 0.0;
+  }
+  matrix_a_(1, 2) = (cf_ + cr_) / mass_;
+  matrix_a_(3, 2) = (lf_ * cf_ - lr_ * cr_) / iz_;
+  matrix_a_coeff_(1, 1) = -(cf_ + cr_) / mass_;
+  matrix_a_coeff_(1, 3) = (lr_ * cr_ - lf_ * cf_) / mass_;
+  matrix_a_coeff_(3, 1) = (lr_ * cr_ - lf_ * cf_) / iz_;
+  matrix_a_coeff_(3, 3) = -1.0 * (lf_ * lf_ * cf_ + lr_ * lr_ * cr_) / iz_;
+
+  /*
+  b = [0.0, c_f / m, 0.0, l_f * c_f / i_z]^T
+  */
+  matrix_b_(1, 0) = cf_ / mass_;
+  matrix_b_(3, 0) = lf_ * cf_ / iz_;
+  UpdateMatrixBd(reverse);
+}
+
+void LatController::UpdateMatrixBd(const bool reverse) {
+  matrix_bd_ = matrix_b_ * ts_;
+  // The steering is flipped along with the driving orientation, this flips
+  // the sign of the gains
+  if (FLAGS_reverse_heading_control && reverse) {
+    matrix_bd_ = -matrix_bd_;
+  }
+}
+
+void LatController::UpdateMatrix(const bool reverse,
+                                 const double linear_velocity) {
   double v;
   // At reverse driving, replace the lateral translational motion dynamics with
   // the corresponding kinematic models
-  if (injector_->vehicle_state()->gear() == canbus::Chassis::GEAR_REVERSE &&
-      !lat_based_lqr_controller_conf_.reverse_use_dynamic_model()) {
-    v = std::min(injector_->vehicle_state()->linear_velocity(),
-                 -minimum_speed_protection_);
+  if (reverse && !lat_based_lqr_controller_conf_.reverse_use_dynamic_model()) {
+    v = std::min(linear_velocity, -minimum_speed_protection_);
     matrix_a_(0, 2) = matrix_a_coeff_(0, 2) * v;
   } else {
-    v = std::max(injector_->vehicle_state()->linear_velocity(),
-                 minimum_speed_protection_);
+    v = std::max(linear_velocity, minimum_speed_protection_);
     matrix_a_(0, 2) = 0.0;
   }
   matrix_a_(1, 1) = matrix_a_coeff_(1, 1) / v;
@@ -731,6 +770,32 @@ void LatController::UpdateMatrix() {
                (matrix_i + ts_ * 0.5 * matrix_a_);
 }
 
+const Matrix &LatController::UpdateMatrixQ(const bool reverse,
+                                           const double linear_velocity) {
+  // Adjust matrix_q_updated when in reverse gear
+  if (reverse) {
+    for (int i = 0; i < lat_based_lqr_controller_conf_.reverse_matrix_q_size();
+         ++i) {
+      matrix_q_(i, i) = lat_based_lqr_controller_conf_.reverse_matrix_q(i);
+    }
+  } else {
+    for (int i = 0; i < lat_based_lqr_controller_conf_.matrix_q_size(); ++i) {
+      matrix_q_(i, i) = lat_based_lqr_controller_conf_.matrix_q(i);
+    }
+  }
+  if (!FLAGS_enable_gain_scheduler) {
+    return matrix_q_;
+  }
+  // Add gain scheduler for higher speed steering
+  matrix_q_updated_(0, 0) =
+      matrix_q_(0, 0) *
+      lat_err_interpolation_->Interpolate(std::fabs(linear_velocity));
+  matrix_q_updated_(2, 2) =
+      matrix_q_(2, 2) *
+      heading_err_interpolation_->Interpolate(std::fabs(linear_velocity));
+  return matrix_q_updated_;
+}
+
 void LatController::UpdateMatrixCompound() {
   // Initialize preview matrix
   matrix_adc_.block(0, 0, basic_state_size_, basic_state_size_) = matrix_ad_;
@@ -920,14 +985,14 @@ void LatController::ComputeLateralErrors(
 void LatController::UpdateDrivingOrientation() {
   auto vehicle_state = injector_->vehicle_state();
   driving_orientation_ = vehicle_state->heading();
-  matrix_bd_ = matrix_b_ * ts_;
+  const bool reverse = vehicle_state->gear() == canbus::Chassis::GEAR_REVERSE;
+  // Update Matrix_b for reverse mode, the gain tables are built with it too
+  UpdateMatrixBd(reverse);
   // Reverse the driving direction if the vehicle is in reverse mode
   if (FLAGS_reverse_heading_control) {
-    if (vehicle_state->gear() == canbus::Chassis::GEAR_REVERSE) {
+    if (reverse) {
       driving_orientation_ =
           common::math::NormalizeAngle(driving_orientation_ + M_PI);
-      // Update Matrix_b for reverse mode
-      matrix_bd_ = -matrix_b_ * ts_;
       ADEBUG << "Matrix_b changed due to gear direction";
     }
   }
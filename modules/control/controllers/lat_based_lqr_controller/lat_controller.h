@@ -34,6 +34,7 @@
 #include "modules/common/filters/digital_filter.h"
 #include "modules/common/filters/digital_filter_coefficients.h"
 #include "modules/common/filters/mean_filter.h"
+#include "modules/common/math/linear_quadratic_regulator.h"
 #include "modules/control/control_component/controller_task_base/common/interpolation_1d.h"
 #include "modules/control/control_component/controller_task_base/common/leadlag_controller.h"
 #include "modules/control/control_component/controller_task_base/common/mrac_controller.h"
@@ -107,13 +108,29 @@ class LatController : public ControlTask {
  protected:
   void UpdateState(SimpleLateralDebug *debug, const canbus::Chassis *chassis);
 
+  // Move the trajectory with the vehicle since it was received, in the
+  // navigation mode
+  void UpdateNavigationModeTrajectory(
+      const localization::LocalizationEstimate *localization,
+      planning::ADCTrajectory *trajectory);
+
   // logic for reverse driving mode
   void UpdateDrivingOrientation();
 
-  void UpdateMatrix();
+  // A, B matrix coefficients of the gear
+  void UpdateGearCoefficients(const bool reverse);
+
+  // Discrete B matrix, negated in reverse with --reverse_heading_control
+  void UpdateMatrixBd(const bool reverse);
+
+  void UpdateMatrix(const bool reverse, const double linear_velocity);
 
   void UpdateMatrixCompound();
 
+  // Q matrix of the gear, with the gain scheduler when enabled
+  const Eigen::MatrixXd &UpdateMatrixQ(const bool reverse,
+                                       const double linear_velocity);
+
   double ComputeFeedForward(double ref_curvature) const;
 
   void ComputeLateralErrors(const double x, const double y, const double theta,
@@ -125,6 +142,8 @@ class LatController : public ControlTask {
   bool LoadControlConf();
   void InitializeFilters();
   void LoadLatGainScheduler();
+  // Solve the gains of the speed grid of each gear ahead of time
+  void BuildGainTables();
   void LogInitParameters();
   void ProcessLogs(const SimpleLateralDebug *debug,
                    const canbus::Chassis *chassis);
@@ -139,6 +158,8 @@ class LatController : public ControlTask {
 
   // a proxy to analyze the planning trajectory
   TrajectoryAnalyzer trajectory_analyzer_;
+  // trajectory_analyzer_ is moved to the center of mass
+  bool trajectory_transformed_to_com_ = false;
 
   // the following parameters are vehicle physics related.
   // control time interval
@@ -204,6 +225,10 @@ class LatController : public ControlTask {
   // 4 by 1 matrix; state matrix
   Eigen::MatrixXd matrix_state_;
 
+  // gains interpolated by speed, empty when the table is disabled
+  common::math::LqrGainTable drive_gain_table_;
+  common::math::LqrGainTable reverse_gain_table_;
+
   // parameters for lqr solver; number of iterations
   int lqr_max_iteration_ = 0;
   // parameters for lqr solver; threshold for computation
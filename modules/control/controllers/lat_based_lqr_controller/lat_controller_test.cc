@@ -36,8 +36,9 @@ using PlanningTrajectoryPb = planning::ADCTrajectory;
 using LocalizationPb = localization::LocalizationEstimate;
 using ChassisPb = canbus::Chassis;
 using apollo::common::VehicleStateProvider;
+using Matrix = Eigen::MatrixXd;
 
-class LatControllerTest : public ::testing::Test, LatController {
+class LatControllerTest : public ::testing::Test, public LatController {
  public:
   virtual void SetUp() {
     FLAGS_v = 3;
@@ -81,6 +82,24 @@ class LatControllerTest : public ::testing::Test, LatController {
     return planning_trajectory_pb;
   }
 
+  // The matrices of Init, after the conf is loaded
+  void InitMatrices() {
+    const int matrix_size = basic_state_size_ + preview_window_;
+    matrix_a_ = Matrix::Zero(basic_state_size_, basic_state_size_);
+    matrix_a_(2, 3) = 1.0;
+    matrix_ad_ = Matrix::Zero(basic_state_size_, basic_state_size_);
+    matrix_adc_ = Matrix::Zero(matrix_size, matrix_size);
+    matrix_a_coeff_ = Matrix::Zero(matrix_size, matrix_size);
+    matrix_b_ = Matrix::Zero(basic_state_size_, 1);
+    matrix_bd_ = Matrix::Zero(basic_state_size_, 1);
+    matrix_bdc_ = Matrix::Zero(matrix_size, 1);
+    matrix_state_ = Matrix::Zero(matrix_size, 1);
+    matrix_k_ = Matrix::Zero(1, matrix_size);
+    matrix_r_ = Matrix::Identity(1, 1);
+    matrix_q_ = Matrix::Zero(matrix_size, matrix_size);
+    matrix_q_updated_ = matrix_q_;
+  }
+
   double timestamp_ = 0.0;
 };
 
@@ -124,5 +143,53 @@ TEST_F(LatControllerTest, ComputeLateralErrors) {
   EXPECT_NEAR(debug->curvature(), matched_kappa_expected, 0.001);
 }
 
+TEST_F(LatControllerTest, ReverseGainTableMatchesSolver) {
+  ACHECK(cyber::common::GetProtoFromFile(
+      "/apollo/modules/control/controllers/lat_based_lqr_controller/conf/"
+      "controller_conf.pb.txt",
+      &lat_based_lqr_controller_conf_));
+  ASSERT_TRUE(lat_based_lqr_controller_conf_.lqr_gain_table_conf().enabled());
+  ASSERT_TRUE(LoadControlConf());
+  InitMatrices();
+
+  auto localization_pb = LoadLocalizaionPb(
+      "/apollo/modules/control/controllers/lat_based_lqr_controller/"
+      "lateral_controller_test/1_localization.pb.txt");
+  auto chassis_pb = LoadChassisPb(
+      "/apollo/modules/control/controllers/lat_based_lqr_controller/"
+      "lateral_controller_test/1_chassis.pb.txt");
+  chassis_pb.set_gear_location(canbus::Chassis::GEAR_REVERSE);
+  FLAGS_enable_map_reference_unify = false;
+  injector_->vehicle_state()->Update(localization_pb, chassis_pb);
+
+  for (const bool reverse_heading_control : {false, true}) {
+    FLAGS_reverse_heading_control = reverse_heading_control;
+    BuildGainTables();
+    ASSERT_FALSE(reverse_gain_table_.empty());
+    for (const double speed : {-0.5, -1.23, -3.0}) {
+      // as in ComputeControlCommand
+      UpdateGearCoefficients(true);
+      UpdateDrivingOrientation();
+      UpdateMatrix(true, speed);
+      UpdateMatrixCompound();
+      Matrix matrix_k_solved;
+      uint num_iteration = 0;
+      double result_diff = 0.0;
+      common::math::SolveLQRProblem(
+          matrix_adc_, matrix_bdc_, UpdateMatrixQ(true, speed), matrix_r_,
+          lqr_eps_, lqr_max_iteration_, &matrix_k_solved, &num_iteration,
+          &result_diff);
+
+      Matrix matrix_k_table;
+      ASSERT_TRUE(reverse_gain_table_.Interpolate(speed, &matrix_k_table));
+      EXPECT_LT((matrix_k_solved - matrix_k_table).cwiseAbs().maxCoeff(),
+                1e-2 * matrix_k_solved.cwiseAbs().maxCoeff())
+          << "speed " << speed << ", reverse_heading_control "
+          << reverse_heading_control;
+    }
+  }
+  FLAGS_reverse_heading_control = false;
+}
+
 }  // namespace control
 }  // namespace apollo
@@ -37,6 +37,7 @@ using apollo::common::ErrorCode;
 using apollo::common::Status;
 using apollo::common::TrajectoryPoint;
 using apollo::common::VehicleStateProvider;
+using apollo::common::math::GridInterpolation2D;
 using apollo::cyber::Time;
 using apollo::external_command::CommandStatusType;
 using apollo::planning::ADCTrajectory;
@@ -155,13 +156,13 @@ void LonController::SetDigitalFilterPitchAngle() {
 void LonController::InitControlCalibrationTable() {
   AINFO << "Control calibration table size is "
         << calibration_table_.calibration_size();
-  Interpolation2D::DataType xyz;
+  GridInterpolation2D::DataType xyz;
   for (const auto &calibration : calibration_table_.calibration()) {
     xyz.push_back(std::make_tuple(calibration.speed(),
                                   calibration.acceleration(),
                                   calibration.command()));
   }
-  control_interpolation_.reset(new Interpolation2D);
+  control_interpolation_.reset(new GridInterpolation2D);
   ACHECK(control_interpolation_->Init(xyz))
       << "Fail to load control calibration table";
 }
@@ -33,7 +33,7 @@
 #include "cyber/plugin_manager/plugin_manager.h"
 #include "modules/common/filters/digital_filter.h"
 #include "modules/common/filters/digital_filter_coefficients.h"
-#include "modules/control/control_component/controller_task_base/common/interpolation_2d.h"
+#include "modules/common/math/grid_interpolation_2d.h"
 #include "modules/control/control_component/controller_task_base/common/leadlag_controller.h"
 #include "modules/control/control_component/controller_task_base/common/pid_controller.h"
 #include "modules/control/control_component/controller_task_base/common/trajectory_analyzer.h"
@@ -133,7 +133,7 @@ class LonController : public ControlTask {
   const localization::LocalizationEstimate *localization_ = nullptr;
   const canbus::Chassis *chassis_ = nullptr;
 
-  std::unique_ptr<Interpolation2D> control_interpolation_;
+  std::unique_ptr<common::math::GridInterpolation2D> control_interpolation_;
   const planning::ADCTrajectory *trajectory_message_ = nullptr;
   std::unique_ptr<TrajectoryAnalyzer> trajectory_analyzer_;
 
@@ -39,6 +39,7 @@ using apollo::common::ErrorCode;
 using apollo::common::Status;
 using apollo::common::TrajectoryPoint;
 using apollo::common::VehicleStateProvider;
+using apollo::common::math::GridInterpolation2D;
 using apollo::cyber::Clock;
 using Matrix = Eigen::MatrixXd;
 using apollo::common::VehicleConfigHelper;
@@ -339,17 +340,27 @@ Status MPCController::ComputeControlCommand(
     const canbus::Chassis *chassis,
     const planning::ADCTrajectory *planning_published_trajectory,
     ControlCommand *cmd) {
-  trajectory_analyzer_ =
-      std::move(TrajectoryAnalyzer(planning_published_trajectory));
   auto vehicle_state = injector_->vehicle_state();
 
   // Transform the coordinate of the planning trajectory from the center of the
   // rear-axis to the center of mass, if conditions matched
-  if (((control_conf_.trajectory_transform_to_com_reverse() &&
-        vehicle_state->gear() == canbus::Chassis::GEAR_REVERSE) ||
-       (control_conf_.trajectory_transform_to_com_reverse() &&
-        vehicle_state->gear() == canbus::Chassis::GEAR_DRIVE))) {
-    trajectory_analyzer_.TrajectoryTransformToCOM(lr_);
+  const bool transform_to_com =
+      (control_conf_.trajectory_transform_to_com_reverse() &&
+       vehicle_state->gear() == canbus::Chassis::GEAR_REVERSE) ||
+      (control_conf_.trajectory_transform_to_com_reverse() &&
+       vehicle_state->gear() == canbus::Chassis::GEAR_DRIVE);
+
+  // The analyzer and its index are kept as long as the trajectory is the same
+  if (trajectory_analyzer_.trajectory_points().empty() ||
+      trajectory_analyzer_.seq_num() !=
+          planning_published_trajectory->header().sequence_num() ||
+      trajectory_transformed_to_com_ != transform_to_com) {
+    trajectory_analyzer_ =
+        std::move(TrajectoryAnalyzer(planning_published_trajectory));
+    if (transform_to_com) {
+      trajectory_analyzer_.TrajectoryTransformToCOM(lr_);
+    }
+    trajectory_transformed_to_com_ = transform_to_com;
   }
 
   // Re-build the vehicle dynamic models at reverse driving (in particular,
@@ -710,13 +721,13 @@ Status MPCController::Reset() {
 void MPCController::InitControlCalibrationTable() {
   ADEBUG << "Control calibration table size is "
          << calibration_table_.calibration_size();
-  Interpolation2D::DataType xyz;
+  GridInterpolation2D::DataType xyz;
   for (const auto &calibration : calibration_table_.calibration()) {
     xyz.push_back(std::make_tuple(calibration.speed(),
                                   calibration.acceleration(),
                                   calibration.command()));
   }
-  control_interpolation_.reset(new Interpolation2D);
+  control_interpolation_.reset(new GridInterpolation2D);
   ACHECK(control_interpolation_->Init(xyz))
       << "Fail to init control calibration table";
 }
@@ -34,9 +34,9 @@
 #include "modules/common/filters/digital_filter.h"
 #include "modules/common/filters/digital_filter_coefficients.h"
 #include "modules/common/filters/mean_filter.h"
+#include "modules/common/math/grid_interpolation_2d.h"
 #include "modules/common/math/mpc_osqp.h"
 #include "modules/control/control_component/controller_task_base/common/interpolation_1d.h"
-#include "modules/control/control_component/controller_task_base/common/interpolation_2d.h"
 #include "modules/control/control_component/controller_task_base/common/leadlag_controller.h"
 #include "modules/control/control_component/controller_task_base/common/pid_controller.h"
 #include "modules/control/control_component/controller_task_base/common/trajectory_analyzer.h"
@@ -145,12 +145,14 @@ class MPCController : public ControlTask {
 
   // a proxy to analyze the planning trajectory
   TrajectoryAnalyzer trajectory_analyzer_;
+  // trajectory_analyzer_ is moved to the center of mass
+  bool trajectory_transformed_to_com_ = false;
 
   void InitControlCalibrationTable();
 
   void LoadMPCGainScheduler();
 
-  std::unique_ptr<Interpolation2D> control_interpolation_;
+  std::unique_ptr<common::math::GridInterpolation2D> control_interpolation_;
 
   MPCControllerConf control_conf_;
   calibration_table calibration_table_;
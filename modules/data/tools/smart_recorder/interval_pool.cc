@@ -116,5 +116,29 @@ Interval IntervalPool::GetNextInterval() const {
   return *pool_iter_;
 }
 
+std::vector<Interval> IntervalPool::GetIntervals(
+    const uint64_t begin_time, const uint64_t end_time) const {
+  std::vector<Interval> overlapped;
+  for (const auto& interval : pool_) {
+    if (interval.begin_time <= end_time && interval.end_time >= begin_time) {
+      overlapped.push_back(interval);
+    }
+  }
+  std::sort(overlapped.begin(), overlapped.end(),
+            [](const Interval& x, const Interval& y) {
+              return x.begin_time < y.begin_time;
+            });
+  std::vector<Interval> merged;
+  for (const auto& interval : overlapped) {
+    if (merged.empty() || interval.begin_time > merged.back().end_time) {
+      merged.push_back(interval);
+    } else {
+      merged.back().end_time =
+          std::max(merged.back().end_time, interval.end_time);
+    }
+  }
+  return merged;
+}
+
 }  // namespace data
 }  // namespace apollo
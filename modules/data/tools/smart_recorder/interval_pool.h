@@ -46,6 +46,9 @@ class IntervalPool {
   void Reset();
   void PrintIntervals() const;
   Interval GetNextInterval() const;
+  // Sorted and merged intervals overlapping [begin_time, end_time]
+  std::vector<Interval> GetIntervals(const uint64_t begin_time,
+                                     const uint64_t end_time) const;
   void SetIntervalEventLogFilePath(const std::string& path,
                                    const std::string& task_id) {
     interval_event_log_file_path_ = absl::StrCat(path, "_", task_id);
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/data/tools/smart_recorder/interval_pool.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace data {
+
+class IntervalPoolTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    pool_ = IntervalPool::Instance();
+    pool_->Reset();
+    // [10, 20] and [15, 40] overlap, the last interval is extended by the
+    // one added after it
+    pool_->AddInterval(10, 20);
+    pool_->AddInterval(30, 40);
+    pool_->AddInterval(15, 35);
+    // [100, 110] and [111, 120] are apart by one nanosecond
+    pool_->AddInterval(100, 110);
+    pool_->AddInterval(111, 120);
+    // [200, 210] and [210, 310] share their end
+    pool_->AddInterval(200, 210);
+    pool_->AddInterval(300, 310);
+    pool_->AddInterval(210, 220);
+  }
+
+  virtual void TearDown() { pool_->Reset(); }
+
+ protected:
+  void ExpectIntervals(const std::vector<Interval>& expected,
+                       const std::vector<Interval>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected[i].begin_time, actual[i].begin_time) << i;
+      EXPECT_EQ(expected[i].end_time, actual[i].end_time) << i;
+    }
+  }
+
+  IntervalPool* pool_ = nullptr;
+};
+
+TEST_F(IntervalPoolTest, merge_overlapping_and_adjacent) {
+  ExpectIntervals({{10, 40}, {100, 110}, {111, 120}, {200, 310}},
+                  pool_->GetIntervals(0, 1000));
+  ExpectIntervals({{200, 310}}, pool_->GetIntervals(205, 215));
+}
+
+// Only the intervals overlapping the range are merged, [10, 20] is not
+// part of [15, 40] from 40 on.
+TEST_F(IntervalPoolTest, bounds_are_inclusive) {
+  ExpectIntervals({{15, 40}, {100, 110}}, pool_->GetIntervals(40, 100));
+  ExpectIntervals({{111, 120}}, pool_->GetIntervals(115, 115));
+  ExpectIntervals({{210, 310}}, pool_->GetIntervals(310, 400));
+  ExpectIntervals({{10, 20}}, pool_->GetIntervals(0, 10));
+}
+
+TEST_F(IntervalPoolTest, out_of_range) {
+  EXPECT_TRUE(pool_->GetIntervals(0, 9).empty());
+  EXPECT_TRUE(pool_->GetIntervals(41, 99).empty());
+  EXPECT_TRUE(pool_->GetIntervals(121, 199).empty());
+  EXPECT_TRUE(pool_->GetIntervals(311, 1000).empty());
+
+  pool_->Reset();
+  EXPECT_TRUE(pool_->GetIntervals(0, 1000).empty());
+}
+
+}  // namespace data
+}  // namespace apollo
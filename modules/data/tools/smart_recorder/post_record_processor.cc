@@ -19,8 +19,12 @@
 #include <dirent.h>
 
 #include <algorithm>
+#include <deque>
+#include <future>
 #include <limits>
 #include <memory>
+#include <set>
+#include <utility>
 
 #include "absl/strings/str_cat.h"
 #include "cyber/common/file.h"
@@ -30,11 +34,13 @@
 
 #include "modules/data/tools/smart_recorder/channel_pool.h"
 #include "modules/data/tools/smart_recorder/interval_pool.h"
+#include "modules/data/tools/smart_recorder/smart_recorder_gflags.h"
 
 namespace apollo {
 namespace data {
 
 using cyber::common::DirectoryExists;
+using cyber::record::RecordMessage;
 using cyber::record::RecordReader;
 using cyber::record::RecordViewer;
 using cyber::record::RecordWriter;
@@ -54,46 +60,115 @@ bool PostRecordProcessor::Init(const SmartRecordTrigger& trigger_conf) {
     AERROR << "base init failed";
     return false;
   }
+  static constexpr double kSecondsToNanoSeconds = 1e9;
+  double max_backward_time = trigger_conf.max_backward_time();
+  for (const auto& trigger : trigger_conf.triggers()) {
+    max_backward_time = std::max(max_backward_time, trigger.backward_time());
+  }
+  max_backward_time_ =
+      static_cast<uint64_t>(max_backward_time * kSecondsToNanoSeconds);
   return true;
 }
 
 bool PostRecordProcessor::Process() {
-  // First scan, get intervals
-  for (const std::string& record : source_record_files_) {
-    const auto reader = std::make_shared<RecordReader>(
-        absl::StrCat(source_record_dir_, "/", record));
-    RecordViewer viewer(reader, 0,
-                        std::numeric_limits<uint64_t>::max(),
-                        ChannelPool::Instance()->GetAllChannels());
-    AINFO << record << ":" << viewer.begin_time() << " - " << viewer.end_time();
-    for (const auto& msg : viewer) {
+  const size_t scan_threads =
+      static_cast<size_t>(std::max(1, FLAGS_post_record_scan_threads));
+  std::deque<std::future<std::unique_ptr<RecordScan>>> scanning;
+  std::deque<std::unique_ptr<RecordScan>> scanned;
+  size_t next_record = 0;
+  uint64_t triggered_time = 0;
+  while (next_record < source_record_files_.size() || !scanning.empty()) {
+    while (next_record < source_record_files_.size() &&
+           scanning.size() < scan_threads) {
+      scanning.push_back(std::async(
+          std::launch::async, &PostRecordProcessor::ScanRecord,
+          absl::StrCat(source_record_dir_, "/",
+                       source_record_files_[next_record++])));
+    }
+    // Triggers pull the records in order, as they keep states across them
+    std::unique_ptr<RecordScan> scan = scanning.front().get();
+    scanning.pop_front();
+    for (const auto& msg : scan->messages) {
       for (const auto& trigger : triggers_) {
         trigger->Pull(msg);
       }
     }
+    triggered_time = std::max(triggered_time, scan->end_time);
+    scanned.push_back(std::move(scan));
+    // No interval added from now on begins before the max backward time
+    while (!scanned.empty() &&
+           scanned.front()->end_time + max_backward_time_ < triggered_time) {
+      RestoreRecord(*scanned.front());
+      scanned.pop_front();
+    }
+  }
+  for (const auto& scan : scanned) {
+    RestoreRecord(*scan);
   }
-  // Second scan, restore messages based on intervals in the first scan
-  IntervalPool::Instance()->ReorgIntervals();
   IntervalPool::Instance()->PrintIntervals();
-  for (const std::string& record : source_record_files_) {
-    const auto reader = std::make_shared<RecordReader>(
-        absl::StrCat(source_record_dir_, "/", record));
-    RecordViewer viewer(reader, 0,
-                        std::numeric_limits<uint64_t>::max(),
-                        ChannelPool::Instance()->GetAllChannels());
-    for (const auto& msg : viewer) {
-      // If the message fall into generated intervals,
-      // or required by any triggers, restore it
-      if (IntervalPool::Instance()->MessageFallIntoRange(msg.time) ||
-          ShouldRestore(msg)) {
-        writer_->WriteChannel(msg.channel_name,
-                              reader->GetMessageType(msg.channel_name),
-                              reader->GetProtoDesc(msg.channel_name));
-        writer_->WriteMessage(msg.channel_name, msg.content, msg.time);
+  return true;
+}
+
+std::unique_ptr<PostRecordProcessor::RecordScan>
+PostRecordProcessor::ScanRecord(const std::string& record) {
+  std::unique_ptr<RecordScan> scan(new RecordScan);
+  scan->reader = std::make_shared<RecordReader>(record);
+  RecordViewer viewer(scan->reader, 0, std::numeric_limits<uint64_t>::max(),
+                      ChannelPool::Instance()->GetAllChannels());
+  AINFO << record << ":" << viewer.begin_time() << " - " << viewer.end_time();
+  scan->begin_time = viewer.begin_time();
+  scan->end_time = viewer.end_time();
+  const std::set<std::string>& small_channels =
+      ChannelPool::Instance()->GetSmallChannels();
+  for (const auto& msg : viewer) {
+    if (small_channels.find(msg.channel_name) != small_channels.end()) {
+      scan->messages.push_back(msg);
+    } else {
+      scan->messages.emplace_back(msg.channel_name, std::string(), msg.time);
+    }
+  }
+  return scan;
+}
+
+void PostRecordProcessor::RestoreRecord(const RecordScan& scan) {
+  const std::vector<Interval> intervals =
+      IntervalPool::Instance()->GetIntervals(scan.begin_time, scan.end_time);
+  auto msg = scan.messages.begin();
+  for (const auto& interval : intervals) {
+    // Outside of the intervals, only the small channels required by any
+    // triggers are restored, which are kept by the scan
+    for (; msg != scan.messages.end() && msg->time < interval.begin_time;
+         ++msg) {
+      if (ShouldRestore(*msg)) {
+        WriteMessage(*scan.reader, *msg);
       }
     }
+    // Within an interval every message is restored, the chunks are read again
+    // for the content of the large channels
+    RecordViewer viewer(scan.reader, interval.begin_time, interval.end_time,
+                        ChannelPool::Instance()->GetAllChannels());
+    for (const auto& restored : viewer) {
+      WriteMessage(*scan.reader, restored);
+    }
+    while (msg != scan.messages.end() && msg->time <= interval.end_time) {
+      ++msg;
+    }
   }
-  return true;
+  for (; msg != scan.messages.end(); ++msg) {
+    if (ShouldRestore(*msg)) {
+      WriteMessage(*scan.reader, *msg);
+    }
+  }
+}
+
+void PostRecordProcessor::WriteMessage(const RecordReader& reader,
+                                       const RecordMessage& msg) {
+  if (writer_->IsNewChannel(msg.channel_name)) {
+    writer_->WriteChannel(msg.channel_name,
+                          reader.GetMessageType(msg.channel_name),
+                          reader.GetProtoDesc(msg.channel_name));
+  }
+  writer_->WriteMessage(msg.channel_name, msg.content, msg.time);
 }
 
 std::string PostRecordProcessor::GetDefaultOutputFile() const {
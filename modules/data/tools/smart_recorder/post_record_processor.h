@@ -16,9 +16,13 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "cyber/record/record_message.h"
+#include "cyber/record/record_reader.h"
+
 #include "modules/data/tools/smart_recorder/proto/smart_recorder_triggers.pb.h"
 #include "modules/data/tools/smart_recorder/record_processor.h"
 
@@ -28,6 +32,13 @@ namespace data {
 /**
  * @class PostRecordProcessor
  * @brief Post processor against recorded tasks that have been completed
+ *
+ * Each record is read once by a pool of scanners, which keep the time of
+ * every message and the content of the small channels only. The triggers
+ * pull the scanned messages record by record in order, and a record is
+ * restored once the triggers are past its end by the max backward time, so
+ * no later trigger can reach back into it. Only the chunks of the large
+ * channels falling into the intervals are read again.
  */
 class PostRecordProcessor : public RecordProcessor {
  public:
@@ -40,9 +51,23 @@ class PostRecordProcessor : public RecordProcessor {
   virtual ~PostRecordProcessor() = default;
 
  private:
+  // A source record read once, the content of the large channels is dropped
+  struct RecordScan {
+    std::shared_ptr<cyber::record::RecordReader> reader;
+    uint64_t begin_time = 0;
+    uint64_t end_time = 0;
+    std::vector<cyber::record::RecordMessage> messages;
+  };
+
   void LoadSourceRecords();
+  static std::unique_ptr<RecordScan> ScanRecord(const std::string& record);
+  void RestoreRecord(const RecordScan& scan);
+  void WriteMessage(const cyber::record::RecordReader& reader,
+                    const cyber::record::RecordMessage& msg);
 
   std::vector<std::string> source_record_files_;
+  // Longest time a trigger reaches back, in nanoseconds
+  uint64_t max_backward_time_ = 0;
 };
 
 }  // namespace data
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/data/tools/smart_recorder/post_record_processor.h"
+
+#include <dirent.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/file.h"
+#include "cyber/record/record_reader.h"
+#include "cyber/record/record_viewer.h"
+#include "cyber/record/record_writer.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/data/tools/smart_recorder/interval_pool.h"
+
+namespace apollo {
+namespace data {
+
+using cyber::record::RecordReader;
+using cyber::record::RecordViewer;
+using cyber::record::RecordWriter;
+
+namespace {
+
+constexpr char kSourceDir[] = "/tmp/post_record_processor_test/source";
+constexpr char kRestoredDir[] = "/tmp/post_record_processor_test/restored";
+constexpr char kMessageType[] = "apollo.cyber.proto.Test";
+constexpr uint64_t kRecordMessageNum = 10;
+constexpr uint64_t kTimeStep = 100;
+
+// Messages of a small and a large channel every kTimeStep from begin_time
+void WriteSourceRecord(const std::string& file, const uint64_t begin_time) {
+  RecordWriter writer;
+  writer.SetSizeOfFileSegmentation(0);
+  writer.SetIntervalOfFileSegmentation(0);
+  ASSERT_TRUE(writer.Open(file));
+  writer.WriteChannel(FLAGS_chassis_topic, kMessageType, "");
+  writer.WriteChannel(FLAGS_pointcloud_16_topic, kMessageType, "");
+  for (uint64_t i = 0; i < kRecordMessageNum; ++i) {
+    const uint64_t time = begin_time + i * kTimeStep;
+    writer.WriteMessage(FLAGS_chassis_topic, std::to_string(time), time);
+    writer.WriteMessage(FLAGS_pointcloud_16_topic, std::to_string(time),
+                        time);
+  }
+  writer.Close();
+}
+
+}  // namespace
+
+class PostRecordProcessorTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    cyber::common::DeleteFile("/tmp/post_record_processor_test");
+    ASSERT_TRUE(cyber::common::EnsureDirectory(kSourceDir));
+    WriteSourceRecord(std::string(kSourceDir) + "/test.record.00000", 1000);
+    WriteSourceRecord(std::string(kSourceDir) + "/test.record.00001", 2000);
+
+    trigger_conf_.mutable_segment_setting()->set_size_segment(0);
+    trigger_conf_.mutable_segment_setting()->set_time_segment(0);
+    trigger_conf_.set_max_backward_time(0.0);
+    trigger_conf_.set_trigger_log_file_path(
+        "/tmp/post_record_processor_test/trigger.log");
+    for (const char* name :
+         {"BumperCrashTrigger", "DriveEventTrigger", "EmergencyModeTrigger",
+          "HardBrakeTrigger", "RegularIntervalTrigger", "SmallTopicsTrigger",
+          "SwerveTrigger"}) {
+      auto* trigger = trigger_conf_.add_triggers();
+      trigger->set_trigger_name(name);
+      // only the small channels are restored out of the intervals
+      trigger->set_enabled(trigger->trigger_name() == "SmallTopicsTrigger");
+    }
+  }
+
+  virtual void TearDown() { IntervalPool::Instance()->Reset(); }
+
+ protected:
+  // Number of times each (channel, time) is restored
+  std::map<std::pair<std::string, uint64_t>, int> RestoredMessages() const {
+    std::map<std::pair<std::string, uint64_t>, int> restored;
+    for (const auto& file : cyber::common::ListSubPaths(kRestoredDir, DT_REG)) {
+      auto reader =
+          std::make_shared<RecordReader>(std::string(kRestoredDir) + "/" +
+                                         file);
+      for (const auto& msg : RecordViewer(reader)) {
+        EXPECT_EQ(std::to_string(msg.time), msg.content);
+        ++restored[std::make_pair(msg.channel_name, msg.time)];
+      }
+    }
+    return restored;
+  }
+
+  SmartRecordTrigger trigger_conf_;
+};
+
+TEST_F(PostRecordProcessorTest, restore_intervals_once) {
+  {
+    PostRecordProcessor processor(kSourceDir, kRestoredDir);
+    ASSERT_TRUE(processor.Init(trigger_conf_));
+    // Init resets the pool. The intervals begin or end on messages, and
+    // the second one spans the two records.
+    IntervalPool::Instance()->AddInterval(1200, 1400);
+    IntervalPool::Instance()->AddInterval(1900, 2100);
+    IntervalPool::Instance()->AddInterval(2900, 3500);
+    ASSERT_TRUE(processor.Process());
+  }
+
+  const auto restored = RestoredMessages();
+  std::map<std::pair<std::string, uint64_t>, int> expected;
+  for (uint64_t time = 1000; time < 3000; time += kTimeStep) {
+    expected[std::make_pair(FLAGS_chassis_topic, time)] = 1;
+  }
+  for (uint64_t time : {1200, 1300, 1400, 1900, 2000, 2100, 2900}) {
+    expected[std::make_pair(FLAGS_pointcloud_16_topic, time)] = 1;
+  }
+  EXPECT_EQ(expected, restored);
+}
+
+TEST_F(PostRecordProcessorTest, restore_no_interval) {
+  {
+    PostRecordProcessor processor(kSourceDir, kRestoredDir);
+    ASSERT_TRUE(processor.Init(trigger_conf_));
+    ASSERT_TRUE(processor.Process());
+  }
+
+  const auto restored = RestoredMessages();
+  ASSERT_EQ(2 * kRecordMessageNum, restored.size());
+  for (const auto& msg : restored) {
+    EXPECT_EQ(FLAGS_chassis_topic, msg.first.first);
+    EXPECT_EQ(1, msg.second);
+  }
+}
+
+}  // namespace data
+}  // namespace apollo
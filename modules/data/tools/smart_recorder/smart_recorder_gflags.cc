@@ -23,3 +23,5 @@ DEFINE_string(smart_recorder_config_filename,
               "smart_recorder_config.pb.txt",
               "The config file.");
 DEFINE_bool(real_time_trigger, true, "Whether to use realtime trigger.");
+DEFINE_int32(post_record_scan_threads, 4,
+             "Number of records scanned in parallel by the post processor.");
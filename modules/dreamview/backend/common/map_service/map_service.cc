@@ -92,6 +92,7 @@ bool MapService::ReloadMap(bool force_reload) {
   bool ret = true;
   if (force_reload) {
     ret = HDMapUtil::ReloadMaps();
+    ++map_version_;
   }
 
   // Update the x,y-offsets if present.
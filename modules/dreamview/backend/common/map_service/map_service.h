@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -96,6 +97,10 @@ class MapService {
   // Reload map from current FLAGS_map_dir.
   bool ReloadMap(bool force_reload);
 
+  // Number of times the map has been reloaded, the data retrieved from the
+  // map is stale once it changes.
+  uint64_t MapVersion() const { return map_version_.load(); }
+
   size_t CalculateMapHash(const MapElementIds &ids) const;
 
   double GetLaneHeading(const std::string &id_str, double s);
@@ -138,6 +143,8 @@ class MapService {
 
   // RW lock to protect map data
   mutable boost::shared_mutex mutex_;
+
+  std::atomic<uint64_t> map_version_{0};
 };
 
 }  // namespace dreamview
@@ -15,15 +15,17 @@
  *****************************************************************************/
 #pragma once
 
-#include <map>
-#include <memory>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/grid_interpolation_2d.h"
+
 namespace apollo {
 namespace dreamview {
 
+// The (speed, acceleration, command) calibration table looked up by
+// (speed, command), on the dense grid of common::math.
 class Interpolation2D {
  public:
   typedef std::vector<std::tuple<double, double, double>> DataType;
@@ -37,14 +39,7 @@ class Interpolation2D {
   double Interpolate(const KeyType& xy) const;
 
  private:
-  double InterpolateYz(const std::map<double, double>& yz_table,
-                       double y) const;
-
-  double InterpolateValue(const double value_before, const double dist_before,
-                          const double value_after,
-                          const double dist_after) const;
-
-  std::map<double, std::map<double, double>> _xyz;
+  common::math::GridInterpolation2D grid_;
 };
 
 }  // namespace dreamview
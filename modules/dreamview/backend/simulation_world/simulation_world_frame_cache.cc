@@ -0,0 +1,161 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_frame_cache.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include "google/protobuf/util/message_differencer.h"
+
+namespace apollo {
+namespace dreamview {
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::util::MessageDifferencer;
+
+void SimulationWorldFrameCache::Add(std::shared_ptr<SimulationWorld> world) {
+  auto frame = std::make_shared<Frame>();
+
+  auto wire_format_with_planning_data =
+      std::make_shared<const std::string>(world->SerializeAsString());
+  if (world->has_planning_data()) {
+    frame->planning_data.reset(world->release_planning_data());
+    frame->wire_format =
+        std::make_shared<const std::string>(world->SerializeAsString());
+  } else {
+    frame->wire_format = wire_format_with_planning_data;
+  }
+  frame->wire_format_with_planning_data =
+      std::move(wire_format_with_planning_data);
+  frame->objects.Swap(world->mutable_object());
+  frame->header.Swap(world.get());
+
+  std::shared_ptr<Frame> previous;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!frames_.empty()) {
+      previous = frames_.back();
+    }
+  }
+  // Most of the clients have received the previous frame.
+  if (previous != nullptr) {
+    frame->deltas[std::make_pair(previous->header.sequence_num(), false)] =
+        SerializeDelta(*previous, *frame, false);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  frames_.push_back(std::move(frame));
+  while (frames_.size() > kFrameNum) {
+    frames_.pop_front();
+  }
+}
+
+std::shared_ptr<const std::string> SimulationWorldFrameCache::GetFrame(
+    bool with_planning_data) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (frames_.empty()) {
+    return nullptr;
+  }
+  return with_planning_data ? frames_.back()->wire_format_with_planning_data
+                            : frames_.back()->wire_format;
+}
+
+std::shared_ptr<const std::string> SimulationWorldFrameCache::GetDelta(
+    uint32_t base_sequence_num, bool with_planning_data) {
+  const auto key = std::make_pair(base_sequence_num, with_planning_data);
+  std::shared_ptr<Frame> base;
+  std::shared_ptr<Frame> frame;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frames_.empty()) {
+      return nullptr;
+    }
+    frame = frames_.back();
+    auto iter = frame->deltas.find(key);
+    if (iter != frame->deltas.end()) {
+      return iter->second;
+    }
+    for (const auto &cached : frames_) {
+      if (cached->header.sequence_num() == base_sequence_num) {
+        base = cached;
+        break;
+      }
+    }
+  }
+  if (base == nullptr) {
+    return with_planning_data ? frame->wire_format_with_planning_data
+                              : frame->wire_format;
+  }
+
+  // Serialized without the lock, a delta requested by two clients at once
+  // is serialized twice and either one is kept.
+  auto delta = SerializeDelta(*base, *frame, with_planning_data);
+  std::lock_guard<std::mutex> lock(mutex_);
+  frame->deltas.emplace(key, delta);
+  return delta;
+}
+
+std::shared_ptr<const std::string> SimulationWorldFrameCache::SerializeDelta(
+    const Frame &base, const Frame &frame, bool with_planning_data) {
+  SimulationWorld delta(frame.header);
+  delta.set_delta_base_sequence_num(base.header.sequence_num());
+
+  const auto *descriptor = SimulationWorld::descriptor();
+  const auto *reflection = SimulationWorld::GetReflection();
+  MessageDifferencer differencer;
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const FieldDescriptor *field = descriptor->field(i);
+    const bool is_set = field->is_repeated()
+                            ? reflection->FieldSize(frame.header, field) > 0
+                            : reflection->HasField(frame.header, field);
+    const std::vector<const FieldDescriptor *> fields = {field};
+    if (is_set &&
+        differencer.CompareWithFields(base.header, frame.header, fields,
+                                      fields)) {
+      reflection->ClearField(&delta, field);
+      delta.add_unchanged_field(field->number());
+    }
+  }
+
+  // Objects are unique by id, those sharing an id in the base are always
+  // sent.
+  std::unordered_map<std::string, const Object *> base_objects;
+  for (const auto &object : base.objects) {
+    auto result = base_objects.emplace(object.id(), &object);
+    if (!result.second) {
+      result.first->second = nullptr;
+    }
+  }
+  for (const auto &object : frame.objects) {
+    auto iter = base_objects.find(object.id());
+    if (!object.id().empty() && iter != base_objects.end() &&
+        iter->second != nullptr &&
+        MessageDifferencer::Equals(*iter->second, object)) {
+      delta.add_unchanged_object_id(object.id());
+    } else {
+      *delta.add_object() = object;
+    }
+  }
+
+  if (with_planning_data && frame.planning_data != nullptr) {
+    *delta.mutable_planning_data() = *frame.planning_data;
+  }
+  return std::make_shared<const std::string>(delta.SerializeAsString());
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "modules/common_msgs/dreamview_msgs/simulation_world.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class SimulationWorldFrameCache
+ * @brief The last frames of SimulationWorld in wire format, shared by all the
+ * websocket connections.
+ *
+ * A frame is serialized once when it is added, with and without planning
+ * data. A client which acknowledges a frame it has received gets a delta
+ * against it instead, see delta_base_sequence_num in SimulationWorld. Deltas
+ * are serialized on first request and kept with their frame, so the clients
+ * at the same frame share them too.
+ */
+class SimulationWorldFrameCache {
+ public:
+  // Number of frames kept as the base of deltas, one second of updates.
+  static constexpr size_t kFrameNum = 10;
+
+  /**
+   * @brief Adds the latest frame and serializes it. Called by a single
+   * thread, off the timer which updates the SimulationWorld.
+   * @param world the frame, which is taken apart.
+   */
+  void Add(std::shared_ptr<SimulationWorld> world);
+
+  /**
+   * @brief Returns the latest frame in wire format, nullptr if none has been
+   * added yet.
+   */
+  std::shared_ptr<const std::string> GetFrame(bool with_planning_data) const;
+
+  /**
+   * @brief Returns the delta of the latest frame against the frame of
+   * base_sequence_num in wire format, or the latest frame if that one is no
+   * longer cached. nullptr if no frame has been added yet.
+   */
+  std::shared_ptr<const std::string> GetDelta(uint32_t base_sequence_num,
+                                              bool with_planning_data);
+
+ private:
+  struct Frame {
+    // The world without object and planning_data.
+    SimulationWorld header;
+    google::protobuf::RepeatedPtrField<Object> objects;
+    std::unique_ptr<apollo::planning_internal::PlanningData> planning_data;
+
+    std::shared_ptr<const std::string> wire_format;
+    std::shared_ptr<const std::string> wire_format_with_planning_data;
+
+    // Deltas of the frame by base sequence num and with planning data,
+    // guarded by mutex_.
+    std::map<std::pair<uint32_t, bool>, std::shared_ptr<const std::string>>
+        deltas;
+  };
+
+  static std::shared_ptr<const std::string> SerializeDelta(
+      const Frame &base, const Frame &frame, bool with_planning_data);
+
+  // Oldest first.
+  std::deque<std::shared_ptr<Frame>> frames_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_frame_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+void AddObject(const std::string &id, double x, SimulationWorld *world) {
+  Object *object = world->add_object();
+  object->set_id(id);
+  object->set_position_x(x);
+  object->set_position_y(0.0);
+}
+
+std::shared_ptr<SimulationWorld> World(uint32_t sequence_num) {
+  auto world = std::make_shared<SimulationWorld>();
+  world->set_sequence_num(sequence_num);
+  world->set_timestamp(100.0 * sequence_num);
+  world->mutable_auto_driving_car()->set_position_x(sequence_num);
+  world->set_engage_advice("READY_TO_ENGAGE");
+  return world;
+}
+
+SimulationWorld Parse(const std::shared_ptr<const std::string> &wire_format) {
+  SimulationWorld world;
+  EXPECT_NE(nullptr, wire_format);
+  EXPECT_TRUE(world.ParseFromString(*wire_format));
+  return world;
+}
+
+}  // namespace
+
+TEST(SimulationWorldFrameCacheTest, GetFrame) {
+  SimulationWorldFrameCache cache;
+  EXPECT_EQ(nullptr, cache.GetFrame(false));
+  EXPECT_EQ(nullptr, cache.GetDelta(0, false));
+
+  auto world = World(1);
+  AddObject("1", 1.0, world.get());
+  world->mutable_planning_data()->mutable_init_point()->set_v(1.0);
+  cache.Add(world);
+
+  const SimulationWorld frame = Parse(cache.GetFrame(false));
+  EXPECT_EQ(1, frame.sequence_num());
+  EXPECT_EQ(1, frame.object_size());
+  EXPECT_FALSE(frame.has_planning_data());
+  EXPECT_FALSE(frame.has_delta_base_sequence_num());
+
+  const SimulationWorld frame_with_planning_data =
+      Parse(cache.GetFrame(true));
+  EXPECT_EQ(1, frame_with_planning_data.object_size());
+  EXPECT_TRUE(frame_with_planning_data.has_planning_data());
+}
+
+TEST(SimulationWorldFrameCacheTest, GetDelta) {
+  SimulationWorldFrameCache cache;
+  auto base = World(1);
+  AddObject("still", 1.0, base.get());
+  AddObject("moving", 2.0, base.get());
+  AddObject("gone", 3.0, base.get());
+  cache.Add(base);
+
+  auto world = World(2);
+  AddObject("still", 1.0, world.get());
+  AddObject("moving", 2.5, world.get());
+  AddObject("new", 4.0, world.get());
+  world->mutable_planning_data()->mutable_init_point()->set_v(1.0);
+  cache.Add(world);
+
+  const SimulationWorld delta = Parse(cache.GetDelta(1, false));
+  EXPECT_EQ(1, delta.delta_base_sequence_num());
+  EXPECT_EQ(2, delta.sequence_num());
+  EXPECT_DOUBLE_EQ(200.0, delta.timestamp());
+  EXPECT_DOUBLE_EQ(2.0, delta.auto_driving_car().position_x());
+  EXPECT_FALSE(delta.has_engage_advice());
+  ASSERT_EQ(1, delta.unchanged_field_size());
+  EXPECT_EQ(SimulationWorld::kEngageAdviceFieldNumber,
+            delta.unchanged_field(0));
+  ASSERT_EQ(1, delta.unchanged_object_id_size());
+  EXPECT_EQ("still", delta.unchanged_object_id(0));
+  ASSERT_EQ(2, delta.object_size());
+  EXPECT_EQ("moving", delta.object(0).id());
+  EXPECT_DOUBLE_EQ(2.5, delta.object(0).position_x());
+  EXPECT_EQ("new", delta.object(1).id());
+  EXPECT_FALSE(delta.has_planning_data());
+
+  const SimulationWorld delta_with_planning_data =
+      Parse(cache.GetDelta(1, true));
+  EXPECT_EQ(1, delta_with_planning_data.delta_base_sequence_num());
+  EXPECT_TRUE(delta_with_planning_data.has_planning_data());
+
+  // The same delta is shared by the clients at the same frame.
+  EXPECT_EQ(cache.GetDelta(1, true), cache.GetDelta(1, true));
+}
+
+TEST(SimulationWorldFrameCacheTest, GetDeltaOfUncachedFrame) {
+  SimulationWorldFrameCache cache;
+  for (uint32_t i = 1; i <= SimulationWorldFrameCache::kFrameNum + 1; ++i) {
+    cache.Add(World(i));
+  }
+  const SimulationWorld frame = Parse(cache.GetDelta(1, false));
+  EXPECT_FALSE(frame.has_delta_base_sequence_num());
+  EXPECT_EQ(SimulationWorldFrameCache::kFrameNum + 1, frame.sequence_num());
+  EXPECT_TRUE(frame.has_engage_advice());
+
+  const SimulationWorld delta = Parse(cache.GetDelta(2, false));
+  EXPECT_EQ(2, delta.delta_base_sequence_num());
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -479,6 +479,20 @@ void SimulationWorldService::GetWireFormatString(
   world_.SerializeToString(sim_world);
 }
 
+void SimulationWorldService::GetWorldSnapshot(double radius,
+                                              SimulationWorld *world) {
+  PopulateMapInfo(radius);
+
+  std::unique_ptr<apollo::planning_internal::PlanningData> planning_data;
+  if (world_.has_planning_data()) {
+    planning_data.reset(world_.release_planning_data());
+  }
+  *world = world_;
+  if (planning_data != nullptr) {
+    world->set_allocated_planning_data(planning_data.release());
+  }
+}
+
 Json SimulationWorldService::GetUpdateAsJson(double radius) const {
   std::string sim_world_json_string;
   MessageToJsonString(world_, &sim_world_json_string);
@@ -114,6 +114,15 @@ class SimulationWorldService {
   void GetWireFormatString(double radius, std::string *sim_world,
                            std::string *sim_world_with_planning_data);
 
+  /**
+   * @brief Copies the SimulationWorld object with the map element ids
+   * within the given radius from the car. The planning data is moved into
+   * the copy, it is only sent once like with GetWireFormatString.
+   * @param radius the search distance from the current car location.
+   * @param world output of the SimulationWorld object.
+   */
+  void GetWorldSnapshot(double radius, SimulationWorld *world);
+
   /**
    * @brief Returns the json representation of the map element Ids and hash
    * within the given radius from the car.
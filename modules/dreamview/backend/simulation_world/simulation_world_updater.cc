@@ -16,6 +16,8 @@
 
 #include "modules/dreamview/backend/simulation_world/simulation_world_updater.h"
 
+#include <chrono>
+
 #include "google/protobuf/util/json_util.h"
 
 #include "cyber/common/file.h"
@@ -71,6 +73,13 @@ SimulationWorldUpdater::SimulationWorldUpdater(
   RegisterMessageHandlers();
 }
 
+SimulationWorldUpdater::~SimulationWorldUpdater() {
+  timer_.reset();
+  if (serialize_future_.valid()) {
+    serialize_future_.wait();
+  }
+}
+
 void SimulationWorldUpdater::RegisterMessageHandlers() {
   // Send current sim_control status to the new client.
   websocket_->RegisterConnectionReadyHandler(
@@ -87,13 +96,10 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         auto iter = json.find("elements");
         if (iter != json.end()) {
           MapElementIds map_element_ids;
-          if (JsonStringToMessage(iter->dump(), &map_element_ids).ok()) {
-            auto retrieved = map_service_->RetrieveMapElements(map_element_ids);
-
-            std::string retrieved_map_string;
-            retrieved.SerializeToString(&retrieved_map_string);
-
-            map_ws_->SendBinaryData(conn, retrieved_map_string, true);
+          const std::string request = iter->dump();
+          if (JsonStringToMessage(request, &map_element_ids).ok()) {
+            auto retrieved = RetrieveMapData(request, map_element_ids);
+            map_ws_->SendBinaryData(conn, *retrieved, true);
           } else {
             AERROR << "Failed to parse MapElementIds from json";
           }
@@ -294,20 +300,25 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         if (planning != json.end() && planning->is_boolean()) {
           enable_pnc_monitor = json["planning"];
         }
-        std::string to_send;
-        {
-          // Pay the price to copy the data instead of sending data over the
-          // wire while holding the lock.
-          boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
-          to_send = enable_pnc_monitor ? simulation_world_with_planning_data_
-                                       : simulation_world_;
+        // A client acknowledging the last frame it has received gets a delta
+        // against it.
+        std::shared_ptr<const std::string> to_send;
+        auto ack = json.find("ackSequenceNum");
+        if (ack != json.end() && ack->is_number_unsigned()) {
+          to_send = frame_cache_.GetDelta(ack->get<uint32_t>(),
+                                          enable_pnc_monitor);
+        } else {
+          to_send = frame_cache_.GetFrame(enable_pnc_monitor);
+        }
+        if (to_send == nullptr) {
+          return;
         }
         if (FLAGS_enable_update_size_check && !enable_pnc_monitor &&
-            to_send.size() > FLAGS_max_update_size) {
-          AWARN << "update size is too big:" << to_send.size();
+            to_send->size() > FLAGS_max_update_size) {
+          AWARN << "update size is too big:" << to_send->size();
           return;
         }
-        websocket_->SendBinaryData(conn, to_send, true);
+        websocket_->SendBinaryData(conn, *to_send, true);
       });
 
   websocket_->RegisterMessageHandler(
@@ -719,12 +730,49 @@ void SimulationWorldUpdater::OnTimer() {
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
     last_pushed_adc_timestamp_sec_ =
         sim_world_service_.world().auto_driving_car().timestamp_sec();
-    sim_world_service_.GetWireFormatString(
-        FLAGS_sim_map_radius, &simulation_world_,
-        &simulation_world_with_planning_data_);
     sim_world_service_.GetRelativeMap().SerializeToString(
         &relative_map_string_);
   }
+
+  // Skip this frame if the last one is still being serialized.
+  if (serialize_future_.valid() &&
+      serialize_future_.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+    AWARN_EVERY(100) << "Serialization of simulation world is behind.";
+    return;
+  }
+  auto world = std::make_shared<SimulationWorld>();
+  sim_world_service_.GetWorldSnapshot(FLAGS_sim_map_radius, world.get());
+  serialize_future_ =
+      cyber::Async(&SimulationWorldFrameCache::Add, &frame_cache_, world);
+}
+
+std::shared_ptr<const std::string> SimulationWorldUpdater::RetrieveMapData(
+    const std::string &request, const MapElementIds &map_element_ids) {
+  const uint64_t map_version = map_service_->MapVersion();
+  {
+    std::lock_guard<std::mutex> lock(map_data_mutex_);
+    if (map_data_cache_version_ != map_version) {
+      map_data_cache_.clear();
+      map_data_cache_version_ = map_version;
+    }
+    auto iter = map_data_cache_.find(request);
+    if (iter != map_data_cache_.end()) {
+      return iter->second;
+    }
+  }
+
+  auto retrieved = std::make_shared<const std::string>(
+      map_service_->RetrieveMapElements(map_element_ids).SerializeAsString());
+
+  std::lock_guard<std::mutex> lock(map_data_mutex_);
+  if (map_data_cache_version_ == map_version) {
+    if (map_data_cache_.size() >= kMapDataCacheSize) {
+      map_data_cache_.clear();
+    }
+    map_data_cache_.emplace(request, retrieved);
+  }
+  return retrieved;
 }
 
 bool SimulationWorldUpdater::LoadPOI() {
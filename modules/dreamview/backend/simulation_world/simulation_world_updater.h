@@ -20,8 +20,11 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/thread/locks.hpp>
@@ -41,6 +44,7 @@
 #include "modules/dreamview/backend/perception_camera_updater/perception_camera_updater.h"
 #include "modules/dreamview/backend/common/plugins/plugin_manager.h"
 #include "modules/common_msgs/localization_msgs/localization.pb.h"
+#include "modules/dreamview/backend/simulation_world/simulation_world_frame_cache.h"
 #include "modules/dreamview/backend/simulation_world/simulation_world_service.h"
 
 /**
@@ -75,6 +79,8 @@ class SimulationWorldUpdater {
                          PluginManager *plugin_manager,
                          bool routing_from_file = false);
 
+  ~SimulationWorldUpdater();
+
   /**
    * @brief Starts to push simulation_world to frontend.
    */
@@ -84,15 +90,25 @@ class SimulationWorldUpdater {
   // frontend.
   static constexpr double kSimWorldTimeIntervalMs = 100;
 
+  // Number of serialized responses of RetrieveMapData kept.
+  static constexpr size_t kMapDataCacheSize = 16;
+
   double LastAdcTimestampSec() { return last_pushed_adc_timestamp_sec_; }
 
  private:
   /**
    * @brief The callback function to get updates from SimulationWorldService,
-   * and update simulation_world_json_.
+   * and hand a snapshot of it to frame_cache_ for serialization.
    */
   void OnTimer();
 
+  /**
+   * @brief Returns the map elements of the given ids in wire format, which
+   * are cached by the requested ids until the map is reloaded.
+   */
+  std::shared_ptr<const std::string> RetrieveMapData(
+      const std::string &request, const MapElementIds &map_element_ids);
+
   /**
    * @brief The function to construct a LaneFollowCommand from the given json,
    * @param json that contains start, end, and waypoints
@@ -198,14 +214,22 @@ class SimulationWorldUpdater {
   apollo::routing::POI park_go_routings_;
 
   // The simulation_world in wire format to be pushed to frontend, which is
-  // updated by timer.
-  std::string simulation_world_;
-  std::string simulation_world_with_planning_data_;
+  // updated by timer and serialized off it, serialize_future_ being the
+  // pending serialization.
+  SimulationWorldFrameCache frame_cache_;
+  std::future<void> serialize_future_;
+
+  // Serialized responses of RetrieveMapData by the requested ids, and the
+  // map version they are retrieved from.
+  std::unordered_map<std::string, std::shared_ptr<const std::string>>
+      map_data_cache_;
+  uint64_t map_data_cache_version_ = 0;
+  std::mutex map_data_mutex_;
 
   // Received relative map data in wire format.
   std::string relative_map_string_;
 
-  // Mutex to protect concurrent access to simulation_world_json_.
+  // Mutex to protect concurrent access to relative_map_string_.
   // NOTE: Use boost until we have std version of rwlock support.
   boost::shared_mutex mutex_;
 
@@ -223,9 +223,11 @@ export default class RealtimeWebSocketEndpoint {
   }
 
   requestSimulationWorld(requestPlanningData) {
+    // The backend replies with a delta against the last world received.
     this.websocket.send(JSON.stringify({
       type: 'RequestSimulationWorld',
       planning: requestPlanningData,
+      ackSequenceNum: this.lastSeqNum,
     }));
   }
 
@@ -12,6 +12,51 @@ const pointCloudRoot = protobuf.Root.fromJSON(
 
 const pointCloudMessage = pointCloudRoot.lookupType('apollo.dreamview.PointCloud');
 
+// The last simulation worlds received, by sequence num, as the base of the
+// delta updates of the backend.
+const MAX_SIM_WORLD_NUM = 10;
+const simWorlds = new Map();
+
+function mergeSimWorldDelta(delta) {
+  const base = simWorlds.get(delta.deltaBaseSequenceNum);
+  if (!base) {
+    console.warn('Missing base of simulation_world delta:',
+      delta.deltaBaseSequenceNum);
+    return null;
+  }
+  const world = Object.assign({}, delta);
+  (delta.unchangedField || []).forEach((id) => {
+    const name = SimWorldMessage.fieldsById[id].name;
+    world[name] = base[name];
+  });
+  const unchangedObjectIds = new Set(delta.unchangedObjectId || []);
+  world.object = (base.object || [])
+    .filter((object) => unchangedObjectIds.has(object.id))
+    .concat(delta.object || []);
+  delete world.deltaBaseSequenceNum;
+  delete world.unchangedField;
+  delete world.unchangedObjectId;
+  return world;
+}
+
+function decodeSimWorld(data) {
+  let world = SimWorldMessage.toObject(
+    SimWorldMessage.decode(new Uint8Array(data)),
+    { enums: String },
+  );
+  if (world.deltaBaseSequenceNum !== undefined) {
+    world = mergeSimWorldDelta(world);
+    if (!world) {
+      return null;
+    }
+  }
+  simWorlds.set(world.sequenceNum, world);
+  if (simWorlds.size > MAX_SIM_WORLD_NUM) {
+    simWorlds.delete(simWorlds.keys().next().value);
+  }
+  return world;
+}
+
 self.addEventListener('message', (event) => {
   let message = null;
   const data = event.data.data;
@@ -20,11 +65,10 @@ self.addEventListener('message', (event) => {
       if (typeof data === 'string') {
         message = JSON.parse(data);
       } else {
-        message = SimWorldMessage.toObject(
-          SimWorldMessage.decode(new Uint8Array(data)),
-          { enums: String },
-        );
-        message.type = 'SimWorldUpdate';
+        message = decodeSimWorld(data);
+        if (message) {
+          message.type = 'SimWorldUpdate';
+        }
       }
       break;
     case 'map':
@@ -16,18 +16,24 @@
 
 #include "modules/drivers/camera/compress_component.h"
 
-#include <exception>
-#include <iostream>
-#include <fstream>
+#include <algorithm>
+#include <string>
 
-#include "opencv2/core/core.hpp"
-#include "opencv2/highgui/highgui.hpp"
-#include "opencv2/imgproc/imgproc.hpp"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace drivers {
 namespace camera {
 
+using apollo::cyber::Time;
+
+namespace {
+
+// Images between two reports of the encoding of a camera
+constexpr uint64_t kReportInterval = 300;
+
+}  // namespace
+
 bool CompressComponent::Init() {
   if (!GetProtoConfig(&config_)) {
     AERROR << "Parse config file failed: " << ConfigFilePath();
@@ -48,7 +54,16 @@ bool CompressComponent::Init() {
 
   writer_ = node_->CreateWriter<CompressedImage>(
       config_.compress_conf().output_channel());
+  latency_recorder_.reset(
+      new common::LatencyRecorder(config_.compress_conf().output_channel()));
 
+  max_pending_images_ = std::max<uint32_t>(
+      config_.compress_conf().max_pending_images(), 1);
+  const uint32_t thread_num =
+      std::max<uint32_t>(config_.compress_conf().encode_thread_num(), 1);
+  for (uint32_t i = 0; i < thread_num; ++i) {
+    encode_threads_.emplace_back(&CompressComponent::EncodeLoop, this);
+  }
   return true;
 }
 
@@ -60,7 +75,63 @@ bool CompressComponent::Proc(const std::shared_ptr<Image>& image) {
       ", but received " << image->width() << "x" << image->height();
     return false;
   }
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_images_.push_back(image);
+    if (pending_images_.size() > max_pending_images_) {
+      // keep the latest images, the encoders can not keep up
+      pending_images_.pop_front();
+      dropped_num_.fetch_add(1);
+      AWARN_EVERY(100) << config_.compress_conf().output_channel()
+                       << " encoding overloaded, " << dropped_num_.load()
+                       << " images dropped";
+    }
+  }
+  pending_cv_.notify_one();
+  return true;
+}
+
+void CompressComponent::Clear() {
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    stopped_ = true;
+  }
+  pending_cv_.notify_all();
+  for (auto& thread : encode_threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  encode_threads_.clear();
+}
+
+void CompressComponent::EncodeLoop() {
+  const int quality = static_cast<int>(config_.compress_conf().jpeg_quality());
+  JpegEncoder encoder(quality);
+  while (true) {
+    std::shared_ptr<Image> image;
+    {
+      std::unique_lock<std::mutex> lock(pending_mutex_);
+      pending_cv_.wait(
+          lock, [this] { return stopped_ || !pending_images_.empty(); });
+      if (stopped_) {
+        return;
+      }
+      image = pending_images_.front();
+      pending_images_.pop_front();
+    }
+    Encode(image, &encoder);
+  }
+}
+
+bool CompressComponent::Encode(const std::shared_ptr<Image>& image,
+                               JpegEncoder* encoder) {
+  const auto start_time = Time::Now();
   auto compressed_image = image_pool_->GetObject();
+  if (compressed_image == nullptr) {
+    AWARN << "compressed image pool is empty, will be new";
+    compressed_image = std::make_shared<CompressedImage>();
+  }
   compressed_image->mutable_header()->CopyFrom(image->header());
   compressed_image->set_frame_id(image->frame_id());
   compressed_image->set_measurement_time(image->measurement_time());
@@ -69,28 +140,28 @@ bool CompressComponent::Proc(const std::shared_ptr<Image>& image) {
 
   compressed_image->set_format(image->encoding() + "; jpeg compressed bgr8");
 
-  std::vector<int> params;
-  params.resize(3, 0);
-  params[0] = cv::IMWRITE_JPEG_QUALITY;
-  params[1] = 95;
-
-  try {
-    cv::Mat mat_image(image->height(), image->width(), CV_8UC3,
-                      const_cast<char*>(image->data().data()), image->step());
-    cv::Mat tmp_mat;
-    cv::cvtColor(mat_image, tmp_mat, cv::COLOR_RGB2BGR);
-    std::vector<uint8_t> compress_buffer;
-    if (!cv::imencode(".jpg", tmp_mat, compress_buffer, params)) {
-      AERROR << "cv::imencode (jpeg) failed on input image";
-      return false;
-    }
-    compressed_image->set_data(compress_buffer.data(), compress_buffer.size());
-  } catch (std::exception& e) {
-    AERROR << "cv::imencode (jpeg) exception :" << e.what();
+  // the data of the pooled image keeps its capacity from the previous use
+  if (!encoder->EncodeRgb(
+          reinterpret_cast<const uint8_t*>(image->data().data()),
+          static_cast<int>(image->width()), static_cast<int>(image->height()),
+          static_cast<int>(image->step()),
+          compressed_image->mutable_data())) {
+    AERROR << "jpeg encoding failed on input image";
     return false;
   }
 
   writer_->Write(compressed_image);
+
+  const auto end_time = Time::Now();
+  latency_recorder_->AppendLatencyRecord(image->header().camera_timestamp(),
+                                         start_time, end_time);
+  const uint64_t encoded_num = encoded_num_.fetch_add(1) + 1;
+  if (encoded_num % kReportInterval == 0) {
+    AINFO << config_.compress_conf().output_channel() << " encoded "
+          << encoded_num << " images, dropped " << dropped_num_.load()
+          << ", last encoding took "
+          << (end_time - start_time).ToNanosecond() / 1e6 << " ms";
+  }
   return true;
 }
 
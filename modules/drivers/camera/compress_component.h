@@ -16,12 +16,19 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "cyber/base/concurrent_object_pool.h"
 #include "cyber/cyber.h"
+#include "modules/common/latency_recorder/latency_recorder.h"
+#include "modules/drivers/camera/jpeg_encoder.h"
 #include "modules/drivers/camera/proto/config.pb.h"
 #include "modules/common_msgs/sensor_msgs/sensor_image.pb.h"
 
@@ -35,17 +42,38 @@ using apollo::cyber::base::CCObjectPool;
 using apollo::drivers::Image;
 using apollo::drivers::camera::config::Config;
 
+/**
+ * @class CompressComponent
+ * @brief Queues the images of a camera for a pool of encoding threads.
+ * When all the threads are busy and max_pending_images are queued, the
+ * oldest queued image is dropped so that the latest one is always sent.
+ */
 class CompressComponent : public Component<Image> {
  public:
   bool Init() override;
   bool Proc(const std::shared_ptr<Image>& image) override;
+  void Clear() override;
 
  private:
+  void EncodeLoop();
+  bool Encode(const std::shared_ptr<Image>& image, JpegEncoder* encoder);
+
   std::shared_ptr<CCObjectPool<CompressedImage>> image_pool_;
   std::shared_ptr<Writer<CompressedImage>> writer_ = nullptr;
   Config config_;
   uint width_;
   uint height_;
+
+  std::mutex pending_mutex_;
+  std::condition_variable pending_cv_;
+  std::deque<std::shared_ptr<Image>> pending_images_;
+  size_t max_pending_images_ = 1;
+  bool stopped_ = false;
+  std::vector<std::thread> encode_threads_;
+
+  std::unique_ptr<common::LatencyRecorder> latency_recorder_;
+  std::atomic<uint64_t> encoded_num_ = {0};
+  std::atomic<uint64_t> dropped_num_ = {0};
 };
 
 CYBER_REGISTER_COMPONENT(CompressComponent)
@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/camera/jpeg_encoder.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+namespace {
+
+// Size of the output buffer of the first image, a 1080p JPEG at quality 95
+// takes about 500KB
+constexpr size_t kMinJpegSize = 512 * 1024;
+// Rows given to libjpeg at once
+constexpr int kRowBatch = 16;
+
+}  // namespace
+
+JpegEncoder::JpegEncoder(int quality) : quality_(quality) {
+  cinfo_.err = jpeg_std_error(&error_.pub);
+  error_.pub.error_exit = &JpegEncoder::ErrorExit;
+  jpeg_create_compress(&cinfo_);
+
+  destination_.pub.init_destination = &JpegEncoder::InitDestination;
+  destination_.pub.empty_output_buffer = &JpegEncoder::EmptyOutputBuffer;
+  destination_.pub.term_destination = &JpegEncoder::TermDestination;
+  cinfo_.dest = &destination_.pub;
+}
+
+JpegEncoder::~JpegEncoder() { jpeg_destroy_compress(&cinfo_); }
+
+bool JpegEncoder::EncodeRgb(const uint8_t* data, int width, int height,
+                            int step, std::string* jpeg) {
+  if (setjmp(error_.jump_buffer)) {
+    char message[JMSG_LENGTH_MAX];
+    (*cinfo_.err->format_message)(reinterpret_cast<j_common_ptr>(&cinfo_),
+                                  message);
+    AERROR << "jpeg encoding failed: " << message;
+    jpeg_abort_compress(&cinfo_);
+    return false;
+  }
+
+  destination_.jpeg = jpeg;
+  cinfo_.image_width = width;
+  cinfo_.image_height = height;
+  cinfo_.input_components = 3;
+  cinfo_.in_color_space = JCS_RGB;
+  jpeg_set_defaults(&cinfo_);
+  jpeg_set_quality(&cinfo_, quality_, TRUE);
+  jpeg_start_compress(&cinfo_, TRUE);
+
+  JSAMPROW rows[kRowBatch];
+  while (cinfo_.next_scanline < cinfo_.image_height) {
+    const int row_num = std::min<int>(
+        kRowBatch, cinfo_.image_height - cinfo_.next_scanline);
+    for (int i = 0; i < row_num; ++i) {
+      rows[i] = const_cast<JSAMPROW>(
+          data + static_cast<size_t>(cinfo_.next_scanline + i) * step);
+    }
+    jpeg_write_scanlines(&cinfo_, rows, row_num);
+  }
+  jpeg_finish_compress(&cinfo_);
+  return true;
+}
+
+void JpegEncoder::ErrorExit(j_common_ptr cinfo) {
+  auto* error = reinterpret_cast<ErrorManager*>(cinfo->err);
+  std::longjmp(error->jump_buffer, 1);
+}
+
+void JpegEncoder::InitDestination(j_compress_ptr cinfo) {
+  auto* destination = reinterpret_cast<Destination*>(cinfo->dest);
+  std::string* jpeg = destination->jpeg;
+  // the whole capacity is used, only the encoded size is kept at the end
+  jpeg->resize(std::max(jpeg->capacity(), kMinJpegSize));
+  destination->pub.next_output_byte =
+      reinterpret_cast<JOCTET*>(&(*jpeg)[0]);
+  destination->pub.free_in_buffer = jpeg->size();
+}
+
+boolean JpegEncoder::EmptyOutputBuffer(j_compress_ptr cinfo) {
+  auto* destination = reinterpret_cast<Destination*>(cinfo->dest);
+  std::string* jpeg = destination->jpeg;
+  const size_t used = jpeg->size();
+  jpeg->resize(used * 2);
+  destination->pub.next_output_byte =
+      reinterpret_cast<JOCTET*>(&(*jpeg)[used]);
+  destination->pub.free_in_buffer = jpeg->size() - used;
+  return TRUE;
+}
+
+void JpegEncoder::TermDestination(j_compress_ptr cinfo) {
+  auto* destination = reinterpret_cast<Destination*>(cinfo->dest);
+  destination->jpeg->resize(destination->jpeg->size() -
+                            destination->pub.free_in_buffer);
+}
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
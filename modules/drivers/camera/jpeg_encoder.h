@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <csetjmp>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "jpeglib.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+/**
+ * @class JpegEncoder
+ * @brief Encodes rgb8 images to JPEG with libjpeg, which takes RGB as its
+ * native input so no BGR copy is made. The compressor is reused from image
+ * to image, an encoder is used by a single thread at a time.
+ */
+class JpegEncoder {
+ public:
+  explicit JpegEncoder(int quality);
+  ~JpegEncoder();
+
+  JpegEncoder(const JpegEncoder&) = delete;
+  JpegEncoder& operator=(const JpegEncoder&) = delete;
+
+  /**
+   * @brief encode an image into jpeg, which is resized to the encoded size.
+   * The capacity of jpeg is reused, it only grows when an image does not
+   * fit in it.
+   */
+  bool EncodeRgb(const uint8_t* data, int width, int height, int step,
+                 std::string* jpeg);
+
+ private:
+  struct ErrorManager {
+    jpeg_error_mgr pub;
+    std::jmp_buf jump_buffer;
+  };
+
+  // Destination writing into the std::string of EncodeRgb
+  struct Destination {
+    jpeg_destination_mgr pub;
+    std::string* jpeg = nullptr;
+  };
+
+  static void ErrorExit(j_common_ptr cinfo);
+  static void InitDestination(j_compress_ptr cinfo);
+  static boolean EmptyOutputBuffer(j_compress_ptr cinfo);
+  static void TermDestination(j_compress_ptr cinfo);
+
+  int quality_;
+  jpeg_compress_struct cinfo_;
+  ErrorManager error_;
+  Destination destination_;
+};
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
@@ -23,6 +23,7 @@
 #include "modules/drivers/lidar/common/proto/lidar_config_base.pb.h"
 
 #include "cyber/cyber.h"
+#include "modules/common/util/packed_point_cloud.h"
 #include "modules/drivers/lidar/common/sync_buffering.h"
 
 namespace apollo {
@@ -51,11 +52,27 @@ class LidarComponentBaseImpl : public apollo::cyber::Component<ComponentType> {
     virtual bool WritePointCloud(
             const std::shared_ptr<PointCloud>& point_cloud);
 
+    // Only valid when packed_point_cloud_channel is configured, lets a
+    // driver fill the packed points directly
+    virtual std::shared_ptr<PackedPointCloud> AllocatePackedPointCloud();
+
+    virtual bool WritePackedPointCloud(
+            const std::shared_ptr<PackedPointCloud>& packed_point_cloud);
+
+    bool HasPackedWriter() const {
+        return packed_writer_ != nullptr;
+    }
+
     static std::shared_ptr<PointCloud> PcdDefaultAllocator();
 
     static void PcdDefaultCleaner(
             std::shared_ptr<PointCloud>& unused_pcd_frame);
 
+    static std::shared_ptr<PackedPointCloud> PackedDefaultAllocator();
+
+    static void PackedDefaultCleaner(
+            std::shared_ptr<PackedPointCloud>& unused_packed_frame);
+
     std::string frame_id_;
 
  private:
@@ -63,6 +80,9 @@ class LidarComponentBaseImpl : public apollo::cyber::Component<ComponentType> {
     std::shared_ptr<cyber::Reader<ScanType>> scan_reader_ = nullptr;
     std::shared_ptr<cyber::Writer<PointCloud>> pcd_writer_ = nullptr;
     std::shared_ptr<SyncBuffering<PointCloud>> pcd_buffer_ = nullptr;
+    std::shared_ptr<cyber::Writer<PackedPointCloud>> packed_writer_ = nullptr;
+    std::shared_ptr<SyncBuffering<PackedPointCloud>> packed_buffer_
+            = nullptr;
 
     std::atomic<int> pcd_sequence_num_{0};
 };
@@ -92,6 +112,17 @@ bool LidarComponentBaseImpl<ScanType, ComponentType>::InitConverter(
             LidarComponentBaseImpl::PcdDefaultCleaner);
     pcd_buffer_->SetBufferSize(lidar_config_base.buffer_size());
     pcd_buffer_->Init();
+
+    if (!lidar_config_base.packed_point_cloud_channel().empty()) {
+        packed_writer_ = this->node_->template CreateWriter<PackedPointCloud>(
+                lidar_config_base.packed_point_cloud_channel());
+        RETURN_VAL_IF(packed_writer_ == nullptr, false);
+        packed_buffer_ = std::make_shared<SyncBuffering<PackedPointCloud>>(
+                LidarComponentBaseImpl::PackedDefaultAllocator,
+                LidarComponentBaseImpl::PackedDefaultCleaner);
+        packed_buffer_->SetBufferSize(lidar_config_base.buffer_size());
+        packed_buffer_->Init();
+    }
     return true;
 }
 
@@ -128,6 +159,35 @@ bool LidarComponentBaseImpl<ScanType, ComponentType>::WritePointCloud(
     point_cloud->mutable_header()->set_timestamp_sec(
             cyber::Time().Now().ToSecond());
     RETURN_VAL_IF(!pcd_writer_->Write(point_cloud), false);
+
+    if (packed_writer_ != nullptr) {
+        // Drivers filling PointCloud still feed the packed consumers, the
+        // points are copied once here instead of once per consumer
+        auto packed_point_cloud = AllocatePackedPointCloud();
+        apollo::common::util::ToPackedPointCloud(
+                *point_cloud, packed_point_cloud.get());
+        RETURN_VAL_IF(!packed_writer_->Write(packed_point_cloud), false);
+    }
+    return true;
+}
+
+template <typename ScanType, typename ComponentType>
+std::shared_ptr<PackedPointCloud>
+LidarComponentBaseImpl<ScanType, ComponentType>::AllocatePackedPointCloud() {
+    return packed_buffer_->AllocateElement();
+}
+
+template <typename ScanType, typename ComponentType>
+bool LidarComponentBaseImpl<ScanType, ComponentType>::WritePackedPointCloud(
+        const std::shared_ptr<PackedPointCloud>& packed_point_cloud) {
+    RETURN_VAL_IF(packed_writer_ == nullptr, false);
+    packed_point_cloud->set_frame_id(frame_id_);
+    packed_point_cloud->mutable_header()->set_frame_id(frame_id_);
+    packed_point_cloud->mutable_header()->set_sequence_num(
+            pcd_sequence_num_.fetch_add(1));
+    packed_point_cloud->mutable_header()->set_timestamp_sec(
+            cyber::Time().Now().ToSecond());
+    RETURN_VAL_IF(!packed_writer_->Write(packed_point_cloud), false);
     return true;
 }
 
@@ -147,6 +207,24 @@ void LidarComponentBaseImpl<ScanType, ComponentType>::PcdDefaultCleaner(
         std::shared_ptr<PointCloud>& unused_pcd_frame) {
     unused_pcd_frame->clear_point();
 }
+
+template <typename ScanType, typename ComponentType>
+std::shared_ptr<PackedPointCloud>
+LidarComponentBaseImpl<ScanType, ComponentType>::PackedDefaultAllocator() {
+    constexpr int default_point_cloud_reserve = 170000;
+    std::shared_ptr<PackedPointCloud> new_packed_object
+            = std::make_shared<PackedPointCloud>();
+    apollo::common::util::MutablePackedPointCloudView(new_packed_object.get())
+            .Reserve(default_point_cloud_reserve);
+    return new_packed_object;
+}
+
+template <typename ScanType, typename ComponentType>
+void LidarComponentBaseImpl<ScanType, ComponentType>::PackedDefaultCleaner(
+        std::shared_ptr<PackedPointCloud>& unused_packed_frame) {
+    // clear() keeps the capacity of the data
+    unused_packed_frame->mutable_data()->clear();
+}
 }  // namespace lidar
 }  // namespace drivers
 }  // namespace apollo
@@ -16,7 +16,6 @@
 
 #include "modules/drivers/lidar/compensator/compensator.h"
 
-#include <limits>
 #include <memory>
 #include <string>
 
@@ -65,6 +64,12 @@ bool Compensator::QueryPoseAffineFromTF2(
     return true;
 }
 
+namespace {
+
+using apollo::common::util::MutablePackedPointCloudView;
+
+}  // namespace
+
 bool Compensator::MotionCompensation(
         const std::shared_ptr<const PointCloud>& msg,
         std::shared_ptr<PointCloud> msg_compensated) {
@@ -79,7 +84,7 @@ bool Compensator::MotionCompensation(
     uint64_t timestamp_min = 0;
     uint64_t timestamp_max = 0;
     std::string frame_id = msg->header().frame_id();
-    GetTimestampInterval(msg, &timestamp_min, &timestamp_max);
+    kernel_.GetTimestampInterval(*msg, &timestamp_min, &timestamp_max);
 
     msg_compensated->mutable_header()->set_timestamp_sec(
             cyber::Time::Now().ToSecond());
@@ -118,23 +123,45 @@ bool Compensator::MotionCompensation(
     return false;
 }
 
-inline void Compensator::GetTimestampInterval(
-        const std::shared_ptr<const PointCloud>& msg,
-        uint64_t* timestamp_min,
-        uint64_t* timestamp_max) {
-    *timestamp_max = 0;
-    *timestamp_min = std::numeric_limits<uint64_t>::max();
-
-    for (const auto& point : msg->point()) {
-        uint64_t timestamp = point.timestamp();
-        if (timestamp < *timestamp_min) {
-            *timestamp_min = timestamp;
-        }
-
-        if (timestamp > *timestamp_max) {
-            *timestamp_max = timestamp;
-        }
+bool Compensator::MotionCompensation(
+        const std::shared_ptr<const PackedPointCloud>& msg,
+        std::shared_ptr<PackedPointCloud> msg_compensated) {
+    if (msg->height() == 0 || msg->width() == 0) {
+        AERROR << "PointCloud width & height should not be 0";
+        return false;
+    }
+    Eigen::Affine3d pose_min_time;
+    Eigen::Affine3d pose_max_time;
+
+    uint64_t timestamp_min = 0;
+    uint64_t timestamp_max = 0;
+    const std::string& frame_id = msg->header().frame_id();
+    kernel_.GetTimestampInterval(*msg, &timestamp_min, &timestamp_max);
+
+    msg_compensated->mutable_header()->set_timestamp_sec(
+            cyber::Time::Now().ToSecond());
+    msg_compensated->mutable_header()->set_frame_id(frame_id);
+    msg_compensated->mutable_header()->set_lidar_timestamp(
+            msg->header().lidar_timestamp());
+    msg_compensated->set_measurement_time(msg->measurement_time());
+    msg_compensated->set_height(msg->height());
+    msg_compensated->set_is_dense(msg->is_dense());
+
+    if (!QueryPoseAffineFromTF2(timestamp_min, &pose_min_time, frame_id)
+        || !QueryPoseAffineFromTF2(timestamp_max, &pose_max_time, frame_id)) {
+        return false;
     }
+    MotionCompensation(
+            msg,
+            msg_compensated,
+            timestamp_min,
+            timestamp_max,
+            pose_min_time,
+            pose_max_time);
+    msg_compensated->set_width(static_cast<uint32_t>(
+            MutablePackedPointCloudView(msg_compensated.get()).size()
+            / msg->height()));
+    return true;
 }
 
 void Compensator::MotionCompensation(
@@ -144,94 +171,29 @@ void Compensator::MotionCompensation(
         const uint64_t timestamp_max,
         const Eigen::Affine3d& pose_min_time,
         const Eigen::Affine3d& pose_max_time) {
-    using std::abs;
-    using std::acos;
-    using std::sin;
-
-    Eigen::Vector3d translation
-            = pose_min_time.translation() - pose_max_time.translation();
-    Eigen::Quaterniond q_max(pose_max_time.linear());
-    Eigen::Quaterniond q_min(pose_min_time.linear());
-    Eigen::Quaterniond q1(q_max.conjugate() * q_min);
-    Eigen::Quaterniond q0(Eigen::Quaterniond::Identity());
-    q1.normalize();
-    translation = q_max.conjugate() * translation;
-
-    // int total = msg->width * msg->height;
-
-    double d = q0.dot(q1);
-    double abs_d = abs(d);
-    double f = 1.0 / static_cast<double>(timestamp_max - timestamp_min);
-
-    // Threshold for a "significant" rotation from min_time to max_time:
-    // The LiDAR range accuracy is ~2 cm. Over 70 meters range, it means an
-    // angle of 0.02 / 70 = 0.0003 rad. So, we consider a rotation "significant"
-    // only if the scalar part of quaternion is less than cos(0.0003 / 2) = 1 -
-    // 1e-8.
-    if (abs_d < 1.0 - 1.0e-8) {
-        double theta = acos(abs_d);
-        double sin_theta = sin(theta);
-        double c1_sign = (d > 0) ? 1 : -1;
-        for (const auto& point : msg->point()) {
-            float x_scalar = point.x();
-            if (std::isnan(x_scalar)) {
-                // if (config_.organized()) {
-                auto* point_new = msg_compensated->add_point();
-                point_new->CopyFrom(point);
-                // } else {
-                //   AERROR << "nan point do not need motion compensation";
-                // }
-                continue;
-            }
-            float y_scalar = point.y();
-            float z_scalar = point.z();
-            Eigen::Vector3d p(x_scalar, y_scalar, z_scalar);
-
-            uint64_t tp = point.timestamp();
-            double t = static_cast<double>(timestamp_max - tp) * f;
-
-            Eigen::Translation3d ti(t * translation);
-
-            double c0 = sin((1 - t) * theta) / sin_theta;
-            double c1 = sin(t * theta) / sin_theta * c1_sign;
-            Eigen::Quaterniond qi(c0 * q0.coeffs() + c1 * q1.coeffs());
-
-            Eigen::Affine3d trans = ti * qi;
-            p = trans * p;
-
-            auto* point_new = msg_compensated->add_point();
-            point_new->set_intensity(point.intensity());
-            point_new->set_timestamp(point.timestamp());
-            point_new->set_x(static_cast<float>(p.x()));
-            point_new->set_y(static_cast<float>(p.y()));
-            point_new->set_z(static_cast<float>(p.z()));
-        }
-        return;
-    }
-    // Not a "significant" rotation. Do translation only.
-    for (auto& point : msg->point()) {
-        float x_scalar = point.x();
-        if (std::isnan(x_scalar)) {
-            // AERROR << "nan point do not need motion compensation";
-            continue;
-        }
-        float y_scalar = point.y();
-        float z_scalar = point.z();
-        Eigen::Vector3d p(x_scalar, y_scalar, z_scalar);
-
-        uint64_t tp = point.timestamp();
-        double t = static_cast<double>(timestamp_max - tp) * f;
-        Eigen::Translation3d ti(t * translation);
-
-        p = ti * p;
-
-        auto* point_new = msg_compensated->add_point();
-        point_new->set_intensity(point.intensity());
-        point_new->set_timestamp(point.timestamp());
-        point_new->set_x(static_cast<float>(p.x()));
-        point_new->set_y(static_cast<float>(p.y()));
-        point_new->set_z(static_cast<float>(p.z()));
-    }
+    const MotionInterpolator interpolator(
+            timestamp_min,
+            timestamp_max,
+            pose_min_time,
+            pose_max_time,
+            kernel_.pose_table_size());
+    kernel_.Compensate(*msg, interpolator, msg_compensated.get());
+}
+
+void Compensator::MotionCompensation(
+        const std::shared_ptr<const PackedPointCloud>& msg,
+        std::shared_ptr<PackedPointCloud> msg_compensated,
+        const uint64_t timestamp_min,
+        const uint64_t timestamp_max,
+        const Eigen::Affine3d& pose_min_time,
+        const Eigen::Affine3d& pose_max_time) {
+    const MotionInterpolator interpolator(
+            timestamp_min,
+            timestamp_max,
+            pose_min_time,
+            pose_max_time,
+            kernel_.pose_table_size());
+    kernel_.Compensate(*msg, interpolator, msg_compensated.get());
 }
 
 }  // namespace compensator
@@ -30,23 +30,37 @@
 #include "modules/common_msgs/sensor_msgs/pointcloud.pb.h"
 #include "modules/drivers/lidar/compensator/proto/compensator_config.pb.h"
 
+#include "modules/common/util/packed_point_cloud.h"
+#include "modules/drivers/lidar/compensator/motion_compensation.h"
 #include "modules/transform/buffer.h"
 
 namespace apollo {
 namespace drivers {
 namespace compensator {
 
+using apollo::drivers::PackedPointCloud;
 using apollo::drivers::PointCloud;
 
 class Compensator {
  public:
-    explicit Compensator(const CompensatorConfig& config) : config_(config) {}
+    explicit Compensator(const CompensatorConfig& config) :
+            config_(config),
+            kernel_(config.compensation_thread_num(),
+                    config.pose_table_size()) {}
     virtual ~Compensator() {}
 
     bool MotionCompensation(
             const std::shared_ptr<const PointCloud>& msg,
             std::shared_ptr<PointCloud> msg_compensated);
 
+    /**
+     * @brief motion compensation of a packed point cloud, the points are
+     *   written in place in the data of msg_compensated
+     */
+    bool MotionCompensation(
+            const std::shared_ptr<const PackedPointCloud>& msg,
+            std::shared_ptr<PackedPointCloud> msg_compensated);
+
  private:
     /**
      * @brief get pose affine from tf2 by gps timestamp
@@ -67,18 +81,18 @@ class Compensator {
             const uint64_t timestamp_max,
             const Eigen::Affine3d& pose_min_time,
             const Eigen::Affine3d& pose_max_time);
-    /**
-     * @brief get min timestamp and max timestamp from points in pointcloud2
-     */
-    inline void GetTimestampInterval(
-            const std::shared_ptr<const PointCloud>& msg,
-            uint64_t* timestamp_min,
-            uint64_t* timestamp_max);
-
+    void MotionCompensation(
+            const std::shared_ptr<const PackedPointCloud>& msg,
+            std::shared_ptr<PackedPointCloud> msg_compensated,
+            const uint64_t timestamp_min,
+            const uint64_t timestamp_max,
+            const Eigen::Affine3d& pose_min_time,
+            const Eigen::Affine3d& pose_max_time);
     bool IsValid(const Eigen::Vector3d& point);
 
     transform::Buffer* tf2_buffer_ptr_ = transform::Buffer::Instance();
     CompensatorConfig config_;
+    MotionCompensationKernel kernel_;
 };
 
 }  // namespace compensator
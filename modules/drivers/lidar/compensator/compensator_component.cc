@@ -90,6 +90,57 @@ bool CompensatorComponent::Proc(
     return true;
 }
 
+bool PackedCompensatorComponent::Init() {
+    CompensatorConfig config;
+    if (!GetProtoConfig(&config)) {
+        AWARN << "Load config failed, config file" << ConfigFilePath();
+        return false;
+    }
+
+    writer_ = node_->CreateWriter<PackedPointCloud>(config.output_channel());
+    compensator_.reset(new Compensator(config));
+    compensator_pool_.reset(new CCObjectPool<PackedPointCloud>(pool_size_));
+    compensator_pool_->ConstructAll();
+    for (int i = 0; i < pool_size_; ++i) {
+        auto point_cloud = compensator_pool_->GetObject();
+        if (point_cloud == nullptr) {
+            AERROR << "fail to getobject:" << i;
+            return false;
+        }
+        common::util::MutablePackedPointCloudView(point_cloud.get())
+                .Reserve(240000);
+    }
+    return true;
+}
+
+bool PackedCompensatorComponent::Proc(
+        const std::shared_ptr<PackedPointCloud>& point_cloud) {
+    const auto start_time = Time::Now();
+    std::shared_ptr<PackedPointCloud> point_cloud_compensated
+            = compensator_pool_->GetObject();
+    if (point_cloud_compensated == nullptr) {
+        AWARN << "compensator fail to getobject, will be new";
+        point_cloud_compensated = std::make_shared<PackedPointCloud>();
+    }
+    // keeps the capacity of the data
+    point_cloud_compensated->mutable_data()->clear();
+    if (compensator_->MotionCompensation(
+                point_cloud, point_cloud_compensated)) {
+        const auto end_time = Time::Now();
+        static common::LatencyRecorder latency_recorder(FLAGS_pointcloud_topic);
+        latency_recorder.AppendLatencyRecord(
+                point_cloud_compensated->header().lidar_timestamp(),
+                start_time,
+                end_time);
+
+        point_cloud_compensated->mutable_header()->set_sequence_num(seq_);
+        writer_->Write(point_cloud_compensated);
+        seq_++;
+    }
+
+    return true;
+}
+
 }  // namespace compensator
 }  // namespace drivers
 }  // namespace apollo
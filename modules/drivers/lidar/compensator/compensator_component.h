@@ -31,6 +31,7 @@ using apollo::cyber::Component;
 using apollo::cyber::Reader;
 using apollo::cyber::Writer;
 using apollo::cyber::base::CCObjectPool;
+using apollo::drivers::PackedPointCloud;
 using apollo::drivers::PointCloud;
 
 class CompensatorComponent : public Component<PointCloud> {
@@ -46,7 +47,27 @@ class CompensatorComponent : public Component<PointCloud> {
     std::shared_ptr<CCObjectPool<PointCloud>> compensator_pool_ = nullptr;
 };
 
+/**
+ * @class PackedCompensatorComponent
+ * @brief Compensates the packed point clouds of the channel, with the same
+ *   config as CompensatorComponent
+ */
+class PackedCompensatorComponent : public Component<PackedPointCloud> {
+ public:
+    bool Init() override;
+    bool Proc(const std::shared_ptr<PackedPointCloud>& point_cloud) override;
+
+ private:
+    std::unique_ptr<Compensator> compensator_ = nullptr;
+    int pool_size_ = 8;
+    int seq_ = 0;
+    std::shared_ptr<Writer<PackedPointCloud>> writer_ = nullptr;
+    std::shared_ptr<CCObjectPool<PackedPointCloud>> compensator_pool_
+            = nullptr;
+};
+
 CYBER_REGISTER_COMPONENT(CompensatorComponent)
+CYBER_REGISTER_COMPONENT(PackedCompensatorComponent)
 }  // namespace compensator
 }  // namespace drivers
 }  // namespace apollo
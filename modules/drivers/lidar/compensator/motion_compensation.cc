@@ -0,0 +1,296 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/lidar/compensator/motion_compensation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+#include "modules/common/util/packed_point_cloud.h"
+
+namespace apollo {
+namespace drivers {
+namespace compensator {
+
+namespace {
+
+using apollo::common::util::MutablePackedPointCloudView;
+using apollo::common::util::PackedPoint;
+using apollo::common::util::PackedPointCloudView;
+
+// Smaller clouds are not worth waking up the pool
+constexpr size_t kMinChunkPoints = 16384;
+
+}  // namespace
+
+MotionInterpolator::MotionInterpolator(
+        const uint64_t timestamp_min,
+        const uint64_t timestamp_max,
+        const Eigen::Affine3d& pose_min_time,
+        const Eigen::Affine3d& pose_max_time,
+        const size_t pose_table_size)
+    : timestamp_max_(timestamp_max), q0_(Eigen::Quaterniond::Identity()) {
+    translation_ = pose_min_time.translation() - pose_max_time.translation();
+    Eigen::Quaterniond q_max(pose_max_time.linear());
+    Eigen::Quaterniond q_min(pose_min_time.linear());
+    q1_ = q_max.conjugate() * q_min;
+    q1_.normalize();
+    translation_ = q_max.conjugate() * translation_;
+
+    double d = q0_.dot(q1_);
+    double abs_d = std::abs(d);
+    // all the points at the same time are not moved
+    if (timestamp_max > timestamp_min) {
+        f_ = 1.0 / static_cast<double>(timestamp_max - timestamp_min);
+    }
+
+    // Threshold for a "significant" rotation from min_time to max_time:
+    // The LiDAR range accuracy is ~2 cm. Over 70 meters range, it means
+    // an angle of 0.02 / 70 = 0.0003 rad. So, we consider a rotation
+    // "significant" only if the scalar part of quaternion is less than
+    // cos(0.0003 / 2) = 1 - 1e-8.
+    rotation_ = abs_d < 1.0 - 1.0e-8;
+    if (!rotation_) {
+        return;
+    }
+    theta_ = std::acos(abs_d);
+    sin_theta_ = std::sin(theta_);
+    c1_sign_ = (d > 0) ? 1 : -1;
+
+    rotation_table_.reserve(pose_table_size);
+    for (size_t i = 0; i < pose_table_size; ++i) {
+        double t = (static_cast<double>(i) + 0.5)
+                / static_cast<double>(pose_table_size);
+        rotation_table_.push_back(Slerp(t).toRotationMatrix());
+    }
+}
+
+Eigen::Quaterniond MotionInterpolator::Slerp(const double t) const {
+    double c0 = std::sin((1 - t) * theta_) / sin_theta_;
+    double c1 = std::sin(t * theta_) / sin_theta_ * c1_sign_;
+    return Eigen::Quaterniond(c0 * q0_.coeffs() + c1 * q1_.coeffs());
+}
+
+Eigen::Vector3d MotionInterpolator::Apply(
+        const Eigen::Vector3d& p, const uint64_t timestamp) const {
+    double t = Ratio(timestamp);
+    if (!rotation_) {
+        return p + t * translation_;
+    }
+    if (rotation_table_.empty()) {
+        return Slerp(t) * p + t * translation_;
+    }
+    const size_t table_size = rotation_table_.size();
+    size_t bucket = std::min(
+            static_cast<size_t>(t * static_cast<double>(table_size)),
+            table_size - 1);
+    return rotation_table_[bucket] * p + t * translation_;
+}
+
+MotionCompensationKernel::MotionCompensationKernel(
+        const size_t thread_num, const size_t pose_table_size)
+    : thread_num_(std::max<size_t>(thread_num, 1)),
+      pose_table_size_(pose_table_size) {
+    if (thread_num_ > 1) {
+        // the calling thread runs a chunk too
+        thread_pool_.reset(new cyber::base::ThreadPool(thread_num_ - 1));
+    }
+}
+
+template <typename Func>
+void MotionCompensationKernel::ParallelFor(
+        const size_t size, const Func& func) const {
+    size_t chunk_num = std::min(
+            thread_num_, (size + kMinChunkPoints - 1) / kMinChunkPoints);
+    if (thread_pool_ == nullptr || chunk_num <= 1) {
+        func(0, size);
+        return;
+    }
+    size_t chunk_size = (size + chunk_num - 1) / chunk_num;
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunk_num - 1);
+    for (size_t begin = chunk_size; begin < size; begin += chunk_size) {
+        size_t end = std::min(begin + chunk_size, size);
+        auto future = thread_pool_->Enqueue(
+                [&func, begin, end]() { func(begin, end); });
+        if (future.valid()) {
+            futures.push_back(std::move(future));
+        } else {
+            func(begin, end);
+        }
+    }
+    func(0, std::min(chunk_size, size));
+    for (auto& future : futures) {
+        future.wait();
+    }
+}
+
+void MotionCompensationKernel::GetTimestampInterval(
+        const PointCloud& msg,
+        uint64_t* timestamp_min,
+        uint64_t* timestamp_max) const {
+    const size_t size = static_cast<size_t>(msg.point_size());
+    std::vector<uint64_t> chunk_min(thread_num_);
+    std::vector<uint64_t> chunk_max(thread_num_);
+    size_t chunk_index = 0;
+    std::mutex chunk_mutex;
+    ParallelFor(size, [&](size_t begin, size_t end) {
+        uint64_t local_min = std::numeric_limits<uint64_t>::max();
+        uint64_t local_max = 0;
+        for (size_t i = begin; i < end; ++i) {
+            uint64_t timestamp = msg.point(static_cast<int>(i)).timestamp();
+            local_min = std::min(local_min, timestamp);
+            local_max = std::max(local_max, timestamp);
+        }
+        std::lock_guard<std::mutex> lock(chunk_mutex);
+        chunk_min[chunk_index] = local_min;
+        chunk_max[chunk_index] = local_max;
+        ++chunk_index;
+    });
+    *timestamp_min = std::numeric_limits<uint64_t>::max();
+    *timestamp_max = 0;
+    for (size_t i = 0; i < chunk_index; ++i) {
+        *timestamp_min = std::min(*timestamp_min, chunk_min[i]);
+        *timestamp_max = std::max(*timestamp_max, chunk_max[i]);
+    }
+}
+
+void MotionCompensationKernel::GetTimestampInterval(
+        const PackedPointCloud& msg,
+        uint64_t* timestamp_min,
+        uint64_t* timestamp_max) const {
+    const PackedPointCloudView points(msg);
+    std::vector<uint64_t> chunk_min(thread_num_);
+    std::vector<uint64_t> chunk_max(thread_num_);
+    size_t chunk_index = 0;
+    std::mutex chunk_mutex;
+    ParallelFor(points.size(), [&](size_t begin, size_t end) {
+        // branchless, so that the compiler vectorizes it
+        uint64_t local_min = std::numeric_limits<uint64_t>::max();
+        uint64_t local_max = 0;
+        const PackedPoint* data = points.begin();
+        for (size_t i = begin; i < end; ++i) {
+            local_min = std::min(local_min, data[i].timestamp);
+            local_max = std::max(local_max, data[i].timestamp);
+        }
+        std::lock_guard<std::mutex> lock(chunk_mutex);
+        chunk_min[chunk_index] = local_min;
+        chunk_max[chunk_index] = local_max;
+        ++chunk_index;
+    });
+    *timestamp_min = std::numeric_limits<uint64_t>::max();
+    *timestamp_max = 0;
+    for (size_t i = 0; i < chunk_index; ++i) {
+        *timestamp_min = std::min(*timestamp_min, chunk_min[i]);
+        *timestamp_max = std::max(*timestamp_max, chunk_max[i]);
+    }
+}
+
+void MotionCompensationKernel::Compensate(
+        const PointCloud& msg,
+        const MotionInterpolator& interpolator,
+        PointCloud* msg_compensated) const {
+    const int offset = msg_compensated->point_size();
+    const int size = msg.point_size();
+    auto* points = msg_compensated->mutable_point();
+    // the points are added up front, cleared ones are reused, so that the
+    // chunks only write their own elements
+    points->Reserve(offset + size);
+    for (int i = 0; i < size; ++i) {
+        points->Add();
+    }
+    ParallelFor(static_cast<size_t>(size), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto& point = msg.point(static_cast<int>(i));
+            auto* point_new = points->Mutable(offset + static_cast<int>(i));
+            if (std::isnan(point.x())) {
+                point_new->CopyFrom(point);
+                continue;
+            }
+            Eigen::Vector3d p(point.x(), point.y(), point.z());
+            p = interpolator.Apply(p, point.timestamp());
+
+            point_new->set_intensity(point.intensity());
+            point_new->set_timestamp(point.timestamp());
+            point_new->set_x(static_cast<float>(p.x()));
+            point_new->set_y(static_cast<float>(p.y()));
+            point_new->set_z(static_cast<float>(p.z()));
+        }
+    });
+    if (interpolator.rotation()) {
+        return;
+    }
+    // nan points are kept in an organized cloud only when rotating
+    int kept = offset;
+    for (int i = offset; i < points->size(); ++i) {
+        if (std::isnan(points->Get(i).x())) {
+            continue;
+        }
+        if (i != kept) {
+            points->SwapElements(i, kept);
+        }
+        ++kept;
+    }
+    while (points->size() > kept) {
+        points->RemoveLast();
+    }
+}
+
+void MotionCompensationKernel::Compensate(
+        const PackedPointCloud& msg,
+        const MotionInterpolator& interpolator,
+        PackedPointCloud* msg_compensated) const {
+    const PackedPointCloudView points(msg);
+    MutablePackedPointCloudView points_compensated(msg_compensated);
+    const size_t offset = points_compensated.size();
+    // written in place, then cut to the points kept
+    points_compensated.Resize(offset + points.size());
+    PackedPoint* output = points_compensated.begin() + offset;
+    ParallelFor(points.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const PackedPoint& point = points[i];
+            PackedPoint& point_new = output[i];
+            if (std::isnan(point.x)) {
+                point_new = point;
+                continue;
+            }
+            Eigen::Vector3d p(point.x, point.y, point.z);
+            p = interpolator.Apply(p, point.timestamp);
+
+            point_new.x = static_cast<float>(p.x());
+            point_new.y = static_cast<float>(p.y());
+            point_new.z = static_cast<float>(p.z());
+            point_new.intensity = point.intensity;
+            point_new.timestamp = point.timestamp;
+        }
+    });
+    if (interpolator.rotation()) {
+        return;
+    }
+    PackedPoint* kept_end = std::remove_if(
+            output, points_compensated.end(), [](const PackedPoint& point) {
+                return std::isnan(point.x);
+            });
+    points_compensated.Resize(kept_end - points_compensated.begin());
+}
+
+}  // namespace compensator
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Eigen/Eigen"
+
+// Eigen 3.3.7: #define ALIVE (0)
+// fastrtps: enum ChangeKind_t { ALIVE, ... };
+#if defined(ALIVE)
+#undef ALIVE
+#endif
+
+#include "modules/common_msgs/sensor_msgs/pointcloud.pb.h"
+
+#include "cyber/base/thread_pool.h"
+
+namespace apollo {
+namespace drivers {
+namespace compensator {
+
+/**
+ * @class MotionInterpolator
+ * @brief Motion of the lidar between the first and the last point of a
+ *   sweep, interpolated at the timestamp of each point.
+ *
+ * With a pose table, the sweep is cut in pose_table_size buckets and the
+ * points of a bucket share the pose of its center instead of a slerp each.
+ */
+class MotionInterpolator {
+ public:
+    MotionInterpolator(
+            const uint64_t timestamp_min,
+            const uint64_t timestamp_max,
+            const Eigen::Affine3d& pose_min_time,
+            const Eigen::Affine3d& pose_max_time,
+            const size_t pose_table_size = 0);
+
+    // Not a "significant" rotation, the points are only translated
+    bool rotation() const {
+        return rotation_;
+    }
+
+    Eigen::Vector3d Apply(
+            const Eigen::Vector3d& p, const uint64_t timestamp) const;
+
+ private:
+    // position of timestamp in the sweep, 0 at timestamp_max
+    double Ratio(const uint64_t timestamp) const {
+        return static_cast<double>(timestamp_max_ - timestamp) * f_;
+    }
+
+    Eigen::Quaterniond Slerp(const double t) const;
+
+    uint64_t timestamp_max_;
+    double f_ = 0.0;
+    Eigen::Vector3d translation_;
+    Eigen::Quaterniond q0_;
+    Eigen::Quaterniond q1_;
+    bool rotation_ = false;
+    double theta_ = 0.0;
+    double sin_theta_ = 0.0;
+    double c1_sign_ = 1.0;
+
+    std::vector<Eigen::Matrix3d> rotation_table_;
+};
+
+/**
+ * @class MotionCompensationKernel
+ * @brief Timestamp range and compensation of the points of a sweep, split
+ *   in chunks run on a thread pool when more than one thread is configured.
+ */
+class MotionCompensationKernel {
+ public:
+    MotionCompensationKernel(
+            const size_t thread_num, const size_t pose_table_size);
+
+    size_t pose_table_size() const {
+        return pose_table_size_;
+    }
+
+    void GetTimestampInterval(
+            const PointCloud& msg,
+            uint64_t* timestamp_min,
+            uint64_t* timestamp_max) const;
+    void GetTimestampInterval(
+            const PackedPointCloud& msg,
+            uint64_t* timestamp_min,
+            uint64_t* timestamp_max) const;
+
+    /**
+     * @brief append the compensated points of msg to msg_compensated,
+     *   nan points are kept only when rotating, as an organized cloud
+     */
+    void Compensate(
+            const PointCloud& msg,
+            const MotionInterpolator& interpolator,
+            PointCloud* msg_compensated) const;
+    void Compensate(
+            const PackedPointCloud& msg,
+            const MotionInterpolator& interpolator,
+            PackedPointCloud* msg_compensated) const;
+
+ private:
+    // Call func(begin, end) on chunks of [0, size), the calling thread
+    // runs the first chunk
+    template <typename Func>
+    void ParallelFor(const size_t size, const Func& func) const;
+
+    size_t thread_num_;
+    size_t pose_table_size_;
+    std::unique_ptr<cyber::base::ThreadPool> thread_pool_;
+};
+
+}  // namespace compensator
+}  // namespace drivers
+}  // namespace apollo
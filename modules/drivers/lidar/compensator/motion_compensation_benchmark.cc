@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/* Motion compensation of synthetic 250k point sweeps, 128 beams over 100 ms
+ * with a few percent of nan points, while the vehicle drives and turns.
+ * Compare the per point slerp with the pose table, on 1 to 8 threads, for
+ * PointCloud and PackedPointCloud.
+ *
+ * Usage:
+ *   motion_compensation_benchmark --benchmark_min_time=1
+ */
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/util/packed_point_cloud.h"
+#include "modules/drivers/lidar/compensator/motion_compensation.h"
+
+namespace apollo {
+namespace drivers {
+namespace compensator {
+namespace {
+
+constexpr int kBeamNum = 128;
+constexpr int kPointNum = 250000;
+constexpr uint64_t kSweepStart = 1700000000000000000ULL;
+constexpr uint64_t kSweepDuration = 100000000ULL;
+/* 20 m/s while turning at 0.5 rad/s */
+constexpr double kSpeed = 20.0;
+constexpr double kYawRate = 0.5;
+
+void MakeSweep(PointCloud* cloud) {
+    std::mt19937 generator(kPointNum);
+    std::uniform_real_distribution<float> range(1.0f, 120.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const int column_num = kPointNum / kBeamNum;
+    cloud->set_height(kBeamNum);
+    cloud->set_width(column_num);
+    for (int column = 0; column < column_num; ++column) {
+        double azimuth = 2.0 * M_PI * column / column_num;
+        uint64_t timestamp = kSweepStart + kSweepDuration * column / column_num;
+        for (int beam = 0; beam < kBeamNum; ++beam) {
+            double elevation = (beam - kBeamNum / 2) * 0.2 * M_PI / 180.0;
+            float r = range(generator);
+            auto* point = cloud->add_point();
+            if (unit(generator) < 0.03f) {
+                point->set_x(std::numeric_limits<float>::quiet_NaN());
+                point->set_y(std::numeric_limits<float>::quiet_NaN());
+                point->set_z(std::numeric_limits<float>::quiet_NaN());
+            } else {
+                point->set_x(static_cast<float>(
+                        r * std::cos(elevation) * std::cos(azimuth)));
+                point->set_y(static_cast<float>(
+                        r * std::cos(elevation) * std::sin(azimuth)));
+                point->set_z(static_cast<float>(r * std::sin(elevation)));
+            }
+            point->set_intensity(static_cast<uint32_t>(r));
+            point->set_timestamp(timestamp);
+        }
+    }
+}
+
+const PointCloud& Sweep() {
+    static const PointCloud* sweep = []() {
+        auto* cloud = new PointCloud();
+        MakeSweep(cloud);
+        return cloud;
+    }();
+    return *sweep;
+}
+
+const PackedPointCloud& PackedSweep() {
+    static const PackedPointCloud* sweep = []() {
+        auto* packed = new PackedPointCloud();
+        apollo::common::util::ToPackedPointCloud(Sweep(), packed);
+        return packed;
+    }();
+    return *sweep;
+}
+
+void SweepPoses(
+        Eigen::Affine3d* pose_min_time, Eigen::Affine3d* pose_max_time) {
+    const double duration = static_cast<double>(kSweepDuration) * 1e-9;
+    *pose_min_time = Eigen::Affine3d::Identity();
+    *pose_max_time = Eigen::Translation3d(kSpeed * duration, 0.0, 0.0)
+            * Eigen::AngleAxisd(kYawRate * duration, Eigen::Vector3d::UnitZ());
+}
+
+/* range(0): threads, range(1): pose table size */
+void BM_CompensatePointCloud(benchmark::State& state) {
+    const MotionCompensationKernel kernel(
+            static_cast<size_t>(state.range(0)),
+            static_cast<size_t>(state.range(1)));
+    const PointCloud& sweep = Sweep();
+    Eigen::Affine3d pose_min_time;
+    Eigen::Affine3d pose_max_time;
+    SweepPoses(&pose_min_time, &pose_max_time);
+    PointCloud compensated;
+    for (auto _ : state) {
+        compensated.clear_point();
+        uint64_t timestamp_min = 0;
+        uint64_t timestamp_max = 0;
+        kernel.GetTimestampInterval(sweep, &timestamp_min, &timestamp_max);
+        const MotionInterpolator interpolator(
+                timestamp_min,
+                timestamp_max,
+                pose_min_time,
+                pose_max_time,
+                kernel.pose_table_size());
+        kernel.Compensate(sweep, interpolator, &compensated);
+        benchmark::DoNotOptimize(compensated.point_size());
+    }
+    state.SetItemsProcessed(state.iterations() * sweep.point_size());
+}
+
+void BM_CompensatePacked(benchmark::State& state) {
+    const MotionCompensationKernel kernel(
+            static_cast<size_t>(state.range(0)),
+            static_cast<size_t>(state.range(1)));
+    const PackedPointCloud& sweep = PackedSweep();
+    Eigen::Affine3d pose_min_time;
+    Eigen::Affine3d pose_max_time;
+    SweepPoses(&pose_min_time, &pose_max_time);
+    PackedPointCloud compensated;
+    for (auto _ : state) {
+        compensated.mutable_data()->clear();
+        uint64_t timestamp_min = 0;
+        uint64_t timestamp_max = 0;
+        kernel.GetTimestampInterval(sweep, &timestamp_min, &timestamp_max);
+        const MotionInterpolator interpolator(
+                timestamp_min,
+                timestamp_max,
+                pose_min_time,
+                pose_max_time,
+                kernel.pose_table_size());
+        kernel.Compensate(sweep, interpolator, &compensated);
+        benchmark::DoNotOptimize(compensated.data().data());
+    }
+    state.SetItemsProcessed(state.iterations() * Sweep().point_size());
+}
+
+void CompensateArgs(benchmark::internal::Benchmark* bench) {
+    for (int threads : {1, 2, 4, 8}) {
+        bench->Args({threads, 0});
+        bench->Args({threads, 1024});
+    }
+    bench->Unit(benchmark::kMicrosecond)->UseRealTime();
+}
+
+BENCHMARK(BM_CompensatePointCloud)->Apply(CompensateArgs);
+BENCHMARK(BM_CompensatePacked)->Apply(CompensateArgs);
+
+}  // namespace
+}  // namespace compensator
+}  // namespace drivers
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,275 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/lidar/compensator/motion_compensation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/packed_point_cloud.h"
+
+namespace apollo {
+namespace drivers {
+namespace compensator {
+namespace {
+
+using apollo::common::util::PackedPoint;
+using apollo::common::util::PackedPointCloudView;
+
+// 4 chunks of 16384 points, enough for 4 threads to split the sweep
+constexpr int kBeamNum = 64;
+constexpr int kColumnNum = 1024;
+constexpr float kMaxRange = 120.0f;
+constexpr uint64_t kSweepStart = 1700000000000000000ULL;
+constexpr uint64_t kSweepDuration = 100000000ULL;
+constexpr size_t kPoseTableSize = 1024;
+// 0.5 rad/s over the 100 ms sweep
+constexpr double kTurn = 0.05;
+// float rounding of the compensated points
+constexpr double kFloatTolerance = 1.0e-5;
+
+void MakeSweep(PointCloud* cloud) {
+    std::mt19937 generator(kBeamNum * kColumnNum);
+    std::uniform_real_distribution<float> range(1.0f, kMaxRange);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    cloud->set_height(kBeamNum);
+    cloud->set_width(kColumnNum);
+    for (int column = 0; column < kColumnNum; ++column) {
+        double azimuth = 2.0 * M_PI * column / kColumnNum;
+        uint64_t timestamp = kSweepStart + kSweepDuration * column / kColumnNum;
+        for (int beam = 0; beam < kBeamNum; ++beam) {
+            double elevation = (beam - kBeamNum / 2) * 0.4 * M_PI / 180.0;
+            float r = range(generator);
+            auto* point = cloud->add_point();
+            if (unit(generator) < 0.03f) {
+                point->set_x(std::numeric_limits<float>::quiet_NaN());
+                point->set_y(std::numeric_limits<float>::quiet_NaN());
+                point->set_z(std::numeric_limits<float>::quiet_NaN());
+            } else {
+                point->set_x(static_cast<float>(
+                        r * std::cos(elevation) * std::cos(azimuth)));
+                point->set_y(static_cast<float>(
+                        r * std::cos(elevation) * std::sin(azimuth)));
+                point->set_z(static_cast<float>(r * std::sin(elevation)));
+            }
+            point->set_intensity(static_cast<uint32_t>(r));
+            point->set_timestamp(timestamp);
+        }
+    }
+}
+
+// 2 m forward over the sweep, turning by kTurn if turning
+void SweepPoses(
+        const bool turning,
+        Eigen::Affine3d* pose_min_time,
+        Eigen::Affine3d* pose_max_time) {
+    *pose_min_time = Eigen::Affine3d::Identity();
+    *pose_max_time = Eigen::Translation3d(2.0, 0.0, 0.0)
+            * Eigen::AngleAxisd(
+                    turning ? kTurn : 0.0, Eigen::Vector3d::UnitZ());
+}
+
+template <typename Cloud>
+void Compensate(
+        const MotionCompensationKernel& kernel,
+        const Cloud& sweep,
+        const bool turning,
+        Cloud* compensated) {
+    Eigen::Affine3d pose_min_time;
+    Eigen::Affine3d pose_max_time;
+    SweepPoses(turning, &pose_min_time, &pose_max_time);
+    uint64_t timestamp_min = 0;
+    uint64_t timestamp_max = 0;
+    kernel.GetTimestampInterval(sweep, &timestamp_min, &timestamp_max);
+    EXPECT_EQ(kSweepStart, timestamp_min);
+    EXPECT_EQ(
+            kSweepStart + kSweepDuration * (kColumnNum - 1) / kColumnNum,
+            timestamp_max);
+    const MotionInterpolator interpolator(
+            timestamp_min,
+            timestamp_max,
+            pose_min_time,
+            pose_max_time,
+            kernel.pose_table_size());
+    EXPECT_EQ(turning, interpolator.rotation());
+    kernel.Compensate(sweep, interpolator, compensated);
+}
+
+uint32_t Bits(const float value) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// same bits, nan points included
+void ExpectSamePoints(const PointCloud& expected, const PointCloud& actual) {
+    ASSERT_EQ(expected.point_size(), actual.point_size());
+    for (int i = 0; i < expected.point_size(); ++i) {
+        const auto& point_expected = expected.point(i);
+        const auto& point_actual = actual.point(i);
+        ASSERT_EQ(Bits(point_expected.x()), Bits(point_actual.x())) << i;
+        ASSERT_EQ(Bits(point_expected.y()), Bits(point_actual.y())) << i;
+        ASSERT_EQ(Bits(point_expected.z()), Bits(point_actual.z())) << i;
+        ASSERT_EQ(point_expected.intensity(), point_actual.intensity()) << i;
+        ASSERT_EQ(point_expected.timestamp(), point_actual.timestamp()) << i;
+    }
+}
+
+void ExpectSamePoints(
+        const PackedPointCloud& expected, const PackedPointCloud& actual) {
+    const PackedPointCloudView points_expected(expected);
+    const PackedPointCloudView points_actual(actual);
+    ASSERT_EQ(points_expected.size(), points_actual.size());
+    for (size_t i = 0; i < points_expected.size(); ++i) {
+        const PackedPoint& point_expected = points_expected[i];
+        const PackedPoint& point_actual = points_actual[i];
+        ASSERT_EQ(Bits(point_expected.x), Bits(point_actual.x)) << i;
+        ASSERT_EQ(Bits(point_expected.y), Bits(point_actual.y)) << i;
+        ASSERT_EQ(Bits(point_expected.z), Bits(point_actual.z)) << i;
+        ASSERT_EQ(point_expected.intensity, point_actual.intensity) << i;
+        ASSERT_EQ(point_expected.timestamp, point_actual.timestamp) << i;
+    }
+}
+
+}  // namespace
+
+TEST(MotionCompensationTest, ThreadNumDoesNotChangeOutput) {
+    PointCloud sweep;
+    MakeSweep(&sweep);
+    PackedPointCloud packed_sweep;
+    apollo::common::util::ToPackedPointCloud(sweep, &packed_sweep);
+    for (size_t pose_table_size : {size_t{0}, kPoseTableSize}) {
+        for (bool turning : {false, true}) {
+            const MotionCompensationKernel kernel(1, pose_table_size);
+            PointCloud expected;
+            Compensate(kernel, sweep, turning, &expected);
+            PackedPointCloud packed_expected;
+            Compensate(kernel, packed_sweep, turning, &packed_expected);
+            for (size_t thread_num : {2, 3, 4}) {
+                const MotionCompensationKernel parallel_kernel(
+                        thread_num, pose_table_size);
+                PointCloud actual;
+                Compensate(parallel_kernel, sweep, turning, &actual);
+                ExpectSamePoints(expected, actual);
+                PackedPointCloud packed_actual;
+                Compensate(
+                        parallel_kernel, packed_sweep, turning, &packed_actual);
+                ExpectSamePoints(packed_expected, packed_actual);
+            }
+        }
+    }
+}
+
+TEST(MotionCompensationTest, PackedMatchesPointCloud) {
+    PointCloud sweep;
+    MakeSweep(&sweep);
+    PackedPointCloud packed_sweep;
+    apollo::common::util::ToPackedPointCloud(sweep, &packed_sweep);
+    for (size_t pose_table_size : {size_t{0}, kPoseTableSize}) {
+        for (bool turning : {false, true}) {
+            const MotionCompensationKernel kernel(4, pose_table_size);
+            PointCloud compensated;
+            Compensate(kernel, sweep, turning, &compensated);
+            PackedPointCloud packed_compensated;
+            Compensate(kernel, packed_sweep, turning, &packed_compensated);
+            PackedPointCloud expected;
+            apollo::common::util::ToPackedPointCloud(compensated, &expected);
+            ExpectSamePoints(expected, packed_compensated);
+        }
+    }
+}
+
+// A point at range r is moved by at most r * kTurn / (2 * kPoseTableSize)
+// from its slerp, 2.9 mm at 120 m here.
+TEST(MotionCompensationTest, PoseTableWithinToleranceOfSlerp) {
+    PointCloud sweep;
+    MakeSweep(&sweep);
+    PointCloud expected;
+    Compensate(MotionCompensationKernel(1, 0), sweep, true, &expected);
+    PointCloud actual;
+    Compensate(
+            MotionCompensationKernel(4, kPoseTableSize), sweep, true, &actual);
+
+    // nan points are kept in place when turning
+    ASSERT_EQ(sweep.point_size(), actual.point_size());
+    const double bucket_turn = kTurn / (2.0 * kPoseTableSize);
+    double max_error = 0.0;
+    for (int i = 0; i < sweep.point_size(); ++i) {
+        const auto& point = sweep.point(i);
+        const auto& point_expected = expected.point(i);
+        const auto& point_actual = actual.point(i);
+        ASSERT_EQ(point.timestamp(), point_actual.timestamp());
+        if (std::isnan(point.x())) {
+            ASSERT_TRUE(std::isnan(point_actual.x())) << i;
+            continue;
+        }
+        const double range = std::sqrt(
+                point.x() * point.x() + point.y() * point.y()
+                + point.z() * point.z());
+        const double error = std::sqrt(
+                std::pow(point_expected.x() - point_actual.x(), 2)
+                + std::pow(point_expected.y() - point_actual.y(), 2)
+                + std::pow(point_expected.z() - point_actual.z(), 2));
+        ASSERT_LE(error, range * bucket_turn + kFloatTolerance) << i;
+        max_error = std::max(max_error, error);
+    }
+    EXPECT_LE(max_error, kMaxRange * bucket_turn + kFloatTolerance);
+}
+
+TEST(MotionCompensationTest, NanPointsDroppedWhenNotTurning) {
+    PointCloud sweep;
+    MakeSweep(&sweep);
+    PackedPointCloud packed_sweep;
+    apollo::common::util::ToPackedPointCloud(sweep, &packed_sweep);
+    const MotionCompensationKernel kernel(4, kPoseTableSize);
+
+    // appended after the points already in the cloud
+    PointCloud compensated;
+    compensated.add_point()->set_x(std::numeric_limits<float>::quiet_NaN());
+    Compensate(kernel, sweep, false, &compensated);
+    PackedPointCloud packed_compensated;
+    apollo::common::util::ToPackedPointCloud(compensated, &packed_compensated);
+    PackedPointCloud packed_actual;
+    packed_actual.mutable_data()->assign(
+            packed_compensated.data(), 0, sizeof(PackedPoint));
+    Compensate(kernel, packed_sweep, false, &packed_actual);
+    ExpectSamePoints(packed_compensated, packed_actual);
+
+    int kept = 1;
+    for (int i = 0; i < sweep.point_size(); ++i) {
+        const auto& point = sweep.point(i);
+        if (std::isnan(point.x())) {
+            continue;
+        }
+        ASSERT_LT(kept, compensated.point_size());
+        const auto& point_new = compensated.point(kept);
+        ASSERT_FALSE(std::isnan(point_new.x())) << i;
+        ASSERT_EQ(point.timestamp(), point_new.timestamp()) << i;
+        ASSERT_EQ(point.intensity(), point_new.intensity()) << i;
+        ++kept;
+    }
+    EXPECT_EQ(kept, compensated.point_size());
+    EXPECT_LT(kept, sweep.point_size() + 1);
+}
+
+}  // namespace compensator
+}  // namespace drivers
+}  // namespace apollo
@@ -16,74 +16,167 @@
 
 #include "modules/drivers/lidar/fusion/pri_sec_fusion_component.h"
 
+#include <algorithm>
+#include <functional>
+#include <future>
 #include <memory>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace apollo {
 namespace drivers {
 namespace fusion {
 
+using apollo::common::util::MutablePackedPointCloudView;
+using apollo::common::util::PackedPoint;
+using apollo::common::util::PackedPointCloudView;
 using apollo::cyber::Time;
 
-bool PriSecFusionComponent::Init() {
-    if (!GetProtoConfig(&conf_)) {
-        AWARN << "Load config failed, config file" << ConfigFilePath();
-        return false;
-    }
-    buffer_ptr_ = apollo::transform::Buffer::Instance();
-
-    fusion_writer_ = node_->CreateWriter<PointCloud>(conf_.fusion_channel());
+namespace {
 
-    for (const auto& channel : conf_.input_channel()) {
-        auto reader = node_->CreateReader<PointCloud>(channel);
-        readers_.emplace_back(reader);
-    }
-    return true;
+template <typename MessageT>
+bool IsExpired(
+        const FusionConfig& conf,
+        const std::shared_ptr<MessageT>& target,
+        const std::shared_ptr<MessageT>& source) {
+    auto diff = target->measurement_time() - source->measurement_time();
+    return diff * 1000 > conf.max_interval_ms();
 }
 
-bool PriSecFusionComponent::Proc(
-        const std::shared_ptr<PointCloud>& point_cloud) {
-    auto target = std::make_shared<PointCloud>(*point_cloud);
-    auto fusion_readers = readers_;
+// Latest message of each reader, waiting at most wait_time_s for the
+// readers without one
+template <typename MessageT>
+std::vector<std::shared_ptr<MessageT>> CollectLatest(
+        const FusionConfig& conf,
+        std::vector<std::shared_ptr<Reader<MessageT>>> fusion_readers,
+        const std::shared_ptr<MessageT>& target) {
+    std::vector<std::shared_ptr<MessageT>> sources;
     auto start_time = Time::Now().ToSecond();
-    while ((Time::Now().ToSecond() - start_time) < conf_.wait_time_s()
+    while ((Time::Now().ToSecond() - start_time) < conf.wait_time_s()
            && fusion_readers.size() > 0) {
         for (auto itr = fusion_readers.begin(); itr != fusion_readers.end();) {
             (*itr)->Observe();
             if (!(*itr)->Empty()) {
                 auto source = (*itr)->GetLatestObserved();
-                if (conf_.drop_expired_data() && IsExpired(target, source)) {
+                if (conf.drop_expired_data()
+                    && IsExpired(conf, target, source)) {
                     ++itr;
                 } else {
-                    Fusion(target, source);
+                    sources.push_back(source);
                     itr = fusion_readers.erase(itr);
                 }
             } else {
                 ++itr;
             }
         }
+        if (fusion_readers.empty()) {
+            break;
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
     }
-    auto diff = Time::Now().ToNanosecond() - target->header().lidar_timestamp();
-    AINFO << "Pointcloud fusion diff: " << diff / 1000000 << "ms";
-    fusion_writer_->Write(target);
+    return sources;
+}
 
-    return true;
+// Run the tasks on the pool, the first one on the calling thread
+void RunTasks(
+        cyber::base::ThreadPool* thread_pool,
+        const std::vector<std::function<void()>>& tasks) {
+    std::vector<std::future<void>> futures;
+    for (size_t i = 1; i < tasks.size(); ++i) {
+        if (thread_pool != nullptr) {
+            auto future = thread_pool->Enqueue(tasks[i]);
+            if (future.valid()) {
+                futures.push_back(std::move(future));
+                continue;
+            }
+        }
+        tasks[i]();
+    }
+    if (!tasks.empty()) {
+        tasks[0]();
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
 }
 
-bool PriSecFusionComponent::IsExpired(
-        const std::shared_ptr<PointCloud>& target,
-        const std::shared_ptr<PointCloud>& source) {
-    auto diff = target->measurement_time() - source->measurement_time();
-    return diff * 1000 > conf_.max_interval_ms();
+size_t PoolThreadNum(const FusionConfig& conf) {
+    if (conf.thread_num() == 0) {
+        return static_cast<size_t>(conf.input_channel_size());
+    }
+    return conf.thread_num() - 1;
+}
+
+// Write the points of source, transformed by pose when not null, to the
+// points of target from offset on, which are already allocated
+void TransformPointCloud(
+        const PointCloud& source,
+        const Eigen::Affine3d* pose,
+        const int offset,
+        PointCloud* target) {
+    if (pose != nullptr && std::isnan((*pose)(0, 0))) {
+        pose = nullptr;
+    }
+    auto* points = target->mutable_point();
+    for (int i = 0; i < source.point_size(); ++i) {
+        const auto& point = source.point(i);
+        PointXYZIT* point_new = points->Mutable(offset + i);
+        point_new->set_intensity(point.intensity());
+        point_new->set_timestamp(point.timestamp());
+        if (pose == nullptr || std::isnan(point.x())) {
+            point_new->set_x(point.x());
+            point_new->set_y(point.y());
+            point_new->set_z(point.z());
+            continue;
+        }
+        const Eigen::Vector3d pt
+                = (*pose) * Eigen::Vector3d(point.x(), point.y(), point.z());
+        point_new->set_x(static_cast<float>(pt.x()));
+        point_new->set_y(static_cast<float>(pt.y()));
+        point_new->set_z(static_cast<float>(pt.z()));
+    }
 }
 
-bool PriSecFusionComponent::QueryPoseAffine(
+void TransformPointCloud(
+        const PackedPointCloud& source,
+        const Eigen::Affine3d* pose,
+        const size_t offset,
+        PackedPointCloud* target) {
+    if (pose != nullptr && std::isnan((*pose)(0, 0))) {
+        pose = nullptr;
+    }
+    const PackedPointCloudView points_source(source);
+    MutablePackedPointCloudView points(target);
+    PackedPoint* point_new = points.begin() + offset;
+    if (pose == nullptr) {
+        std::copy(points_source.begin(), points_source.end(), point_new);
+        return;
+    }
+    const Eigen::Matrix3d rotation = pose->linear();
+    const Eigen::Vector3d translation = pose->translation();
+    for (const auto& point : points_source) {
+        *point_new = point;
+        if (!std::isnan(point.x)) {
+            const Eigen::Vector3d pt
+                    = rotation * Eigen::Vector3d(point.x, point.y, point.z)
+                    + translation;
+            point_new->x = static_cast<float>(pt.x());
+            point_new->y = static_cast<float>(pt.y());
+            point_new->z = static_cast<float>(pt.z());
+        }
+        ++point_new;
+    }
+}
+
+bool QueryPoseAffine(
+        apollo::transform::Buffer* buffer_ptr,
         const std::string& target_frame_id,
         const std::string& source_frame_id,
         Eigen::Affine3d* pose) {
     std::string err_string;
-    if (!buffer_ptr_->canTransform(
+    if (!buffer_ptr->canTransform(
                 target_frame_id,
                 source_frame_id,
                 cyber::Time(0),
@@ -97,7 +190,7 @@ bool PriSecFusionComponent::QueryPoseAffine(
     }
     apollo::transform::TransformStamped stamped_transform;
     try {
-        stamped_transform = buffer_ptr_->lookupTransform(
+        stamped_transform = buffer_ptr->lookupTransform(
                 target_frame_id, source_frame_id, cyber::Time(0));
     } catch (tf2::TransformException& ex) {
         AERROR << ex.what();
@@ -115,65 +208,224 @@ bool PriSecFusionComponent::QueryPoseAffine(
     return true;
 }
 
-void PriSecFusionComponent::AppendPointCloud(
-        std::shared_ptr<PointCloud> point_cloud,
-        std::shared_ptr<PointCloud> point_cloud_add,
-        const Eigen::Affine3d& pose) {
-    if (std::isnan(pose(0, 0))) {
-        for (auto& point : point_cloud_add->point()) {
-            PointXYZIT* point_new = point_cloud->add_point();
-            point_new->set_intensity(point.intensity());
-            point_new->set_timestamp(point.timestamp());
-            point_new->set_x(point.x());
-            point_new->set_y(point.y());
-            point_new->set_z(point.z());
-        }
-    } else {
-        for (auto& point : point_cloud_add->point()) {
-            if (std::isnan(point.x())) {
-                PointXYZIT* point_new = point_cloud->add_point();
-                point_new->set_intensity(point.intensity());
-                point_new->set_timestamp(point.timestamp());
-                point_new->set_x(point.x());
-                point_new->set_y(point.y());
-                point_new->set_z(point.z());
-            } else {
-                PointXYZIT* point_new = point_cloud->add_point();
-                point_new->set_intensity(point.intensity());
-                point_new->set_timestamp(point.timestamp());
-                Eigen::Matrix<float, 3, 1> pt(point.x(), point.y(), point.z());
-                point_new->set_x(static_cast<float>(
-                        pose(0, 0) * pt.coeffRef(0)
-                        + pose(0, 1) * pt.coeffRef(1)
-                        + pose(0, 2) * pt.coeffRef(2) + pose(0, 3)));
-                point_new->set_y(static_cast<float>(
-                        pose(1, 0) * pt.coeffRef(0)
-                        + pose(1, 1) * pt.coeffRef(1)
-                        + pose(1, 2) * pt.coeffRef(2) + pose(1, 3)));
-                point_new->set_z(static_cast<float>(
-                        pose(2, 0) * pt.coeffRef(0)
-                        + pose(2, 1) * pt.coeffRef(1)
-                        + pose(2, 2) * pt.coeffRef(2) + pose(2, 3)));
-            }
+template <typename MessageT>
+bool QueryPoses(
+        apollo::transform::Buffer* buffer_ptr,
+        const MessageT& target,
+        std::vector<std::shared_ptr<MessageT>>* sources,
+        std::vector<Eigen::Affine3d>* poses) {
+    poses->clear();
+    for (auto itr = sources->begin(); itr != sources->end();) {
+        Eigen::Affine3d pose;
+        if (QueryPoseAffine(
+                    buffer_ptr,
+                    target.header().frame_id(),
+                    (*itr)->header().frame_id(),
+                    &pose)) {
+            poses->push_back(pose);
+            ++itr;
+        } else {
+            itr = sources->erase(itr);
         }
     }
+    return !sources->empty();
+}
+
+}  // namespace
+
+bool PriSecFusionComponent::Init() {
+    if (!GetProtoConfig(&conf_)) {
+        AWARN << "Load config failed, config file" << ConfigFilePath();
+        return false;
+    }
+    if (conf_.buffer_size() <= 0) {
+        AERROR << "Invalid buffer_size " << conf_.buffer_size()
+               << ", config file " << ConfigFilePath();
+        return false;
+    }
+    buffer_ptr_ = apollo::transform::Buffer::Instance();
 
-    int new_width = point_cloud->point_size() / point_cloud->height();
-    point_cloud->set_width(new_width);
+    fusion_writer_ = node_->CreateWriter<PointCloud>(conf_.fusion_channel());
+
+    for (const auto& channel : conf_.input_channel()) {
+        auto reader = node_->CreateReader<PointCloud>(channel);
+        readers_.emplace_back(reader);
+    }
+
+    const size_t pool_thread_num = PoolThreadNum(conf_);
+    if (pool_thread_num > 0) {
+        thread_pool_.reset(new cyber::base::ThreadPool(pool_thread_num));
+    }
+    const int point_cloud_reserve
+            = static_cast<int>(conf_.point_cloud_reserve());
+    pcd_buffer_ = std::make_shared<lidar::SyncBuffering<PointCloud>>(
+            [point_cloud_reserve]() {
+                auto point_cloud = std::make_shared<PointCloud>();
+                point_cloud->mutable_point()->Reserve(point_cloud_reserve);
+                return point_cloud;
+            },
+            [](std::shared_ptr<PointCloud>& point_cloud) {
+                // the cleared points are reused by the next frame
+                point_cloud->clear_point();
+            });
+    pcd_buffer_->SetBufferSize(conf_.buffer_size());
+    pcd_buffer_->Init();
+    return true;
+}
+
+bool PriSecFusionComponent::Proc(
+        const std::shared_ptr<PointCloud>& point_cloud) {
+    auto sources = CollectLatest<PointCloud>(conf_, readers_, point_cloud);
+    auto target = pcd_buffer_->AllocateElement();
+    Fusion(*point_cloud, &sources, target.get());
+    auto diff = Time::Now().ToNanosecond() - target->header().lidar_timestamp();
+    AINFO << "Pointcloud fusion diff: " << diff / 1000000 << "ms";
+    fusion_writer_->Write(target);
+
+    return true;
 }
 
 bool PriSecFusionComponent::Fusion(
-        std::shared_ptr<PointCloud> target,
-        std::shared_ptr<PointCloud> source) {
-    Eigen::Affine3d pose;
-    if (QueryPoseAffine(
-                target->header().frame_id(),
-                source->header().frame_id(),
-                &pose)) {
-        AppendPointCloud(target, source, pose);
-        return true;
-    }
-    return false;
+        const PointCloud& primary,
+        std::vector<std::shared_ptr<PointCloud>>* sources,
+        PointCloud* target) {
+    std::vector<Eigen::Affine3d> poses;
+    const bool fused = QueryPoses(buffer_ptr_, primary, sources, &poses);
+
+    target->mutable_header()->CopyFrom(primary.header());
+    target->set_frame_id(primary.frame_id());
+    target->set_is_dense(primary.is_dense());
+    target->set_measurement_time(primary.measurement_time());
+    target->set_height(primary.height());
+
+    // the final size is known, the points are all added before being
+    // written concurrently, one task per cloud
+    int point_num = primary.point_size();
+    for (const auto& source : *sources) {
+        point_num += source->point_size();
+    }
+    auto* points = target->mutable_point();
+    points->Reserve(point_num);
+    while (points->size() < point_num) {
+        points->Add();
+    }
+
+    std::vector<std::function<void()>> tasks;
+    tasks.emplace_back([&primary, target]() {
+        TransformPointCloud(primary, nullptr, 0, target);
+    });
+    int offset = primary.point_size();
+    for (size_t i = 0; i < sources->size(); ++i) {
+        const PointCloud& source = *(*sources)[i];
+        const Eigen::Affine3d* pose = &poses[i];
+        tasks.emplace_back([&source, pose, offset, target]() {
+            TransformPointCloud(source, pose, offset, target);
+        });
+        offset += source.point_size();
+    }
+    RunTasks(thread_pool_.get(), tasks);
+
+    if (target->height() > 0) {
+        target->set_width(point_num / target->height());
+    }
+    return fused;
+}
+
+bool PackedPriSecFusionComponent::Init() {
+    if (!GetProtoConfig(&conf_)) {
+        AWARN << "Load config failed, config file" << ConfigFilePath();
+        return false;
+    }
+    if (conf_.buffer_size() <= 0) {
+        AERROR << "Invalid buffer_size " << conf_.buffer_size()
+               << ", config file " << ConfigFilePath();
+        return false;
+    }
+    buffer_ptr_ = apollo::transform::Buffer::Instance();
+
+    fusion_writer_
+            = node_->CreateWriter<PackedPointCloud>(conf_.fusion_channel());
+
+    for (const auto& channel : conf_.input_channel()) {
+        auto reader = node_->CreateReader<PackedPointCloud>(channel);
+        readers_.emplace_back(reader);
+    }
+
+    const size_t pool_thread_num = PoolThreadNum(conf_);
+    if (pool_thread_num > 0) {
+        thread_pool_.reset(new cyber::base::ThreadPool(pool_thread_num));
+    }
+    const size_t point_cloud_reserve = conf_.point_cloud_reserve();
+    pcd_buffer_ = std::make_shared<lidar::SyncBuffering<PackedPointCloud>>(
+            [point_cloud_reserve]() {
+                auto point_cloud = std::make_shared<PackedPointCloud>();
+                MutablePackedPointCloudView(point_cloud.get())
+                        .Reserve(point_cloud_reserve);
+                return point_cloud;
+            },
+            [](std::shared_ptr<PackedPointCloud>& point_cloud) {
+                // clear() keeps the capacity of the data
+                point_cloud->mutable_data()->clear();
+            });
+    pcd_buffer_->SetBufferSize(conf_.buffer_size());
+    pcd_buffer_->Init();
+    return true;
+}
+
+bool PackedPriSecFusionComponent::Proc(
+        const std::shared_ptr<PackedPointCloud>& point_cloud) {
+    auto sources
+            = CollectLatest<PackedPointCloud>(conf_, readers_, point_cloud);
+    auto target = pcd_buffer_->AllocateElement();
+    Fusion(*point_cloud, &sources, target.get());
+    auto diff = Time::Now().ToNanosecond() - target->header().lidar_timestamp();
+    AINFO << "Pointcloud fusion diff: " << diff / 1000000 << "ms";
+    fusion_writer_->Write(target);
+
+    return true;
+}
+
+bool PackedPriSecFusionComponent::Fusion(
+        const PackedPointCloud& primary,
+        std::vector<std::shared_ptr<PackedPointCloud>>* sources,
+        PackedPointCloud* target) {
+    std::vector<Eigen::Affine3d> poses;
+    const bool fused = QueryPoses(buffer_ptr_, primary, sources, &poses);
+
+    target->mutable_header()->CopyFrom(primary.header());
+    target->set_frame_id(primary.frame_id());
+    target->set_is_dense(primary.is_dense());
+    target->set_measurement_time(primary.measurement_time());
+    target->set_height(primary.height());
+
+    const size_t primary_size = PackedPointCloudView(primary).size();
+    size_t point_num = primary_size;
+    for (const auto& source : *sources) {
+        point_num += PackedPointCloudView(*source).size();
+    }
+    // a single resize of the data, the points are then written in place
+    MutablePackedPointCloudView(target).Resize(point_num);
+
+    std::vector<std::function<void()>> tasks;
+    tasks.emplace_back([&primary, target]() {
+        TransformPointCloud(primary, nullptr, 0, target);
+    });
+    size_t offset = primary_size;
+    for (size_t i = 0; i < sources->size(); ++i) {
+        const PackedPointCloud& source = *(*sources)[i];
+        const Eigen::Affine3d* pose = &poses[i];
+        tasks.emplace_back([&source, pose, offset, target]() {
+            TransformPointCloud(source, pose, offset, target);
+        });
+        offset += PackedPointCloudView(source).size();
+    }
+    RunTasks(thread_pool_.get(), tasks);
+
+    if (target->height() > 0) {
+        target->set_width(
+                static_cast<uint32_t>(point_num / target->height()));
+    }
+    return fused;
 }
 
 }  // namespace fusion
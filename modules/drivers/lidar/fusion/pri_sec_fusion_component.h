@@ -31,7 +31,10 @@
 #include "modules/common_msgs/sensor_msgs/pointcloud.pb.h"
 #include "modules/drivers/lidar/fusion/proto/fusion_config.pb.h"
 
+#include "cyber/base/thread_pool.h"
 #include "cyber/cyber.h"
+#include "modules/common/util/packed_point_cloud.h"
+#include "modules/drivers/lidar/common/sync_buffering.h"
 #include "modules/transform/buffer.h"
 
 namespace apollo {
@@ -41,6 +44,7 @@ namespace fusion {
 using apollo::cyber::Component;
 using apollo::cyber::Reader;
 using apollo::cyber::Writer;
+using apollo::drivers::PackedPointCloud;
 using apollo::drivers::PointCloud;
 
 class PriSecFusionComponent : public Component<PointCloud> {
@@ -49,28 +53,49 @@ class PriSecFusionComponent : public Component<PointCloud> {
     bool Proc(const std::shared_ptr<PointCloud>& point_cloud) override;
 
  private:
+    /**
+     * @brief fuse primary and the sources with a known pose into target,
+     *   the sources without one are removed
+     */
     bool Fusion(
-            std::shared_ptr<PointCloud> target,
-            std::shared_ptr<PointCloud> source);
-    bool IsExpired(
-            const std::shared_ptr<PointCloud>& target,
-            const std::shared_ptr<PointCloud>& source);
-    bool QueryPoseAffine(
-            const std::string& target_frame_id,
-            const std::string& source_frame_id,
-            Eigen::Affine3d* pose);
-    void AppendPointCloud(
-            std::shared_ptr<PointCloud> point_cloud,
-            std::shared_ptr<PointCloud> point_cloud_add,
-            const Eigen::Affine3d& pose);
+            const PointCloud& primary,
+            std::vector<std::shared_ptr<PointCloud>>* sources,
+            PointCloud* target);
 
     FusionConfig conf_;
     apollo::transform::Buffer* buffer_ptr_ = nullptr;
     std::shared_ptr<Writer<PointCloud>> fusion_writer_;
     std::vector<std::shared_ptr<Reader<PointCloud>>> readers_;
+    std::unique_ptr<cyber::base::ThreadPool> thread_pool_;
+    std::shared_ptr<lidar::SyncBuffering<PointCloud>> pcd_buffer_;
+};
+
+/**
+ * @class PackedPriSecFusionComponent
+ * @brief Fuses packed point clouds, with the same config as
+ *   PriSecFusionComponent
+ */
+class PackedPriSecFusionComponent : public Component<PackedPointCloud> {
+ public:
+    bool Init() override;
+    bool Proc(const std::shared_ptr<PackedPointCloud>& point_cloud) override;
+
+ private:
+    bool Fusion(
+            const PackedPointCloud& primary,
+            std::vector<std::shared_ptr<PackedPointCloud>>* sources,
+            PackedPointCloud* target);
+
+    FusionConfig conf_;
+    apollo::transform::Buffer* buffer_ptr_ = nullptr;
+    std::shared_ptr<Writer<PackedPointCloud>> fusion_writer_;
+    std::vector<std::shared_ptr<Reader<PackedPointCloud>>> readers_;
+    std::unique_ptr<cyber::base::ThreadPool> thread_pool_;
+    std::shared_ptr<lidar::SyncBuffering<PackedPointCloud>> pcd_buffer_;
 };
 
 CYBER_REGISTER_COMPONENT(PriSecFusionComponent)
+CYBER_REGISTER_COMPONENT(PackedPriSecFusionComponent)
 }  // namespace fusion
 }  // namespace drivers
 }  // namespace apollo
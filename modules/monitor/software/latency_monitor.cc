@@ -18,11 +18,12 @@
 
 #include <algorithm>
 #include <memory>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
 #include "cyber/common/log.h"
 #include "cyber/time/time.h"
 #include "modules/common/adapters/adapter_gflags.h"
@@ -42,53 +43,53 @@ DEFINE_double(latency_report_interval, 15.0,
 DEFINE_int32(latency_reader_capacity, 30,
              "The max message numbers in latency reader queue.");
 
+DEFINE_string(latency_e2e_chains, "",
+              "End to end chains of latency recorders joined by message id, "
+              "as recorder names separated by ',', chains separated by ';'. "
+              "Default to pointcloud -> perception -> prediction -> planning "
+              "-> control.");
+
 namespace apollo {
 namespace monitor {
 
 namespace {
 
+using apollo::common::LatencyHistogram;
 using apollo::common::LatencyRecordMap;
 using apollo::common::LatencyReport;
-using apollo::common::LatencyStat;
 using apollo::common::LatencyTrack;
 
-LatencyStat GenerateStat(const std::vector<uint64_t>& numbers) {
-  LatencyStat stat;
-  uint64_t min_number = (1UL << 63), max_number = 0, sum = 0;
-  for (const auto number : numbers) {
-    min_number = std::min(min_number, number);
-    max_number = std::max(max_number, number);
-    sum += number;
-  }
-  const uint32_t sample_size = static_cast<uint32_t>(numbers.size());
-  stat.set_min_duration(min_number);
-  stat.set_max_duration(max_number);
-  stat.set_aver_duration(
-      sample_size == 0 ? 0 : static_cast<uint64_t>(sum / sample_size));
-  stat.set_sample_size(sample_size);
-  return stat;
-}
-
-void SetStat(const LatencyStat& src, LatencyStat* dst) {
-  dst->set_min_duration(src.min_duration());
-  dst->set_max_duration(src.max_duration());
-  dst->set_aver_duration(src.aver_duration());
-  dst->set_sample_size(src.sample_size());
-}
-
 void SetLatency(const std::string& latency_name,
-                const std::vector<uint64_t>& latency_values,
-                LatencyTrack* track) {
+                const LatencyHistogram& histogram, LatencyTrack* track) {
   auto* latency_track = track->add_latency_track();
   latency_track->set_latency_name(latency_name);
-  SetStat(GenerateStat(latency_values), latency_track->mutable_latency_stat());
+  histogram.ToStat(latency_track->mutable_latency_stat());
+}
+
+std::vector<std::vector<std::string>> ParseChains(const std::string& chains) {
+  std::vector<std::vector<std::string>> result;
+  for (const auto& chain : absl::StrSplit(chains, ';', absl::SkipEmpty())) {
+    std::vector<std::string> modules =
+        absl::StrSplit(chain, ',', absl::SkipWhitespace());
+    if (modules.size() >= 2) {
+      result.push_back(std::move(modules));
+    }
+  }
+  return result;
 }
 
 }  // namespace
 
 LatencyMonitor::LatencyMonitor()
     : RecurrentRunner(FLAGS_latency_monitor_name,
-                      FLAGS_latency_monitor_interval) {}
+                      FLAGS_latency_monitor_interval) {
+  chains_ = ParseChains(FLAGS_latency_e2e_chains);
+  if (FLAGS_latency_e2e_chains.empty()) {
+    chains_.push_back({FLAGS_pointcloud_topic, FLAGS_perception_obstacle_topic,
+                       FLAGS_prediction_topic, FLAGS_planning_trajectory_topic,
+                       FLAGS_control_command_topic});
+  }
+}
 
 void LatencyMonitor::RunOnce(const double current_time) {
   static auto reader =
@@ -114,7 +115,7 @@ void LatencyMonitor::RunOnce(const double current_time) {
 
   if (current_time - flush_time_ > FLAGS_latency_report_interval) {
     flush_time_ = current_time;
-    if (!track_map_.empty()) {
+    if (!track_map_.empty() || !modules_histogram_.empty()) {
       PublishLatencyReport();
     }
   }
@@ -127,6 +128,17 @@ void LatencyMonitor::UpdateStat(
     track_map_[record.message_id()].emplace(record.begin_time(),
                                             record.end_time(), module_name);
   }
+  // recorders publish their latencies in compact form, older ones only the
+  // records themselves
+  auto& histogram = modules_histogram_[module_name];
+  if (!records->has_latency_distribution() ||
+      !histogram.Merge(records->latency_distribution())) {
+    for (const auto& record : records->latency_records()) {
+      if (record.end_time() > record.begin_time()) {
+        histogram.Record(record.end_time() - record.begin_time());
+      }
+    }
+  }
 
   if (!records->latency_records().empty()) {
     const auto begin_time = records->latency_records().begin()->begin_time();
@@ -147,29 +159,18 @@ void LatencyMonitor::PublishLatencyReport() {
   writer->Write(latency_report_);
   latency_report_.clear_header();
   track_map_.clear();
+  modules_histogram_.clear();
   latency_report_.clear_modules_latency();
   latency_report_.clear_e2es_latency();
 }
 
 void LatencyMonitor::AggregateLatency() {
   static const std::string kE2EStartPoint = FLAGS_pointcloud_topic;
-  std::unordered_map<std::string, std::vector<uint64_t>> modules_track;
-  std::unordered_map<std::string, std::vector<uint64_t>> e2es_track;
-  std::unordered_set<std::string> all_modules;
+  std::unordered_map<std::string, LatencyHistogram> e2es_track;
 
-  // Aggregate modules latencies
-  std::string module_name;
-  uint64_t begin_time = 0, end_time = 0;
-  for (const auto& message : track_map_) {
-    auto iter = message.second.begin();
-    while (iter != message.second.end()) {
-      std::tie(begin_time, end_time, module_name) = *iter;
-      modules_track[module_name].push_back(end_time - begin_time);
-      all_modules.emplace(module_name);
-      ++iter;
-    }
-  }
   // Aggregate E2E latencies
+  std::string module_name;
+  uint64_t begin_time = 0;
   std::unordered_map<std::string, uint64_t> e2e_latencies;
   for (const auto& message : track_map_) {
     uint64_t e2e_begin_time = 0;
@@ -183,7 +184,7 @@ void LatencyMonitor::AggregateLatency() {
                  e2e_latencies.find(module_name) == e2e_latencies.end()) {
         const auto duration = begin_time - e2e_begin_time;
         e2e_latencies[module_name] = duration;
-        e2es_track[module_name].push_back(duration);
+        e2es_track[module_name].Record(duration);
       }
       ++iter;
     }
@@ -192,18 +193,18 @@ void LatencyMonitor::AggregateLatency() {
   // The results could be in the following fromat:
   // e2e latency:
   // pointcloud -> perception: min(500), max(600), average(550),
-  // sample_size(1500) pointcloud -> planning: min(800), max(1000),
-  // average(900), sample_size(1500) pointcloud -> control: min(1200),
-  // max(1300), average(1250), sample_size(1500)
+  // p50(540), p90(580), p99(595), p99.9(600), sample_size(1500)
+  // pointcloud -> planning: min(800), max(1000), average(900), ...
+  // pointcloud -> perception -> prediction -> planning -> control: ...
   // ...
   // modules latency:
-  // perception: min(5), max(50), average(30), sample_size(1000)
-  // prediction: min(500), max(5000), average(2000), sample_size(800)
-  // control: min(500), max(800), average(600), sample_size(800)
+  // perception: min(5), max(50), average(30), p50(28), p90(45), ...
+  // prediction: min(500), max(5000), average(2000), ...
+  // control: min(500), max(800), average(600), ...
   // ...
 
   auto* modules_latency = latency_report_.mutable_modules_latency();
-  for (const auto& module : modules_track) {
+  for (const auto& module : modules_histogram_) {
     SetLatency(module.first, module.second, modules_latency);
   }
   auto* e2es_latency = latency_report_.mutable_e2es_latency();
@@ -211,6 +212,41 @@ void LatencyMonitor::AggregateLatency() {
     SetLatency(absl::StrCat(kE2EStartPoint, " -> ", e2e.first), e2e.second,
                e2es_latency);
   }
+  AggregateChainLatency();
+}
+
+void LatencyMonitor::AggregateChainLatency() {
+  // A chain latency spans from the beginning of its first module to the end
+  // of its last one for the same message, the modules in between may not
+  // record latencies.
+  std::vector<LatencyHistogram> chains_track(chains_.size());
+  std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> modules_time;
+  for (const auto& message : track_map_) {
+    modules_time.clear();
+    // the records are ordered by begin time, keep the first of each module
+    for (const auto& record : message.second) {
+      modules_time.emplace(std::get<2>(record),
+                           std::make_pair(std::get<0>(record),
+                                          std::get<1>(record)));
+    }
+    for (size_t i = 0; i < chains_.size(); ++i) {
+      const auto first = modules_time.find(chains_[i].front());
+      const auto last = modules_time.find(chains_[i].back());
+      if (first == modules_time.end() || last == modules_time.end() ||
+          last->second.second < first->second.first) {
+        continue;
+      }
+      chains_track[i].Record(last->second.second - first->second.first);
+    }
+  }
+
+  auto* e2es_latency = latency_report_.mutable_e2es_latency();
+  for (size_t i = 0; i < chains_.size(); ++i) {
+    if (!chains_track[i].empty()) {
+      SetLatency(absl::StrJoin(chains_[i], " -> "), chains_track[i],
+                 e2es_latency);
+    }
+  }
 }
 
 bool LatencyMonitor::GetFrequency(const std::string& channel_name,
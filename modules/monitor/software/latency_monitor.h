@@ -21,7 +21,9 @@
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
+#include "modules/common/latency_recorder/latency_histogram.h"
 #include "modules/common/latency_recorder/proto/latency_record.pb.h"
 #include "modules/monitor/common/recurrent_runner.h"
 
@@ -39,8 +41,14 @@ class LatencyMonitor : public RecurrentRunner {
       const std::shared_ptr<apollo::common::LatencyRecordMap>& records);
   void PublishLatencyReport();
   void AggregateLatency();
+  void AggregateChainLatency();
 
   apollo::common::LatencyReport latency_report_;
+  // latencies of the modules merged from the recorders since the last report
+  std::unordered_map<std::string, apollo::common::LatencyHistogram>
+      modules_histogram_;
+  // modules of the end to end chains, in processing order
+  std::vector<std::vector<std::string>> chains_;
   std::unordered_map<uint64_t,
                      std::set<std::tuple<uint64_t, uint64_t, std::string>>>
       track_map_;
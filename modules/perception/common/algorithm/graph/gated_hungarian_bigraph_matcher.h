@@ -18,14 +18,17 @@
 
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <map>
 #include <utility>
 #include <vector>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 
 #include "modules/perception/common/algorithm/graph/connected_component_analysis.h"
 #include "modules/perception/common/algorithm/graph/hungarian_optimizer.h"
+#include "modules/perception/common/algorithm/graph/sparse_assignment_optimizer.h"
 
 namespace apollo {
 namespace perception {
@@ -35,6 +38,9 @@ template <typename T>
 class GatedHungarianMatcher {
  public:
   enum class OptimizeFlag { OPTMAX, OPTMIN };
+  /* HUNGARIAN: dense Munkres on the local cost matrix of each component
+   * SPARSE_LAPJV: shortest augmenting path on gated edges of each component */
+  enum class OptimizerType { HUNGARIAN, SPARSE_LAPJV };
 
   explicit GatedHungarianMatcher(int max_matching_size = 1000) {
     global_costs_.Reserve(max_matching_size, max_matching_size);
@@ -52,6 +58,17 @@ class GatedHungarianMatcher {
   const SecureMat<T>& global_costs() const { return global_costs_; }
   SecureMat<T>* mutable_global_costs() { return &global_costs_; }
 
+  /* @brief: select the optimizer of connected components, HUNGARIAN is the
+   * default one. With SPARSE_LAPJV, components could be optimized in
+   * parallel, the assignments are the same as the serial ones. */
+  void set_optimizer_type(OptimizerType optimizer_type) {
+    optimizer_type_ = optimizer_type;
+  }
+  OptimizerType optimizer_type() const { return optimizer_type_; }
+  void set_parallel_components(bool parallel_components) {
+    parallel_components_ = parallel_components;
+  }
+
   void Match(T cost_thresh, OptimizeFlag opt_flag,
              std::vector<std::pair<size_t, size_t>>* assignments,
              std::vector<size_t>* unassigned_rows,
@@ -97,9 +114,32 @@ class GatedHungarianMatcher {
   void OptimizeAdapter(
       std::vector<std::pair<size_t, size_t>>* local_assignments);
 
+  /* @brief: optimize all the connected components with sparse optimizers,
+   * non-trivial components are dispatched to cyber tasks if enabled. */
+  void OptimizeConnectedComponentsSparse(
+      const std::vector<std::vector<size_t>>& row_components,
+      const std::vector<std::vector<size_t>>& col_components);
+
+  /* @brief: optimize single connected component with the sparse optimizer,
+   * the global assignments are appended to component_assignments */
+  void OptimizeSparseComponent(
+      const std::vector<size_t>& row_component,
+      const std::vector<size_t>& col_component,
+      SparseAssignmentOptimizer<T>* sparse_optimizer,
+      std::vector<std::pair<size_t, size_t>>* component_assignments) const;
+
+  /* components smaller than it are optimized in the calling thread */
+  static constexpr size_t kMinParallelComponentSize = 32;
+
   /* Hungarian optimizer */
   HungarianOptimizer<T> optimizer_;
 
+  /* sparse optimizers, one for each component optimized in parallel */
+  std::vector<SparseAssignmentOptimizer<T>> sparse_optimizers_;
+  std::vector<std::vector<std::pair<size_t, size_t>>> component_assignments_;
+  OptimizerType optimizer_type_ = OptimizerType::HUNGARIAN;
+  bool parallel_components_ = false;
+
   /* global costs matrix */
   SecureMat<T> global_costs_;
 
@@ -156,8 +196,12 @@ void GatedHungarianMatcher<T>::Match(
   /* compute assignments */
   assignments_ptr_->clear();
   assignments_ptr_->reserve(std::max(rows_num_, cols_num_));
-  for (size_t i = 0; i < row_components.size(); ++i) {
-    this->OptimizeConnectedComponent(row_components[i], col_components[i]);
+  if (optimizer_type_ == OptimizerType::SPARSE_LAPJV) {
+    this->OptimizeConnectedComponentsSparse(row_components, col_components);
+  } else {
+    for (size_t i = 0; i < row_components.size(); ++i) {
+      this->OptimizeConnectedComponent(row_components[i], col_components[i]);
+    }
   }
 
   this->GenerateUnassignedData(unassigned_rows, unassigned_cols);
@@ -318,6 +362,97 @@ void GatedHungarianMatcher<T>::OptimizeAdapter(
   }
 }
 
+template <typename T>
+void GatedHungarianMatcher<T>::OptimizeConnectedComponentsSparse(
+    const std::vector<std::vector<size_t>>& row_components,
+    const std::vector<std::vector<size_t>>& col_components) {
+  const size_t components_num = row_components.size();
+  if (sparse_optimizers_.size() < components_num) {
+    sparse_optimizers_.resize(components_num);
+  }
+  if (component_assignments_.size() < components_num) {
+    component_assignments_.resize(components_num);
+  }
+
+  std::vector<std::future<void>> futures;
+  for (size_t i = 0; i < components_num; ++i) {
+    component_assignments_[i].clear();
+    /* small components are not worth a task */
+    const bool small_component =
+        row_components[i].size() + col_components[i].size() <
+        kMinParallelComponentSize;
+    if (!parallel_components_ || small_component) {
+      OptimizeSparseComponent(row_components[i], col_components[i],
+                              &sparse_optimizers_[i],
+                              &component_assignments_[i]);
+      continue;
+    }
+    futures.emplace_back(cyber::Async(
+        &GatedHungarianMatcher<T>::OptimizeSparseComponent, this,
+        std::cref(row_components[i]), std::cref(col_components[i]),
+        &sparse_optimizers_[i], &component_assignments_[i]));
+  }
+  for (auto& future : futures) {
+    future.wait();
+  }
+
+  /* merge in the order of components, same as the serial one */
+  for (size_t i = 0; i < components_num; ++i) {
+    assignments_ptr_->insert(assignments_ptr_->end(),
+                             component_assignments_[i].begin(),
+                             component_assignments_[i].end());
+  }
+}
+
+template <typename T>
+void GatedHungarianMatcher<T>::OptimizeSparseComponent(
+    const std::vector<size_t>& row_component,
+    const std::vector<size_t>& col_component,
+    SparseAssignmentOptimizer<T>* sparse_optimizer,
+    std::vector<std::pair<size_t, size_t>>* component_assignments) const {
+  size_t local_rows_num = row_component.size();
+  size_t local_cols_num = col_component.size();
+
+  /* simple case 1: no possible matches */
+  if (!local_rows_num || !local_cols_num) {
+    return;
+  }
+  /* simple case 2: 1v1 pair with no ambiguousness */
+  if (local_rows_num == 1 && local_cols_num == 1) {
+    size_t idx_r = row_component[0];
+    size_t idx_c = col_component[0];
+    if (is_valid_cost_(global_costs_(idx_r, idx_c))) {
+      component_assignments->push_back(std::make_pair(idx_r, idx_c));
+    }
+    return;
+  }
+
+  /* collect gated edges only */
+  sparse_optimizer->Reset(local_rows_num, local_cols_num);
+  for (size_t i = 0; i < local_rows_num; ++i) {
+    for (size_t j = 0; j < local_cols_num; ++j) {
+      const T& current_cost = global_costs_(row_component[i], col_component[j]);
+      if (is_valid_cost_(current_cost)) {
+        sparse_optimizer->AddEdge(i, j, current_cost);
+      }
+    }
+  }
+
+  std::vector<std::pair<size_t, size_t>> local_assignments;
+  if (opt_flag_ == OptimizeFlag::OPTMAX) {
+    sparse_optimizer->Maximize(bound_value_, &local_assignments);
+  } else {
+    sparse_optimizer->Minimize(bound_value_, &local_assignments);
+  }
+
+  /* parse local assginments into global ones */
+  for (const auto& local_assignment : local_assignments) {
+    component_assignments->push_back(
+        std::make_pair(row_component[local_assignment.first],
+                       col_component[local_assignment.second]));
+  }
+}
+
 }  // namespace algorithm
 }  // namespace perception
 }  // namespace apollo
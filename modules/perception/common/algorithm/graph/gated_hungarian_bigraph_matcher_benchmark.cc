@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/* Compare the dense hungarian optimizer with the sparse one behind
+ * GatedHungarianMatcher. Tracks and objects are scattered over a square
+ * whose size keeps the density of a crowded scene, costs are the euclidean
+ * distances between them and gated by cost_thresh, like the association of
+ * lidar tracking and multi-sensor fusion.
+ *
+ * Usage:
+ *   gated_hungarian_bigraph_matcher_benchmark --benchmark_min_time=1
+ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/perception/common/algorithm/graph/gated_hungarian_bigraph_matcher.h"
+
+namespace apollo {
+namespace perception {
+namespace algorithm {
+namespace {
+
+typedef GatedHungarianMatcher<float> Matcher;
+
+constexpr float kCostThresh = 4.0f;
+constexpr float kBoundValue = 10.0f;
+/* objects per square meter, which makes a lot of ambiguous gates */
+constexpr float kObjectDensity = 0.01f;
+
+void FillCosts(size_t objects_num, float gate_scale, Matcher* matcher) {
+  std::mt19937 generator(static_cast<unsigned int>(objects_num));
+  float range = std::sqrt(static_cast<float>(objects_num) / kObjectDensity);
+  std::uniform_real_distribution<float> position(0.0f, range);
+  std::normal_distribution<float> noise(0.0f, 1.0f);
+  std::vector<float> track_x(objects_num);
+  std::vector<float> track_y(objects_num);
+  for (size_t i = 0; i < objects_num; ++i) {
+    track_x[i] = position(generator);
+    track_y[i] = position(generator);
+  }
+
+  SecureMat<float>* costs = matcher->mutable_global_costs();
+  costs->Resize(objects_num, objects_num);
+  for (size_t j = 0; j < objects_num; ++j) {
+    float object_x = track_x[j] + noise(generator);
+    float object_y = track_y[j] + noise(generator);
+    for (size_t i = 0; i < objects_num; ++i) {
+      float dx = track_x[i] - object_x;
+      float dy = track_y[i] - object_y;
+      (*costs)(i, j) = std::sqrt(dx * dx + dy * dy) / gate_scale;
+    }
+  }
+}
+
+void BM_GatedMatch(benchmark::State& state, Matcher::OptimizerType type,
+                   bool parallel) {
+  const size_t objects_num = static_cast<size_t>(state.range(0));
+  /* gate_scale > 1 widens the gate and merges the connected components */
+  const float gate_scale = static_cast<float>(state.range(1)) / 10.0f;
+  Matcher matcher(static_cast<int>(objects_num));
+  matcher.set_optimizer_type(type);
+  matcher.set_parallel_components(parallel);
+  FillCosts(objects_num, gate_scale, &matcher);
+
+  std::vector<std::pair<size_t, size_t>> assignments;
+  std::vector<size_t> unassigned_rows;
+  std::vector<size_t> unassigned_cols;
+  for (auto _ : state) {
+    matcher.Match(kCostThresh, kBoundValue, Matcher::OptimizeFlag::OPTMIN,
+                  &assignments, &unassigned_rows, &unassigned_cols);
+    benchmark::DoNotOptimize(assignments.data());
+  }
+  state.counters["assignments"] = static_cast<double>(assignments.size());
+}
+
+void MatchArgs(benchmark::internal::Benchmark* bench) {
+  for (int objects_num : {50, 200, 1000}) {
+    /* gate scale 1.0 and 3.0 */
+    bench->Args({objects_num, 10});
+    bench->Args({objects_num, 30});
+  }
+  bench->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_CAPTURE(BM_GatedMatch, hungarian, Matcher::OptimizerType::HUNGARIAN,
+                  false)
+    ->Apply(MatchArgs);
+BENCHMARK_CAPTURE(BM_GatedMatch, sparse_lapjv,
+                  Matcher::OptimizerType::SPARSE_LAPJV, false)
+    ->Apply(MatchArgs);
+BENCHMARK_CAPTURE(BM_GatedMatch, sparse_lapjv_parallel,
+                  Matcher::OptimizerType::SPARSE_LAPJV, true)
+    ->Apply(MatchArgs)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace algorithm
+}  // namespace perception
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -16,6 +16,8 @@
 
 #include "modules/perception/common/algorithm/graph/gated_hungarian_bigraph_matcher.h"
 
+#include <random>
+
 #include "Eigen/Core"
 #include "gtest/gtest.h"
 
@@ -551,6 +553,72 @@ TEST_F(GatedHungarianMatcherTest, test_Match_Maximize) {
   EXPECT_EQ(0, unassigned_rows.size());
 }
 
+TEST_F(GatedHungarianMatcherTest, test_Match_SparseLapjv) {
+  /* random gated costs, the sparse optimizer should find assignments with the
+   * same total cost as the hungarian one, serial or parallel */
+  GatedHungarianMatcher<float> sparse_matcher(1000);
+  GatedHungarianMatcher<float> parallel_matcher(1000);
+  sparse_matcher.set_optimizer_type(
+      GatedHungarianMatcher<float>::OptimizerType::SPARSE_LAPJV);
+  parallel_matcher.set_optimizer_type(
+      GatedHungarianMatcher<float>::OptimizerType::SPARSE_LAPJV);
+  parallel_matcher.set_parallel_components(true);
+
+  float cost_thresh = 2.5f;
+  float bound_value = 10.0f;
+  GatedHungarianMatcher<float>::OptimizeFlag opt_flag =
+      GatedHungarianMatcher<float>::OptimizeFlag::OPTMIN;
+  std::vector<std::pair<size_t, size_t>> assignments;
+  std::vector<std::pair<size_t, size_t>> sparse_assignments;
+  std::vector<std::pair<size_t, size_t>> parallel_assignments;
+  std::vector<size_t> unassigned_rows;
+  std::vector<size_t> unassigned_cols;
+
+  std::mt19937 generator(2024);
+  std::uniform_real_distribution<float> cost_distribution(0.0f, 20.0f);
+  auto total_cost = [&](const std::vector<std::pair<size_t, size_t>>& pairs) {
+    double total = 0.0;
+    for (const auto& pair : pairs) {
+      total += (*optimizer_->mutable_global_costs())(pair.first, pair.second);
+    }
+    return total - static_cast<double>(pairs.size()) * bound_value;
+  };
+
+  for (size_t trial = 0; trial < 20; ++trial) {
+    size_t rows_num = 5 + trial * 3;
+    size_t cols_num = 4 + trial * 2;
+    std::vector<SecureMat<float>*> all_costs = {
+        optimizer_->mutable_global_costs(),
+        sparse_matcher.mutable_global_costs(),
+        parallel_matcher.mutable_global_costs()};
+    for (auto* costs : all_costs) {
+      costs->Resize(rows_num, cols_num);
+    }
+    for (size_t i = 0; i < rows_num; ++i) {
+      for (size_t j = 0; j < cols_num; ++j) {
+        float cost = cost_distribution(generator);
+        for (auto* costs : all_costs) {
+          (*costs)(i, j) = cost;
+        }
+      }
+    }
+
+    optimizer_->Match(cost_thresh, bound_value, opt_flag, &assignments,
+                      &unassigned_rows, &unassigned_cols);
+    sparse_matcher.Match(cost_thresh, bound_value, opt_flag,
+                         &sparse_assignments, &unassigned_rows,
+                         &unassigned_cols);
+    EXPECT_EQ(rows_num, sparse_assignments.size() + unassigned_rows.size());
+    EXPECT_EQ(cols_num, sparse_assignments.size() + unassigned_cols.size());
+    parallel_matcher.Match(cost_thresh, bound_value, opt_flag,
+                           &parallel_assignments, &unassigned_rows,
+                           &unassigned_cols);
+
+    EXPECT_NEAR(total_cost(assignments), total_cost(sparse_assignments), 1e-3);
+    EXPECT_EQ(sparse_assignments, parallel_assignments);
+  }
+}
+
 }  // namespace algorithm
 }  // namespace perception
 }  // namespace apollo
@@ -0,0 +1,341 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace perception {
+namespace algorithm {
+
+/* Sparse linear assignment solver working on gated edges only.
+ *
+ * It solves the same problem as HungarianOptimizer fed with a cost matrix in
+ * which every non-gated cell is set to bound_value, but only touches the
+ * edges added through AddEdge(). Every row owns a private dummy column which
+ * stands for "unassigned at bound_value", so the problem becomes a complete
+ * rectangular assignment that is solved by Jonker-Volgenant style shortest
+ * augmenting paths (Dijkstra with dual potentials) over a CSR adjacency.
+ * The complexity is O(n * E * log(E)) instead of O(n^3). */
+template <typename T>
+class SparseAssignmentOptimizer {
+ public:
+  SparseAssignmentOptimizer() : SparseAssignmentOptimizer(1000) {}
+  explicit SparseAssignmentOptimizer(const size_t max_optimization_size);
+  ~SparseAssignmentOptimizer() {}
+
+  /* @brief: clear all the edges and set the size of the graph, the memory
+   * reserved before is kept for the next optimization.
+   * @params[IN] rows_num: number of rows
+   * @params[IN] cols_num: number of cols */
+  void Reset(const size_t rows_num, const size_t cols_num);
+
+  /* @brief: add a gated edge, only the edges added here could be assigned
+   * @params[IN] row: index of row, should be less than rows_num
+   * @params[IN] col: index of col, should be less than cols_num
+   * @params[IN] cost: cost of the edge */
+  void AddEdge(const size_t row, const size_t col, const T cost);
+
+  size_t rows_num() const { return rows_num_; }
+  size_t cols_num() const { return cols_num_; }
+  size_t edges_num() const { return edge_rows_.size(); }
+
+  /* @brief: find the assignments which maximize the overall costs, any edge
+   * no better than bound_value is ignored. Each pair (i, j) of assignments
+   * corresponds to assigning row i to col j, sorted by row. */
+  void Maximize(const T bound_value,
+                std::vector<std::pair<size_t, size_t>>* assignments);
+
+  /* @brief: find the assignments which minimize the overall costs, any edge
+   * no better than bound_value is ignored. */
+  void Minimize(const T bound_value,
+                std::vector<std::pair<size_t, size_t>>* assignments);
+
+ private:
+  struct Edge {
+    size_t col = 0;
+    double cost = 0.0;
+  };
+
+  typedef std::pair<double, size_t> HeapItem;
+
+  /* Build the CSR adjacency from the edges added, convert costs of edges into
+   * non-negative ones relative to the dummy cost. Return false if there is
+   * no edge better than bound_value. */
+  bool BuildGraph(const bool maximize, const T bound_value);
+
+  /* Run the optimization over the CSR adjacency. */
+  void Optimize(const bool maximize, const T bound_value,
+                std::vector<std::pair<size_t, size_t>>* assignments);
+
+  /* Find the shortest augmenting path from the free row source_row, update
+   * the dual potentials and augment the matching along the path. */
+  void Augment(const size_t source_row);
+
+  size_t rows_num_ = 0;
+  size_t cols_num_ = 0;
+
+  /* edges added, in the order of insertion */
+  std::vector<size_t> edge_rows_;
+  std::vector<size_t> edge_cols_;
+  std::vector<T> edge_costs_;
+
+  /* CSR adjacency, the edges of row i are [row_offsets_[i],
+   * row_offsets_[i + 1]) of edges_ */
+  std::vector<size_t> row_offsets_;
+  std::vector<Edge> edges_;
+
+  /* cost of the dummy column of each row, i.e. of leaving a row unassigned */
+  double dummy_cost_ = 0.0;
+
+  /* matching, the dummy column of row i is cols_num_ + i */
+  std::vector<int> col4row_;
+  std::vector<int> row4col_;
+
+  /* dual potentials */
+  std::vector<double> u_;
+  std::vector<double> v_;
+
+  /* status of shortest path search */
+  std::vector<double> shortest_;
+  std::vector<size_t> path_;
+  std::vector<bool> col_visited_;
+  std::vector<size_t> visited_rows_;
+  std::vector<size_t> touched_cols_;
+  std::vector<HeapItem> heap_;
+};  // class SparseAssignmentOptimizer
+
+template <typename T>
+SparseAssignmentOptimizer<T>::SparseAssignmentOptimizer(
+    const size_t max_optimization_size) {
+  edge_rows_.reserve(max_optimization_size);
+  edge_cols_.reserve(max_optimization_size);
+  edge_costs_.reserve(max_optimization_size);
+  edges_.reserve(max_optimization_size);
+  row_offsets_.reserve(max_optimization_size + 1);
+  col4row_.reserve(max_optimization_size);
+  u_.reserve(max_optimization_size);
+  visited_rows_.reserve(max_optimization_size);
+}
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::Reset(const size_t rows_num,
+                                         const size_t cols_num) {
+  rows_num_ = rows_num;
+  cols_num_ = cols_num;
+  edge_rows_.clear();
+  edge_cols_.clear();
+  edge_costs_.clear();
+}
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::AddEdge(const size_t row, const size_t col,
+                                           const T cost) {
+  if (row >= rows_num_ || col >= cols_num_) {
+    return;
+  }
+  edge_rows_.push_back(row);
+  edge_cols_.push_back(col);
+  edge_costs_.push_back(cost);
+}
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::Maximize(
+    const T bound_value, std::vector<std::pair<size_t, size_t>>* assignments) {
+  Optimize(true, bound_value, assignments);
+}
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::Minimize(
+    const T bound_value, std::vector<std::pair<size_t, size_t>>* assignments) {
+  Optimize(false, bound_value, assignments);
+}
+
+template <typename T>
+bool SparseAssignmentOptimizer<T>::BuildGraph(const bool maximize,
+                                              const T bound_value) {
+  /* gain of an edge compared with leaving the row unassigned */
+  auto gain = [&](const T cost) -> double {
+    return maximize ? static_cast<double>(cost) - bound_value
+                    : static_cast<double>(bound_value) - cost;
+  };
+
+  /* counting sort of edges by row, edges with no gain are dropped */
+  row_offsets_.assign(rows_num_ + 1, 0);
+  dummy_cost_ = 0.0;
+  for (size_t k = 0; k < edge_rows_.size(); ++k) {
+    const double edge_gain = gain(edge_costs_[k]);
+    if (edge_gain > 0.0) {
+      ++row_offsets_[edge_rows_[k] + 1];
+      dummy_cost_ = std::max(dummy_cost_, edge_gain);
+    }
+  }
+  for (size_t i = 0; i < rows_num_; ++i) {
+    row_offsets_[i + 1] += row_offsets_[i];
+  }
+  if (row_offsets_[rows_num_] == 0) {
+    return false;
+  }
+
+  /* all the costs are shifted to [0, dummy_cost_) which keeps the initial
+   * reduced costs non-negative and the optimum unchanged, since every row
+   * is assigned to either a real column or its own dummy one */
+  edges_.resize(row_offsets_[rows_num_]);
+  std::vector<size_t> cursor(row_offsets_.begin(), row_offsets_.end() - 1);
+  for (size_t k = 0; k < edge_rows_.size(); ++k) {
+    const double edge_gain = gain(edge_costs_[k]);
+    if (edge_gain > 0.0) {
+      Edge& edge = edges_[cursor[edge_rows_[k]]++];
+      edge.col = edge_cols_[k];
+      edge.cost = dummy_cost_ - edge_gain;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::Optimize(
+    const bool maximize, const T bound_value,
+    std::vector<std::pair<size_t, size_t>>* assignments) {
+  assignments->clear();
+  if (rows_num_ == 0 || cols_num_ == 0 || !BuildGraph(maximize, bound_value)) {
+    return;
+  }
+
+  const size_t all_cols_num = cols_num_ + rows_num_;
+  col4row_.assign(rows_num_, -1);
+  row4col_.assign(all_cols_num, -1);
+  u_.assign(rows_num_, 0.0);
+  v_.assign(all_cols_num, 0.0);
+  shortest_.assign(all_cols_num, std::numeric_limits<double>::infinity());
+  path_.assign(all_cols_num, 0);
+  col_visited_.assign(all_cols_num, false);
+
+  for (size_t row = 0; row < rows_num_; ++row) {
+    /* a row without any edge stays in its dummy column */
+    if (row_offsets_[row] == row_offsets_[row + 1]) {
+      col4row_[row] = static_cast<int>(cols_num_ + row);
+      row4col_[cols_num_ + row] = static_cast<int>(row);
+      continue;
+    }
+    Augment(row);
+  }
+
+  assignments->reserve(std::min(rows_num_, cols_num_));
+  for (size_t row = 0; row < rows_num_; ++row) {
+    if (col4row_[row] >= 0 && static_cast<size_t>(col4row_[row]) < cols_num_) {
+      assignments->push_back(
+          std::make_pair(row, static_cast<size_t>(col4row_[row])));
+    }
+  }
+}
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::Augment(const size_t source_row) {
+  const double kInfinity = std::numeric_limits<double>::infinity();
+  visited_rows_.clear();
+  touched_cols_.clear();
+  heap_.clear();
+
+  double min_val = 0.0;
+  size_t row = source_row;
+  size_t sink = 0;
+  while (true) {
+    visited_rows_.push_back(row);
+    /* relax the edges of the current row, the dummy column included */
+    auto relax = [&](const size_t col, const double cost) {
+      if (col_visited_[col]) {
+        return;
+      }
+      const double reduced = min_val + cost - u_[row] - v_[col];
+      if (reduced < shortest_[col]) {
+        if (shortest_[col] == kInfinity) {
+          touched_cols_.push_back(col);
+        }
+        shortest_[col] = reduced;
+        path_[col] = row;
+        heap_.push_back(std::make_pair(reduced, col));
+        std::push_heap(heap_.begin(), heap_.end(), std::greater<HeapItem>());
+      }
+    };
+    for (size_t k = row_offsets_[row]; k < row_offsets_[row + 1]; ++k) {
+      relax(edges_[k].col, edges_[k].cost);
+    }
+    relax(cols_num_ + row, dummy_cost_);
+
+    /* pop the closest unvisited column, stale items are skipped lazily. the
+     * dummy column of source_row guarantees the heap never runs out */
+    size_t col = 0;
+    while (true) {
+      std::pop_heap(heap_.begin(), heap_.end(), std::greater<HeapItem>());
+      const HeapItem item = heap_.back();
+      heap_.pop_back();
+      if (!col_visited_[item.second] && item.first == shortest_[item.second]) {
+        col = item.second;
+        break;
+      }
+    }
+    min_val = shortest_[col];
+    col_visited_[col] = true;
+    if (row4col_[col] < 0) {
+      sink = col;
+      break;
+    }
+    row = static_cast<size_t>(row4col_[col]);
+  }
+
+  /* update dual potentials */
+  u_[source_row] += min_val;
+  for (const size_t visited_row : visited_rows_) {
+    if (visited_row != source_row) {
+      u_[visited_row] += min_val - shortest_[col4row_[visited_row]];
+    }
+  }
+  for (const size_t col : touched_cols_) {
+    if (col_visited_[col]) {
+      v_[col] -= min_val - shortest_[col];
+    }
+  }
+
+  /* augment the matching along the path */
+  size_t col = sink;
+  while (true) {
+    const size_t path_row = path_[col];
+    const int prev_col = col4row_[path_row];
+    row4col_[col] = static_cast<int>(path_row);
+    col4row_[path_row] = static_cast<int>(col);
+    if (path_row == source_row) {
+      break;
+    }
+    col = static_cast<size_t>(prev_col);
+  }
+
+  /* reset the status of search for the next row */
+  for (const size_t touched_col : touched_cols_) {
+    shortest_[touched_col] = kInfinity;
+    col_visited_[touched_col] = false;
+  }
+}
+
+}  // namespace algorithm
+}  // namespace perception
+}  // namespace apollo
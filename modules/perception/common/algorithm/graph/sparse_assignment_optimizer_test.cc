@@ -0,0 +1,183 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/common/algorithm/graph/sparse_assignment_optimizer.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/common/algorithm/graph/hungarian_optimizer.h"
+
+namespace apollo {
+namespace perception {
+namespace algorithm {
+
+class SparseAssignmentOptimizerTest : public testing::Test {
+ public:
+  SparseAssignmentOptimizerTest() {}
+  ~SparseAssignmentOptimizerTest() {}
+
+ protected:
+  void SetUp() { optimizer_ = new SparseAssignmentOptimizer<float>(); }
+  void TearDown() {
+    delete optimizer_;
+    optimizer_ = nullptr;
+  }
+
+  /* total cost of assignments, unassigned rows cost bound_value */
+  double TotalCost(const std::vector<std::vector<float>>& costs,
+                   float bound_value,
+                   const std::vector<std::pair<size_t, size_t>>& assignments) {
+    size_t rows_num = costs.size();
+    size_t cols_num = costs.empty() ? 0 : costs[0].size();
+    double total = static_cast<double>(std::min(rows_num, cols_num)) *
+                   bound_value;
+    for (const auto& assignment : assignments) {
+      total += costs[assignment.first][assignment.second] - bound_value;
+    }
+    return total;
+  }
+
+ public:
+  SparseAssignmentOptimizer<float>* optimizer_ = nullptr;
+};  // class SparseAssignmentOptimizerTest
+
+TEST_F(SparseAssignmentOptimizerTest, test_Minimize) {
+  std::vector<std::pair<size_t, size_t>> assignments;
+
+  /* case 1: most basic one
+   * costs:
+   * 0.1,  -
+   * -,    0.1
+   * matches:
+   * (0->0, 1->1) */
+  optimizer_->Reset(2, 2);
+  optimizer_->AddEdge(0, 0, 0.1f);
+  optimizer_->AddEdge(1, 1, 0.1f);
+  optimizer_->Minimize(1.0f, &assignments);
+  EXPECT_EQ(2, assignments.size());
+  EXPECT_EQ(0, assignments[0].first);
+  EXPECT_EQ(0, assignments[0].second);
+  EXPECT_EQ(1, assignments[1].first);
+  EXPECT_EQ(1, assignments[1].second);
+
+  /* case 2: conflict which needs an augmenting path
+   * costs:
+   * 0.1,  0.2
+   * 0.3,  -
+   * matches:
+   * (0->1, 1->0) */
+  optimizer_->Reset(2, 2);
+  optimizer_->AddEdge(0, 0, 0.1f);
+  optimizer_->AddEdge(0, 1, 0.2f);
+  optimizer_->AddEdge(1, 0, 0.3f);
+  optimizer_->Minimize(1.0f, &assignments);
+  EXPECT_EQ(2, assignments.size());
+  EXPECT_EQ(0, assignments[0].first);
+  EXPECT_EQ(1, assignments[0].second);
+  EXPECT_EQ(1, assignments[1].first);
+  EXPECT_EQ(0, assignments[1].second);
+
+  /* case 3: leaving a row unassigned may be better
+   * costs:
+   * 0.1,  0.95
+   * 0.2,  -
+   * matches:
+   * bound 2.0: (0->1, 1->0), 1.15 vs 0.1 + 2.0
+   * bound 1.0: (0->0), 0.1 + 1.0 vs 1.15 */
+  optimizer_->Reset(2, 2);
+  optimizer_->AddEdge(0, 0, 0.1f);
+  optimizer_->AddEdge(0, 1, 0.95f);
+  optimizer_->AddEdge(1, 0, 0.2f);
+  optimizer_->Minimize(2.0f, &assignments);
+  EXPECT_EQ(2, assignments.size());
+  optimizer_->Minimize(1.0f, &assignments);
+  EXPECT_EQ(1, assignments.size());
+  EXPECT_EQ(0, assignments[0].first);
+  EXPECT_EQ(0, assignments[0].second);
+
+  /* case 4: empty graph */
+  optimizer_->Reset(3, 0);
+  optimizer_->Minimize(1.0f, &assignments);
+  EXPECT_EQ(0, assignments.size());
+  optimizer_->Reset(3, 3);
+  optimizer_->Minimize(1.0f, &assignments);
+  EXPECT_EQ(0, assignments.size());
+}
+
+TEST_F(SparseAssignmentOptimizerTest, test_Maximize) {
+  std::vector<std::pair<size_t, size_t>> assignments;
+
+  /* costs:
+   * 4.0,  3.0,  -
+   * 3.0,  -,    1.0
+   * matches:
+   * (0->1, 1->0) */
+  optimizer_->Reset(2, 3);
+  optimizer_->AddEdge(0, 0, 4.0f);
+  optimizer_->AddEdge(0, 1, 3.0f);
+  optimizer_->AddEdge(1, 0, 3.0f);
+  optimizer_->AddEdge(1, 2, 1.0f);
+  optimizer_->Maximize(0.0f, &assignments);
+  EXPECT_EQ(2, assignments.size());
+  EXPECT_EQ(0, assignments[0].first);
+  EXPECT_EQ(1, assignments[0].second);
+  EXPECT_EQ(1, assignments[1].first);
+  EXPECT_EQ(0, assignments[1].second);
+}
+
+TEST_F(SparseAssignmentOptimizerTest, test_SameCostAsHungarian) {
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<float> cost_distribution(0.0f, 4.0f);
+  const float bound_value = 4.0f;
+  const float cost_thresh = 2.5f;
+  HungarianOptimizer<float> hungarian_optimizer;
+  std::vector<std::pair<size_t, size_t>> assignments;
+  std::vector<std::pair<size_t, size_t>> hungarian_assignments;
+
+  for (size_t trial = 0; trial < 50; ++trial) {
+    size_t rows_num = 1 + trial % 13;
+    size_t cols_num = 1 + (trial * 7) % 11;
+    std::vector<std::vector<float>> costs(rows_num,
+                                          std::vector<float>(cols_num));
+    optimizer_->Reset(rows_num, cols_num);
+    hungarian_optimizer.costs()->Resize(rows_num, cols_num);
+    for (size_t i = 0; i < rows_num; ++i) {
+      for (size_t j = 0; j < cols_num; ++j) {
+        float cost = cost_distribution(generator);
+        if (cost < cost_thresh) {
+          costs[i][j] = cost;
+          optimizer_->AddEdge(i, j, cost);
+        } else {
+          costs[i][j] = bound_value;
+        }
+        (*hungarian_optimizer.costs())(i, j) = costs[i][j];
+      }
+    }
+    optimizer_->Minimize(bound_value, &assignments);
+    hungarian_optimizer.Minimize(&hungarian_assignments);
+    EXPECT_NEAR(TotalCost(costs, bound_value, hungarian_assignments),
+                TotalCost(costs, bound_value, assignments), 1e-4);
+    for (const auto& assignment : assignments) {
+      EXPECT_LT(costs[assignment.first][assignment.second], cost_thresh);
+    }
+  }
+}
+
+}  // namespace algorithm
+}  // namespace perception
+}  // namespace apollo
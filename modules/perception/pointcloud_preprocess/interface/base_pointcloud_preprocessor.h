@@ -21,6 +21,7 @@
 #include "modules/common_msgs/sensor_msgs/pointcloud.pb.h"
 
 #include "cyber/common/macros.h"
+#include "modules/common/util/packed_point_cloud.h"
 #include "modules/perception/common/lib/interface/base_init_options.h"
 #include "modules/perception/common/lib/registerer/registerer.h"
 #include "modules/perception/common/lidar/common/lidar_frame.h"
@@ -69,6 +70,25 @@ class BasePointCloudPreprocessor {
       const PointCloudPreprocessorOptions& options,
       const std::shared_ptr<apollo::drivers::PointCloud const>& message,
       LidarFrame* frame) const = 0;
+  /**
+   * @brief Preprocess packed point cloud, converted to a point cloud unless
+   * overridden
+   *
+   * @param options
+   * @param message Packed point cloud message
+   * @param frame Location of pointcloud data write to
+   * @return true
+   * @return false
+   */
+  virtual bool Preprocess(
+      const PointCloudPreprocessorOptions& options,
+      const std::shared_ptr<apollo::drivers::PackedPointCloud const>& message,
+      LidarFrame* frame) const {
+    auto cloud = std::make_shared<apollo::drivers::PointCloud>();
+    apollo::common::util::ToPointCloud(*message, cloud.get());
+    return Preprocess(options, cloud, frame);
+  }
+
   /**
    * @brief Preprocess point cloud
    *
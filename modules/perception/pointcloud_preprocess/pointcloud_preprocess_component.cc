@@ -28,11 +28,13 @@ namespace lidar {
 using apollo::cyber::Clock;
 using apollo::cyber::common::GetAbsolutePath;
 
-std::atomic<uint32_t> PointCloudPreprocessComponent::seq_num_{0};
+template <typename MessageT>
+std::atomic<uint32_t> PointCloudPreprocessComponentT<MessageT>::seq_num_{0};
 
-bool PointCloudPreprocessComponent::Init() {
+template <typename MessageT>
+bool PointCloudPreprocessComponentT<MessageT>::Init() {
   PointCloudPreprocessComponentConfig comp_config;
-  if (!GetProtoConfig(&comp_config)) {
+  if (!this->GetProtoConfig(&comp_config)) {
     AERROR << "Get PointCloudPreprocessComponentConfig file failed";
     return false;
   }
@@ -55,8 +57,8 @@ bool PointCloudPreprocessComponent::Init() {
       cloud_preprocessor_name);
   CHECK_NOTNULL(cloud_preprocessor_);
   // writer
-  writer_ =
-      node_->CreateWriter<onboard::LidarFrameMessage>(output_channel_name_);
+  writer_ = this->node_->template CreateWriter<onboard::LidarFrameMessage>(
+      output_channel_name_);
 
   if (!InitAlgorithmPlugin()) {
     AERROR << "Failed to init pointcloud preprocess component plugin.";
@@ -66,8 +68,9 @@ bool PointCloudPreprocessComponent::Init() {
   return true;
 }
 
-bool PointCloudPreprocessComponent::Proc(
-    const std::shared_ptr<drivers::PointCloud>& message) {
+template <typename MessageT>
+bool PointCloudPreprocessComponentT<MessageT>::Proc(
+    const std::shared_ptr<MessageT>& message) {
   PERF_FUNCTION()
   AINFO << std::setprecision(16)
         << "Enter pointcloud preprocess component, message timestamp: "
@@ -85,7 +88,8 @@ bool PointCloudPreprocessComponent::Proc(
   return status;
 }
 
-bool PointCloudPreprocessComponent::InitAlgorithmPlugin() {
+template <typename MessageT>
+bool PointCloudPreprocessComponentT<MessageT>::InitAlgorithmPlugin() {
   ACHECK(algorithm::SensorManager::Instance()->GetSensorInfo(sensor_name_,
                                                              &sensor_info_));
   // pointcloud preprocessor init
@@ -100,8 +104,9 @@ bool PointCloudPreprocessComponent::InitAlgorithmPlugin() {
   return true;
 }
 
-bool PointCloudPreprocessComponent::InternalProc(
-    const std::shared_ptr<const drivers::PointCloud>& in_message,
+template <typename MessageT>
+bool PointCloudPreprocessComponentT<MessageT>::InternalProc(
+    const std::shared_ptr<const MessageT>& in_message,
     const std::shared_ptr<onboard::LidarFrameMessage>& out_message) {
   uint32_t seq_num = seq_num_.fetch_add(1);
   const double timestamp = in_message->measurement_time();
@@ -157,6 +162,9 @@ bool PointCloudPreprocessComponent::InternalProc(
   return true;
 }
 
+template class PointCloudPreprocessComponentT<drivers::PointCloud>;
+template class PointCloudPreprocessComponentT<drivers::PackedPointCloud>;
+
 }  // namespace lidar
 }  // namespace perception
 }  // namespace apollo
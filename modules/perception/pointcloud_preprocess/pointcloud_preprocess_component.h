@@ -33,11 +33,15 @@ namespace apollo {
 namespace perception {
 namespace lidar {
 
-class PointCloudPreprocessComponent
-    : public cyber::Component<drivers::PointCloud> {
+/**
+ * @brief Preprocess component of the point clouds of a lidar, MessageT is
+ * drivers::PointCloud or drivers::PackedPointCloud
+ */
+template <typename MessageT>
+class PointCloudPreprocessComponentT : public cyber::Component<MessageT> {
  public:
-  PointCloudPreprocessComponent() = default;
-  virtual ~PointCloudPreprocessComponent() = default;
+  PointCloudPreprocessComponentT() = default;
+  virtual ~PointCloudPreprocessComponentT() = default;
   /**
    * @brief Init pointcloud preprocess component
    *
@@ -52,12 +56,12 @@ class PointCloudPreprocessComponent
    * @return true
    * @return false
    */
-  bool Proc(const std::shared_ptr<drivers::PointCloud>& message) override;
+  bool Proc(const std::shared_ptr<MessageT>& message) override;
 
  private:
   bool InitAlgorithmPlugin();
   bool InternalProc(
-      const std::shared_ptr<const drivers::PointCloud>& in_message,
+      const std::shared_ptr<const MessageT>& in_message,
       const std::shared_ptr<onboard::LidarFrameMessage>& out_message);
 
  private:
@@ -78,7 +82,13 @@ class PointCloudPreprocessComponent
   BasePointCloudPreprocessor* cloud_preprocessor_;
 };
 
+using PointCloudPreprocessComponent =
+    PointCloudPreprocessComponentT<drivers::PointCloud>;
+using PackedPointCloudPreprocessComponent =
+    PointCloudPreprocessComponentT<drivers::PackedPointCloud>;
+
 CYBER_REGISTER_COMPONENT(PointCloudPreprocessComponent);
+CYBER_REGISTER_COMPONENT(PackedPointCloudPreprocessComponent);
 
 }  // namespace lidar
 }  // namespace perception
@@ -48,10 +48,48 @@ bool PointCloudPreprocessor::Init(
   return true;
 }
 
+namespace {
+
+// Fields of the points of both point cloud messages
+inline float PointX(const apollo::drivers::PointXYZIT& pt) { return pt.x(); }
+inline float PointY(const apollo::drivers::PointXYZIT& pt) { return pt.y(); }
+inline float PointZ(const apollo::drivers::PointXYZIT& pt) { return pt.z(); }
+inline uint32_t PointIntensity(const apollo::drivers::PointXYZIT& pt) {
+  return pt.intensity();
+}
+inline uint64_t PointTimestamp(const apollo::drivers::PointXYZIT& pt) {
+  return pt.timestamp();
+}
+
+using apollo::common::util::PackedPoint;
+inline float PointX(const PackedPoint& pt) { return pt.x; }
+inline float PointY(const PackedPoint& pt) { return pt.y; }
+inline float PointZ(const PackedPoint& pt) { return pt.z; }
+inline uint32_t PointIntensity(const PackedPoint& pt) { return pt.intensity; }
+inline uint64_t PointTimestamp(const PackedPoint& pt) { return pt.timestamp; }
+
+}  // namespace
+
 bool PointCloudPreprocessor::Preprocess(
     const PointCloudPreprocessorOptions& options,
     const std::shared_ptr<apollo::drivers::PointCloud const>& message,
     LidarFrame* frame) const {
+  return PreprocessPoints(message->point(), message->measurement_time(),
+                          frame);
+}
+
+bool PointCloudPreprocessor::Preprocess(
+    const PointCloudPreprocessorOptions& options,
+    const std::shared_ptr<apollo::drivers::PackedPointCloud const>& message,
+    LidarFrame* frame) const {
+  return PreprocessPoints(apollo::common::util::PackedPointCloudView(*message),
+                          message->measurement_time(), frame);
+}
+
+template <typename PointsT>
+bool PointCloudPreprocessor::PreprocessPoints(const PointsT& points,
+                                              const double measurement_time,
+                                              LidarFrame* frame) const {
   if (frame == nullptr) {
     return false;
   }
@@ -62,23 +100,27 @@ bool PointCloudPreprocessor::Preprocess(
     frame->world_cloud = base::PointDCloudPool::Instance().Get();
   }
 
-  frame->cloud->set_timestamp(message->measurement_time());
-  if (message->point_size() > 0) {
-    frame->cloud->reserve(message->point_size());
+  frame->cloud->set_timestamp(measurement_time);
+  if (points.size() > 0) {
+    frame->cloud->reserve(points.size());
     base::PointF point;
-    for (int i = 0; i < message->point_size(); ++i) {
-      const apollo::drivers::PointXYZIT& pt = message->point(i);
+    int i = 0;
+    for (const auto& pt : points) {
+      const float x = PointX(pt);
+      const float y = PointY(pt);
+      const float z = PointZ(pt);
       if (filter_naninf_points_) {
-        if (std::isnan(pt.x()) || std::isnan(pt.y()) || std::isnan(pt.z())) {
+        if (std::isnan(x) || std::isnan(y) || std::isnan(z)) {
+          ++i;
           continue;
         }
-        if (fabs(pt.x()) > kPointInfThreshold ||
-            fabs(pt.y()) > kPointInfThreshold ||
-            fabs(pt.z()) > kPointInfThreshold) {
+        if (fabs(x) > kPointInfThreshold || fabs(y) > kPointInfThreshold ||
+            fabs(z) > kPointInfThreshold) {
+          ++i;
           continue;
         }
       }
-      Eigen::Vector3d vec3d_lidar(pt.x(), pt.y(), pt.z());
+      Eigen::Vector3d vec3d_lidar(x, y, z);
       // Eigen::Vector3d vec3d_novatel =
       //     options.sensor2novatel_extrinsics * vec3d_lidar;
       Eigen::Vector3d vec3d_novatel = vec3d_lidar;
@@ -86,17 +128,21 @@ bool PointCloudPreprocessor::Preprocess(
           vec3d_novatel[0] > box_backward_x_ &&
           vec3d_novatel[1] < box_forward_y_ &&
           vec3d_novatel[1] > box_backward_y_) {
+        ++i;
         continue;
       }
-      if (filter_high_z_points_ && pt.z() > z_threshold_) {
+      if (filter_high_z_points_ && z > z_threshold_) {
+        ++i;
         continue;
       }
-      point.x = pt.x();
-      point.y = pt.y();
-      point.z = pt.z();
-      point.intensity = static_cast<float>(pt.intensity());
-      frame->cloud->push_back(point, static_cast<double>(pt.timestamp()) * 1e-9,
-                              std::numeric_limits<float>::max(), i, 0);
+      point.x = x;
+      point.y = y;
+      point.z = z;
+      point.intensity = static_cast<float>(PointIntensity(pt));
+      frame->cloud->push_back(
+          point, static_cast<double>(PointTimestamp(pt)) * 1e-9,
+          std::numeric_limits<float>::max(), i, 0);
+      ++i;
     }
     TransformCloud(frame->cloud, frame->lidar2world_pose, frame->world_cloud);
   }
@@ -57,6 +57,19 @@ class PointCloudPreprocessor : public BasePointCloudPreprocessor {
       const PointCloudPreprocessorOptions& options,
       const std::shared_ptr<apollo::drivers::PointCloud const>& message,
       LidarFrame* frame) const;
+  /**
+   * @brief Preprocess packed point cloud, read in place
+   *
+   * @param options
+   * @param message Packed point cloud message
+   * @param frame Fill cloud and world_cloud data
+   * @return true
+   * @return false
+   */
+  bool Preprocess(
+      const PointCloudPreprocessorOptions& options,
+      const std::shared_ptr<apollo::drivers::PackedPointCloud const>& message,
+      LidarFrame* frame) const;
   /**
    * @brief Preprocess point cloud
    *
@@ -75,6 +88,9 @@ class PointCloudPreprocessor : public BasePointCloudPreprocessor {
   std::string Name() const { return "PointCloudPreprocessor"; }
 
  private:
+  template <typename PointsT>
+  bool PreprocessPoints(const PointsT& points, const double measurement_time,
+                        LidarFrame* frame) const;
   bool TransformCloud(const base::PointFCloudPtr& local_cloud,
                       const Eigen::Affine3d& pose,
                       base::PointDCloudPtr world_cloud) const;
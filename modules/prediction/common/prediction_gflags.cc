@@ -55,6 +55,13 @@ DEFINE_double(pedestrian_nearby_lane_search_radius, 5.0,
               "Radius to determine if pedestrian-like obstacle is near lane.");
 DEFINE_int32(road_graph_max_search_horizon, 20,
              "Maximal search depth for building road graph");
+DEFINE_bool(enable_lane_graph_cache, true,
+            "If reuse lane graphs built on the same lane across obstacles "
+            "and frames.");
+DEFINE_double(lane_graph_cache_s_bucket, 1.0,
+              "Bucket size of start s and search length to reuse a lane graph");
+DEFINE_int32(lane_graph_cache_max_size, 10000,
+             "Maximal number of cached lane graphs.");
 DEFINE_double(surrounding_lane_search_radius, 3.0,
               "Search radius for surrounding lanes.");
 
@@ -63,6 +70,13 @@ DEFINE_double(base_image_half_range, 100.0, "The half range of base image.");
 DEFINE_bool(enable_draw_adc_trajectory, true,
             "If draw adc trajectory in semantic map");
 DEFINE_bool(img_show_semantic_map, false, "If show the image of semantic map.");
+DEFINE_bool(enable_semantic_map_tile_cache, true,
+            "If compose the static layers of semantic map from cached tiles "
+            "instead of drawing them from hdmap every frame.");
+DEFINE_int32(semantic_map_tile_size, 500,
+             "Size in pixels of a cached tile of semantic map.");
+DEFINE_int32(semantic_map_max_cached_tiles, 64,
+             "Maximal number of cached tiles of semantic map.");
 
 // Scenario
 DEFINE_double(junction_distance_threshold, 10.0,
@@ -147,6 +161,10 @@ DEFINE_double(still_unknown_position_std, 0.5,
 DEFINE_double(slow_obstacle_speed_threshold, 2.0,
               "Speed threshold for slow obstacles");
 DEFINE_double(max_history_time, 7.0, "Obstacles' maximal historical time.");
+DEFINE_int32(max_num_full_history_features, 5,
+             "Number of the latest features of an obstacle kept in full, the "
+             "older ones keep only the fields used by evaluators. "
+             "Non-positive to keep all features in full.");
 DEFINE_double(target_lane_gap, 2.0, "Gap between two lane points.");
 DEFINE_double(dense_lane_gap, 0.2,
               "Gap between two adjacent lane points"
@@ -42,12 +42,18 @@ DECLARE_double(lane_search_radius_in_junction);
 DECLARE_double(junction_search_radius);
 DECLARE_double(pedestrian_nearby_lane_search_radius);
 DECLARE_int32(road_graph_max_search_horizon);
+DECLARE_bool(enable_lane_graph_cache);
+DECLARE_double(lane_graph_cache_s_bucket);
+DECLARE_int32(lane_graph_cache_max_size);
 DECLARE_double(surrounding_lane_search_radius);
 
 // Semantic Map
 DECLARE_double(base_image_half_range);
 DECLARE_bool(enable_draw_adc_trajectory);
 DECLARE_bool(img_show_semantic_map);
+DECLARE_bool(enable_semantic_map_tile_cache);
+DECLARE_int32(semantic_map_tile_size);
+DECLARE_int32(semantic_map_max_cached_tiles);
 
 // Scenario
 DECLARE_double(junction_distance_threshold);
@@ -93,6 +99,7 @@ DECLARE_double(still_pedestrian_position_std);
 DECLARE_double(still_unknown_position_std);
 DECLARE_double(slow_obstacle_speed_threshold);
 DECLARE_double(max_history_time);
+DECLARE_int32(max_num_full_history_features);
 DECLARE_double(target_lane_gap);
 DECLARE_double(dense_lane_gap);
 DECLARE_int32(max_num_current_lane);
@@ -108,6 +108,7 @@ Status RoadGraph::BuildLaneGraph(LaneGraph* const lane_graph_ptr) {
   // Run the recursive function to perform DFS.
   std::list<LaneSegment> lane_segments;
   double accumulated_s = 0.0;
+  search_horizon_reached_ = false;
   ConstructLaneSequence(accumulated_s, start_s_, lane_info_ptr_,
                         FLAGS_road_graph_max_search_horizon, consider_divide_,
                         &lane_segments, lane_graph_ptr);
@@ -132,6 +133,7 @@ Status RoadGraph::BuildLaneGraphBidirection(LaneGraph* const lane_graph_ptr) {
   // Run the recursive function to perform DFS.
   std::list<LaneSegment> lane_segments;
   LaneGraph lane_graph_successor;
+  search_horizon_reached_ = false;
   ConstructLaneSequence(true, 0.0, start_s_, lane_info_ptr_,
                         FLAGS_road_graph_max_search_horizon, consider_divide_,
                         &lane_segments, &lane_graph_successor);
@@ -147,6 +149,59 @@ Status RoadGraph::BuildLaneGraphBidirection(LaneGraph* const lane_graph_ptr) {
   return Status::OK();
 }
 
+bool RoadGraph::BuildLaneGraphFromCache(const LaneGraph& cached_lane_graph,
+                                        LaneGraph* const lane_graph_ptr) const {
+  if (length_ < 0.0 || lane_info_ptr_ == nullptr || lane_graph_ptr == nullptr) {
+    return false;
+  }
+
+  // Redo the s computation of the forward search in ConstructLaneSequence
+  // along each cached lane sequence. The lane sequences stay the same as long
+  // as the search continues and stops at the same lane segments.
+  const double first_lane_s =
+      start_s_ >= 0.0 ? start_s_ : lane_info_ptr_->total_length();
+  lane_graph_ptr->Clear();
+  for (const auto& cached_sequence : cached_lane_graph.lane_sequence()) {
+    if (cached_sequence.lane_segment_size() == 0 ||
+        cached_sequence.lane_segment(0).lane_id() !=
+            lane_info_ptr_->id().id()) {
+      return false;
+    }
+    LaneSequence* sequence = lane_graph_ptr->add_lane_sequence();
+    double accumulated_s = 0.0;
+    double curr_s = first_lane_s;
+    for (int i = 0; i < cached_sequence.lane_segment_size(); ++i) {
+      const LaneSegment& cached_segment = cached_sequence.lane_segment(i);
+      LaneSegment* lane_segment = sequence->add_lane_segment();
+      *lane_segment = cached_segment;
+      lane_segment->set_adc_s(curr_s);
+      lane_segment->set_start_s(curr_s);
+      lane_segment->set_end_s(std::fmin(curr_s + length_ - accumulated_s,
+                                        cached_segment.total_length()));
+      const bool reach_lane_end =
+          lane_segment->end_s() >= cached_segment.total_length();
+      if (i + 1 < cached_sequence.lane_segment_size()) {
+        // The search used to go on to the successor lane
+        if (!reach_lane_end) {
+          return false;
+        }
+      } else if (reach_lane_end &&
+                 cached_segment.end_s() < cached_segment.total_length()) {
+        // The search used to stop before the end of this lane, it stops now
+        // only if there is no successor lane.
+        auto lane_info_ptr = PredictionMap::LaneById(cached_segment.lane_id());
+        if (lane_info_ptr == nullptr ||
+            !lane_info_ptr->lane().successor_id().empty()) {
+          return false;
+        }
+      }
+      accumulated_s = accumulated_s + cached_segment.total_length() - curr_s;
+      curr_s = 0.0;
+    }
+  }
+  return true;
+}
+
 LaneGraph RoadGraph::CombineLaneGraphs(const LaneGraph& lane_graph_predecessor,
                                        const LaneGraph& lane_graph_successor) {
   LaneGraph final_lane_graph;
@@ -201,7 +256,7 @@ void RoadGraph::ConstructLaneSequence(
     std::shared_ptr<const LaneInfo> lane_info_ptr,
     const int graph_search_horizon, const bool consider_lane_split,
     std::list<LaneSegment>* const lane_segments,
-    LaneGraph* const lane_graph_ptr) const {
+    LaneGraph* const lane_graph_ptr) {
   ConstructLaneSequence(true, accumulated_s, curr_lane_seg_s, lane_info_ptr,
                         graph_search_horizon, consider_lane_split,
                         lane_segments, lane_graph_ptr);
@@ -212,13 +267,14 @@ void RoadGraph::ConstructLaneSequence(
     const double curr_lane_seg_s, std::shared_ptr<const LaneInfo> lane_info_ptr,
     const int graph_search_horizon, const bool consider_lane_split,
     std::list<LaneSegment>* const lane_segments,
-    LaneGraph* const lane_graph_ptr) const {
+    LaneGraph* const lane_graph_ptr) {
   // Sanity checks.
   if (lane_info_ptr == nullptr) {
     AERROR << "Invalid lane.";
     return;
   }
   if (graph_search_horizon < 0) {
+    search_horizon_reached_ = true;
     AERROR << "The lane search has already reached the limits";
     AERROR << "Possible map error found!";
     return;
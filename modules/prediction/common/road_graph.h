@@ -50,6 +50,24 @@ class RoadGraph {
 
   common::Status BuildLaneGraphBidirection(LaneGraph* const lane_graph_ptr);
 
+  /**
+   * @brief Build the lane graph from a cached one, which was built by
+   *        BuildLaneGraph on the same lane and lane split setting but with
+   *        another start s and length. Only s values are updated.
+   * @param The cached lane graph.
+   * @param The built lane graph.
+   * @return False if the lane sequences would differ from the cached ones,
+   *         and the lane graph needs to be built by BuildLaneGraph.
+   */
+  bool BuildLaneGraphFromCache(const LaneGraph& cached_lane_graph,
+                               LaneGraph* const lane_graph_ptr) const;
+
+  /**
+   * @brief Check if the last lane graph search reached the max search
+   *        horizon, in which case some lane sequences were dropped.
+   */
+  bool search_horizon_reached() const { return search_horizon_reached_; }
+
   /**
    * @brief Check if a lane with an s is on the lane graph
    * @param Lane ID
@@ -87,7 +105,7 @@ class RoadGraph {
       std::shared_ptr<const hdmap::LaneInfo> lane_info_ptr,
       const int graph_search_horizon, const bool consider_lane_split,
       std::list<LaneSegment>* const lane_segments,
-      LaneGraph* const lane_graph_ptr) const;
+      LaneGraph* const lane_graph_ptr);
 
   /** @brief If direction unspecified, by default construct forward direction.
    */
@@ -96,7 +114,7 @@ class RoadGraph {
       std::shared_ptr<const hdmap::LaneInfo> lane_info_ptr,
       const int graph_search_horizon, const bool consider_lane_split,
       std::list<LaneSegment>* const lane_segments,
-      LaneGraph* const lane_graph_ptr) const;
+      LaneGraph* const lane_graph_ptr);
 
  private:
   // The s of the obstacle on its own lane_segment.
@@ -110,6 +128,9 @@ class RoadGraph {
 
   // The lane_info of the lane_segment where the obstacle is on.
   std::shared_ptr<const hdmap::LaneInfo> lane_info_ptr_ = nullptr;
+
+  // If the last search reached the max search horizon
+  bool search_horizon_reached_ = false;
 };
 
 }  // namespace prediction
@@ -128,5 +128,33 @@ TEST_F(RoadGraphTest, MultipleLaneSequence) {
   EXPECT_EQ("l29", lane_graph.lane_sequence(1).lane_segment(2).lane_id());
 }
 
+TEST_F(RoadGraphTest, BuildLaneGraphFromCache) {
+  auto lane = PredictionMap::LaneById("l20");
+  EXPECT_NE(lane, nullptr);
+
+  RoadGraph cached_road_graph(200.0, 200.0, true, lane);
+  LaneGraph cached_lane_graph;
+  EXPECT_TRUE(cached_road_graph.BuildLaneGraph(&cached_lane_graph).ok());
+  EXPECT_FALSE(cached_road_graph.search_horizon_reached());
+
+  RoadGraph road_graph(200.5, 200.3, true, lane);
+  LaneGraph lane_graph;
+  EXPECT_TRUE(road_graph.BuildLaneGraph(&lane_graph).ok());
+  LaneGraph lane_graph_from_cache;
+  EXPECT_TRUE(road_graph.BuildLaneGraphFromCache(cached_lane_graph,
+                                                 &lane_graph_from_cache));
+  EXPECT_EQ(lane_graph.DebugString(), lane_graph_from_cache.DebugString());
+
+  // The search goes further than the cached lane sequences
+  auto short_lane = PredictionMap::LaneById("l9");
+  RoadGraph short_road_graph(99.0, 50.0, true, short_lane);
+  LaneGraph short_lane_graph;
+  EXPECT_TRUE(short_road_graph.BuildLaneGraph(&short_lane_graph).ok());
+  EXPECT_EQ(2, short_lane_graph.lane_sequence(0).lane_segment_size());
+  RoadGraph long_road_graph(99.0, 100.0, true, short_lane);
+  EXPECT_FALSE(long_road_graph.BuildLaneGraphFromCache(short_lane_graph,
+                                                       &lane_graph));
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -16,6 +16,8 @@
 
 #include "modules/prediction/common/semantic_map.h"
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 #include <vector>
 
@@ -36,6 +38,23 @@ namespace prediction {
 
 namespace {
 
+// Size of base image in pixels and meters per pixel
+constexpr int kBaseImageSize = 2000;
+constexpr double kResolution = 0.1;
+// Radius of map elements searched around the center of base image
+constexpr double kBaseImageSearchRadius = 141.4;
+// Margin of map elements searched around a tile for the width of lines
+constexpr double kTileSearchMargin = 1.0;
+
+int FloorDiv(const int a, const int b) {
+  return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+
+int64_t TileKey(const int tile_col, const int tile_row) {
+  return (static_cast<int64_t>(tile_col) << 32) |
+         static_cast<uint32_t>(tile_row);
+}
+
 bool ValidFeatureHistory(const ObstacleHistory& obstacle_history,
                          const double curr_base_x, const double curr_base_y) {
   if (obstacle_history.feature_size() == 0) {
@@ -57,8 +76,12 @@ bool ValidFeatureHistory(const ObstacleHistory& obstacle_history,
 SemanticMap::SemanticMap() {}
 
 void SemanticMap::Init() {
-  curr_img_ = cv::Mat(2000, 2000, CV_8UC3, cv::Scalar(0, 0, 0));
+  curr_img_ = cv::Mat(kBaseImageSize, kBaseImageSize, CV_8UC3,
+                      cv::Scalar(0, 0, 0));
   obstacle_id_history_map_.clear();
+  tiles_.clear();
+  tiles_lru_.clear();
+  tiles_map_ = nullptr;
 #ifdef __aarch64__
   affine_transformer_.Init(cv::Size(2000, 2000), CV_8UC3);
 #endif
@@ -72,7 +95,10 @@ void SemanticMap::RunCurrFrame(
   }
 
   ego_feature_ = obstacle_id_history_map.at(FLAGS_ego_vehicle_id).feature(0);
-  if (!FLAGS_enable_async_draw_base_image) {
+  if (FLAGS_enable_semantic_map_tile_cache) {
+    // Copying cached tiles is cheap enough to be done in the current cycle
+    ComposeBaseMap(ego_feature_.position().x(), ego_feature_.position().y());
+  } else if (!FLAGS_enable_async_draw_base_image) {
     double x = ego_feature_.position().x();
     double y = ego_feature_.position().y();
     curr_base_x_ = x - FLAGS_base_image_half_range;
@@ -118,12 +144,14 @@ void SemanticMap::RunCurrFrame(
 
 void SemanticMap::DrawBaseMap(const double x, const double y,
                               const double base_x, const double base_y) {
-  base_img_ = cv::Mat(2000, 2000, CV_8UC3, cv::Scalar(0, 0, 0));
+  base_img_ = cv::Mat(kBaseImageSize, kBaseImageSize, CV_8UC3,
+                      cv::Scalar(0, 0, 0));
   common::PointENU center_point = common::util::PointFactory::ToPointENU(x, y);
-  DrawRoads(center_point, base_x, base_y);
-  DrawJunctions(center_point, base_x, base_y);
-  DrawCrosswalks(center_point, base_x, base_y);
-  DrawLanes(center_point, base_x, base_y);
+  DrawStaticLayers(center_point, kBaseImageSearchRadius,
+                   [this, base_x, base_y](const double px, const double py) {
+                     return GetTransPoint(px, py, base_x, base_y);
+                   },
+                   &base_img_);
 }
 
 void SemanticMap::DrawBaseMapThread() {
@@ -135,11 +163,108 @@ void SemanticMap::DrawBaseMapThread() {
   DrawBaseMap(x, y, base_x_, base_y_);
 }
 
+void SemanticMap::ComposeBaseMap(const double x, const double y) {
+  const hdmap::HDMap* map = apollo::hdmap::HDMapUtil::BaseMapPtr();
+  if (map != tiles_map_) {
+    tiles_.clear();
+    tiles_lru_.clear();
+    tiles_map_ = map;
+  }
+
+  // Align the base image with the pixel grid of tiles, so that tiles could be
+  // copied without resampling
+  const int tile_size = FLAGS_semantic_map_tile_size;
+  const int base_col = static_cast<int>(
+      std::floor((x - FLAGS_base_image_half_range) / kResolution));
+  const int base_row = static_cast<int>(
+      std::floor((y - FLAGS_base_image_half_range) / kResolution));
+  curr_base_x_ = base_col * kResolution;
+  curr_base_y_ = base_row * kResolution;
+
+  // World pixel column gx is at column (gx - base_col) of the base image, and
+  // world pixel row gy is at row (base_row + kBaseImageSize - gy), see
+  // DrawTile() for the layout of a tile.
+  const int min_tile_col = FloorDiv(base_col, tile_size);
+  const int max_tile_col = FloorDiv(base_col + kBaseImageSize - 1, tile_size);
+  const int min_tile_row = FloorDiv(base_row, tile_size);
+  const int max_tile_row = FloorDiv(base_row + kBaseImageSize - 1, tile_size);
+  const cv::Rect image_rect(0, 0, kBaseImageSize, kBaseImageSize);
+  for (int tile_row = min_tile_row; tile_row <= max_tile_row; ++tile_row) {
+    for (int tile_col = min_tile_col; tile_col <= max_tile_col; ++tile_col) {
+      const cv::Rect tile_rect(
+          tile_col * tile_size - base_col,
+          base_row + kBaseImageSize - (tile_row + 1) * tile_size, tile_size,
+          tile_size);
+      const cv::Rect dst_rect = tile_rect & image_rect;
+      if (dst_rect.empty()) {
+        continue;
+      }
+      const cv::Rect src_rect = dst_rect - tile_rect.tl();
+      GetTile(tile_col, tile_row)(src_rect).copyTo(curr_img_(dst_rect));
+    }
+  }
+}
+
+const cv::Mat& SemanticMap::GetTile(const int tile_col, const int tile_row) {
+  const int64_t key = TileKey(tile_col, tile_row);
+  auto it = tiles_.find(key);
+  if (it != tiles_.end()) {
+    tiles_lru_.splice(tiles_lru_.end(), tiles_lru_, it->second.lru_iter);
+    return it->second.img;
+  }
+
+  while (!tiles_lru_.empty() &&
+         static_cast<int>(tiles_.size()) >=
+             std::max(FLAGS_semantic_map_max_cached_tiles, 1)) {
+    tiles_.erase(tiles_lru_.front());
+    tiles_lru_.pop_front();
+  }
+  Tile& tile = tiles_[key];
+  tile.lru_iter = tiles_lru_.insert(tiles_lru_.end(), key);
+  DrawTile(tile_col, tile_row, &tile.img);
+  return tile.img;
+}
+
+void SemanticMap::DrawTile(const int tile_col, const int tile_row,
+                           cv::Mat* img) {
+  // A tile covers world pixel columns [tile_col, tile_col + 1) * tile_size
+  // from left to right, and world pixel rows (tile_row, tile_row + 1] *
+  // tile_size from bottom to top, same as the layout of base image.
+  const int tile_size = FLAGS_semantic_map_tile_size;
+  const int left_col = tile_col * tile_size;
+  const int top_row = (tile_row + 1) * tile_size;
+  *img = cv::Mat(tile_size, tile_size, CV_8UC3, cv::Scalar(0, 0, 0));
+  const double half_size = 0.5 * tile_size * kResolution;
+  common::PointENU center_point = common::util::PointFactory::ToPointENU(
+      left_col * kResolution + half_size,
+      tile_row * tile_size * kResolution + half_size);
+  DrawStaticLayers(center_point, half_size * M_SQRT2 + kTileSearchMargin,
+                   [left_col, top_row](const double px, const double py) {
+                     return cv::Point2i(
+                         static_cast<int>(std::floor(px / kResolution)) -
+                             left_col,
+                         top_row -
+                             static_cast<int>(std::floor(py / kResolution)));
+                   },
+                   img);
+}
+
+void SemanticMap::DrawStaticLayers(const common::PointENU& center_point,
+                                   const double radius,
+                                   const PointTransform& transform,
+                                   cv::Mat* img) {
+  DrawRoads(center_point, radius, transform, img);
+  DrawJunctions(center_point, radius, transform, img);
+  DrawCrosswalks(center_point, radius, transform, img);
+  DrawLanes(center_point, radius, transform, img);
+}
+
 void SemanticMap::DrawRoads(const common::PointENU& center_point,
-                            const double base_x, const double base_y,
+                            const double radius,
+                            const PointTransform& transform, cv::Mat* img,
                             const cv::Scalar& color) {
   std::vector<apollo::hdmap::RoadInfoConstPtr> roads;
-  apollo::hdmap::HDMapUtil::BaseMap().GetRoads(center_point, 141.4, &roads);
+  apollo::hdmap::HDMapUtil::BaseMap().GetRoads(center_point, radius, &roads);
   for (const auto& road : roads) {
     for (const auto& section : road->road().section()) {
       std::vector<cv::Point> polygon;
@@ -147,21 +272,19 @@ void SemanticMap::DrawRoads(const common::PointENU& center_point,
         if (edge.type() == 2) {  // left edge
           for (const auto& segment : edge.curve().segment()) {
             for (const auto& point : segment.line_segment().point()) {
-              polygon.push_back(std::move(
-                  GetTransPoint(point.x(), point.y(), base_x, base_y)));
+              polygon.push_back(transform(point.x(), point.y()));
             }
           }
         } else if (edge.type() == 3) {  // right edge
           for (const auto& segment : edge.curve().segment()) {
             for (const auto& point : segment.line_segment().point()) {
               polygon.insert(polygon.begin(),
-                             std::move(GetTransPoint(point.x(), point.y(),
-                                                     base_x, base_y)));
+                             transform(point.x(), point.y()));
             }
           }
         }
       }
-      cv::fillPoly(base_img_,
+      cv::fillPoly(*img,
                    std::vector<std::vector<cv::Point>>({std::move(polygon)}),
                    color);
     }
@@ -169,56 +292,55 @@ void SemanticMap::DrawRoads(const common::PointENU& center_point,
 }
 
 void SemanticMap::DrawJunctions(const common::PointENU& center_point,
-                                const double base_x, const double base_y,
+                                const double radius,
+                                const PointTransform& transform, cv::Mat* img,
                                 const cv::Scalar& color) {
   std::vector<apollo::hdmap::JunctionInfoConstPtr> junctions;
-  apollo::hdmap::HDMapUtil::BaseMap().GetJunctions(center_point, 141.4,
+  apollo::hdmap::HDMapUtil::BaseMap().GetJunctions(center_point, radius,
                                                    &junctions);
   for (const auto& junction : junctions) {
     std::vector<cv::Point> polygon;
     for (const auto& point : junction->junction().polygon().point()) {
-      polygon.push_back(
-          std::move(GetTransPoint(point.x(), point.y(), base_x, base_y)));
+      polygon.push_back(transform(point.x(), point.y()));
     }
-    cv::fillPoly(base_img_,
+    cv::fillPoly(*img,
                  std::vector<std::vector<cv::Point>>({std::move(polygon)}),
                  color);
   }
 }
 
 void SemanticMap::DrawCrosswalks(const common::PointENU& center_point,
-                                 const double base_x, const double base_y,
+                                 const double radius,
+                                 const PointTransform& transform, cv::Mat* img,
                                  const cv::Scalar& color) {
   std::vector<apollo::hdmap::CrosswalkInfoConstPtr> crosswalks;
-  apollo::hdmap::HDMapUtil::BaseMap().GetCrosswalks(center_point, 141.4,
+  apollo::hdmap::HDMapUtil::BaseMap().GetCrosswalks(center_point, radius,
                                                     &crosswalks);
   for (const auto& crosswalk : crosswalks) {
     std::vector<cv::Point> polygon;
     for (const auto& point : crosswalk->crosswalk().polygon().point()) {
-      polygon.push_back(
-          std::move(GetTransPoint(point.x(), point.y(), base_x, base_y)));
+      polygon.push_back(transform(point.x(), point.y()));
     }
-    cv::fillPoly(base_img_,
+    cv::fillPoly(*img,
                  std::vector<std::vector<cv::Point>>({std::move(polygon)}),
                  color);
   }
 }
 
 void SemanticMap::DrawLanes(const common::PointENU& center_point,
-                            const double base_x, const double base_y,
+                            const double radius,
+                            const PointTransform& transform, cv::Mat* img,
                             const cv::Scalar& color) {
   std::vector<apollo::hdmap::LaneInfoConstPtr> lanes;
-  apollo::hdmap::HDMapUtil::BaseMap().GetLanes(center_point, 141.4, &lanes);
+  apollo::hdmap::HDMapUtil::BaseMap().GetLanes(center_point, radius, &lanes);
   for (const auto& lane : lanes) {
     // Draw lane_central first
     for (const auto& segment : lane->lane().central_curve().segment()) {
       for (int i = 0; i < segment.line_segment().point_size() - 1; ++i) {
-        const auto& p0 =
-            GetTransPoint(segment.line_segment().point(i).x(),
-                          segment.line_segment().point(i).y(), base_x, base_y);
-        const auto& p1 = GetTransPoint(segment.line_segment().point(i + 1).x(),
-                                       segment.line_segment().point(i + 1).y(),
-                                       base_x, base_y);
+        const auto& p0 = transform(segment.line_segment().point(i).x(),
+                                   segment.line_segment().point(i).y());
+        const auto& p1 = transform(segment.line_segment().point(i + 1).x(),
+                                   segment.line_segment().point(i + 1).y());
         double theta = atan2(segment.line_segment().point(i + 1).y() -
                                  segment.line_segment().point(i).y(),
                              segment.line_segment().point(i + 1).x() -
@@ -232,7 +354,7 @@ void SemanticMap::DrawLanes(const common::PointENU& center_point,
         //     cv::Scalar(rgb.at<float>(0, 0) * 255, rgb.at<float>(0, 1) * 255,
         //                rgb.at<float>(0, 2) * 255);
 
-        cv::line(base_img_, p0, p1, HSVtoRGB(H), 4);
+        cv::line(*img, p0, p1, HSVtoRGB(H), 4);
       }
     }
     // Not drawing boundary for virtual city_driving lane
@@ -243,26 +365,22 @@ void SemanticMap::DrawLanes(const common::PointENU& center_point,
     // Draw lane's left_boundary
     for (const auto& segment : lane->lane().left_boundary().curve().segment()) {
       for (int i = 0; i < segment.line_segment().point_size() - 1; ++i) {
-        const auto& p0 =
-            GetTransPoint(segment.line_segment().point(i).x(),
-                          segment.line_segment().point(i).y(), base_x, base_y);
-        const auto& p1 = GetTransPoint(segment.line_segment().point(i + 1).x(),
-                                       segment.line_segment().point(i + 1).y(),
-                                       base_x, base_y);
-        cv::line(base_img_, p0, p1, color, 2);
+        const auto& p0 = transform(segment.line_segment().point(i).x(),
+                                   segment.line_segment().point(i).y());
+        const auto& p1 = transform(segment.line_segment().point(i + 1).x(),
+                                   segment.line_segment().point(i + 1).y());
+        cv::line(*img, p0, p1, color, 2);
       }
     }
     // Draw lane's right_boundary
     for (const auto& segment :
          lane->lane().right_boundary().curve().segment()) {
       for (int i = 0; i < segment.line_segment().point_size() - 1; ++i) {
-        const auto& p0 =
-            GetTransPoint(segment.line_segment().point(i).x(),
-                          segment.line_segment().point(i).y(), base_x, base_y);
-        const auto& p1 = GetTransPoint(segment.line_segment().point(i + 1).x(),
-                                       segment.line_segment().point(i + 1).y(),
-                                       base_x, base_y);
-        cv::line(base_img_, p0, p1, color, 2);
+        const auto& p0 = transform(segment.line_segment().point(i).x(),
+                                   segment.line_segment().point(i).y());
+        const auto& p1 = transform(segment.line_segment().point(i + 1).x(),
+                                   segment.line_segment().point(i + 1).y());
+        cv::line(*img, p0, p1, color, 2);
       }
     }
   }
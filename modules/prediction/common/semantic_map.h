@@ -16,13 +16,18 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <future>
+#include <list>
 #include <unordered_map>
+#include <utility>
 
 #include "opencv2/opencv.hpp"
 
 #include "cyber/common/macros.h"
 #include "modules/common_msgs/prediction_msgs/feature.pb.h"
+#include "modules/map/hdmap/hdmap.h"
 
 #ifdef __aarch64__
 #include "modules/prediction/common/affine_transform.h"
@@ -51,25 +56,44 @@ class SemanticMap {
                        static_cast<int>(2000 - (y - base_y) / 0.1));
   }
 
+  // Transform a point in world coordinates into pixel coordinates of an image
+  using PointTransform =
+      std::function<cv::Point2i(const double x, const double y)>;
+
   void DrawBaseMap(const double x, const double y, const double base_x,
                    const double base_y);
 
   void DrawBaseMapThread();
 
-  void DrawRoads(const common::PointENU& center_point, const double base_x,
-                 const double base_y,
+  // Compose the static layers around (x, y) from cached tiles into curr_img_,
+  // and update curr_base_x_ and curr_base_y_ aligned with the pixel grid.
+  void ComposeBaseMap(const double x, const double y);
+
+  // Get the tile of static layers at tile_col and tile_row, draw it first if
+  // it is not cached yet.
+  const cv::Mat& GetTile(const int tile_col, const int tile_row);
+
+  void DrawTile(const int tile_col, const int tile_row, cv::Mat* img);
+
+  void DrawStaticLayers(const common::PointENU& center_point,
+                        const double radius, const PointTransform& transform,
+                        cv::Mat* img);
+
+  void DrawRoads(const common::PointENU& center_point, const double radius,
+                 const PointTransform& transform, cv::Mat* img,
                  const cv::Scalar& color = cv::Scalar(64, 64, 64));
 
-  void DrawJunctions(const common::PointENU& center_point, const double base_x,
-                     const double base_y,
+  void DrawJunctions(const common::PointENU& center_point, const double radius,
+                     const PointTransform& transform, cv::Mat* img,
                      const cv::Scalar& color = cv::Scalar(128, 128, 128));
 
-  void DrawCrosswalks(const common::PointENU& center_point, const double base_x,
-                      const double base_y,
+  void DrawCrosswalks(const common::PointENU& center_point,
+                      const double radius, const PointTransform& transform,
+                      cv::Mat* img,
                       const cv::Scalar& color = cv::Scalar(192, 192, 192));
 
-  void DrawLanes(const common::PointENU& center_point, const double base_x,
-                 const double base_y,
+  void DrawLanes(const common::PointENU& center_point, const double radius,
+                 const PointTransform& transform, cv::Mat* img,
                  const cv::Scalar& color = cv::Scalar(255, 255, 255));
 
   cv::Scalar HSVtoRGB(double H = 1.0, double S = 1.0, double V = 1.0);
@@ -113,6 +137,17 @@ class SemanticMap {
 
   bool started_drawing_ = false;
 
+  // Cached tiles of static layers, keyed by tile_col and tile_row, in the
+  // order of least recently used first
+  struct Tile {
+    cv::Mat img;
+    std::list<int64_t>::iterator lru_iter;
+  };
+  std::unordered_map<int64_t, Tile> tiles_;
+  std::list<int64_t> tiles_lru_;
+  // The map tiles are drawn from, tiles are dropped once it is reloaded
+  const hdmap::HDMap* tiles_map_ = nullptr;
+
 #ifdef __aarch64__
   AffineTransform affine_transformer_;
 #endif
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/container/obstacles/feature_history.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace prediction {
+
+constexpr size_t FeatureHistory::kInitialCapacity;
+
+FeatureHistory::FeatureHistory(const size_t capacity)
+    : arena_(new google::protobuf::Arena()) {
+  slots_.reserve(capacity);
+  for (size_t i = 0; i < capacity; ++i) {
+    slots_.push_back(
+        google::protobuf::Arena::CreateMessage<Feature>(arena_.get()));
+  }
+}
+
+FeatureHistory::FeatureHistory(const FeatureHistory& other)
+    : FeatureHistory(std::max(other.size_, kInitialCapacity)) {
+  CopyFrom(other);
+}
+
+FeatureHistory::FeatureHistory(FeatureHistory&& other) noexcept
+    : arena_(std::move(other.arena_)),
+      slots_(std::move(other.slots_)),
+      head_(other.head_),
+      size_(other.size_) {
+  other.slots_.clear();
+  other.head_ = 0;
+  other.size_ = 0;
+}
+
+FeatureHistory& FeatureHistory::operator=(const FeatureHistory& other) {
+  if (this != &other) {
+    CopyFrom(other);
+  }
+  return *this;
+}
+
+FeatureHistory& FeatureHistory::operator=(FeatureHistory&& other) noexcept {
+  if (this != &other) {
+    arena_ = std::move(other.arena_);
+    slots_ = std::move(other.slots_);
+    head_ = other.head_;
+    size_ = other.size_;
+    other.slots_.clear();
+    other.head_ = 0;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+void FeatureHistory::CopyFrom(const FeatureHistory& other) {
+  // Features of this history are reused as many as possible
+  size_ = 0;
+  head_ = 0;
+  while (slots_.size() < other.size_) {
+    Grow();
+  }
+  for (size_t i = 0; i < other.size_; ++i) {
+    slots_[i]->CopyFrom(other[i]);
+  }
+  size_ = other.size_;
+}
+
+Feature* FeatureHistory::spare() {
+  if (size_ == slots_.size()) {
+    Grow();
+  }
+  Feature* feature = slots_[Index(slots_.size() - 1)];
+  feature->Clear();
+  return feature;
+}
+
+void FeatureHistory::PushSpareFront() {
+  ACHECK(size_ < slots_.size());
+  head_ = Index(slots_.size() - 1);
+  ++size_;
+}
+
+void FeatureHistory::PushFront(const Feature& feature) {
+  spare()->CopyFrom(feature);
+  PushSpareFront();
+}
+
+void FeatureHistory::PopBack() {
+  ACHECK(size_ > 0);
+  --size_;
+}
+
+void FeatureHistory::Truncate(const size_t size) {
+  size_ = std::min(size_, size);
+}
+
+void FeatureHistory::Compact(Feature* feature) {
+  if (feature->has_lane()) {
+    Lane* lane = feature->mutable_lane();
+    lane->clear_current_lane_feature();
+    lane->clear_nearby_lane_feature();
+    lane->clear_lane_graph();
+    lane->clear_lane_graph_ordered();
+  }
+  if (feature->has_junction_feature()) {
+    JunctionFeature* junction_feature = feature->mutable_junction_feature();
+    junction_feature->clear_junction_exit();
+    junction_feature->clear_junction_mlp_feature();
+    junction_feature->clear_junction_mlp_label();
+    junction_feature->clear_junction_mlp_probability();
+    junction_feature->clear_start_lane_id();
+  }
+  feature->clear_short_term_predicted_trajectory_points();
+  feature->clear_predicted_trajectory();
+  feature->clear_adc_trajectory_point();
+  feature->clear_adc_localization();
+  feature->clear_surrounding_lane_id();
+  feature->clear_within_lane_id();
+}
+
+void FeatureHistory::Grow() {
+  if (arena_ == nullptr) {
+    arena_.reset(new google::protobuf::Arena());
+  }
+  const size_t capacity = std::max(slots_.size() * 2, kInitialCapacity);
+  std::vector<Feature*> slots;
+  slots.reserve(capacity);
+  // Features in the history first, then the recycled ones
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    slots.push_back(slots_[Index(i)]);
+  }
+  while (slots.size() < capacity) {
+    slots.push_back(
+        google::protobuf::Arena::CreateMessage<Feature>(arena_.get()));
+  }
+  slots_ = std::move(slots);
+  head_ = 0;
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Ring buffer of the historical features of an obstacle
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "google/protobuf/arena.h"
+
+#include "modules/common_msgs/prediction_msgs/feature.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class FeatureHistory
+ * @brief Features of an obstacle from the latest one to the oldest one.
+ *        Features are allocated on an arena owned by the history and
+ *        recycled once popped, so that inserting a frame does not allocate
+ *        once the history reaches its usual size.
+ */
+class FeatureHistory {
+ public:
+  /**
+   * @brief Constructor
+   * @param The initial number of features allocated
+   */
+  explicit FeatureHistory(const size_t capacity = kInitialCapacity);
+
+  FeatureHistory(const FeatureHistory& other);
+
+  FeatureHistory(FeatureHistory&& other) noexcept;
+
+  FeatureHistory& operator=(const FeatureHistory& other);
+
+  FeatureHistory& operator=(FeatureHistory&& other) noexcept;
+
+  ~FeatureHistory() = default;
+
+  bool empty() const { return size_ == 0; }
+
+  size_t size() const { return size_; }
+
+  size_t capacity() const { return slots_.size(); }
+
+  /**
+   * @brief Get the i-th feature, 0 is the latest one
+   */
+  const Feature& operator[](const size_t i) const {
+    return *slots_[Index(i)];
+  }
+
+  Feature& operator[](const size_t i) { return *slots_[Index(i)]; }
+
+  const Feature& front() const { return (*this)[0]; }
+
+  Feature& front() { return (*this)[0]; }
+
+  const Feature& back() const { return (*this)[size_ - 1]; }
+
+  Feature& back() { return (*this)[size_ - 1]; }
+
+  /**
+   * @brief Get a cleared feature which is not in the history yet, it becomes
+   *        the latest one after PushSpareFront()
+   * @return The spare feature
+   */
+  Feature* spare();
+
+  /**
+   * @brief Insert the spare feature as the latest one
+   */
+  void PushSpareFront();
+
+  /**
+   * @brief Insert a copy of the feature as the latest one
+   */
+  void PushFront(const Feature& feature);
+
+  /**
+   * @brief Remove the oldest feature, it is kept for recycling
+   */
+  void PopBack();
+
+  /**
+   * @brief Keep the latest size features at most
+   */
+  void Truncate(const size_t size);
+
+  /**
+   * @brief Clear the fields of a feature which are only used in the frame
+   *        it was built, like lane graphs, junction exits and trajectories.
+   *        Position, shape, kinematics, lane feature and junction range are
+   *        kept for the evaluators looking into the history.
+   */
+  static void Compact(Feature* feature);
+
+ private:
+  static constexpr size_t kInitialCapacity = 8;
+
+  size_t Index(const size_t i) const {
+    return (head_ + i) % slots_.size();
+  }
+
+  // Double the capacity, the order of features is kept.
+  void Grow();
+
+  void CopyFrom(const FeatureHistory& other);
+
+  std::unique_ptr<google::protobuf::Arena> arena_;
+
+  // Ring of features allocated on arena_, the latest feature is at head_
+  std::vector<Feature*> slots_;
+
+  size_t head_ = 0;
+
+  size_t size_ = 0;
+};
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/container/obstacles/feature_history.h"
+
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+Feature MakeFeature(const double timestamp) {
+  Feature feature;
+  feature.set_timestamp(timestamp);
+  feature.mutable_position()->set_x(timestamp);
+  return feature;
+}
+
+}  // namespace
+
+TEST(FeatureHistoryTest, PushAndPop) {
+  FeatureHistory history(2);
+  EXPECT_TRUE(history.empty());
+  for (int i = 0; i < 5; ++i) {
+    history.PushFront(MakeFeature(static_cast<double>(i)));
+  }
+  EXPECT_EQ(5, history.size());
+  EXPECT_GE(history.capacity(), 5);
+  EXPECT_DOUBLE_EQ(4.0, history.front().timestamp());
+  EXPECT_DOUBLE_EQ(0.0, history.back().timestamp());
+  for (size_t i = 0; i < history.size(); ++i) {
+    EXPECT_DOUBLE_EQ(4.0 - static_cast<double>(i), history[i].timestamp());
+  }
+
+  history.PopBack();
+  history.PopBack();
+  EXPECT_EQ(3, history.size());
+  EXPECT_DOUBLE_EQ(2.0, history.back().timestamp());
+
+  // Popped features are recycled without growing the history
+  const size_t capacity = history.capacity();
+  for (int i = 5; i < 7; ++i) {
+    Feature* feature = history.spare();
+    EXPECT_FALSE(feature->has_timestamp());
+    feature->set_timestamp(static_cast<double>(i));
+    history.PushSpareFront();
+  }
+  EXPECT_EQ(capacity, history.capacity());
+  EXPECT_EQ(5, history.size());
+  EXPECT_DOUBLE_EQ(6.0, history.front().timestamp());
+  EXPECT_DOUBLE_EQ(2.0, history.back().timestamp());
+
+  history.Truncate(2);
+  EXPECT_EQ(2, history.size());
+  EXPECT_DOUBLE_EQ(5.0, history.back().timestamp());
+}
+
+TEST(FeatureHistoryTest, CopyAndMove) {
+  FeatureHistory history;
+  for (int i = 0; i < 10; ++i) {
+    history.PushFront(MakeFeature(static_cast<double>(i)));
+  }
+  history.PopBack();
+
+  FeatureHistory copied_history(history);
+  ASSERT_EQ(history.size(), copied_history.size());
+  for (size_t i = 0; i < history.size(); ++i) {
+    EXPECT_DOUBLE_EQ(history[i].timestamp(), copied_history[i].timestamp());
+    EXPECT_NE(&history[i], &copied_history[i]);
+  }
+
+  FeatureHistory assigned_history;
+  assigned_history.PushFront(MakeFeature(100.0));
+  assigned_history = history;
+  ASSERT_EQ(history.size(), assigned_history.size());
+  EXPECT_DOUBLE_EQ(9.0, assigned_history.front().timestamp());
+  EXPECT_DOUBLE_EQ(1.0, assigned_history.back().timestamp());
+
+  const Feature* latest_feature = &history.front();
+  FeatureHistory moved_history(std::move(history));
+  EXPECT_EQ(latest_feature, &moved_history.front());
+  EXPECT_EQ(9, moved_history.size());
+}
+
+TEST(FeatureHistoryTest, Compact) {
+  Feature feature = MakeFeature(1.0);
+  feature.add_polygon_point()->set_x(1.0);
+  feature.mutable_lane()->mutable_lane_feature()->set_lane_l(0.5);
+  feature.mutable_lane()->add_current_lane_feature()->set_lane_l(0.5);
+  feature.mutable_lane()->mutable_lane_graph()->add_lane_sequence();
+  feature.mutable_junction_feature()->set_junction_range(10.0);
+  feature.mutable_junction_feature()->add_junction_exit();
+  feature.add_predicted_trajectory();
+  feature.add_adc_trajectory_point();
+
+  FeatureHistory::Compact(&feature);
+  EXPECT_DOUBLE_EQ(1.0, feature.position().x());
+  EXPECT_EQ(1, feature.polygon_point_size());
+  EXPECT_DOUBLE_EQ(0.5, feature.lane().lane_feature().lane_l());
+  EXPECT_EQ(0, feature.lane().current_lane_feature_size());
+  EXPECT_FALSE(feature.lane().has_lane_graph());
+  EXPECT_DOUBLE_EQ(10.0, feature.junction_feature().junction_range());
+  EXPECT_EQ(0, feature.junction_feature().junction_exit_size());
+  EXPECT_EQ(0, feature.predicted_trajectory_size());
+  EXPECT_EQ(0, feature.adc_trajectory_point_size());
+
+  Feature feature_without_lane = MakeFeature(2.0);
+  FeatureHistory::Compact(&feature_without_lane);
+  EXPECT_FALSE(feature_without_lane.has_lane());
+  EXPECT_FALSE(feature_without_lane.has_junction_feature());
+}
+
+}  // namespace prediction
+}  // namespace apollo
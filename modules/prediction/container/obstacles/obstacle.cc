@@ -154,34 +154,36 @@ bool Obstacle::Insert(const PerceptionObstacle& perception_obstacle,
     return false;
   }
 
-  // Set ID, Type, and Status of the feature.
-  Feature feature;
-  if (!SetId(perception_obstacle, &feature, prediction_obstacle_id)) {
+  // Set ID, Type, and Status of the feature, which is recycled from the
+  // discarded historical features.
+  Feature* feature = feature_history_.spare();
+  if (!SetId(perception_obstacle, feature, prediction_obstacle_id)) {
     return false;
   }
 
-  SetType(perception_obstacle, &feature);
+  SetType(perception_obstacle, feature);
 
-  SetStatus(perception_obstacle, timestamp, &feature);
+  SetStatus(perception_obstacle, timestamp, feature);
 
   // Set obstacle lane features
   if (type_ != PerceptionObstacle::PEDESTRIAN) {
-    SetCurrentLanes(&feature);
-    SetNearbyLanes(&feature);
+    SetCurrentLanes(feature);
+    SetNearbyLanes(feature);
   }
 
   if (FLAGS_prediction_offline_mode ==
       PredictionConstants::kDumpDataForLearning) {
-    SetSurroundingLaneIds(&feature, FLAGS_surrounding_lane_search_radius);
+    SetSurroundingLaneIds(feature, FLAGS_surrounding_lane_search_radius);
   }
 
   if (FLAGS_adjust_vehicle_heading_by_lane &&
       type_ == PerceptionObstacle::VEHICLE) {
-    AdjustHeadingByLane(&feature);
+    AdjustHeadingByLane(feature);
   }
 
   // Insert obstacle feature to history
-  InsertFeatureToHistory(feature);
+  feature_history_.PushSpareFront();
+  CompactHistory();
 
   // Set obstacle motion status
   if (FLAGS_use_navigation_mode) {
@@ -215,9 +217,7 @@ void Obstacle::ClearOldInformation() {
 }
 
 void Obstacle::TrimHistory(const size_t remain_size) {
-  if (feature_history_.size() > remain_size) {
-    feature_history_.resize(remain_size);
-  }
+  feature_history_.Truncate(remain_size);
 }
 
 bool Obstacle::IsInJunction(const std::string& junction_id) const {
@@ -1340,14 +1340,12 @@ void Obstacle::SetMotionStatus() {
   len = std::max(len, FLAGS_min_still_obstacle_history_length);
   CHECK_GT(len, 1);
 
-  auto feature_riter = feature_history_.rbegin();
-  start_x = feature_riter->position().x();
-  start_y = feature_riter->position().y();
-  ++feature_riter;
-  while (feature_riter != feature_history_.rend()) {
-    avg_drift_x += (feature_riter->position().x() - start_x) / (len - 1);
-    avg_drift_y += (feature_riter->position().y() - start_y) / (len - 1);
-    ++feature_riter;
+  start_x = feature_history_.back().position().x();
+  start_y = feature_history_.back().position().y();
+  for (int i = history_size - 2; i >= 0; --i) {
+    const Feature& feature = feature_history_[i];
+    avg_drift_x += (feature.position().x() - start_x) / (len - 1);
+    avg_drift_y += (feature.position().y() - start_y) / (len - 1);
   }
 
   double delta_ts = feature_history_.front().timestamp() -
@@ -1399,10 +1397,21 @@ void Obstacle::SetMotionStatusBySpeed() {
 }
 
 void Obstacle::InsertFeatureToHistory(const Feature& feature) {
-  feature_history_.emplace_front(feature);
+  feature_history_.PushFront(feature);
+  CompactHistory();
   ADEBUG << "Obstacle [" << id_ << "] inserted a frame into the history.";
 }
 
+void Obstacle::CompactHistory() {
+  // Each feature is compacted once when it becomes older than the latest
+  // max_num_full_history_features ones.
+  const int num_full_features = FLAGS_max_num_full_history_features;
+  if (num_full_features > 0 &&
+      feature_history_.size() > static_cast<size_t>(num_full_features)) {
+    FeatureHistory::Compact(&feature_history_[num_full_features]);
+  }
+}
+
 std::unique_ptr<Obstacle> Obstacle::Create(
     const PerceptionObstacle& perception_obstacle, const double timestamp,
     const int prediction_id, ObstacleClusters* clusters_ptr) {
@@ -1435,7 +1444,7 @@ void Obstacle::DiscardOutdatedHistory() {
   const double latest_ts = feature_history_.front().timestamp();
   while (latest_ts - feature_history_.back().timestamp() >=
          FLAGS_max_history_time) {
-    feature_history_.pop_back();
+    feature_history_.PopBack();
   }
   auto num_of_discarded_frames = num_of_frames - feature_history_.size();
   if (num_of_discarded_frames > 0) {
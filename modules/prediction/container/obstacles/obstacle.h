@@ -21,7 +21,6 @@
 
 #pragma once
 
-#include <deque>
 #include <list>
 #include <memory>
 #include <string>
@@ -33,6 +32,7 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/prediction/common/junction_analyzer.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/container/obstacles/feature_history.h"
 #include "modules/prediction/container/obstacles/obstacle_clusters.h"
 #include "modules/common_msgs/prediction_msgs/feature.pb.h"
 #include "modules/prediction/proto/prediction_conf.pb.h"
@@ -317,6 +317,8 @@ class Obstacle {
 
   void InsertFeatureToHistory(const Feature& feature);
 
+  void CompactHistory();
+
   void SetJunctionFeatureWithEnterLane(const std::string& enter_lane_id,
                                        Feature* const feature_ptr);
 
@@ -342,7 +344,7 @@ class Obstacle {
   perception::PerceptionObstacle::Type type_ =
       perception::PerceptionObstacle::UNKNOWN_UNMOVABLE;
 
-  std::deque<Feature> feature_history_;
+  FeatureHistory feature_history_;
 
   std::vector<std::shared_ptr<const hdmap::LaneInfo>> current_lanes_;
 
@@ -17,8 +17,12 @@
 #include "modules/prediction/container/obstacles/obstacle_clusters.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
+#include "absl/strings/str_cat.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/road_graph.h"
 
 namespace apollo {
@@ -26,13 +30,59 @@ namespace prediction {
 
 using ::apollo::hdmap::LaneInfo;
 
+void ObstacleClusters::Init() {
+  std::lock_guard<std::mutex> lock(lane_graphs_mutex_);
+  lane_graphs_.clear();
+  lane_graphs_map_ = nullptr;
+}
+
 LaneGraph ObstacleClusters::GetLaneGraph(
     const double start_s, const double length, const bool consider_lane_split,
     std::shared_ptr<const LaneInfo> lane_info_ptr) {
-  std::string lane_id = lane_info_ptr->id().id();
   RoadGraph road_graph(start_s, length, consider_lane_split, lane_info_ptr);
   LaneGraph lane_graph;
-  road_graph.BuildLaneGraph(&lane_graph);
+  if (!FLAGS_enable_lane_graph_cache || lane_info_ptr == nullptr ||
+      FLAGS_lane_graph_cache_s_bucket <= 0.0) {
+    road_graph.BuildLaneGraph(&lane_graph);
+    return lane_graph;
+  }
+
+  const double bucket = FLAGS_lane_graph_cache_s_bucket;
+  const std::string key = absl::StrCat(
+      lane_info_ptr->id().id(), "|",
+      static_cast<int64_t>(std::floor(start_s / bucket)), "|",
+      static_cast<int64_t>(std::floor(length / bucket)), "|",
+      consider_lane_split ? "1" : "0");
+  {
+    std::lock_guard<std::mutex> lock(lane_graphs_mutex_);
+    // Drop all lane graphs once the map is reloaded
+    const apollo::hdmap::HDMap* map = apollo::hdmap::HDMapUtil::BaseMapPtr();
+    if (map != lane_graphs_map_) {
+      lane_graphs_.clear();
+      lane_graphs_map_ = map;
+    }
+    auto it = lane_graphs_.find(key);
+    if (it != lane_graphs_.end() &&
+        it->second.lane_info_ptr == lane_info_ptr &&
+        road_graph.BuildLaneGraphFromCache(it->second.lane_graph,
+                                           &lane_graph)) {
+      return lane_graph;
+    }
+  }
+
+  lane_graph.Clear();
+  if (!road_graph.BuildLaneGraph(&lane_graph).ok() ||
+      road_graph.search_horizon_reached()) {
+    return lane_graph;
+  }
+  std::lock_guard<std::mutex> lock(lane_graphs_mutex_);
+  if (static_cast<int>(lane_graphs_.size()) >=
+      FLAGS_lane_graph_cache_max_size) {
+    lane_graphs_.clear();
+  }
+  CachedLaneGraph& cached_lane_graph = lane_graphs_[key];
+  cached_lane_graph.lane_info_ptr = lane_info_ptr;
+  cached_lane_graph.lane_graph = lane_graph;
   return lane_graph;
 }
 
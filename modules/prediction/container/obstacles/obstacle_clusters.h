@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "modules/common/util/util.h"
+#include "modules/map/hdmap/hdmap.h"
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/common_msgs/prediction_msgs/feature.pb.h"
 
@@ -42,7 +43,8 @@ class ObstacleClusters {
   void Init();
 
   /**
-   * @brief Obtain a lane graph given a lane info and s
+   * @brief Obtain a lane graph given a lane info and s, reuse the lane graph
+   *        built before on the same lane with close start s and length.
    * @param lane start s
    * @param lane total length
    * @param if consider lane split ahead
@@ -132,6 +134,17 @@ class ObstacleClusters {
  private:
   std::unordered_map<std::string, std::vector<LaneObstacle>> lane_obstacles_;
   std::unordered_map<std::string, StopSign> lane_id_stop_sign_map_;
+
+  struct CachedLaneGraph {
+    std::shared_ptr<const apollo::hdmap::LaneInfo> lane_info_ptr;
+    LaneGraph lane_graph;
+  };
+  // Lane graphs keyed by lane id, start s bucket, length bucket and if
+  // consider lane split, shared by obstacles and frames
+  std::unordered_map<std::string, CachedLaneGraph> lane_graphs_;
+  // The map the cached lane graphs are built on
+  const apollo::hdmap::HDMap* lane_graphs_map_ = nullptr;
+  std::mutex lane_graphs_mutex_;
 };
 
 }  // namespace prediction
@@ -18,6 +18,7 @@
 
 #include "modules/prediction/common/kml_map_based_test.h"
 #include "modules/prediction/common/prediction_map.h"
+#include "modules/prediction/common/road_graph.h"
 
 namespace apollo {
 namespace prediction {
@@ -47,5 +48,24 @@ TEST_F(ObstacleClustersTest, ObstacleClusters) {
   EXPECT_EQ("l18", lane_graph_2.lane_sequence(0).lane_segment(1).lane_id());
 }
 
+TEST_F(ObstacleClustersTest, CachedLaneGraph) {
+  auto lane = PredictionMap::LaneById("l9");
+  ObstacleClusters cluster;
+  const LaneGraph lane_graph = cluster.GetLaneGraph(99.0, 100.0, true, lane);
+  // Close start s and length hit the cached lane graph
+  const LaneGraph cached_lane_graph =
+      cluster.GetLaneGraph(99.4, 100.2, true, lane);
+  ASSERT_EQ(1, cached_lane_graph.lane_sequence_size());
+  EXPECT_EQ(3, cached_lane_graph.lane_sequence(0).lane_segment_size());
+  EXPECT_DOUBLE_EQ(
+      99.4, cached_lane_graph.lane_sequence(0).lane_segment(0).start_s());
+
+  RoadGraph road_graph(99.4, 100.2, true, lane);
+  LaneGraph expected_lane_graph;
+  EXPECT_TRUE(road_graph.BuildLaneGraph(&expected_lane_graph).ok());
+  EXPECT_EQ(expected_lane_graph.DebugString(),
+            cached_lane_graph.DebugString());
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -83,6 +83,26 @@ class Evaluator {
                         ObstaclesContainer* obstacles_container) {
     return Evaluate(obstacle, obstacles_container);
   }
+
+  /**
+   * @brief Extract model inputs of an obstacle for the batched inference,
+   *        evaluators without batched inference evaluate it directly.
+   *        Could be called from multiple threads.
+   * @param Obstacle pointer
+   * @param Obstacles container
+   * @return False if the obstacle could not be evaluated
+   */
+  virtual bool PrepareBatch(Obstacle* obstacle,
+                            ObstaclesContainer* obstacles_container) {
+    return Evaluate(obstacle, obstacles_container);
+  }
+
+  /**
+   * @brief Run the batched inference on all obstacles prepared since the
+   *        last call, and write results back to their features.
+   */
+  virtual void EvaluateBatch() {}
+
   /**
    * @brief Get the name of evaluator
    */
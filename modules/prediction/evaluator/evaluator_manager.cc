@@ -225,6 +225,7 @@ void EvaluatorManager::Run(
   }
 
   std::vector<Obstacle*> dynamic_env;
+  batch_evaluation_ = FLAGS_enable_batch_evaluation;
 
   if (FLAGS_enable_multi_agent_pedestrian_evaluator || 
     FLAGS_enable_multi_agent_vehicle_evaluator) {
@@ -264,6 +265,31 @@ void EvaluatorManager::Run(
                       obstacles_container, dynamic_env);
     }
   }
+
+  if (batch_evaluation_) {
+    // Features of all obstacles are ready, run one batched inference for
+    // each evaluator.
+    auto start_time_batch = std::chrono::system_clock::now();
+    for (auto& evaluator : evaluators_) {
+      if (evaluator.second != nullptr) {
+        evaluator.second->EvaluateBatch();
+      }
+    }
+    auto end_time_batch = std::chrono::system_clock::now();
+    std::chrono::duration<double> time_cost_batch =
+        end_time_batch - start_time_batch;
+    ADEBUG << "batched evaluators used time: "
+           << time_cost_batch.count() * 1000 << " ms.";
+    batch_evaluation_ = false;
+  }
+}
+
+bool EvaluatorManager::RunEvaluator(Evaluator* evaluator, Obstacle* obstacle,
+                                    ObstaclesContainer* obstacles_container) {
+  if (batch_evaluation_) {
+    return evaluator->PrepareBatch(obstacle, obstacles_container);
+  }
+  return evaluator->Evaluate(obstacle, obstacles_container);
 }
 
 void EvaluatorManager::EvaluateObstacle(
@@ -302,7 +328,7 @@ void EvaluatorManager::EvaluateObstacle(
                   << " downgrade to normal level!";
           }
         } else {
-          if (evaluator->Evaluate(obstacle, obstacles_container)) {
+          if (RunEvaluator(evaluator, obstacle, obstacles_container)) {
             break;
           } else {
             AERROR << "Obstacle: " << obstacle->id()
@@ -327,7 +353,7 @@ void EvaluatorManager::EvaluateObstacle(
       if (evaluator->GetName() == "LANE_SCANNING_EVALUATOR") {
         evaluator->Evaluate(obstacle, obstacles_container, dynamic_env);
       } else {
-        evaluator->Evaluate(obstacle, obstacles_container);
+        RunEvaluator(evaluator, obstacle, obstacles_container);
       }
       break;
     }
@@ -335,7 +361,7 @@ void EvaluatorManager::EvaluateObstacle(
       if (obstacle->IsOnLane()) {
         evaluator = GetEvaluator(cyclist_on_lane_evaluator_);
         CHECK_NOTNULL(evaluator);
-        evaluator->Evaluate(obstacle, obstacles_container);
+        RunEvaluator(evaluator, obstacle, obstacles_container);
       }
       break;
     }
@@ -348,7 +374,7 @@ void EvaluatorManager::EvaluateObstacle(
         evaluator = GetEvaluator(pedestrian_evaluator_);
         CHECK_NOTNULL(evaluator);
         auto start_time_inference = std::chrono::system_clock::now();
-        evaluator->Evaluate(obstacle, obstacles_container);
+        RunEvaluator(evaluator, obstacle, obstacles_container);
         auto end_time_inference = std::chrono::system_clock::now();
         std::chrono::duration<double> time_cost_lstm =
             end_time_inference - start_time_inference;
@@ -361,7 +387,7 @@ void EvaluatorManager::EvaluateObstacle(
       if (obstacle->IsOnLane()) {
         evaluator = GetEvaluator(default_on_lane_evaluator_);
         CHECK_NOTNULL(evaluator);
-        evaluator->Evaluate(obstacle, obstacles_container);
+        RunEvaluator(evaluator, obstacle, obstacles_container);
       }
       break;
     }
@@ -88,6 +88,17 @@ class EvaluatorManager {
 
   void DumpCurrentFrameEnv(ObstaclesContainer* obstacles_container);
 
+  /**
+   * @brief Evaluate an obstacle, or only prepare its model inputs if the
+   *        batched evaluation is running
+   * @param Evaluator pointer
+   * @param Obstacle pointer
+   * @param Obstacles container
+   * @return False if the evaluation failed
+   */
+  bool RunEvaluator(Evaluator* evaluator, Obstacle* obstacle,
+                    ObstaclesContainer* obstacles_container);
+
   /**
    * @brief Register an evaluator by type
    * @param Evaluator type
@@ -146,6 +157,9 @@ class EvaluatorManager {
   std::unordered_map<int, ObstacleHistory> obstacle_id_history_map_;
 
   std::unique_ptr<SemanticMap> semantic_map_;
+
+  // True while obstacles are prepared for the batched evaluation in Run
+  bool batch_evaluation_ = false;
 };
 
 }  // namespace prediction
@@ -49,6 +49,26 @@ class ModelBase {
                          std::vector<void*>* output_buffer,
                          unsigned int output_size) = 0;
 
+  /**
+   * @brief performing network inference on samples stacked along the first
+   * dimension of every buffer, models without batch support only accept
+   * batch_size of 1
+   *
+   * @param input_buffer vector of input tensor
+   * @param input_size size of input_buffer
+   * @param output_buffer vector of output tensor
+   * @param output_size size of output_buffer
+   * @param batch_size number of samples
+   * @return inference result, true for success
+   */
+  virtual bool BatchInference(const std::vector<void*>& input_buffer,
+                              unsigned int input_size,
+                              std::vector<void*>* output_buffer,
+                              unsigned int output_size, int batch_size) {
+    return batch_size == 1 &&
+           Inference(input_buffer, input_size, output_buffer, output_size);
+  }
+
   /**
    * @brief load the model from file
    *
@@ -54,6 +54,18 @@ class SemanticLstmPedestrianGpuTorch : public ModelBase {
                          std::vector<void*>* output_buffer,
                          unsigned int output_size);
 
+  /**
+   * @brief performing network inference on samples stacked along the first
+   * dimension of every buffer
+   *
+   * @param batch_size number of samples
+   * @return inference result, true for success
+   */
+  virtual bool BatchInference(const std::vector<void*>& input_buffer,
+                              unsigned int input_size,
+                              std::vector<void*>* output_buffer,
+                              unsigned int output_size, int batch_size);
+
   /**
    * @brief load the model from file
    *
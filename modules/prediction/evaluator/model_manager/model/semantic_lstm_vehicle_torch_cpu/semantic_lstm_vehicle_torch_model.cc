@@ -83,6 +83,14 @@ bool SemanticLstmVehicleCpuTorch::LoadModel() {
 bool SemanticLstmVehicleCpuTorch::Inference(
     const std::vector<void*>& input_buffer, unsigned int input_size,
     std::vector<void*>* output_buffer, unsigned int output_size) {
+  return BatchInference(input_buffer, input_size, output_buffer, output_size,
+                        1);
+}
+
+bool SemanticLstmVehicleCpuTorch::BatchInference(
+    const std::vector<void*>& input_buffer, unsigned int input_size,
+    std::vector<void*>* output_buffer, unsigned int output_size,
+    int batch_size) {
   ACHECK(input_size == input_buffer.size() && input_size == 3);
   ACHECK(output_size == output_buffer->size() && output_size == 1);
 
@@ -95,10 +103,11 @@ bool SemanticLstmVehicleCpuTorch::Inference(
     device = torch::Device(torch::kCUDA);
   }
   torch::Tensor img_tensor =
-      torch::from_blob(input_buffer[0], {1, 3, 224, 224});
-  torch::Tensor obstacle_pos = torch::from_blob(input_buffer[1], {1, 20, 2});
+      torch::from_blob(input_buffer[0], {batch_size, 3, 224, 224});
+  torch::Tensor obstacle_pos =
+      torch::from_blob(input_buffer[1], {batch_size, 20, 2});
   torch::Tensor obstacle_pos_step =
-      torch::from_blob(input_buffer[2], {1, 20, 2});
+      torch::from_blob(input_buffer[2], {batch_size, 20, 2});
 
   std::vector<torch::jit::IValue> torch_inputs;
 
@@ -109,7 +118,7 @@ bool SemanticLstmVehicleCpuTorch::Inference(
   torch::Tensor torch_output_tensor =
       model_instance_.forward(torch_inputs).toTensor().to(torch::kCPU);
   memcpy((*output_buffer)[0], torch_output_tensor.data_ptr<float>(),
-         1 * 30 * 2 * sizeof(float));
+         batch_size * 30 * 2 * sizeof(float));
   return true;
 }
 
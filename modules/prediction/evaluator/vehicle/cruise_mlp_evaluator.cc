@@ -53,6 +53,40 @@ void CruiseMLPEvaluator::Clear() {}
 
 bool CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
                                   ObstaclesContainer* obstacles_container) {
+  std::vector<LaneSequenceInput> lane_sequence_inputs;
+  if (!ExtractLaneSequenceInputs(obstacle_ptr, obstacles_container,
+                                 &lane_sequence_inputs)) {
+    return false;
+  }
+  ModelInference(lane_sequence_inputs);
+  return true;
+}
+
+bool CruiseMLPEvaluator::PrepareBatch(
+    Obstacle* obstacle_ptr, ObstaclesContainer* obstacles_container) {
+  std::vector<LaneSequenceInput> lane_sequence_inputs;
+  if (!ExtractLaneSequenceInputs(obstacle_ptr, obstacles_container,
+                                 &lane_sequence_inputs)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(batch_mutex_);
+  for (auto& lane_sequence_input : lane_sequence_inputs) {
+    batch_inputs_.push_back(std::move(lane_sequence_input));
+  }
+  return true;
+}
+
+void CruiseMLPEvaluator::EvaluateBatch() {
+  std::lock_guard<std::mutex> lock(batch_mutex_);
+  ADEBUG << "Batched inference on " << batch_inputs_.size()
+         << " lane sequences.";
+  ModelInference(batch_inputs_);
+  batch_inputs_.clear();
+}
+
+bool CruiseMLPEvaluator::ExtractLaneSequenceInputs(
+    Obstacle* obstacle_ptr, ObstaclesContainer* obstacles_container,
+    std::vector<LaneSequenceInput>* lane_sequence_inputs) {
   // Sanity checks.
   omp_set_num_threads(1);
   Clear();
@@ -85,6 +119,7 @@ bool CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
   // For every possible lane sequence, extract features that are needed
   // to feed into our trained model.
   // Then compute the likelihood of the obstacle moving onto that laneseq.
+  lane_sequence_inputs->reserve(lane_graph_ptr->lane_sequence_size());
   for (int i = 0; i < lane_graph_ptr->lane_sequence_size(); ++i) {
     LaneSequence* lane_sequence_ptr = lane_graph_ptr->mutable_lane_sequence(i);
     CHECK_NOTNULL(lane_sequence_ptr);
@@ -118,22 +153,14 @@ bool CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
       FeatureOutput::InsertDataForLearning(*latest_feature_ptr, feature_values,
                                            "lane_scanning", lane_sequence_ptr);
       ADEBUG << "Save extracted features for learning locally.";
+      lane_sequence_inputs->clear();
       return true;  // Skip Compute probability for offline mode
     }
 
-    std::vector<torch::jit::IValue> torch_inputs;
-    int input_dim = static_cast<int>(
-        OBSTACLE_FEATURE_SIZE + SINGLE_LANE_FEATURE_SIZE * LANE_POINTS_SIZE);
-    torch::Tensor torch_input = torch::zeros({1, input_dim});
-    for (size_t i = 0; i < feature_values.size(); ++i) {
-      torch_input[0][i] = static_cast<float>(feature_values[i]);
-    }
-    torch_inputs.push_back(std::move(torch_input.to(device_)));
-    if (lane_sequence_ptr->vehicle_on_lane()) {
-      ModelInference(torch_inputs, torch_go_model_, lane_sequence_ptr);
-    } else {
-      ModelInference(torch_inputs, torch_cutin_model_, lane_sequence_ptr);
-    }
+    LaneSequenceInput lane_sequence_input;
+    lane_sequence_input.lane_sequence_ptr = lane_sequence_ptr;
+    lane_sequence_input.feature_values = std::move(feature_values);
+    lane_sequence_inputs->push_back(std::move(lane_sequence_input));
   }
   return true;
 }
@@ -555,18 +582,56 @@ void CruiseMLPEvaluator::LoadModels() {
 }
 
 void CruiseMLPEvaluator::ModelInference(
-    const std::vector<torch::jit::IValue>& torch_inputs,
-    torch::jit::script::Module torch_model_ptr,
-    LaneSequence* lane_sequence_ptr) {
-  auto torch_output_tuple = torch_model_ptr.forward(torch_inputs).toTuple();
+    const std::vector<LaneSequenceInput>& lane_sequence_inputs) {
+  std::vector<const LaneSequenceInput*> go_inputs;
+  std::vector<const LaneSequenceInput*> cutin_inputs;
+  for (const auto& lane_sequence_input : lane_sequence_inputs) {
+    if (lane_sequence_input.lane_sequence_ptr->vehicle_on_lane()) {
+      go_inputs.push_back(&lane_sequence_input);
+    } else {
+      cutin_inputs.push_back(&lane_sequence_input);
+    }
+  }
+  ModelInference(go_inputs, &torch_go_model_);
+  ModelInference(cutin_inputs, &torch_cutin_model_);
+}
+
+void CruiseMLPEvaluator::ModelInference(
+    const std::vector<const LaneSequenceInput*>& inputs,
+    torch::jit::script::Module* torch_model_ptr) {
+  if (inputs.empty()) {
+    return;
+  }
+  // Stack lane sequences along the batch dimension.
+  int64_t batch_size = static_cast<int64_t>(inputs.size());
+  int input_dim = static_cast<int>(
+      OBSTACLE_FEATURE_SIZE + SINGLE_LANE_FEATURE_SIZE * LANE_POINTS_SIZE);
+  torch::Tensor torch_input = torch::zeros({batch_size, input_dim});
+  auto torch_input_accessor = torch_input.accessor<float, 2>();
+  for (int64_t i = 0; i < batch_size; ++i) {
+    const std::vector<double>& feature_values = inputs[i]->feature_values;
+    for (size_t j = 0; j < feature_values.size(); ++j) {
+      torch_input_accessor[i][j] = static_cast<float>(feature_values[j]);
+    }
+  }
+  std::vector<torch::jit::IValue> torch_inputs;
+  torch_inputs.push_back(std::move(torch_input.to(device_)));
+
+  auto torch_output_tuple = torch_model_ptr->forward(torch_inputs).toTuple();
   auto probability_tensor =
       torch_output_tuple->elements()[0].toTensor().to(torch::kCPU);
   auto finish_time_tensor =
       torch_output_tuple->elements()[1].toTensor().to(torch::kCPU);
-  lane_sequence_ptr->set_probability(apollo::common::math::Sigmoid(
-      static_cast<double>(probability_tensor.accessor<float, 2>()[0][0])));
-  lane_sequence_ptr->set_time_to_lane_center(
-      static_cast<double>(finish_time_tensor.accessor<float, 2>()[0][0]));
+  auto probability = probability_tensor.accessor<float, 2>();
+  auto finish_time = finish_time_tensor.accessor<float, 2>();
+  // Scatter outputs back to lane sequences.
+  for (int64_t i = 0; i < batch_size; ++i) {
+    LaneSequence* lane_sequence_ptr = inputs[i]->lane_sequence_ptr;
+    lane_sequence_ptr->set_probability(apollo::common::math::Sigmoid(
+        static_cast<double>(probability[i][0])));
+    lane_sequence_ptr->set_time_to_lane_center(
+        static_cast<double>(finish_time[i][0]));
+  }
 }
 
 }  // namespace prediction
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -49,6 +50,19 @@ class CruiseMLPEvaluator : public Evaluator {
   bool Evaluate(Obstacle* obstacle_ptr,
                 ObstaclesContainer* obstacles_container) override;
 
+  /**
+   * @brief Override PrepareBatch
+   * @param Obstacle pointer
+   * @param Obstacles container
+   */
+  bool PrepareBatch(Obstacle* obstacle_ptr,
+                    ObstaclesContainer* obstacles_container) override;
+
+  /**
+   * @brief Override EvaluateBatch
+   */
+  void EvaluateBatch() override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -66,6 +80,22 @@ class CruiseMLPEvaluator : public Evaluator {
   void Clear();
 
  private:
+  struct LaneSequenceInput {
+    LaneSequence* lane_sequence_ptr = nullptr;
+    std::vector<double> feature_values;
+  };
+
+  /**
+   * @brief Extract model inputs of all lane sequences of an obstacle
+   * @param Obstacle pointer
+   * @param Obstacles container
+   * @param Model inputs of lane sequences to be inferred
+   * @return False if the obstacle could not be evaluated
+   */
+  bool ExtractLaneSequenceInputs(
+      Obstacle* obstacle_ptr, ObstaclesContainer* obstacles_container,
+      std::vector<LaneSequenceInput>* lane_sequence_inputs);
+
   /**
    * @brief Set obstacle feature vector
    * @param Obstacle pointer
@@ -101,9 +131,16 @@ class CruiseMLPEvaluator : public Evaluator {
    */
   void LoadModels();
 
-  void ModelInference(const std::vector<torch::jit::IValue>& torch_inputs,
-                      torch::jit::script::Module torch_model_ptr,
-                      LaneSequence* lane_sequence_ptr);
+  /**
+   * @brief Run go and cutin models on lane sequences, each model runs one
+   *        batched forward pass
+   * @param Model inputs of lane sequences
+   */
+  void ModelInference(
+      const std::vector<LaneSequenceInput>& lane_sequence_inputs);
+
+  void ModelInference(const std::vector<const LaneSequenceInput*>& inputs,
+                      torch::jit::script::Module* torch_model_ptr);
 
  private:
   static const size_t OBSTACLE_FEATURE_SIZE = 23 + 5 * 9;
@@ -114,6 +151,9 @@ class CruiseMLPEvaluator : public Evaluator {
   torch::jit::script::Module torch_go_model_;
   torch::jit::script::Module torch_cutin_model_;
   torch::Device device_;
+
+  std::mutex batch_mutex_;
+  std::vector<LaneSequenceInput> batch_inputs_;
 };
 
 }  // namespace prediction
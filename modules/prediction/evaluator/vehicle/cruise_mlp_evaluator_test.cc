@@ -56,5 +56,36 @@ TEST_F(CruiseMLPEvaluatorTest, OnLaneCase) {
   cruise_mlp_evaluator.Clear();
 }
 
+TEST_F(CruiseMLPEvaluatorTest, BatchOnLaneCase) {
+  CruiseMLPEvaluator cruise_mlp_evaluator;
+  ObstaclesContainer container;
+  container.Insert(perception_obstacles_);
+  container.BuildLaneGraph();
+  Obstacle* obstacle_ptr = container.GetObstacle(1);
+  EXPECT_NE(obstacle_ptr, nullptr);
+  cruise_mlp_evaluator.Evaluate(obstacle_ptr, &container);
+  std::vector<double> probabilities;
+  std::vector<double> times_to_lane_center;
+  for (const auto& lane_sequence :
+       obstacle_ptr->latest_feature().lane().lane_graph().lane_sequence()) {
+    probabilities.push_back(lane_sequence.probability());
+    times_to_lane_center.push_back(lane_sequence.time_to_lane_center());
+  }
+
+  // The batched inference should give the same results.
+  EXPECT_TRUE(cruise_mlp_evaluator.PrepareBatch(obstacle_ptr, &container));
+  cruise_mlp_evaluator.EvaluateBatch();
+  const LaneGraph& lane_graph =
+      obstacle_ptr->latest_feature().lane().lane_graph();
+  ASSERT_EQ(static_cast<int>(probabilities.size()),
+            lane_graph.lane_sequence_size());
+  for (int i = 0; i < lane_graph.lane_sequence_size(); ++i) {
+    EXPECT_NEAR(probabilities[i], lane_graph.lane_sequence(i).probability(),
+                1e-6);
+    EXPECT_NEAR(times_to_lane_center[i],
+                lane_graph.lane_sequence(i).time_to_lane_center(), 1e-6);
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -64,6 +64,76 @@ void JunctionMLPEvaluator::Clear() {}
 
 bool JunctionMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
                                     ObstaclesContainer* obstacles_container) {
+  std::vector<double> feature_values;
+  if (!ExtractModelInput(obstacle_ptr, obstacles_container, &feature_values)) {
+    return false;
+  }
+  if (FLAGS_prediction_offline_mode ==
+      PredictionConstants::kDumpDataForLearning) {
+    return true;  // Skip Compute probability for offline mode
+  }
+
+  std::vector<double> probability;
+  if (obstacle_ptr->latest_feature().junction_feature().junction_exit_size() >
+      1) {
+    std::vector<std::vector<double>> probabilities;
+    ModelInference({&feature_values}, &probabilities);
+    probability = std::move(probabilities.front());
+  } else {
+    probability = ExitProbabilityFromFeature(feature_values);
+  }
+  return AssignProbability(obstacle_ptr, probability);
+}
+
+bool JunctionMLPEvaluator::PrepareBatch(
+    Obstacle* obstacle_ptr, ObstaclesContainer* obstacles_container) {
+  std::vector<double> feature_values;
+  if (!ExtractModelInput(obstacle_ptr, obstacles_container, &feature_values)) {
+    return false;
+  }
+  if (FLAGS_prediction_offline_mode ==
+      PredictionConstants::kDumpDataForLearning) {
+    return true;  // Skip Compute probability for offline mode
+  }
+  // Failures after the batched inference can not be reported to the
+  // evaluator manager, so check the lane graph in advance.
+  const Feature& latest_feature = obstacle_ptr->latest_feature();
+  if (latest_feature.lane().lane_graph().lane_sequence().empty()) {
+    AERROR << "Obstacle [" << obstacle_ptr->id() << "] has no lane sequences.";
+    return false;
+  }
+
+  if (latest_feature.junction_feature().junction_exit_size() > 1) {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+    batch_inputs_.emplace_back(obstacle_ptr, std::move(feature_values));
+    return true;
+  }
+  return AssignProbability(obstacle_ptr,
+                           ExitProbabilityFromFeature(feature_values));
+}
+
+void JunctionMLPEvaluator::EvaluateBatch() {
+  std::lock_guard<std::mutex> lock(batch_mutex_);
+  if (batch_inputs_.empty()) {
+    return;
+  }
+  ADEBUG << "Batched inference on " << batch_inputs_.size() << " obstacles.";
+  std::vector<const std::vector<double>*> feature_values_batch;
+  feature_values_batch.reserve(batch_inputs_.size());
+  for (const auto& batch_input : batch_inputs_) {
+    feature_values_batch.push_back(&batch_input.second);
+  }
+  std::vector<std::vector<double>> probabilities;
+  ModelInference(feature_values_batch, &probabilities);
+  for (size_t i = 0; i < batch_inputs_.size(); ++i) {
+    AssignProbability(batch_inputs_[i].first, probabilities[i]);
+  }
+  batch_inputs_.clear();
+}
+
+bool JunctionMLPEvaluator::ExtractModelInput(
+    Obstacle* obstacle_ptr, ObstaclesContainer* obstacles_container,
+    std::vector<double>* feature_values) {
   // Sanity checks.
   omp_set_num_threads(1);
   Clear();
@@ -86,39 +156,62 @@ bool JunctionMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
     return false;
   }
 
-  std::vector<double> feature_values;
-  ExtractFeatureValues(obstacle_ptr, obstacles_container, &feature_values);
+  ExtractFeatureValues(obstacle_ptr, obstacles_container, feature_values);
 
   // Insert features to DataForLearning
   if (FLAGS_prediction_offline_mode ==
       PredictionConstants::kDumpDataForLearning) {
-    FeatureOutput::InsertDataForLearning(*latest_feature_ptr, feature_values,
+    FeatureOutput::InsertDataForLearning(*latest_feature_ptr, *feature_values,
                                          "junction", nullptr);
     ADEBUG << "Save extracted features for learning locally.";
-    return true;  // Skip Compute probability for offline mode
   }
-  std::vector<torch::jit::IValue> torch_inputs;
+  return true;
+}
+
+std::vector<double> JunctionMLPEvaluator::ExitProbabilityFromFeature(
+    const std::vector<double>& feature_values) {
+  std::vector<double> probability;
+  for (int i = 0; i < 12; ++i) {
+    probability.push_back(
+        feature_values[OBSTACLE_FEATURE_SIZE + EGO_VEHICLE_FEATURE_SIZE +
+                       8 * i]);
+  }
+  return probability;
+}
+
+void JunctionMLPEvaluator::ModelInference(
+    const std::vector<const std::vector<double>*>& feature_values_batch,
+    std::vector<std::vector<double>>* probabilities) {
+  // Stack obstacles along the batch dimension.
+  int64_t batch_size = static_cast<int64_t>(feature_values_batch.size());
   int input_dim = static_cast<int>(
       OBSTACLE_FEATURE_SIZE + EGO_VEHICLE_FEATURE_SIZE + JUNCTION_FEATURE_SIZE);
-  torch::Tensor torch_input = torch::zeros({1, input_dim});
-  for (size_t i = 0; i < feature_values.size(); ++i) {
-    torch_input[0][i] = static_cast<float>(feature_values[i]);
+  torch::Tensor torch_input = torch::zeros({batch_size, input_dim});
+  auto torch_input_accessor = torch_input.accessor<float, 2>();
+  for (int64_t i = 0; i < batch_size; ++i) {
+    const std::vector<double>& feature_values = *feature_values_batch[i];
+    for (size_t j = 0; j < feature_values.size(); ++j) {
+      torch_input_accessor[i][j] = static_cast<float>(feature_values[j]);
+    }
   }
+  std::vector<torch::jit::IValue> torch_inputs;
   torch_inputs.push_back(std::move(torch_input.to(device_)));
-  std::vector<double> probability;
-  if (latest_feature_ptr->junction_feature().junction_exit_size() > 1) {
-    at::Tensor torch_output_tensor =
-        torch_model_.forward(torch_inputs).toTensor().to(torch::kCPU);
-    auto torch_output = torch_output_tensor.accessor<float, 2>();
-    for (int i = 0; i < torch_output.size(1); ++i) {
-      probability.push_back(static_cast<double>(torch_output[0][i]));
-    }
-  } else {
-    for (int i = 0; i < 12; ++i) {
-      probability.push_back(feature_values[OBSTACLE_FEATURE_SIZE +
-                                           EGO_VEHICLE_FEATURE_SIZE + 8 * i]);
+
+  at::Tensor torch_output_tensor =
+      torch_model_.forward(torch_inputs).toTensor().to(torch::kCPU);
+  auto torch_output = torch_output_tensor.accessor<float, 2>();
+  probabilities->assign(batch_size, std::vector<double>());
+  for (int64_t i = 0; i < batch_size; ++i) {
+    for (int j = 0; j < torch_output.size(1); ++j) {
+      (*probabilities)[i].push_back(static_cast<double>(torch_output[i][j]));
     }
   }
+}
+
+bool JunctionMLPEvaluator::AssignProbability(
+    Obstacle* obstacle_ptr, const std::vector<double>& probability) {
+  int id = obstacle_ptr->id();
+  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
   for (double prob : probability) {
     latest_feature_ptr->mutable_junction_feature()
         ->add_junction_mlp_probability(prob);
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "torch/script.h"
@@ -53,6 +55,19 @@ class JunctionMLPEvaluator : public Evaluator {
   bool Evaluate(Obstacle* obstacle_ptr,
                 ObstaclesContainer* obstacles_container) override;
 
+  /**
+   * @brief Override PrepareBatch
+   * @param Obstacle pointer
+   * @param Obstacles container
+   */
+  bool PrepareBatch(Obstacle* obstacle_ptr,
+                    ObstaclesContainer* obstacles_container) override;
+
+  /**
+   * @brief Override EvaluateBatch
+   */
+  void EvaluateBatch() override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -69,6 +84,43 @@ class JunctionMLPEvaluator : public Evaluator {
   std::string GetName() override { return "JUNCTION_MLP_EVALUATOR"; }
 
  private:
+  /**
+   * @brief Sanity checks and extract the model input of an obstacle
+   * @param Obstacle pointer
+   * @param Obstacles container
+   * @param Feature container in a vector for receiving the feature values
+   * @return False if the obstacle could not be evaluated
+   */
+  bool ExtractModelInput(Obstacle* obstacle_ptr,
+                         ObstaclesContainer* obstacles_container,
+                         std::vector<double>* feature_values);
+
+  /**
+   * @brief Exit probability of 12 fan areas without the model, used when
+   *        there is only one junction exit
+   * @param Feature values
+   */
+  std::vector<double> ExitProbabilityFromFeature(
+      const std::vector<double>& feature_values);
+
+  /**
+   * @brief Run one batched forward pass
+   * @param Feature values of obstacles
+   * @param Exit probability of 12 fan areas of obstacles
+   */
+  void ModelInference(
+      const std::vector<const std::vector<double>*>& feature_values_batch,
+      std::vector<std::vector<double>>* probabilities);
+
+  /**
+   * @brief Write exit probability to junction feature and lane sequences
+   * @param Obstacle pointer
+   * @param Exit probability of 12 fan areas
+   * @return False if the obstacle has no lane sequence
+   */
+  bool AssignProbability(Obstacle* obstacle_ptr,
+                         const std::vector<double>& probability);
+
   /**
    * @brief Set obstacle feature vector
    * @param Obstacle pointer
@@ -110,6 +162,9 @@ class JunctionMLPEvaluator : public Evaluator {
 
   torch::jit::script::Module torch_model_;
   torch::Device device_;
+
+  std::mutex batch_mutex_;
+  std::vector<std::pair<Obstacle*, std::vector<double>>> batch_inputs_;
 };
 
 }  // namespace prediction
@@ -16,6 +16,8 @@
 
 #include "modules/prediction/evaluator/vehicle/semantic_lstm_evaluator.h"
 
+#include <cstring>
+
 #include <omp.h>
 
 #include "Eigen/Dense"
@@ -34,7 +36,6 @@ using apollo::common::math::Vec2d;
 SemanticLSTMEvaluator::SemanticLSTMEvaluator(SemanticMap* semantic_map)
     : semantic_map_(semantic_map) {
   evaluator_type_ = ObstacleConf::SEMANTIC_LSTM_EVALUATOR;
-  torch_default_output_tensor_ = torch::zeros({1, 30, 2});
   model_manager_ = ModelManager();
   model_manager_.Init();
   LoadModel();
@@ -44,6 +45,44 @@ void SemanticLSTMEvaluator::Clear() {}
 
 bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
                                      ObstaclesContainer* obstacles_container) {
+  ModelInput model_input;
+  if (!ExtractModelInput(obstacle_ptr, &model_input)) {
+    return false;
+  }
+  return ModelInference({&model_input}, obstacle_ptr->IsPedestrian());
+}
+
+bool SemanticLSTMEvaluator::PrepareBatch(
+    Obstacle* obstacle_ptr, ObstaclesContainer* obstacles_container) {
+  ModelInput model_input;
+  if (!ExtractModelInput(obstacle_ptr, &model_input)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(batch_mutex_);
+  batch_inputs_.push_back(std::move(model_input));
+  return true;
+}
+
+void SemanticLSTMEvaluator::EvaluateBatch() {
+  std::lock_guard<std::mutex> lock(batch_mutex_);
+  std::vector<ModelInput*> pedestrian_inputs;
+  std::vector<ModelInput*> vehicle_inputs;
+  for (auto& model_input : batch_inputs_) {
+    if (model_input.obstacle_ptr->IsPedestrian()) {
+      pedestrian_inputs.push_back(&model_input);
+    } else {
+      vehicle_inputs.push_back(&model_input);
+    }
+  }
+  ADEBUG << "Batched inference on " << pedestrian_inputs.size()
+         << " pedestrians and " << vehicle_inputs.size() << " vehicles.";
+  ModelInference(pedestrian_inputs, true);
+  ModelInference(vehicle_inputs, false);
+  batch_inputs_.clear();
+}
+
+bool SemanticLSTMEvaluator::ExtractModelInput(Obstacle* obstacle_ptr,
+                                              ModelInput* model_input) {
   omp_set_num_threads(1);
 
   obstacle_ptr->SetEvaluatorType(evaluator_type_);
@@ -55,8 +94,6 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
     AERROR << "Obstacle [" << id << "] has no latest feature.";
     return false;
   }
-  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
-  CHECK_NOTNULL(latest_feature_ptr);
 
   if (!FLAGS_enable_semantic_map) {
     ADEBUG << "Not enable semantic map, exit semantic_lstm_evaluator.";
@@ -70,7 +107,9 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
   cv::cvtColor(feature_map, feature_map, cv::COLOR_BGR2RGB);
   cv::Mat img_float;
   feature_map.convertTo(img_float, CV_32F, 1.0 / 255);
-  torch::Tensor img_tensor = torch::from_blob(img_float.data, {1, 224, 224, 3});
+  // Clone the image since the input may outlive img_float in batched mode
+  torch::Tensor img_tensor =
+      torch::from_blob(img_float.data, {1, 224, 224, 3}).clone();
   img_tensor = img_tensor.permute({0, 3, 1, 2});
   img_tensor[0][0] = img_tensor[0][0].sub(0.485).div(0.229);
   img_tensor[0][1] = img_tensor[0][1].sub(0.456).div(0.224);
@@ -98,42 +137,81 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
         pos_history[i].second - pos_history[i + 1].second;
   }
 
+  model_input->obstacle_ptr = obstacle_ptr;
+  model_input->img_tensor = img_tensor;
+  model_input->obstacle_pos = obstacle_pos;
+  model_input->obstacle_pos_step = obstacle_pos_step;
+  return true;
+}
+
+bool SemanticLSTMEvaluator::ModelInference(
+    const std::vector<ModelInput*>& model_inputs, bool is_pedestrian) {
+  if (model_inputs.empty()) {
+    return true;
+  }
+  // Stack the raw input buffers of obstacles along the batch dimension
+  static const int64_t kImageSize = 3 * 224 * 224;
+  static const int64_t kPosSize = 20 * 2;
+  int64_t batch_size = static_cast<int64_t>(model_inputs.size());
+  torch::Tensor img_batch = torch::empty({batch_size, 3, 224, 224});
+  torch::Tensor obstacle_pos_batch = torch::empty({batch_size, 20, 2});
+  torch::Tensor obstacle_pos_step_batch = torch::empty({batch_size, 20, 2});
+  for (int64_t i = 0; i < batch_size; ++i) {
+    std::memcpy(img_batch.data_ptr<float>() + i * kImageSize,
+                model_inputs[i]->img_tensor.data_ptr<float>(),
+                kImageSize * sizeof(float));
+    std::memcpy(obstacle_pos_batch.data_ptr<float>() + i * kPosSize,
+                model_inputs[i]->obstacle_pos.data_ptr<float>(),
+                kPosSize * sizeof(float));
+    std::memcpy(obstacle_pos_step_batch.data_ptr<float>() + i * kPosSize,
+                model_inputs[i]->obstacle_pos_step.data_ptr<float>(),
+                kPosSize * sizeof(float));
+  }
+
   // Build input features for torch
   std::vector<void*> input_buffers{
-      img_tensor.data_ptr<float>(),
-      obstacle_pos.data_ptr<float>(),
-      obstacle_pos_step.data_ptr<float>()
+      img_batch.data_ptr<float>(),
+      obstacle_pos_batch.data_ptr<float>(),
+      obstacle_pos_step_batch.data_ptr<float>()
   };
-  std::vector<void*> output_buffers{
-    torch_default_output_tensor_.data_ptr<float>()};
-
-  // Compute pred_traj
-  std::vector<double> pred_traj;
+  at::Tensor torch_output_tensor = torch::zeros({batch_size, 30, 2});
+  std::vector<void*> output_buffers{torch_output_tensor.data_ptr<float>()};
 
   auto start_time = std::chrono::system_clock::now();
-  if (obstacle_ptr->IsPedestrian()) {
-    if (!model_manager_.SelectModel(
-          device_, ObstacleConf::SEMANTIC_LSTM_EVALUATOR,
-          apollo::perception::PerceptionObstacle::PEDESTRIAN)->Inference(
-            input_buffers, 3, &output_buffers, 1)) {
+  auto model_ptr = model_manager_.SelectModel(
+      device_, ObstacleConf::SEMANTIC_LSTM_EVALUATOR,
+      is_pedestrian ? apollo::perception::PerceptionObstacle::PEDESTRIAN
+                    : apollo::perception::PerceptionObstacle::VEHICLE);
+  if (!model_ptr->BatchInference(input_buffers, 3, &output_buffers, 1,
+                                 static_cast<int>(batch_size))) {
+    if (batch_size == 1) {
       return false;
     }
-  } else {
-    if (!model_manager_.SelectModel(
-          device_, ObstacleConf::SEMANTIC_LSTM_EVALUATOR,
-          apollo::perception::PerceptionObstacle::VEHICLE)->Inference(
-            input_buffers, 3, &output_buffers, 1)) {
-      return false;
+    // The model does not support batches, infer obstacles one by one
+    bool success = true;
+    for (ModelInput* model_input : model_inputs) {
+      success = ModelInference({model_input}, is_pedestrian) && success;
     }
+    return success;
   }
-  at::Tensor torch_output_tensor = torch::from_blob(
-      output_buffers[0], {1, 30, 2});
 
   auto end_time = std::chrono::system_clock::now();
   std::chrono::duration<double> diff = end_time - start_time;
   ADEBUG << "Semantic_LSTM_evaluator used time: " << diff.count() * 1000
-         << " ms.";
+         << " ms for " << batch_size << " obstacles.";
   auto torch_output = torch_output_tensor.accessor<float, 3>();
+  for (int64_t i = 0; i < batch_size; ++i) {
+    AssignTrajectory(model_inputs[i]->obstacle_ptr, torch_output[i],
+                     torch_output_tensor.sizes()[2]);
+  }
+  return true;
+}
+
+void SemanticLSTMEvaluator::AssignTrajectory(
+    Obstacle* obstacle_ptr, const at::TensorAccessor<float, 2>& torch_output,
+    int64_t output_dim) {
+  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
+  CHECK_NOTNULL(latest_feature_ptr);
 
   // Get the trajectory
   double pos_x = latest_feature_ptr->position().x();
@@ -150,8 +228,8 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
       prev_y = last_point.y();
     }
     TrajectoryPoint* point = trajectory->add_trajectory_point();
-    double dx = static_cast<double>(torch_output[0][i][0]);
-    double dy = static_cast<double>(torch_output[0][i][1]);
+    double dx = static_cast<double>(torch_output[i][0]);
+    double dy = static_cast<double>(torch_output[i][1]);
 
     double heading = latest_feature_ptr->velocity_heading();
     Vec2d offset(dx, dy);
@@ -161,10 +239,10 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
     point->mutable_path_point()->set_x(point_x);
     point->mutable_path_point()->set_y(point_y);
 
-    if (torch_output_tensor.sizes()[2] == 5) {
-      double sigma_xr = std::abs(static_cast<double>(torch_output[0][i][2]));
-      double sigma_yr = std::abs(static_cast<double>(torch_output[0][i][3]));
-      double corr_r = static_cast<double>(torch_output[0][i][4]);
+    if (output_dim == 5) {
+      double sigma_xr = std::abs(static_cast<double>(torch_output[i][2]));
+      double sigma_yr = std::abs(static_cast<double>(torch_output[i][3]));
+      double corr_r = static_cast<double>(torch_output[i][4]);
       Eigen::Matrix2d cov_matrix_r;
       cov_matrix_r(0, 0) = sigma_xr * sigma_xr;
       cov_matrix_r(0, 1) = corr_r * sigma_xr * sigma_yr;
@@ -225,8 +303,6 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
                    FLAGS_prediction_trajectory_time_resolution);
     }
   }
-
-  return true;
 }
 
 bool SemanticLSTMEvaluator::ExtractObstacleHistory(
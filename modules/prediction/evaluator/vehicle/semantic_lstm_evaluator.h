@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -55,6 +56,19 @@ class SemanticLSTMEvaluator : public Evaluator {
   bool Evaluate(Obstacle* obstacle_ptr,
                 ObstaclesContainer* obstacles_container) override;
 
+  /**
+   * @brief Override PrepareBatch
+   * @param Obstacle pointer
+   * @param Obstacles container
+   */
+  bool PrepareBatch(Obstacle* obstacle_ptr,
+                    ObstaclesContainer* obstacles_container) override;
+
+  /**
+   * @brief Override EvaluateBatch
+   */
+  void EvaluateBatch() override;
+
   /**
    * @brief Extract obstacle history
    * @param Obstacle pointer
@@ -70,6 +84,40 @@ class SemanticLSTMEvaluator : public Evaluator {
   std::string GetName() override { return "SEMANTIC_LSTM_EVALUATOR"; }
 
  private:
+  struct ModelInput {
+    Obstacle* obstacle_ptr = nullptr;
+    torch::Tensor img_tensor;
+    torch::Tensor obstacle_pos;
+    torch::Tensor obstacle_pos_step;
+  };
+
+  /**
+   * @brief Extract the semantic map and history of an obstacle
+   * @param Obstacle pointer
+   * @param Model input of the obstacle
+   * @return False if the obstacle could not be evaluated
+   */
+  bool ExtractModelInput(Obstacle* obstacle_ptr, ModelInput* model_input);
+
+  /**
+   * @brief Run one batched inference and write predicted trajectories
+   * @param Model inputs of obstacles
+   * @param If use the pedestrian model
+   * @return False if the inference failed
+   */
+  bool ModelInference(const std::vector<ModelInput*>& model_inputs,
+                      bool is_pedestrian);
+
+  /**
+   * @brief Write a predicted trajectory to the latest feature
+   * @param Obstacle pointer
+   * @param Model output of the obstacle
+   * @param Dimension of each output point
+   */
+  void AssignTrajectory(Obstacle* obstacle_ptr,
+                        const at::TensorAccessor<float, 2>& torch_output,
+                        int64_t output_dim);
+
   /**
    * @brief Load model file
    */
@@ -77,9 +125,11 @@ class SemanticLSTMEvaluator : public Evaluator {
 
  private:
   ModelManager model_manager_;
-  at::Tensor torch_default_output_tensor_;
   Model::Backend device_;
   SemanticMap* semantic_map_;
+
+  std::mutex batch_mutex_;
+  std::vector<ModelInput> batch_inputs_;
 };
 
 }  // namespace prediction
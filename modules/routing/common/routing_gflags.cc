@@ -32,3 +32,12 @@ DEFINE_bool(enable_change_lane_in_result, true,
 
 DEFINE_uint32(routing_response_history_interval_ms, 1000,
               "ms, emit routing resposne for this time interval");
+
+DEFINE_bool(enable_routing_landmarks, false,
+            "guide the A* search by the routing costs to and from landmarks "
+            "instead of the straight line distance");
+
+DEFINE_int32(routing_landmark_num, 8, "number of routing landmarks");
+
+DEFINE_string(routing_landmark_filename, "routing_landmarks.bin",
+              "routing landmark table file, next to the routing map");
@@ -107,6 +107,14 @@ Navigator::Navigator(const std::string& topo_file_path) {
           << topo_file_path;
     return;
   }
+  if (FLAGS_enable_routing_landmarks) {
+    const std::string landmark_file =
+        cyber::common::GetDirName(topo_file_path) + "/" +
+        FLAGS_routing_landmark_filename;
+    if (!graph_->LoadLandmarks(landmark_file, FLAGS_routing_landmark_num)) {
+      AWARN << "Search routes without landmarks.";
+    }
+  }
   black_list_generator_.reset(new BlackListRangeGenerator);
   result_generator_.reset(new ResultGenerator);
   is_ready_ = true;
@@ -18,13 +18,21 @@
 
 #include <utility>
 
+#include "cyber/common/file.h"
+#include "modules/routing/graph/topo_landmarks.h"
+
 namespace apollo {
 namespace routing {
 
+TopoGraph::TopoGraph() = default;
+
+TopoGraph::~TopoGraph() = default;
+
 void TopoGraph::Clear() {
   topo_nodes_.clear();
   topo_edges_.clear();
   node_index_map_.clear();
+  landmarks_.reset();
 }
 
 bool TopoGraph::LoadNodes(const Graph& graph) {
@@ -36,6 +44,7 @@ bool TopoGraph::LoadNodes(const Graph& graph) {
     node_index_map_[node.lane_id()] = static_cast<int>(topo_nodes_.size());
     std::shared_ptr<TopoNode> topo_node;
     topo_node.reset(new TopoNode(node));
+    topo_node->SetIndex(static_cast<int>(topo_nodes_.size()));
     road_node_map_[node.road_id()].insert(topo_node.get());
     topo_nodes_.push_back(std::move(topo_node));
   }
@@ -84,6 +93,33 @@ bool TopoGraph::LoadGraph(const Graph& graph) {
   return true;
 }
 
+bool TopoGraph::LoadLandmarks(const std::string& landmark_file,
+                              int landmark_num) {
+  landmarks_.reset();
+  std::unique_ptr<TopoLandmarks> landmarks(new TopoLandmarks());
+  LandmarkTable table;
+  if (cyber::common::PathExists(landmark_file) &&
+      cyber::common::GetProtoFromFile(landmark_file, &table) &&
+      table.landmark_lane_id_size() == landmark_num &&
+      landmarks->Init(*this, table)) {
+    AINFO << "Load routing landmarks from " << landmark_file;
+    landmarks_ = std::move(landmarks);
+    return true;
+  }
+
+  if (!landmarks->Init(*this, landmark_num, &table)) {
+    AERROR << "Failed to compute routing landmarks.";
+    return false;
+  }
+  if (!cyber::common::SetProtoToBinaryFile(table, landmark_file)) {
+    AWARN << "Failed to save routing landmarks to " << landmark_file;
+  } else {
+    AINFO << "Save routing landmarks to " << landmark_file;
+  }
+  landmarks_ = std::move(landmarks);
+  return true;
+}
+
 const std::string& TopoGraph::MapVersion() const { return map_version_; }
 
 const std::string& TopoGraph::MapDistrict() const { return map_district_; }
@@ -96,6 +132,26 @@ const TopoNode* TopoGraph::GetNode(const std::string& id) const {
   return topo_nodes_[iter->second].get();
 }
 
+int TopoGraph::NodeNum() const { return static_cast<int>(topo_nodes_.size()); }
+
+int TopoGraph::EdgeNum() const { return static_cast<int>(topo_edges_.size()); }
+
+const TopoNode* TopoGraph::GetNodeByIndex(int index) const {
+  if (index < 0 || index >= NodeNum()) {
+    return nullptr;
+  }
+  return topo_nodes_[index].get();
+}
+
+const TopoEdge* TopoGraph::GetEdgeByIndex(int index) const {
+  if (index < 0 || index >= EdgeNum()) {
+    return nullptr;
+  }
+  return topo_edges_[index].get();
+}
+
+const TopoLandmarks* TopoGraph::Landmarks() const { return landmarks_.get(); }
+
 void TopoGraph::GetNodesByRoadId(
     const std::string& road_id,
     std::unordered_set<const TopoNode*>* const node_in_road) const {
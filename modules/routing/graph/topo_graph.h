@@ -28,16 +28,30 @@
 namespace apollo {
 namespace routing {
 
+class TopoLandmarks;
+
 class TopoGraph {
  public:
-  TopoGraph() = default;
-  ~TopoGraph() = default;
+  TopoGraph();
+  ~TopoGraph();
 
   bool LoadGraph(const Graph& filename);
+  // Loads the landmark table of the graph from landmark_file, or computes it
+  // with landmark_num landmarks and saves it there if the file is missing or
+  // is not of the graph.
+  bool LoadLandmarks(const std::string& landmark_file, int landmark_num);
 
   const std::string& MapVersion() const;
   const std::string& MapDistrict() const;
   const TopoNode* GetNode(const std::string& id) const;
+  // Nodes are indexed in the order of Graph.node, see TopoNode::Index().
+  int NodeNum() const;
+  int EdgeNum() const;
+  const TopoNode* GetNodeByIndex(int index) const;
+  // Edges are indexed in the order of Graph.edge.
+  const TopoEdge* GetEdgeByIndex(int index) const;
+  // nullptr if no landmark table is loaded.
+  const TopoLandmarks* Landmarks() const;
   void GetNodesByRoadId(
       const std::string& road_id,
       std::unordered_set<const TopoNode*>* const node_in_road) const;
@@ -55,6 +69,7 @@ class TopoGraph {
   std::unordered_map<std::string, int> node_index_map_;
   std::unordered_map<std::string, std::unordered_set<const TopoNode*>>
       road_node_map_;
+  std::unique_ptr<TopoLandmarks> landmarks_;
 };
 
 }  // namespace routing
@@ -0,0 +1,263 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/graph/topo_landmarks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+// FNV-1a, which unlike std::hash is the same in every build reading the
+// table file.
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+void HashBytes(const void* data, size_t size, uint64_t* const hash) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    *hash = (*hash ^ bytes[i]) * kFnvPrime;
+  }
+}
+
+void HashDouble(const double value, uint64_t* const hash) {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  HashBytes(&bits, sizeof(bits), hash);
+}
+
+void HashInt(const int value, uint64_t* const hash) {
+  HashBytes(&value, sizeof(value), hash);
+}
+
+// Changed along with the costs below, so that older tables are rejected.
+constexpr int kCostVersion = 2;
+
+// Half the cost of the lane of node.
+double Potential(const TopoNode* node) { return node->Cost() / 2; }
+
+// The cost of AStarStrategy to move along the edge, plus the potential of
+// its from node minus the one of its to node. A lane change costs its edge
+// only then, which is not negative unlike the cost of AStarStrategy to a
+// cheaper lane.
+double ReducedEdgeCost(const TopoEdge* edge) {
+  double cost = edge->Cost();
+  if (edge->Type() == TopoEdgeType::TET_FORWARD) {
+    cost += Potential(edge->FromNode()) + Potential(edge->ToNode());
+  }
+  // Not negative for the costs of a routing map.
+  return std::max(cost, 0.0);
+}
+
+double Distance(const TopoNode* node_1, const TopoNode* node_2) {
+  const auto& point_1 = node_1->AnchorPoint();
+  const auto& point_2 = node_2->AnchorPoint();
+  const double distance = std::fabs(point_1.x() - point_2.x()) +
+                          std::fabs(point_1.y() - point_2.y());
+  // NaN if either node has no anchor point.
+  return std::isnan(distance) ? 0.0 : distance;
+}
+
+// Farthest point selection over the anchor points, skipping the nodes
+// without any edge.
+std::vector<const TopoNode*> SelectLandmarks(const TopoGraph& graph,
+                                             int landmark_num) {
+  std::vector<const TopoNode*> candidates;
+  for (int i = 0; i < graph.NodeNum(); ++i) {
+    const TopoNode* node = graph.GetNodeByIndex(i);
+    if (!node->InFromAllEdge().empty() || !node->OutToAllEdge().empty()) {
+      candidates.push_back(node);
+    }
+  }
+  std::vector<const TopoNode*> landmarks;
+  if (candidates.empty()) {
+    return landmarks;
+  }
+  // Distance to the closest landmark, to the first candidate at first.
+  std::vector<double> distances;
+  for (const auto* node : candidates) {
+    distances.push_back(Distance(candidates.front(), node));
+  }
+  while (static_cast<int>(landmarks.size()) < landmark_num) {
+    const size_t farthest =
+        std::max_element(distances.begin(), distances.end()) -
+        distances.begin();
+    if (!landmarks.empty() && distances[farthest] <= 0.0) {
+      break;
+    }
+    landmarks.push_back(candidates[farthest]);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      distances[i] =
+          std::min(distances[i], Distance(candidates[farthest], candidates[i]));
+    }
+  }
+  return landmarks;
+}
+
+}  // namespace
+
+bool TopoLandmarks::Init(const TopoGraph& graph, int landmark_num,
+                         LandmarkTable* const table) {
+  const auto landmarks = SelectLandmarks(graph, landmark_num);
+  if (landmarks.empty()) {
+    AERROR << "No landmark found in topo graph.";
+    return false;
+  }
+  landmark_num_ = static_cast<int>(landmarks.size());
+  const int node_num = graph.NodeNum();
+  cost_from_landmark_.assign(node_num * landmark_num_, kInfinity);
+  cost_to_landmark_.assign(node_num * landmark_num_, kInfinity);
+
+  table->Clear();
+  table->set_hdmap_version(graph.MapVersion());
+  table->set_node_num(node_num);
+  table->set_edge_num(graph.EdgeNum());
+  table->set_cost_hash(CostHash(graph));
+  std::vector<double> costs;
+  for (int l = 0; l < landmark_num_; ++l) {
+    table->add_landmark_lane_id(landmarks[l]->LaneId());
+    ComputeCosts(graph, landmarks[l], true, &costs);
+    for (int i = 0; i < node_num; ++i) {
+      cost_from_landmark_[i * landmark_num_ + l] = costs[i];
+    }
+    ComputeCosts(graph, landmarks[l], false, &costs);
+    for (int i = 0; i < node_num; ++i) {
+      cost_to_landmark_[i * landmark_num_ + l] = costs[i];
+    }
+  }
+  table->mutable_cost_from_landmark()->Add(cost_from_landmark_.begin(),
+                                           cost_from_landmark_.end());
+  table->mutable_cost_to_landmark()->Add(cost_to_landmark_.begin(),
+                                         cost_to_landmark_.end());
+  AINFO << "Computed the routing costs of " << landmark_num_
+        << " landmarks over " << node_num << " nodes.";
+  return true;
+}
+
+bool TopoLandmarks::Init(const TopoGraph& graph, const LandmarkTable& table) {
+  const int landmark_num = table.landmark_lane_id_size();
+  const int size = graph.NodeNum() * landmark_num;
+  if (table.hdmap_version() != graph.MapVersion() ||
+      table.node_num() != graph.NodeNum() ||
+      table.edge_num() != graph.EdgeNum() ||
+      table.cost_hash() != CostHash(graph) || landmark_num == 0 ||
+      table.cost_from_landmark_size() != size ||
+      table.cost_to_landmark_size() != size) {
+    AWARN << "The landmark table is not of the topo graph.";
+    return false;
+  }
+  for (const auto& lane_id : table.landmark_lane_id()) {
+    if (graph.GetNode(lane_id) == nullptr) {
+      AWARN << "Landmark is not found in topo graph! ID: " << lane_id;
+      return false;
+    }
+  }
+  landmark_num_ = landmark_num;
+  cost_from_landmark_.assign(table.cost_from_landmark().begin(),
+                             table.cost_from_landmark().end());
+  cost_to_landmark_.assign(table.cost_to_landmark().begin(),
+                           table.cost_to_landmark().end());
+  return true;
+}
+
+int TopoLandmarks::LandmarkNum() const { return landmark_num_; }
+
+double TopoLandmarks::LowerBound(const TopoNode* from_node,
+                                 const TopoNode* to_node) const {
+  const int from_offset = from_node->OriginNode()->Index() * landmark_num_;
+  const int to_offset = to_node->OriginNode()->Index() * landmark_num_;
+  const double* landmark_to_from = &cost_from_landmark_[from_offset];
+  const double* landmark_to_to = &cost_from_landmark_[to_offset];
+  const double* from_to_landmark = &cost_to_landmark_[from_offset];
+  const double* to_to_landmark = &cost_to_landmark_[to_offset];
+  double bound = 0.0;
+  for (int l = 0; l < landmark_num_; ++l) {
+    // Not finite if either node can not reach or be reached by the landmark.
+    const double before = landmark_to_to[l] - landmark_to_from[l];
+    if (std::isfinite(before)) {
+      bound = std::max(bound, before);
+    }
+    const double after = from_to_landmark[l] - to_to_landmark[l];
+    if (std::isfinite(after)) {
+      bound = std::max(bound, after);
+    }
+  }
+  // Back from the reduced costs. Sub nodes have the costs of their lanes,
+  // and the routes between them are the ones of their lanes or longer.
+  return bound + Potential(to_node) - Potential(from_node);
+}
+
+uint64_t TopoLandmarks::CostHash(const TopoGraph& graph) {
+  uint64_t hash = kFnvOffsetBasis;
+  HashInt(kCostVersion, &hash);
+  for (int i = 0; i < graph.NodeNum(); ++i) {
+    const TopoNode* node = graph.GetNodeByIndex(i);
+    HashBytes(node->LaneId().data(), node->LaneId().size(), &hash);
+    HashDouble(node->Cost(), &hash);
+  }
+  for (int i = 0; i < graph.EdgeNum(); ++i) {
+    const TopoEdge* edge = graph.GetEdgeByIndex(i);
+    HashInt(edge->FromNode()->Index(), &hash);
+    HashInt(edge->ToNode()->Index(), &hash);
+    HashInt(static_cast<int>(edge->Type()), &hash);
+    HashDouble(edge->Cost(), &hash);
+  }
+  return hash;
+}
+
+void TopoLandmarks::ComputeCosts(const TopoGraph& graph,
+                                 const TopoNode* landmark, bool forward,
+                                 std::vector<double>* const costs) {
+  costs->assign(graph.NodeNum(), kInfinity);
+  using CostIndex = std::pair<double, int>;
+  std::priority_queue<CostIndex, std::vector<CostIndex>,
+                      std::greater<CostIndex>>
+      open_set;
+  (*costs)[landmark->Index()] = 0.0;
+  open_set.emplace(0.0, landmark->Index());
+  while (!open_set.empty()) {
+    const CostIndex current = open_set.top();
+    open_set.pop();
+    if (current.first > (*costs)[current.second]) {
+      continue;
+    }
+    const TopoNode* node = graph.GetNodeByIndex(current.second);
+    const auto& edges = forward ? node->OutToAllEdge() : node->InFromAllEdge();
+    for (const auto* edge : edges) {
+      const TopoNode* next = forward ? edge->ToNode() : edge->FromNode();
+      const double cost = current.first + ReducedEdgeCost(edge);
+      if (cost < (*costs)[next->Index()]) {
+        (*costs)[next->Index()] = cost;
+        open_set.emplace(cost, next->Index());
+      }
+    }
+  }
+}
+
+}  // namespace routing
+}  // namespace apollo
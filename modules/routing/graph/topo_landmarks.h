@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "modules/routing/proto/topo_graph.pb.h"
+#include "modules/routing/graph/topo_graph.h"
+
+namespace apollo {
+namespace routing {
+
+// Routing costs from and to a few landmark nodes of a TopoGraph, for the
+// lower bounds of the routing cost between any two nodes by the triangle
+// inequality (the ALT heuristic).
+//
+// The costs are those of AStarStrategy with all the edges usable, reduced by
+// a potential of half the lane cost per node: a route costs the same less
+// the potential of its start plus the one of its end, and no edge has a
+// negative reduced cost. The bounds of the reduced costs are then exact,
+// unlike ones of the costs of AStarStrategy, in which a lane change to a
+// cheaper lane is negative.
+class TopoLandmarks {
+ public:
+  TopoLandmarks() = default;
+  ~TopoLandmarks() = default;
+
+  // Selects landmark_num landmarks spread over the map and computes the
+  // costs, which are saved to table.
+  bool Init(const TopoGraph& graph, int landmark_num,
+            LandmarkTable* const table);
+  // Loads the costs from table, which fails if it is not of graph or the
+  // costs of graph changed since.
+  bool Init(const TopoGraph& graph, const LandmarkTable& table);
+
+  int LandmarkNum() const;
+  // A lower bound of the routing cost from from_node to to_node, nodes of
+  // the graph or sub nodes of them. It is negative when to_node is much
+  // cheaper than from_node.
+  double LowerBound(const TopoNode* from_node, const TopoNode* to_node) const;
+
+ private:
+  // Of the lane ids and the costs of the nodes and edges of graph.
+  static uint64_t CostHash(const TopoGraph& graph);
+  static void ComputeCosts(const TopoGraph& graph, const TopoNode* landmark,
+                           bool forward, std::vector<double>* const costs);
+
+  int landmark_num_ = 0;
+  // By node index, then by landmark.
+  std::vector<double> cost_from_landmark_;
+  std::vector<double> cost_to_landmark_;
+};
+
+}  // namespace routing
+}  // namespace apollo
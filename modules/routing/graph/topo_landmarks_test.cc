@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/graph/topo_landmarks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+const double kForwardCost = TEST_EDGE_COST + TEST_LANE_COST;
+const double kLaneChangeCost = TEST_EDGE_COST;
+
+// The routing costs of AStarStrategy between all the nodes, by Bellman-Ford
+// as a lane change to a cheaper lane has a negative cost.
+std::vector<std::vector<double>> RoutingCosts(const TopoGraph& graph) {
+  const int node_num = graph.NodeNum();
+  std::vector<std::vector<double>> costs(
+      node_num,
+      std::vector<double>(node_num, std::numeric_limits<double>::infinity()));
+  for (int from = 0; from < node_num; ++from) {
+    costs[from][from] = 0.0;
+    for (int round = 1; round < node_num; ++round) {
+      for (int i = 0; i < graph.EdgeNum(); ++i) {
+        const TopoEdge* edge = graph.GetEdgeByIndex(i);
+        double cost = edge->Cost() + edge->ToNode()->Cost();
+        if (edge->Type() != TopoEdgeType::TET_FORWARD) {
+          cost -= (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
+        }
+        double& to_cost = costs[from][edge->ToNode()->Index()];
+        to_cost = std::min(to_cost, costs[from][edge->FromNode()->Index()] +
+                                        cost);
+      }
+    }
+  }
+  return costs;
+}
+
+}  // namespace
+
+TEST(TopoLandmarksTestSuit, lower_bound) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+
+  // The lanes have no anchor point, so L1 is the only landmark.
+  TopoLandmarks landmarks;
+  LandmarkTable table;
+  ASSERT_TRUE(landmarks.Init(topo_graph, 4, &table));
+  ASSERT_EQ(1, landmarks.LandmarkNum());
+  ASSERT_EQ(1, table.landmark_lane_id_size());
+  ASSERT_EQ(TEST_L1, table.landmark_lane_id(0));
+
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  const TopoNode* node_3 = topo_graph.GetNode(TEST_L3);
+  const TopoNode* node_5 = topo_graph.GetNode(TEST_L5);
+  const TopoNode* node_6 = topo_graph.GetNode(TEST_L6);
+  ASSERT_DOUBLE_EQ(2 * kForwardCost, landmarks.LowerBound(node_1, node_5));
+  ASSERT_DOUBLE_EQ(kForwardCost + kLaneChangeCost,
+                   landmarks.LowerBound(node_3, node_6));
+  // L1 can not be reached from L5.
+  ASSERT_DOUBLE_EQ(0.0, landmarks.LowerBound(node_5, node_1));
+  ASSERT_DOUBLE_EQ(0.0, landmarks.LowerBound(node_5, node_5));
+
+  // A sub node of the lane is not reached at a higher cost than the lane.
+  const TopoNode sub_node_5(node_5, NodeSRange(0.0, TEST_LANE_LENGTH / 2));
+  ASSERT_DOUBLE_EQ(landmarks.LowerBound(node_1, node_5),
+                   landmarks.LowerBound(node_1, &sub_node_5));
+}
+
+TEST(TopoLandmarksTestSuit, lower_bound_with_cheaper_lanes) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  // Changing from L3 to L4, or from L5 to L6, costs less than nothing.
+  graph.mutable_node(2)->set_cost(100 * TEST_LANE_COST);
+  graph.mutable_node(4)->set_cost(10 * TEST_LANE_COST);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  TopoLandmarks landmarks;
+  LandmarkTable table;
+  ASSERT_TRUE(landmarks.Init(topo_graph, 4, &table));
+
+  const auto costs = RoutingCosts(topo_graph);
+  const TopoNode* node_3 = topo_graph.GetNode(TEST_L3);
+  const TopoNode* node_6 = topo_graph.GetNode(TEST_L6);
+  ASSERT_LT(costs[node_3->Index()][node_6->Index()], 0.0);
+  for (int from = 0; from < topo_graph.NodeNum(); ++from) {
+    for (int to = 0; to < topo_graph.NodeNum(); ++to) {
+      if (std::isfinite(costs[from][to])) {
+        EXPECT_LE(landmarks.LowerBound(topo_graph.GetNodeByIndex(from),
+                                       topo_graph.GetNodeByIndex(to)),
+                  costs[from][to] + 1e-9)
+            << from << " to " << to;
+      }
+    }
+  }
+  // Exact from the landmark L1 along the route through the cheaper lanes.
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  EXPECT_DOUBLE_EQ(costs[node_1->Index()][node_6->Index()],
+                   landmarks.LowerBound(node_1, node_6));
+}
+
+TEST(TopoLandmarksTestSuit, load_table) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+
+  LandmarkTable table;
+  TopoLandmarks computed;
+  ASSERT_TRUE(computed.Init(topo_graph, 1, &table));
+  TopoLandmarks loaded;
+  ASSERT_TRUE(loaded.Init(topo_graph, table));
+  ASSERT_EQ(1, loaded.LandmarkNum());
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  const TopoNode* node_6 = topo_graph.GetNode(TEST_L6);
+  ASSERT_DOUBLE_EQ(computed.LowerBound(node_1, node_6),
+                   loaded.LowerBound(node_1, node_6));
+
+  // The table of another graph is rejected.
+  Graph graph_2;
+  GetGraph2ForTest(&graph_2);
+  TopoGraph topo_graph_2;
+  ASSERT_TRUE(topo_graph_2.LoadGraph(graph_2));
+  ASSERT_FALSE(loaded.Init(topo_graph_2, table));
+
+  // Nor the table of the graph before its costs changed.
+  graph.mutable_edge(0)->set_cost(2 * TEST_EDGE_COST);
+  TopoGraph topo_graph_3;
+  ASSERT_TRUE(topo_graph_3.LoadGraph(graph));
+  ASSERT_FALSE(loaded.Init(topo_graph_3, table));
+  graph.mutable_node(0)->set_cost(2 * TEST_LANE_COST);
+  ASSERT_TRUE(topo_graph_3.LoadGraph(graph));
+  ASSERT_TRUE(computed.Init(topo_graph_3, 1, &table));
+  ASSERT_TRUE(loaded.Init(topo_graph_3, table));
+  table.set_cost_hash(table.cost_hash() + 1);
+  ASSERT_FALSE(loaded.Init(topo_graph_3, table));
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -67,6 +67,9 @@ class TopoNode {
   const TopoEdge* GetOutEdgeTo(const TopoNode* to_node) const;
 
   const TopoNode* OriginNode() const;
+  // Ordinal of the node in its TopoGraph or SubTopoGraph, -1 if not set.
+  int Index() const;
+  void SetIndex(int index);
   double StartS() const;
   double EndS() const;
   bool IsSubNode() const;
@@ -110,6 +113,7 @@ class TopoNode {
   std::unordered_map<const TopoNode*, const TopoEdge*> in_edge_map_;
 
   const TopoNode* origin_node_;
+  int index_ = -1;
 };
 
 enum TopoEdgeType {
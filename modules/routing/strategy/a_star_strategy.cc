@@ -18,10 +18,13 @@
 #include <cmath>
 #include <limits>
 #include <queue>
+#include <unordered_set>
+#include <utility>
 
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/graph/sub_topo_graph.h"
 #include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/graph/topo_landmarks.h"
 #include "modules/routing/strategy/a_star_strategy.h"
 
 namespace apollo {
@@ -175,17 +178,9 @@ bool AdjustLaneChange(std::vector<const TopoNode*>* const result_node_vec) {
   return true;
 }
 
-bool Reconstruct(
-    const std::unordered_map<const TopoNode*, const TopoNode*>& came_from,
-    const TopoNode* dest_node, std::vector<NodeWithRange>* result_nodes) {
-  std::vector<const TopoNode*> result_node_vec;
-  result_node_vec.push_back(dest_node);
-
-  auto iter = came_from.find(dest_node);
-  while (iter != came_from.end()) {
-    result_node_vec.push_back(iter->second);
-    iter = came_from.find(iter->second);
-  }
+// result_node_vec is from the dest node back to the src node.
+bool Reconstruct(std::vector<const TopoNode*> result_node_vec,
+                 std::vector<NodeWithRange>* result_nodes) {
   std::reverse(result_node_vec.begin(), result_node_vec.end());
   if (!AdjustLaneChange(&result_node_vec)) {
     AERROR << "Failed to adjust lane change";
@@ -204,16 +199,24 @@ bool Reconstruct(
 AStarStrategy::AStarStrategy(bool enable_change)
     : change_lane_enabled_(enable_change) {}
 
-void AStarStrategy::Clear() {
-  closed_set_.clear();
-  open_set_.clear();
-  came_from_.clear();
-  enter_s_.clear();
-  g_score_.clear();
+void AStarStrategy::Clear(int node_num) {
+  closed_set_.assign(node_num, false);
+  open_set_.assign(node_num, false);
+  came_from_.assign(node_num, nullptr);
+  enter_s_.assign(node_num, std::numeric_limits<double>::quiet_NaN());
+  g_score_.assign(node_num, 0.0);
+  f_score_.assign(node_num, 0.0);
+}
+
+int AStarStrategy::NodeSlot(const TopoNode* node) const {
+  return node->IsSubNode() ? graph_node_num_ + node->Index() : node->Index();
 }
 
 double AStarStrategy::HeuristicCost(const TopoNode* src_node,
                                     const TopoNode* dest_node) {
+  if (landmarks_ != nullptr) {
+    return landmarks_->LowerBound(src_node, dest_node);
+  }
   const auto& src_point = src_node->AnchorPoint();
   const auto& dest_point = dest_node->AnchorPoint();
   double distance = std::fabs(src_point.x() - dest_point.x()) +
@@ -225,8 +228,11 @@ bool AStarStrategy::Search(const TopoGraph* graph,
                            const SubTopoGraph* sub_graph,
                            const TopoNode* src_node, const TopoNode* dest_node,
                            std::vector<NodeWithRange>* const result_nodes) {
-  Clear();
-  AINFO << "Start A* search algorithm.";
+  landmarks_ = graph->Landmarks();
+  graph_node_num_ = graph->NodeNum();
+  Clear(graph_node_num_ + sub_graph->NodeNum());
+  AINFO << "Start A* search algorithm"
+        << (landmarks_ != nullptr ? " with landmarks." : ".");
 
   std::priority_queue<SearchNode> open_set_detail;
 
@@ -234,9 +240,11 @@ bool AStarStrategy::Search(const TopoGraph* graph,
   src_search_node.f = HeuristicCost(src_node, dest_node);
   open_set_detail.push(src_search_node);
 
-  open_set_.insert(src_node);
-  g_score_[src_node] = 0.0;
-  enter_s_[src_node] = src_node->StartS();
+  const int src_slot = NodeSlot(src_node);
+  open_set_[src_slot] = true;
+  g_score_[src_slot] = 0.0;
+  f_score_[src_slot] = src_search_node.f;
+  enter_s_[src_slot] = src_node->StartS();
 
   SearchNode current_node;
   std::unordered_set<const TopoEdge*> next_edge_set;
@@ -244,21 +252,27 @@ bool AStarStrategy::Search(const TopoGraph* graph,
   while (!open_set_detail.empty()) {
     current_node = open_set_detail.top();
     const auto* from_node = current_node.topo_node;
+    const int from_slot = NodeSlot(from_node);
     if (current_node.topo_node == dest_node) {
-      if (!Reconstruct(came_from_, from_node, result_nodes)) {
+      std::vector<const TopoNode*> result_node_vec;
+      for (const auto* node = from_node; node != nullptr;
+           node = came_from_[NodeSlot(node)]) {
+        result_node_vec.push_back(node);
+      }
+      if (!Reconstruct(std::move(result_node_vec), result_nodes)) {
         AERROR << "Failed to reconstruct route.";
         return false;
       }
       return true;
     }
-    open_set_.erase(from_node);
+    open_set_[from_slot] = false;
     open_set_detail.pop();
 
-    if (closed_set_.count(from_node) != 0) {
+    if (closed_set_[from_slot]) {
       // if showed before, just skip...
       continue;
     }
-    closed_set_.emplace(from_node);
+    closed_set_[from_slot] = true;
 
     // if residual_s is less than FLAGS_min_length_for_lane_change, only move
     // forward
@@ -277,29 +291,29 @@ bool AStarStrategy::Search(const TopoGraph* graph,
 
     for (const auto* edge : next_edge_set) {
       const auto* to_node = edge->ToNode();
-      if (closed_set_.count(to_node) == 1) {
+      const int to_slot = NodeSlot(to_node);
+      if (closed_set_[to_slot]) {
         continue;
       }
       if (GetResidualS(edge, to_node) < FLAGS_min_length_for_lane_change) {
         continue;
       }
-      tentative_g_score =
-          g_score_[current_node.topo_node] + GetCostToNeighbor(edge);
+      tentative_g_score = g_score_[from_slot] + GetCostToNeighbor(edge);
       if (edge->Type() != TopoEdgeType::TET_FORWARD) {
         tentative_g_score -=
             (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
       }
       double f = tentative_g_score + HeuristicCost(to_node, dest_node);
-      if (open_set_.count(to_node) != 0 && f >= g_score_[to_node]) {
+      if (open_set_[to_slot] && f >= f_score_[to_slot]) {
         continue;
       }
       // if to_node is reached by forward, reset enter_s to start_s
       if (edge->Type() == TopoEdgeType::TET_FORWARD) {
-        enter_s_[to_node] = to_node->StartS();
+        enter_s_[to_slot] = to_node->StartS();
       } else {
         // else, add enter_s with FLAGS_min_length_for_lane_change
         double to_node_enter_s =
-            (enter_s_[from_node] + FLAGS_min_length_for_lane_change) /
+            (enter_s_[from_slot] + FLAGS_min_length_for_lane_change) /
             from_node->Length() * to_node->Length();
         // enter s could be larger than end_s but should be less than length
         to_node_enter_s = std::min(to_node_enter_s, to_node->Length());
@@ -307,17 +321,18 @@ bool AStarStrategy::Search(const TopoGraph* graph,
         if (to_node_enter_s > to_node->EndS() && to_node == dest_node) {
           continue;
         }
-        enter_s_[to_node] = to_node_enter_s;
+        enter_s_[to_slot] = to_node_enter_s;
       }
 
-      g_score_[to_node] = f;
+      // The straight line search keeps f as the g score, which adds up the
+      // heuristics along the route. Kept as is to not change its routes.
+      g_score_[to_slot] = landmarks_ != nullptr ? tentative_g_score : f;
+      f_score_[to_slot] = f;
       SearchNode next_node(to_node);
       next_node.f = f;
       open_set_detail.push(next_node);
-      came_from_[to_node] = from_node;
-      if (open_set_.count(to_node) == 0) {
-        open_set_.insert(to_node);
-      }
+      came_from_[to_slot] = from_node;
+      open_set_[to_slot] = true;
     }
   }
   AERROR << "Failed to find goal lane with id: " << dest_node->LaneId();
@@ -326,12 +341,12 @@ bool AStarStrategy::Search(const TopoGraph* graph,
 
 double AStarStrategy::GetResidualS(const TopoNode* node) {
   double start_s = node->StartS();
-  const auto iter = enter_s_.find(node);
-  if (iter != enter_s_.end()) {
-    if (iter->second > node->EndS()) {
+  const double enter_s = enter_s_[NodeSlot(node)];
+  if (!std::isnan(enter_s)) {
+    if (enter_s > node->EndS()) {
       return 0.0;
     }
-    start_s = iter->second;
+    start_s = enter_s;
   } else {
     AWARN << "lane " << node->LaneId() << "(" << node->StartS() << ", "
           << node->EndS() << "not found in enter_s map";
@@ -357,9 +372,9 @@ double AStarStrategy::GetResidualS(const TopoEdge* edge,
   }
   double start_s = to_node->StartS();
   const auto* from_node = edge->FromNode();
-  const auto iter = enter_s_.find(from_node);
-  if (iter != enter_s_.end()) {
-    double temp_s = iter->second / from_node->Length() * to_node->Length();
+  const double enter_s = enter_s_[NodeSlot(from_node)];
+  if (!std::isnan(enter_s)) {
+    double temp_s = enter_s / from_node->Length() * to_node->Length();
     start_s = std::max(start_s, temp_s);
   } else {
     AWARN << "lane " << from_node->LaneId() << "(" << from_node->StartS()
@@ -16,8 +16,6 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "modules/routing/strategy/strategy.h"
@@ -25,6 +23,11 @@
 namespace apollo {
 namespace routing {
 
+class TopoLandmarks;
+
+// The search is guided by the routing costs to and from the landmarks of the
+// graph if it has loaded them, see TopoGraph::LoadLandmarks(), or else by the
+// straight line distance.
 class AStarStrategy : public Strategy {
  public:
   explicit AStarStrategy(bool enable_change);
@@ -35,18 +38,26 @@ class AStarStrategy : public Strategy {
                       std::vector<NodeWithRange>* const result_nodes);
 
  private:
-  void Clear();
+  void Clear(int node_num);
+  // Index of the node in the per node vectors, the nodes of the graph
+  // followed by the sub nodes of the sub graph.
+  int NodeSlot(const TopoNode* node) const;
   double HeuristicCost(const TopoNode* src_node, const TopoNode* dest_node);
   double GetResidualS(const TopoNode* node);
   double GetResidualS(const TopoEdge* edge, const TopoNode* to_node);
 
  private:
   bool change_lane_enabled_;
-  std::unordered_set<const TopoNode*> open_set_;
-  std::unordered_set<const TopoNode*> closed_set_;
-  std::unordered_map<const TopoNode*, const TopoNode*> came_from_;
-  std::unordered_map<const TopoNode*, double> g_score_;
-  std::unordered_map<const TopoNode*, double> enter_s_;
+  const TopoLandmarks* landmarks_ = nullptr;
+  int graph_node_num_ = 0;
+  // By NodeSlot(), kept between the searches to reuse their memory.
+  std::vector<bool> open_set_;
+  std::vector<bool> closed_set_;
+  std::vector<const TopoNode*> came_from_;
+  std::vector<double> g_score_;
+  std::vector<double> f_score_;
+  // NaN if the node is not entered.
+  std::vector<double> enter_s_;
 };
 
 }  // namespace routing
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/* Route between random lanes of the demo maps with AStarStrategy, guided by
+ * the straight line distance, range(1) == 0, or by the routing landmarks,
+ * range(1) == 1. range(0) is the map in kMapDirs.
+ *
+ * Usage:
+ *   a_star_strategy_benchmark --benchmark_min_time=1
+ */
+
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/graph/sub_topo_graph.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/strategy/a_star_strategy.h"
+
+namespace apollo {
+namespace routing {
+namespace {
+
+const char* const kMapDirs[] = {
+    "/apollo/modules/map/data/demo",
+    "/apollo/modules/map/data/borregas_ave",
+};
+
+constexpr size_t kRouteNum = 64;
+constexpr int kMaxTryNum = 1024;
+
+std::unique_ptr<TopoGraph> LoadGraph(const std::string& map_dir,
+                                     bool with_landmarks) {
+  std::string routing_map_file = map_dir + "/routing_map.bin";
+  if (!cyber::common::PathExists(routing_map_file)) {
+    routing_map_file = map_dir + "/routing_map.txt";
+  }
+  Graph graph;
+  ACHECK(cyber::common::GetProtoFromFile(routing_map_file, &graph));
+  std::unique_ptr<TopoGraph> topo_graph(new TopoGraph());
+  ACHECK(topo_graph->LoadGraph(graph));
+  if (with_landmarks) {
+    const std::string landmark_file =
+        "/tmp/" + cyber::common::GetFileName(map_dir) + "_" +
+        FLAGS_routing_landmark_filename;
+    if (!topo_graph->LoadLandmarks(landmark_file,
+                                   FLAGS_routing_landmark_num)) {
+      return nullptr;
+    }
+  }
+  return topo_graph;
+}
+
+// Random pairs of lanes with a route between them, the same pairs with or
+// without landmarks.
+std::vector<std::pair<const TopoNode*, const TopoNode*>> Routes(
+    const TopoGraph& graph, const SubTopoGraph& sub_graph) {
+  std::mt19937 generator(kRouteNum);
+  std::uniform_int_distribution<int> index(0, graph.NodeNum() - 1);
+  AStarStrategy strategy(FLAGS_enable_change_lane_in_result);
+  std::vector<NodeWithRange> result_nodes;
+  std::vector<std::pair<const TopoNode*, const TopoNode*>> routes;
+  for (int i = 0; i < kMaxTryNum && routes.size() < kRouteNum; ++i) {
+    const TopoNode* src_node = graph.GetNodeByIndex(index(generator));
+    const TopoNode* dest_node = graph.GetNodeByIndex(index(generator));
+    if (src_node != dest_node &&
+        strategy.Search(&graph, &sub_graph, src_node, dest_node,
+                        &result_nodes)) {
+      routes.emplace_back(src_node, dest_node);
+    }
+  }
+  return routes;
+}
+
+void BM_Search(benchmark::State& state) {
+  const auto graph =
+      LoadGraph(kMapDirs[state.range(0)], state.range(1) != 0);
+  if (graph == nullptr) {
+    state.SkipWithError("No landmark in the map.");
+    return;
+  }
+  const SubTopoGraph sub_graph(
+      std::unordered_map<const TopoNode*, std::vector<NodeSRange>>{});
+  const auto routes = Routes(*graph, sub_graph);
+  if (routes.empty()) {
+    state.SkipWithError("No route in the map.");
+    return;
+  }
+
+  AStarStrategy strategy(FLAGS_enable_change_lane_in_result);
+  std::vector<NodeWithRange> result_nodes;
+  for (auto _ : state) {
+    for (const auto& route : routes) {
+      benchmark::DoNotOptimize(strategy.Search(
+          graph.get(), &sub_graph, route.first, route.second, &result_nodes));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * routes.size());
+}
+
+BENCHMARK(BM_Search)->Args({0, 0})->Args({0, 1})->Args({1, 0})->Args({1, 1});
+
+}  // namespace
+}  // namespace routing
+}  // namespace apollo
+
+BENCHMARK_MAIN();
@@ -0,0 +1,14 @@
+"""Loads the libjpeg-turbo library"""
+
+# Sanitize a dependency so that it works correctly from code that includes
+# Apollo as a submodule.
+def clean_dep(dep):
+    return str(Label(dep))
+
+# Installed via libjpeg-turbo8-dev
+def repo():
+    native.new_local_repository(
+        name = "libjpeg_turbo",
+        build_file = clean_dep("//third_party/libjpeg_turbo:libjpeg_turbo.BUILD"),
+        path = "/usr/include",
+    )
@@ -19,6 +19,7 @@ load("//third_party/nvjpeg:workspace.bzl", nvjpeg = "repo")
 load("//third_party/gtest:workspace.bzl", gtest = "repo")
 load("//third_party/gflags:workspace.bzl", gflags = "repo")
 load("//third_party/ipopt:workspace.bzl", ipopt = "repo")
+load("//third_party/libjpeg_turbo:workspace.bzl", libjpeg_turbo = "repo")
 load("//third_party/libtorch:workspace.bzl", libtorch_cpu = "repo_cpu", libtorch_gpu = "repo_gpu")
 load("//third_party/ncurses5:workspace.bzl", ncurses5 = "repo")
 load("//third_party/nlohmann_json:workspace.bzl", nlohmann_json = "repo")
@@ -68,6 +69,7 @@ def initialize_third_party():
     glog()
     gtest()
     ipopt()
+    libjpeg_turbo()
     libtorch_cpu()
     libtorch_gpu()
     ncurses5()